@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <curl/curl.h>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// One HTTP request for AsyncHttpClient
+struct HttpRequest {
+  std::string method = "POST";
+  std::string url;
+  std::string body;
+  std::unordered_map<std::string, std::string> headers;
+  bool gzipBody = false; // Content-Encoding: gzip, when it makes it smaller
+  std::chrono::milliseconds timeout{30000};
+  std::chrono::milliseconds connectTimeout{10000};
+};
+
+struct HttpResponse {
+  long status = 0;   // 0 when no response arrived
+  std::string body;
+  std::string error; // set when the transfer itself failed
+  std::chrono::microseconds latency{0}; // from send() to completion
+  size_t bytesSent = 0;                 // request body as sent
+
+  bool succeeded() const {
+    return error.empty() && status >= 200 && status < 300;
+  }
+};
+
+/**
+ * @brief Non-blocking HTTP client on one curl multi handle.
+ *
+ * send() queues a request and returns; one event-loop thread drives every
+ * transfer and calls the completion callback when it ends, so a slow
+ * endpoint only delays its own requests. Connections are kept alive in
+ * the multi handle's cache and reused by later requests to the same
+ * destination (scheme, host and port); HTTPS destinations that support
+ * HTTP/2 multiplex requests over one connection.
+ *
+ * Each destination runs at most maxConnectionsPerHost requests at once and
+ * queues up to maxQueuedPerHost more; beyond that send() fails the request
+ * at once. Callbacks run on the event-loop thread and must not block.
+ */
+class AsyncHttpClient {
+public:
+  struct Config {
+    size_t maxConnectionsPerHost = 8;
+    size_t maxQueuedPerHost = 1024;
+    size_t maxTotalConnections = 64;
+    std::chrono::seconds maxConnectionAge{118}; // idle reuse limit
+    std::string userAgent = "ETLPlus/1.0";
+  };
+
+  struct Stats {
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> succeeded{0};
+    std::atomic<uint64_t> failed{0};   // errors and non-2xx responses
+    std::atomic<uint64_t> rejected{0}; // destination queue full, or stopping
+    std::atomic<uint64_t> connectionsOpened{0};
+    std::atomic<uint64_t> bytesSent{0};       // request bodies as sent
+    std::atomic<uint64_t> bytesBeforeGzip{0}; // the same, uncompressed
+    std::atomic<uint64_t> totalLatencyUs{0};  // of succeeded and failed
+  };
+
+  using Callback = std::function<void(HttpResponse)>;
+
+  AsyncHttpClient();
+  explicit AsyncHttpClient(const Config &config);
+  // Fails requests still queued or in flight, without waiting for them
+  ~AsyncHttpClient();
+
+  AsyncHttpClient(const AsyncHttpClient &) = delete;
+  AsyncHttpClient &operator=(const AsyncHttpClient &) = delete;
+
+  // The process-wide client that webhook delivery and log shipping share
+  static std::shared_ptr<AsyncHttpClient> shared();
+
+  // done is called exactly once, on the event-loop thread, or on the
+  // calling thread when the request is rejected
+  void send(HttpRequest request, Callback done);
+  std::future<HttpResponse> send(HttpRequest request);
+
+  const Stats &getStats() const { return stats_; }
+  // Requests queued or running
+  size_t pending() const;
+
+private:
+  struct Transfer;
+  struct Destination {
+    size_t active = 0;
+    std::deque<std::unique_ptr<Transfer>> waiting;
+  };
+
+  void run();
+  bool startTransfers();
+  void finishTransfer(CURL *easy, CURLcode result);
+  void release(const Transfer &transfer);
+  void complete(Transfer &transfer, HttpResponse response);
+  void failAll(const std::string &error);
+
+  Config config_;
+  CURLM *multi_ = nullptr;
+  Stats stats_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Destination> destinations_;
+  // Admitted under the destination limit, not yet added to multi_
+  std::vector<std::unique_ptr<Transfer>> ready_;
+  size_t pending_ = 0;
+  bool stop_ = false;
+
+  // Event-loop thread only
+  std::unordered_map<CURL *, std::unique_ptr<Transfer>> running_;
+  std::vector<CURL *> idleHandles_;
+  std::thread loop_;
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+/**
+ * Blocking multi-producer/multi-consumer FIFO with a fixed capacity, used to
+ * connect pipeline stages. push() blocks while the queue is full, which
+ * propagates backpressure to faster upstream stages; the time producers and
+ * consumers spend blocked is accumulated so callers can report it.
+ *
+ * close() stops new pushes and lets consumers drain what is left; cancel()
+ * additionally discards queued items so every stage unblocks immediately.
+ */
+template <typename T> class BoundedQueue {
+public:
+  explicit BoundedQueue(size_t capacity) : capacity_(capacity ? capacity : 1) {}
+
+  BoundedQueue(const BoundedQueue &) = delete;
+  BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+  // Returns false if the queue was closed before the item could be added
+  bool push(T item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (items_.size() >= capacity_ && !closed_) {
+      auto start = std::chrono::steady_clock::now();
+      notFull_.wait(lock,
+                    [this] { return items_.size() < capacity_ || closed_; });
+      producerWait_ += std::chrono::steady_clock::now() - start;
+    }
+    if (closed_) {
+      return false;
+    }
+    items_.push_back(std::move(item));
+    lock.unlock();
+    notEmpty_.notify_one();
+    return true;
+  }
+
+  // Returns std::nullopt once the queue is closed and drained
+  std::optional<T> pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (items_.empty() && !closed_) {
+      auto start = std::chrono::steady_clock::now();
+      notEmpty_.wait(lock, [this] { return !items_.empty() || closed_; });
+      consumerWait_ += std::chrono::steady_clock::now() - start;
+    }
+    if (items_.empty()) {
+      return std::nullopt;
+    }
+    T item = std::move(items_.front());
+    items_.pop_front();
+    lock.unlock();
+    notFull_.notify_one();
+    return item;
+  }
+
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    notEmpty_.notify_all();
+    notFull_.notify_all();
+  }
+
+  void cancel() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+      items_.clear();
+    }
+    notEmpty_.notify_all();
+    notFull_.notify_all();
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return items_.size();
+  }
+  size_t capacity() const { return capacity_; }
+
+  // Total time push() spent waiting for space (backpressure)
+  std::chrono::nanoseconds producerWaitTime() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return producerWait_;
+  }
+  // Total time pop() spent waiting for input (starvation)
+  std::chrono::nanoseconds consumerWaitTime() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return consumerWait_;
+  }
+
+private:
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  std::condition_variable notEmpty_;
+  std::condition_variable notFull_;
+  std::deque<T> items_;
+  bool closed_ = false;
+  std::chrono::nanoseconds producerWait_{0};
+  std::chrono::nanoseconds consumerWait_{0};
+};
@@ -2,9 +2,11 @@
 
 #include "logger.hpp"
 #include "transparent_string_hash.hpp"
+#include <atomic>
 #include <functional>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -112,57 +114,62 @@ private:
   // Get logger instance once for better performance
   static Logger &getLogger() { return Logger::getInstance(); }
 
+  // This component's entry in Logger's threshold table, looked up once
+  static const std::atomic<int> &threshold() {
+    static const std::atomic<int> &level =
+        getLogger().componentThreshold(component_name);
+    return level;
+  }
+
 public:
+  // Checked by the component macros before anything else is evaluated:
+  // one relaxed load of this component's threshold, which Logger updates
+  // on every level or filter change
+  static bool enabled(LogLevel level) {
+    return static_cast<int>(level) >=
+           threshold().load(std::memory_order_relaxed);
+  }
+
+  // Job messages are also streamed, possibly below the logging threshold
+  static bool enabledForJob(LogLevel level) {
+    return enabled(level) || getLogger().isStreamingEnabled(level);
+  }
+
+  // The message's "{}" arguments are formatted by the thread that writes
+  // the line; the macros tag a literal message so it is kept by address
+  template <typename Message, typename... Args>
+  static void record(LogLevel level, const Message &message,
+                     const Args &...args) {
+    if (enabled(level)) {
+      getLogger().writeFormat(level, component_name, message, args...);
+    }
+  }
+
   // Standard logging methods with compile-time component name resolution
 
-  template <typename... Args>
-  static void debug(const std::string &message, Args &&...args) {
-    if constexpr (sizeof...(args) > 0) {
-      getLogger().debug(component_name,
-                        format_message(message, std::forward<Args>(args)...));
-    } else {
-      getLogger().debug(component_name, message);
-    }
+  template <typename Message, typename... Args>
+  static void debug(const Message &message, const Args &...args) {
+    record(LogLevel::DEBUG, message, args...);
   }
 
-  template <typename... Args>
-  static void info(const std::string &message, Args &&...args) {
-    if constexpr (sizeof...(args) > 0) {
-      getLogger().info(component_name,
-                       format_message(message, std::forward<Args>(args)...));
-    } else {
-      getLogger().info(component_name, message);
-    }
+  template <typename Message, typename... Args>
+  static void info(const Message &message, const Args &...args) {
+    record(LogLevel::INFO, message, args...);
   }
 
-  template <typename... Args>
-  static void warn(const std::string &message, Args &&...args) {
-    if constexpr (sizeof...(args) > 0) {
-      getLogger().warn(component_name,
-                       format_message(message, std::forward<Args>(args)...));
-    } else {
-      getLogger().warn(component_name, message);
-    }
+  template <typename Message, typename... Args>
+  static void warn(const Message &message, const Args &...args) {
+    record(LogLevel::WARN, message, args...);
   }
 
-  template <typename... Args>
-  static void error(const std::string &message, Args &&...args) {
-    if constexpr (sizeof...(args) > 0) {
-      getLogger().error(component_name,
-                        format_message(message, std::forward<Args>(args)...));
-    } else {
-      getLogger().error(component_name, message);
-    }
+  template <typename Message, typename... Args>
+  static void error(const Message &message, const Args &...args) {
+    record(LogLevel::ERROR, message, args...);
   }
 
-  template <typename... Args>
-  static void fatal(const std::string &message, Args &&...args) {
-    if constexpr (sizeof...(args) > 0) {
-      getLogger().fatal(component_name,
-                        format_message(message, std::forward<Args>(args)...));
-    } else {
-      getLogger().fatal(component_name, message);
-    }
+  template <typename Message, typename... Args>
+  static void fatal(const Message &message, const Args &...args) {
+    record(LogLevel::FATAL, message, args...);
   }
 
   // Job-specific logging methods
@@ -366,73 +373,17 @@ public:
   }
 
 private:
-  // Helper function to convert unordered_map to string representation
-  template <typename K, typename V, typename H, typename E>
-  static std::string to_string(const std::unordered_map<K, V, H, E> &map) {
-    std::stringstream ss;
-    ss << "{";
-    bool first = true;
-    for (const auto &pair : map) {
-      if (!first)
-        ss << ", ";
-      ss << pair.first << ": " << pair.second;
-      first = false;
-    }
-    ss << "}";
-    return ss.str();
-  }
-
-  // Helper function to convert any type to string for logging
-  template <typename T>
-  static void stream_value(std::stringstream &ss, T &&value) {
-    // Detect any unordered_map<std::string, std::string, H, E>
-    if constexpr (std::is_same_v<std::string,
-                                 typename std::decay_t<T>::key_type> &&
-                  std::is_same_v<std::string,
-                                 typename std::decay_t<T>::mapped_type> &&
-                  std::is_same_v<
-                      std::unordered_map<typename std::decay_t<T>::key_type,
-                                         typename std::decay_t<T>::mapped_type,
-                                         typename std::decay_t<T>::hasher,
-                                         typename std::decay_t<T>::key_equal>,
-                      std::decay_t<T>>) {
-      ss << to_string(value);
-    } else if constexpr (std::is_arithmetic_v<std::decay_t<T>> ||
-                         std::is_convertible_v<T, std::string>) {
-      ss << std::forward<T>(value);
-    } else {
-      ss << "[object]";
-    }
-  }
-
-  // Helper function for message formatting with variadic templates
+  // The message a job log call streams, formatted as record() would
   template <typename... Args>
-  static std::string format_message(const std::string &format, Args &&...args) {
-    // Simple string formatting - could be enhanced with fmt library
-    std::stringstream ss;
-    format_impl(ss, format, std::forward<Args>(args)...);
-    return ss.str();
-  }
-
-  template <typename T, typename... Args>
-  static void format_impl(std::stringstream &ss, const std::string &format,
-                          T &&arg, Args &&...args) {
-    size_t pos = format.find("{}");
-    if (pos != std::string::npos) {
-      ss << format.substr(0, pos);
-      stream_value(ss, std::forward<T>(arg));
-      if constexpr (sizeof...(args) > 0) {
-        format_impl(ss, format.substr(pos + 2), std::forward<Args>(args)...);
-      } else {
-        ss << format.substr(pos + 2);
-      }
-    } else {
-      ss << format;
-    }
-  }
-
-  static void format_impl(std::stringstream &ss, const std::string &format) {
-    ss << format;
+  static std::string format_message(std::string_view format,
+                                    const Args &...args) {
+    LogRecordWriter message(LogRecordWriter::scratch());
+    message.begin(LogLevel::INFO, sizeof...(Args), 0);
+    message.literal(component_name,
+                    std::char_traits<char>::length(component_name));
+    message.string(format);
+    (message.arg(args), ...);
+    return renderLogMessage(LogRecordWriter::scratch());
   }
 };
 
@@ -456,111 +407,175 @@ using WebSocketConnectionLogger = ComponentLogger<class WebSocketConnection>;
 
 } // namespace etl
 
+// A level below the threshold costs one check: neither the message nor the
+// arguments are evaluated. Otherwise the call is recorded by
+// ComponentLogger::record() and formatted on the writer thread.
+#define ETL_COMPONENT_LOG(Component, Level, message, ...)                      \
+  do {                                                                         \
+    if (Component::enabled(LogLevel::Level)) {                                 \
+      Component::record(LogLevel::Level, ETL_LOG_FORMAT_TEXT(message),         \
+                        ##__VA_ARGS__);                                        \
+    }                                                                          \
+  } while (0)
+
+#define ETL_COMPONENT_LOG_JOB(Component, Level, method, message, jobId, ...)   \
+  do {                                                                         \
+    if (Component::enabledForJob(LogLevel::Level)) {                           \
+      Component::method(message, jobId, ##__VA_ARGS__);                        \
+    }                                                                          \
+  } while (0)
+
 // Template-based macros for easier migration from existing macro-based code
 #define COMPONENT_LOG_DEBUG(ComponentClass, message, ...)                      \
-  etl::ComponentLogger<ComponentClass>::debug(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ComponentLogger<ComponentClass>, DEBUG, message,      \
+                    ##__VA_ARGS__)
 
 #define COMPONENT_LOG_INFO(ComponentClass, message, ...)                       \
-  etl::ComponentLogger<ComponentClass>::info(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ComponentLogger<ComponentClass>, INFO, message,       \
+                    ##__VA_ARGS__)
 
 #define COMPONENT_LOG_WARN(ComponentClass, message, ...)                       \
-  etl::ComponentLogger<ComponentClass>::warn(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ComponentLogger<ComponentClass>, WARN, message,       \
+                    ##__VA_ARGS__)
 
 #define COMPONENT_LOG_ERROR(ComponentClass, message, ...)                      \
-  etl::ComponentLogger<ComponentClass>::error(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ComponentLogger<ComponentClass>, ERROR, message,      \
+                    ##__VA_ARGS__)
 
 #define COMPONENT_LOG_FATAL(ComponentClass, message, ...)                      \
-  etl::ComponentLogger<ComponentClass>::fatal(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ComponentLogger<ComponentClass>, FATAL, message,      \
+                    ##__VA_ARGS__)
 
 #define COMPONENT_LOG_DEBUG_JOB(ComponentClass, message, jobId, ...)           \
-  etl::ComponentLogger<ComponentClass>::debugJob(message, jobId, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG_JOB(etl::ComponentLogger<ComponentClass>, DEBUG,           \
+                        debugJob, message, jobId, ##__VA_ARGS__)
 
 #define COMPONENT_LOG_INFO_JOB(ComponentClass, message, jobId, ...)            \
-  etl::ComponentLogger<ComponentClass>::infoJob(message, jobId, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG_JOB(etl::ComponentLogger<ComponentClass>, INFO,            \
+                        infoJob, message, jobId, ##__VA_ARGS__)
 
 #define COMPONENT_LOG_WARN_JOB(ComponentClass, message, jobId, ...)            \
-  etl::ComponentLogger<ComponentClass>::warnJob(message, jobId, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG_JOB(etl::ComponentLogger<ComponentClass>, WARN,            \
+                        warnJob, message, jobId, ##__VA_ARGS__)
 
 #define COMPONENT_LOG_ERROR_JOB(ComponentClass, message, jobId, ...)           \
-  etl::ComponentLogger<ComponentClass>::errorJob(message, jobId, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG_JOB(etl::ComponentLogger<ComponentClass>, ERROR,           \
+                        errorJob, message, jobId, ##__VA_ARGS__)
 
 #define COMPONENT_LOG_FATAL_JOB(ComponentClass, message, jobId, ...)           \
-  etl::ComponentLogger<ComponentClass>::fatalJob(message, jobId, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG_JOB(etl::ComponentLogger<ComponentClass>, FATAL,           \
+                        fatalJob, message, jobId, ##__VA_ARGS__)
 
 // Convenient component-specific macros that replace old hardcoded string macros
 #define CONFIG_LOG_DEBUG(message, ...)                                         \
-  etl::ConfigLogger::debug(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ConfigLogger, DEBUG, message, ##__VA_ARGS__)
 #define CONFIG_LOG_INFO(message, ...)                                          \
-  etl::ConfigLogger::info(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ConfigLogger, INFO, message, ##__VA_ARGS__)
 #define CONFIG_LOG_WARN(message, ...)                                          \
-  etl::ConfigLogger::warn(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ConfigLogger, WARN, message, ##__VA_ARGS__)
 #define CONFIG_LOG_ERROR(message, ...)                                         \
-  etl::ConfigLogger::error(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ConfigLogger, ERROR, message, ##__VA_ARGS__)
 #define CONFIG_LOG_FATAL(message, ...)                                         \
-  etl::ConfigLogger::fatal(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ConfigLogger, FATAL, message, ##__VA_ARGS__)
 
 #define DB_LOG_DEBUG(message, ...)                                             \
-  etl::DatabaseLogger::debug(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::DatabaseLogger, DEBUG, message, ##__VA_ARGS__)
 #define DB_LOG_INFO(message, ...)                                              \
-  etl::DatabaseLogger::info(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::DatabaseLogger, INFO, message, ##__VA_ARGS__)
 #define DB_LOG_WARN(message, ...)                                              \
-  etl::DatabaseLogger::warn(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::DatabaseLogger, WARN, message, ##__VA_ARGS__)
 #define DB_LOG_ERROR(message, ...)                                             \
-  etl::DatabaseLogger::error(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::DatabaseLogger, ERROR, message, ##__VA_ARGS__)
 #define DB_LOG_FATAL(message, ...)                                             \
-  etl::DatabaseLogger::fatal(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::DatabaseLogger, FATAL, message, ##__VA_ARGS__)
 
 #define ETL_LOG_DEBUG(message, ...)                                            \
-  etl::ETLJobLogger::debug(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ETLJobLogger, DEBUG, message, ##__VA_ARGS__)
 #define ETL_LOG_INFO(message, ...)                                             \
-  etl::ETLJobLogger::info(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ETLJobLogger, INFO, message, ##__VA_ARGS__)
 #define ETL_LOG_WARN(message, ...)                                             \
-  etl::ETLJobLogger::warn(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ETLJobLogger, WARN, message, ##__VA_ARGS__)
 #define ETL_LOG_ERROR(message, ...)                                            \
-  etl::ETLJobLogger::error(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ETLJobLogger, ERROR, message, ##__VA_ARGS__)
 #define ETL_LOG_FATAL(message, ...)                                            \
-  etl::ETLJobLogger::fatal(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::ETLJobLogger, FATAL, message, ##__VA_ARGS__)
 
 #define ETL_LOG_DEBUG_JOB(message, jobId, ...)                                 \
-  etl::ETLJobLogger::debugJob(message, jobId, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG_JOB(etl::ETLJobLogger, DEBUG, debugJob, message, jobId,    \
+                        ##__VA_ARGS__)
 #define ETL_LOG_INFO_JOB(message, jobId, ...)                                  \
-  etl::ETLJobLogger::infoJob(message, jobId, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG_JOB(etl::ETLJobLogger, INFO, infoJob, message, jobId,      \
+                        ##__VA_ARGS__)
 #define ETL_LOG_WARN_JOB(message, jobId, ...)                                  \
-  etl::ETLJobLogger::warnJob(message, jobId, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG_JOB(etl::ETLJobLogger, WARN, warnJob, message, jobId,      \
+                        ##__VA_ARGS__)
 #define ETL_LOG_ERROR_JOB(message, jobId, ...)                                 \
-  etl::ETLJobLogger::errorJob(message, jobId, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG_JOB(etl::ETLJobLogger, ERROR, errorJob, message, jobId,    \
+                        ##__VA_ARGS__)
 #define ETL_LOG_FATAL_JOB(message, jobId, ...)                                 \
-  etl::ETLJobLogger::fatalJob(message, jobId, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG_JOB(etl::ETLJobLogger, FATAL, fatalJob, message, jobId,    \
+                        ##__VA_ARGS__)
 
 #define WS_LOG_DEBUG(message, ...)                                             \
-  etl::WebSocketLogger::debug(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::WebSocketLogger, DEBUG, message, ##__VA_ARGS__)
 #define WS_LOG_INFO(message, ...)                                              \
-  etl::WebSocketLogger::info(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::WebSocketLogger, INFO, message, ##__VA_ARGS__)
 #define WS_LOG_WARN(message, ...)                                              \
-  etl::WebSocketLogger::warn(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::WebSocketLogger, WARN, message, ##__VA_ARGS__)
 #define WS_LOG_ERROR(message, ...)                                             \
-  etl::WebSocketLogger::error(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::WebSocketLogger, ERROR, message, ##__VA_ARGS__)
 #define WS_LOG_FATAL(message, ...)                                             \
-  etl::WebSocketLogger::fatal(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::WebSocketLogger, FATAL, message, ##__VA_ARGS__)
 
 #define AUTH_LOG_DEBUG(message, ...)                                           \
-  etl::AuthLogger::debug(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::AuthLogger, DEBUG, message, ##__VA_ARGS__)
 #define AUTH_LOG_INFO(message, ...)                                            \
-  etl::AuthLogger::info(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::AuthLogger, INFO, message, ##__VA_ARGS__)
 #define AUTH_LOG_WARN(message, ...)                                            \
-  etl::AuthLogger::warn(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::AuthLogger, WARN, message, ##__VA_ARGS__)
 #define AUTH_LOG_ERROR(message, ...)                                           \
-  etl::AuthLogger::error(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::AuthLogger, ERROR, message, ##__VA_ARGS__)
 #define AUTH_LOG_FATAL(message, ...)                                           \
-  etl::AuthLogger::fatal(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::AuthLogger, FATAL, message, ##__VA_ARGS__)
 
 #define HTTP_LOG_DEBUG(message, ...)                                           \
-  etl::HttpLogger::debug(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::HttpLogger, DEBUG, message, ##__VA_ARGS__)
 #define HTTP_LOG_INFO(message, ...)                                            \
-  etl::HttpLogger::info(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::HttpLogger, INFO, message, ##__VA_ARGS__)
 #define HTTP_LOG_WARN(message, ...)                                            \
-  etl::HttpLogger::warn(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::HttpLogger, WARN, message, ##__VA_ARGS__)
 #define HTTP_LOG_ERROR(message, ...)                                           \
-  etl::HttpLogger::error(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::HttpLogger, ERROR, message, ##__VA_ARGS__)
 #define HTTP_LOG_FATAL(message, ...)                                           \
-  etl::HttpLogger::fatal(message, ##__VA_ARGS__)
+  ETL_COMPONENT_LOG(etl::HttpLogger, FATAL, message, ##__VA_ARGS__)
+
+#define REQ_LOG_DEBUG(message, ...)                                            \
+  ETL_COMPONENT_LOG(etl::ComponentLogger<etl::RequestHandler>, DEBUG, message, \
+                    ##__VA_ARGS__)
+#define REQ_LOG_INFO(message, ...)                                             \
+  ETL_COMPONENT_LOG(etl::ComponentLogger<etl::RequestHandler>, INFO, message,  \
+                    ##__VA_ARGS__)
+#define REQ_LOG_WARN(message, ...)                                             \
+  ETL_COMPONENT_LOG(etl::ComponentLogger<etl::RequestHandler>, WARN, message,  \
+                    ##__VA_ARGS__)
+#define REQ_LOG_ERROR(message, ...)                                            \
+  ETL_COMPONENT_LOG(etl::ComponentLogger<etl::RequestHandler>, ERROR, message, \
+                    ##__VA_ARGS__)
+
+#define TRANSFORM_LOG_DEBUG(message, ...)                                      \
+  ETL_COMPONENT_LOG(etl::DataTransformerLogger, DEBUG, message, ##__VA_ARGS__)
+#define TRANSFORM_LOG_INFO(message, ...)                                       \
+  ETL_COMPONENT_LOG(etl::DataTransformerLogger, INFO, message, ##__VA_ARGS__)
+#define TRANSFORM_LOG_WARN(message, ...)                                       \
+  ETL_COMPONENT_LOG(etl::DataTransformerLogger, WARN, message, ##__VA_ARGS__)
+#define TRANSFORM_LOG_ERROR(message, ...)                                      \
+  ETL_COMPONENT_LOG(etl::DataTransformerLogger, ERROR, message, ##__VA_ARGS__)
+
+#define JOB_LOG_DEBUG(message, ...)                                            \
+  ETL_COMPONENT_LOG(etl::JobMonitorLogger, DEBUG, message, ##__VA_ARGS__)
+#define JOB_LOG_INFO(message, ...)                                             \
+  ETL_COMPONENT_LOG(etl::JobMonitorLogger, INFO, message, ##__VA_ARGS__)
+#define JOB_LOG_WARN(message, ...)                                             \
+  ETL_COMPONENT_LOG(etl::JobMonitorLogger, WARN, message, ##__VA_ARGS__)
+#define JOB_LOG_ERROR(message, ...)                                            \
+  ETL_COMPONENT_LOG(etl::JobMonitorLogger, ERROR, message, ##__VA_ARGS__)
@@ -9,6 +9,7 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -113,6 +114,11 @@ public:
   void cleanupStaleConnections();
   void forceCleanup(size_t maxToRemove = 0);
 
+  // Called, outside the pool lock, with the id of every connection the pool
+  // drops by itself (stale, inactive and forced cleanup, stop()), so owners of
+  // per-connection state can release it; removeConnection() does not call it
+  void setRemovalListener(std::function<void(const std::string &)> listener);
+
 private:
   // Configuration and state
   ConnectionPoolConfig config_;
@@ -120,6 +126,8 @@ private:
   std::unordered_map<std::string, std::shared_ptr<WebSocketConnection>>
       connections_;
   std::atomic<bool> running_{false};
+  std::mutex listenerMutex_;
+  std::function<void(const std::string &)> removalListener_;
 
   // Health monitoring
   std::unique_ptr<boost::asio::steady_timer> healthCheckTimer_;
@@ -132,5 +140,6 @@ private:
   bool isConnectionStale(
       const std::shared_ptr<WebSocketConnection> &connection) const;
   void removeConnectionInternal(const std::string &connectionId);
+  void notifyRemoved(const std::vector<std::string> &connectionIds);
   void updateStats(ConnectionPoolStats &stats) const;
 };
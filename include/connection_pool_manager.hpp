@@ -20,6 +20,7 @@ class RequestHandler;
 class WebSocketManager;
 class TimeoutManager;
 class PerformanceMonitor;
+class RequestExecutor;
 
 /**
  * ConnectionPoolManager manages a pool of reusable PooledSession connections
@@ -192,6 +193,12 @@ public:
    */
   void resetStatistics();
 
+  /**
+   * Run request handlers of sessions created from now on on the given
+   * executor instead of the I/O thread; null restores inline handling
+   */
+  void setRequestExecutor(std::shared_ptr<RequestExecutor> executor);
+
 private:
   // Configuration
   net::io_context &ioc_;
@@ -204,6 +211,7 @@ private:
   std::shared_ptr<WebSocketManager> wsManager_;
   std::shared_ptr<TimeoutManager> timeoutManager_;
   std::shared_ptr<PerformanceMonitor> performanceMonitor_;
+  std::shared_ptr<RequestExecutor> requestExecutor_;
 
   // Connection pools
   std::queue<std::shared_ptr<PooledSession>> idleConnections_;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "record_batch.hpp"
 #include "transparent_string_hash.hpp"
 #include <memory>
 #include <string>
@@ -15,15 +16,62 @@ struct TransformationRule {
       parameters;
 };
 
+enum class TransformOp { NONE, UPPERCASE, LOWERCASE, TRIM, MULTIPLY, ADD };
+
+// One rule after compilation: the operator is resolved to an enum, numeric
+// parameters are parsed once, and fields are referenced by index into the
+// plan's field table.
+struct CompiledTransformation {
+  TransformOp op = TransformOp::NONE;
+  size_t sourceIndex = 0;
+  size_t targetIndex = 0;
+  double operand = 0.0;
+};
+
+/**
+ * Immutable, pre-resolved form of a DataTransformer rule set. Built once when
+ * rules change so that transform() never compares operator names or re-parses
+ * numeric parameters per value.
+ */
+class TransformationPlan {
+public:
+  static std::shared_ptr<const TransformationPlan>
+  compile(const std::vector<TransformationRule> &rules);
+
+  const std::vector<CompiledTransformation> &steps() const { return steps_; }
+  const std::vector<std::string> &fields() const { return fields_; }
+  const std::string &fieldName(size_t index) const { return fields_[index]; }
+  // Field indexes whose rule carries required=true
+  const std::vector<size_t> &requiredFields() const { return requiredFields_; }
+
+private:
+  std::vector<CompiledTransformation> steps_;
+  std::vector<std::string> fields_;
+  std::vector<size_t> requiredFields_;
+
+  size_t internField(const std::string &name);
+};
+
+// Settings for DataTransformer's partitioned parallel mode
+struct ParallelTransformConfig {
+  bool enabled = false;
+  size_t workerCount = 0; // 0 = hardware concurrency
+  size_t chunkSize = 0;   // records per chunk; 0 = sized to the L2 cache
+  size_t minParallelRecords = 4096; // smaller inputs run inline
+};
+
 struct DataRecord {
   std::unordered_map<std::string, std::string, TransparentStringHash,
                      std::equal_to<>>
       fields;
 };
 
+class WorkStealingPool;
+
 class DataTransformer {
 public:
   DataTransformer();
+  ~DataTransformer();
 
   // Rule management
   void addTransformationRule(const TransformationRule &rule);
@@ -35,21 +83,38 @@ public:
   transform(const std::vector<DataRecord> &inputData) const;
   DataRecord transformRecord(const DataRecord &record) const;
 
+  // Parallel mode: transform() splits its input into chunks and runs them on
+  // a work-stealing pool. Output order always matches input order.
+  void setParallelConfig(const ParallelTransformConfig &config);
+  const ParallelTransformConfig &getParallelConfig() const {
+    return parallelConfig_;
+  }
+  std::vector<DataRecord>
+  transformParallel(const std::vector<DataRecord> &inputData) const;
+
+  // Columnar transformation: applies every rule to whole columns at once.
+  // Produces the same values as transform() on the equivalent DataRecords.
+  RecordBatch transformBatch(const RecordBatch &batch) const;
+
   // Validation
   bool validateData(const std::vector<DataRecord> &data) const;
   std::vector<std::string> getValidationErrors(const DataRecord &record) const;
 
+  // Compiled form of the current rule set
+  std::shared_ptr<const TransformationPlan> getPlan() const { return plan_; }
+
 private:
   std::vector<TransformationRule> rules_;
+  std::shared_ptr<const TransformationPlan> plan_;
+  ParallelTransformConfig parallelConfig_;
+  std::shared_ptr<WorkStealingPool> pool_;
+
+  void recompilePlan();
+  size_t resolveChunkSize(const std::vector<DataRecord> &inputData) const;
 
-  std::string applyTransformation(const std::string &value,
-                                  const TransformationRule &rule) const;
-  std::string applyStringTransformation(
-      const std::string &value, const std::string &type,
-      const std::unordered_map<std::string, std::string, TransparentStringHash,
-                               std::equal_to<>> &params) const;
-  std::string applyNumericTransformation(
-      const std::string &value, const std::string &type,
-      const std::unordered_map<std::string, std::string, TransparentStringHash,
-                               std::equal_to<>> &params) const;
+  std::string applyStep(const std::string &value,
+                        const CompiledTransformation &step) const;
+  Column transformColumn(const Column &source,
+                         const CompiledTransformation &step,
+                         const std::string &sourceField) const;
 };
@@ -14,6 +14,7 @@
 #include <queue>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 struct DatabaseConnectionConfig {
@@ -29,6 +30,8 @@ struct DatabaseConnectionConfig {
   bool enableHealthChecks = true;
   int maxRetries = 3;
   std::chrono::milliseconds retryDelay = std::chrono::milliseconds(1000);
+  // Prepared statements cached per connection; 0 disables preparing
+  size_t maxPreparedStatements = 256;
 
   // Helper methods for password management
   void setPassword(const std::string &pwd) {
@@ -63,6 +66,15 @@ public:
   // Connection management
   std::shared_ptr<pqxx::connection> acquireConnection();
   void releaseConnection(std::shared_ptr<pqxx::connection> conn);
+
+  // Prepared statements. The caller must hold `conn` (acquired and not yet
+  // released). Returns the name `sql` is prepared under on that connection,
+  // preparing it on first use, or an empty string if it cannot be cached.
+  std::string prepareStatement(const std::shared_ptr<pqxx::connection> &conn,
+                               const std::string &sql);
+  // Forgets what was prepared on `conn`, e.g. after the server dropped it
+  void invalidatePreparedStatements(
+      const std::shared_ptr<pqxx::connection> &conn);
   void closeAll();
   bool gracefulShutdown(std::chrono::milliseconds timeout);
 
@@ -81,6 +93,8 @@ public:
     size_t connectionTimeouts = 0;
     size_t healthCheckFailures = 0;
     double averageWaitTimeMs = 0.0;
+    size_t preparedStatementHits = 0;
+    size_t preparedStatementMisses = 0; // statements prepared
     std::chrono::steady_clock::time_point lastHealthCheck;
   };
 
@@ -96,6 +110,12 @@ private:
     std::chrono::steady_clock::time_point lastUsedTime;
     bool isHealthy = true;
 
+    // SQL text -> statement name. New connections start empty, so statements
+    // are re-prepared after a reconnect. Only the holder of the connection
+    // touches it.
+    std::unordered_map<std::string, std::string> preparedStatements;
+    size_t nextStatementId = 0;
+
     PooledConnection(std::shared_ptr<pqxx::connection> conn)
         : connection(std::move(conn)),
           createdTime(std::chrono::steady_clock::now()),
@@ -123,10 +143,14 @@ private:
   PoolMetrics metrics_;
   static constexpr size_t MAX_WAIT_TIMES = 100;
   std::deque<double> waitTimes_;
+  std::atomic<size_t> preparedHits_{0};
+  std::atomic<size_t> preparedMisses_{0};
 
   // Private methods
   std::shared_ptr<pqxx::connection> createConnection();
   bool validateConnection(std::shared_ptr<pqxx::connection> conn);
+  std::shared_ptr<PooledConnection>
+  findActive(const std::shared_ptr<pqxx::connection> &conn) const;
   void performHealthCheck();
   void cleanupExpiredConnections();
   void adjustPoolSize();
@@ -1,11 +1,65 @@
 #pragma once
 
 #include "database_connection_pool.hpp"
+#include <chrono>
 #include <future>
 #include <memory>
 #include <string>
 #include <vector>
 
+class RecordBatch;
+
+struct BulkLoadOptions {
+  size_t batchSize = 5000; // rows per COPY statement and transaction
+  // Bisect failed batches to load the good rows and count only the bad ones
+  bool isolateFailedRows = true;
+  size_t maxErrorMessages = 10;
+};
+
+struct BulkLoadResult {
+  size_t rowsLoaded = 0;
+  size_t rowsFailed = 0;
+  size_t batchesCommitted = 0;
+  size_t batchesFailed = 0;
+  std::vector<std::string> errors; // first maxErrorMessages failures
+  std::chrono::milliseconds elapsed{0};
+
+  bool success() const { return rowsFailed == 0; }
+};
+
+/**
+ * Forward-only cursor over a query result. Rows are pulled from a PostgreSQL
+ * server-side cursor batchSize at a time and returned as typed RecordBatch
+ * columns (integer and float columns as INT64/DOUBLE, everything else as
+ * text), so memory stays bounded by one batch however large the result is.
+ *
+ * The cursor holds a pooled connection and an open transaction until it is
+ * exhausted, closed or destroyed; closing early is how callers stop
+ * reading. It must not outlive the DatabaseManager that opened it.
+ */
+class QueryCursor {
+public:
+  struct State;
+
+  explicit QueryCursor(std::unique_ptr<State> state);
+  ~QueryCursor();
+
+  QueryCursor(const QueryCursor &) = delete;
+  QueryCursor &operator=(const QueryCursor &) = delete;
+
+  // Replaces `batch` with the next rows; returns false once no rows are left.
+  // Throws etl::SystemException if the fetch fails.
+  bool fetch(RecordBatch &batch);
+  // Releases the connection; safe to call more than once
+  void close();
+
+  bool isOpen() const;
+  size_t rowsFetched() const;
+
+private:
+  std::unique_ptr<State> state_;
+};
+
 struct ConnectionConfig {
   std::string host;
   int port;
@@ -34,6 +88,22 @@ public:
   std::vector<std::vector<std::string>>
   selectQuery(const std::string &query, const std::vector<std::string> &params);
 
+  // Streams the batch into `table` with COPY ... FROM STDIN. `columns` names
+  // both the target columns and the batch fields that feed them (missing
+  // fields load as NULL); empty means every batch field. Identifiers must be
+  // lowercase SQL names.
+  BulkLoadResult bulkLoad(const std::string &table,
+                          const std::vector<std::string> &columns,
+                          const RecordBatch &batch,
+                          const BulkLoadOptions &options = {});
+
+  // Opens a streaming cursor over `query`. Throws etl::SystemException if
+  // the database is unavailable or the query is rejected.
+  std::unique_ptr<QueryCursor>
+  openCursor(const std::string &query,
+             const std::vector<std::string> &params = {},
+             size_t batchSize = 1000);
+
   // Transaction support
   bool beginTransaction();
   bool commitTransaction();
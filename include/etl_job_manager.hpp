@@ -1,20 +1,23 @@
 #pragma once
 
+#include "database_manager.hpp"
 #include "etl_job_models.hpp"
+#include "job_registry.hpp"
+#include "job_scheduler.hpp"
 #include "lock_utils.hpp"
 #include "system_metrics.hpp"
+#include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
 #include <vector>
 
 // Forward declarations
 class DataTransformer;
+class RecordBatch;
 class DatabaseManager;
 class ETLJobRepository;
 class NotificationService;
@@ -31,6 +34,10 @@ public:
 
   // Job management
   std::string scheduleJob(const ETLJobConfig &config);
+  // A running job can only be cancelled if it checks for cancellation:
+  // FULL_ETL and table EXTRACT jobs. Returns false for the others.
+  // A FULL_ETL job loads batch by batch, each committed on its own, so a
+  // cancelled or failed job leaves the batches it loaded in the target.
   bool cancelJob(const std::string &jobId);
   bool pauseJob(const std::string &jobId);
   bool resumeJob(const std::string &jobId);
@@ -39,12 +46,25 @@ public:
   std::shared_ptr<ETLJob> getJob(const std::string &jobId) const;
   std::vector<std::shared_ptr<ETLJob>> getAllJobs() const;
   std::vector<std::shared_ptr<ETLJob>> getJobsByStatus(JobStatus status) const;
+  // Keyset-paginated summaries from the repository, with the live state of
+  // jobs still held in memory
+  JobPage listJobs(const JobPageQuery &query) const;
 
   // Job execution
   void start();
   void stop();
   bool isRunning() const;
 
+  // Worker pool and scheduling policy; worker count applies on next start()
+  void configureScheduler(const JobSchedulerConfig &config);
+  JobSchedulerMetrics getSchedulerMetrics() const;
+
+  // Finished jobs kept in memory before being evicted to the repository
+  void setJobCacheCapacity(size_t maxFinishedJobs);
+
+  // COPY batching used by LOAD and FULL_ETL jobs; call before start()
+  void setLoadOptions(const BulkLoadOptions &options);
+
   // Job monitoring integration
   void
   setJobMonitorService(std::shared_ptr<JobMonitorServiceInterface> monitor);
@@ -65,13 +85,15 @@ private:
   std::shared_ptr<ETLJobRepository> jobRepo_;
   std::shared_ptr<JobMonitorServiceInterface> monitorService_;
 
-  std::queue<std::shared_ptr<ETLJob>> jobQueue_;
-  mutable std::vector<std::shared_ptr<ETLJob>> jobs_;
+  JobScheduler scheduler_;
+  // Mutable so const getters can cache jobs loaded from the repository
+  mutable JobRegistry jobRegistry_;
 
-  std::thread workerThread_;
-  mutable std::timed_mutex jobMutex_;
-  std::condition_variable_any jobCondition_;
-  bool running_;
+  std::vector<std::thread> workers_;
+  // Serialises updates of a job's metrics struct with readers of it
+  mutable std::timed_mutex metricsMutex_;
+  std::atomic<bool> running_{false};
+  BulkLoadOptions loadOptions_;
 
   // Metrics collection settings
   bool metricsCollectionEnabled_{true};
@@ -81,14 +103,24 @@ private:
   void executeJob(std::shared_ptr<ETLJob> job);
   void executeJobWithMonitoring(std::shared_ptr<ETLJob> job);
   void executeExtractJob(std::shared_ptr<ETLJob> job);
+  void extractTable(const std::shared_ptr<ETLJob> &job,
+                    const std::string &table);
   void executeTransformJob(std::shared_ptr<ETLJob> job);
   void executeLoadJob(std::shared_ptr<ETLJob> job);
   void executeFullETLJob(std::shared_ptr<ETLJob> job);
 
+  // Streaming FULL_ETL stages; each call handles one batch
+  RecordBatch extractBatch(const std::shared_ptr<ETLJob> &job, size_t offset,
+                           size_t count);
+  void loadBatch(const std::shared_ptr<ETLJob> &job, const RecordBatch &batch);
+
   // Helper methods for progress tracking
   void updateJobProgress(std::shared_ptr<ETLJob> job, int progress,
                          const std::string &step);
   void updateJobStatus(std::shared_ptr<ETLJob> job, JobStatus newStatus);
+  // Timestamps, database row and monitor event for a change already made
+  void recordStatusChange(const std::shared_ptr<ETLJob> &job,
+                          JobStatus oldStatus, JobStatus newStatus);
 
   // Metrics collection helpers
   void startJobMetricsCollection(std::shared_ptr<ETLJob> job);
@@ -96,5 +128,9 @@ private:
   void updateJobMetricsFromCollector(std::shared_ptr<ETLJob> job);
   void setupMetricsCallback(std::shared_ptr<ETLJob> job);
 
+  // Repository results with in-memory instances substituted where cached
+  std::vector<std::shared_ptr<ETLJob>>
+  mergeWithRegistry(const std::vector<ETLJob> &dbJobs) const;
+
   std::string generateJobId();
 };
@@ -4,7 +4,12 @@
 #include "system_metrics.hpp"
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
+
+// Scheduling class of a job; queued jobs age upwards over time
+enum class JobPriority { LOW, NORMAL, HIGH, CRITICAL };
 
 struct ETLJobConfig {
   std::string jobId;
@@ -15,18 +20,22 @@ struct ETLJobConfig {
   std::chrono::system_clock::time_point scheduledTime;
   bool isRecurring;
   std::chrono::minutes recurringInterval;
+  JobPriority priority = JobPriority::NORMAL;
 };
 
 struct ETLJob {
   std::string jobId;
   JobType type = JobType::FULL_ETL;
   JobStatus status = JobStatus::PENDING;
+  JobPriority priority = JobPriority::NORMAL;
   std::string sourceConfig;
   std::string targetConfig;
   std::chrono::system_clock::time_point createdAt =
       std::chrono::system_clock::now();
   std::chrono::system_clock::time_point startedAt{};
   std::chrono::system_clock::time_point completedAt{};
+  // When the job entered the scheduler queue (steady clock for wait times)
+  std::chrono::steady_clock::time_point queuedAt{};
   std::string errorMessage;
   int recordsProcessed = 0;
   int recordsSuccessful = 0;
@@ -39,3 +48,26 @@ struct ETLJob {
   // Default constructor
   ETLJob() = default;
 };
+
+// List-view projection of a job: no configs, error text or metrics
+struct JobSummary {
+  std::string jobId;
+  JobType type = JobType::EXTRACT;
+  JobStatus status = JobStatus::PENDING;
+  std::chrono::system_clock::time_point createdAt;
+  int recordsProcessed = 0;
+  int recordsSuccessful = 0;
+  int recordsFailed = 0;
+};
+
+// Keyset page request; jobs are ordered newest first by (created_at, job_id)
+struct JobPageQuery {
+  size_t limit = 100;
+  std::string cursor; // nextCursor of the previous page; empty for the first
+  std::optional<JobStatus> status;
+};
+
+struct JobPage {
+  std::vector<JobSummary> jobs;
+  std::string nextCursor; // empty on the last page
+};
@@ -2,6 +2,7 @@
 
 #include "etl_job_models.hpp"
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -25,6 +26,17 @@ public:
   std::vector<ETLJob> getJobsByType(JobType type);
   std::vector<ETLJob> getActiveJobs();
 
+  // Keyset-paginated list of job summaries; cost depends on the page size,
+  // not on how many jobs the table holds. An invalid cursor yields an empty
+  // page.
+  JobPage listJobs(const JobPageQuery &query);
+
+  // Opaque page cursor: hex of "<created_at in us since epoch>:<job_id>"
+  static std::string encodePageCursor(int64_t createdAtMicros,
+                                      const std::string &jobId);
+  static bool decodePageCursor(const std::string &cursor,
+                               int64_t &createdAtMicros, std::string &jobId);
+
 private:
   std::shared_ptr<DatabaseManager> dbManager_;
 
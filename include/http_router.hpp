@@ -0,0 +1,295 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Path parameters captured by RadixRouter::match(). Names point into the
+ * router and values into the matched path, so both must outlive the params.
+ * Fixed capacity, so capturing never allocates.
+ */
+class RouteParams {
+public:
+  static constexpr size_t kMaxParams = 4;
+
+  // Empty if the route has no such parameter. The catch-all is named "*".
+  std::string_view get(std::string_view name) const {
+    for (size_t i = 0; i < count_; ++i) {
+      if (params_[i].first == name) {
+        return params_[i].second;
+      }
+    }
+    return {};
+  }
+
+  size_t size() const { return count_; }
+  bool empty() const { return count_ == 0; }
+
+  void push(std::string_view name, std::string_view value) {
+    params_[count_++] = {name, value};
+  }
+  void pop() { --count_; }
+
+private:
+  std::array<std::pair<std::string_view, std::string_view>, kMaxParams>
+      params_{};
+  size_t count_ = 0;
+};
+
+/**
+ * Read-only view of a URL query string ("a=1&b=2"). Lookups scan the string
+ * in place instead of building a map; values are returned raw, without
+ * percent-decoding. Pairs without '=' are ignored and the last occurrence of
+ * a key wins, as in InputValidator::parseQueryString().
+ */
+class QueryView {
+public:
+  QueryView() = default;
+  explicit QueryView(std::string_view query) : query_(query) {}
+
+  std::string_view raw() const { return query_; }
+  bool empty() const { return query_.empty(); }
+
+  std::optional<std::string_view> get(std::string_view key) const {
+    std::optional<std::string_view> found;
+    forEach([&](std::string_view k, std::string_view v) {
+      if (k == key) {
+        found = v;
+      }
+    });
+    return found;
+  }
+
+  bool contains(std::string_view key) const { return get(key).has_value(); }
+
+  // Calls fn(key, value) for every pair, in order
+  template <class Fn> void forEach(Fn &&fn) const {
+    std::string_view rest = query_;
+    while (!rest.empty()) {
+      size_t amp = rest.find('&');
+      std::string_view pair = rest.substr(0, amp);
+      rest = amp == std::string_view::npos ? std::string_view{}
+                                           : rest.substr(amp + 1);
+      if (size_t eq = pair.find('='); eq != std::string_view::npos) {
+        fn(pair.substr(0, eq), pair.substr(eq + 1));
+      }
+    }
+  }
+
+  // For validators that still take a map
+  std::unordered_map<std::string, std::string> toMap() const {
+    std::unordered_map<std::string, std::string> params;
+    forEach([&params](std::string_view k, std::string_view v) {
+      params[std::string(k)] = std::string(v);
+    });
+    return params;
+  }
+
+private:
+  std::string_view query_;
+};
+
+// Splits a request target into path and query (without the '?')
+inline std::pair<std::string_view, std::string_view>
+splitRequestTarget(std::string_view target) {
+  size_t pos = target.find('?');
+  if (pos == std::string_view::npos) {
+    return {target, {}};
+  }
+  return {target.substr(0, pos), target.substr(pos + 1)};
+}
+
+/**
+ * Radix tree mapping URL path patterns to values, built once and then only
+ * read. Patterns are literal text plus ":name" segments, which match one
+ * non-empty path segment, and an optional trailing "*", which matches the
+ * rest of the path. Shared literal prefixes are stored once, so a lookup
+ * walks each path character at most once plus any backtracking between
+ * overlapping routes.
+ *
+ * Literal routes win over ":name" routes, which win over "*". match() does
+ * not allocate; captured parameters are views into the path. add() is not
+ * thread-safe, match() is safe to call concurrently once routes are added.
+ */
+template <class Value> class RadixRouter {
+public:
+  struct Match {
+    Value value;
+    RouteParams params;
+  };
+
+  // Throws std::invalid_argument on a malformed pattern or one that
+  // duplicates or conflicts with an existing route
+  void add(std::string_view pattern, Value value) {
+    if (pattern.empty() || pattern[0] != '/') {
+      throw std::invalid_argument("Route pattern must start with '/': " +
+                                  std::string(pattern));
+    }
+
+    Node *node = &root_;
+    std::string_view rest = pattern;
+    size_t paramCount = 0;
+    while (!rest.empty()) {
+      if (rest[0] == '*') {
+        if (rest.size() != 1 || ++paramCount > RouteParams::kMaxParams) {
+          throw std::invalid_argument("Invalid catch-all in route: " +
+                                      std::string(pattern));
+        }
+        if (node->catchAll) {
+          throw std::invalid_argument("Duplicate route: " +
+                                      std::string(pattern));
+        }
+        node->catchAll = std::move(value);
+        ++routeCount_;
+        return;
+      }
+
+      if (rest[0] == ':') {
+        size_t end = rest.find('/');
+        std::string_view name = rest.substr(1, end - 1);
+        if (name.empty() || ++paramCount > RouteParams::kMaxParams) {
+          throw std::invalid_argument("Invalid parameter in route: " +
+                                      std::string(pattern));
+        }
+        if (!node->param) {
+          node->param = std::make_unique<Node>();
+          node->paramName = std::string(name);
+        } else if (node->paramName != name) {
+          throw std::invalid_argument("Conflicting parameter name in route: " +
+                                      std::string(pattern));
+        }
+        node = node->param.get();
+        rest = end == std::string_view::npos ? std::string_view{}
+                                             : rest.substr(end);
+        continue;
+      }
+
+      // Literal text up to the next parameter, which must start a segment
+      size_t end = rest.find_first_of(":*");
+      if (end != std::string_view::npos && rest[end - 1] != '/') {
+        throw std::invalid_argument(
+            "Parameters must span a whole path segment: " +
+            std::string(pattern));
+      }
+      node = insertLiteral(*node, rest.substr(0, end));
+      rest = end == std::string_view::npos ? std::string_view{}
+                                           : rest.substr(end);
+    }
+
+    if (node->value) {
+      throw std::invalid_argument("Duplicate route: " + std::string(pattern));
+    }
+    node->value = std::move(value);
+    ++routeCount_;
+  }
+
+  // `path` must not include the query string
+  std::optional<Match> match(std::string_view path) const {
+    Match result{Value{}, RouteParams{}};
+    const Value *value = nullptr;
+    if (!lookup(root_, path, result.params, value)) {
+      return std::nullopt;
+    }
+    result.value = *value;
+    return result;
+  }
+
+  size_t size() const { return routeCount_; }
+
+private:
+  struct Node {
+    std::string prefix;
+    std::string firstChars; // firstChars[i] == children[i]->prefix[0]
+    std::vector<std::unique_ptr<Node>> children;
+    std::unique_ptr<Node> param;
+    std::string paramName;
+    std::optional<Value> value;
+    std::optional<Value> catchAll;
+  };
+
+  Node root_;
+  size_t routeCount_ = 0;
+
+  // Descends along `literal`, splitting edges as needed, and returns the node
+  // where it ends
+  static Node *insertLiteral(Node &start, std::string_view literal) {
+    Node *node = &start;
+    while (!literal.empty()) {
+      size_t i = node->firstChars.find(literal[0]);
+      if (i == std::string::npos) {
+        auto child = std::make_unique<Node>();
+        child->prefix = std::string(literal);
+        node->firstChars.push_back(literal[0]);
+        node->children.push_back(std::move(child));
+        return node->children.back().get();
+      }
+
+      auto &slot = node->children[i];
+      size_t common = 0;
+      while (common < slot->prefix.size() && common < literal.size() &&
+             slot->prefix[common] == literal[common]) {
+        ++common;
+      }
+      if (common < slot->prefix.size()) {
+        auto split = std::make_unique<Node>();
+        split->prefix = slot->prefix.substr(0, common);
+        slot->prefix.erase(0, common);
+        split->firstChars.push_back(slot->prefix[0]);
+        split->children.push_back(std::move(slot));
+        slot = std::move(split);
+      }
+      node = slot.get();
+      literal.remove_prefix(common);
+    }
+    return node;
+  }
+
+  // `node`'s own prefix has already been consumed from the path
+  static bool lookup(const Node &node, std::string_view path,
+                     RouteParams &params, const Value *&value) {
+    if (path.empty() && node.value) {
+      value = &*node.value;
+      return true;
+    }
+
+    if (!path.empty()) {
+      if (size_t i = node.firstChars.find(path[0]); i != std::string::npos) {
+        const Node &child = *node.children[i];
+        if (path.compare(0, child.prefix.size(), child.prefix) == 0 &&
+            lookup(child, path.substr(child.prefix.size()), params, value)) {
+          return true;
+        }
+      }
+
+      if (node.param) {
+        size_t end = path.find('/');
+        std::string_view segment = path.substr(0, end);
+        if (!segment.empty()) {
+          params.push(node.paramName, segment);
+          std::string_view rest = end == std::string_view::npos
+                                      ? std::string_view{}
+                                      : path.substr(end);
+          if (lookup(*node.param, rest, params, value)) {
+            return true;
+          }
+          params.pop();
+        }
+      }
+    }
+
+    if (node.catchAll) {
+      params.push("*", path);
+      value = &*node.catchAll;
+      return true;
+    }
+    return false;
+  }
+};
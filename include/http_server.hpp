@@ -22,6 +22,7 @@ class ETLJobManager;
 class JobMonitorService;
 class ConnectionPoolManager;
 class TimeoutManager;
+class PerformanceMonitor;
 struct ServerConfig;
 
 class HttpServer {
@@ -45,6 +46,8 @@ public:
   // Connection pool management
   std::shared_ptr<ConnectionPoolManager> getConnectionPoolManager();
   std::shared_ptr<TimeoutManager> getTimeoutManager();
+  // Null when ServerConfig::enableMetrics is off
+  std::shared_ptr<PerformanceMonitor> getPerformanceMonitor();
 
   // Add getters for testing purposes
   std::shared_ptr<ETLJobManager> getJobManager();
@@ -3,6 +3,7 @@
 #include <optional>
 #include <regex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -80,16 +81,15 @@ public:
       const std::unordered_map<std::string, std::string> &params);
 
   // URL and path validation
-  static ValidationResult validateEndpointPath(const std::string &path);
-  static ValidationResult
-  validateQueryParameters(const std::string &queryString);
+  static ValidationResult validateEndpointPath(std::string_view path);
+  static ValidationResult validateQueryParameters(std::string_view queryString);
 
   // HTTP method validation
   static bool isValidHttpMethod(const std::string &method,
                                 const std::vector<std::string> &allowedMethods);
 
   // Content type validation
-  static bool isValidContentType(const std::string &contentType);
+  static bool isValidContentType(std::string_view contentType);
 
   // Authorization header validation
   static ValidationResult
@@ -100,6 +100,10 @@ public:
                                  size_t maxSize = 1024 * 1024); // 1MB default
   static ValidationResult validateRequestHeaders(
       const std::unordered_map<std::string, std::string> &headers);
+  // Checks one header in place; adds any errors to `result`
+  static void validateRequestHeader(std::string_view name,
+                                    std::string_view value,
+                                    ValidationResult &result);
 
   // Utility methods
   static std::string extractJsonField(const std::string &json,
@@ -122,6 +126,6 @@ private:
                                                   const std::string &field);
   static std::string extractJsonValue(const std::string &json, size_t start,
                                       size_t end);
-  static bool containsSqlInjection(const std::string &input);
-  static bool containsXss(const std::string &input);
+  static bool containsSqlInjection(std::string_view input);
+  static bool containsXss(std::string_view input);
 };
@@ -54,6 +54,10 @@ struct JobMetrics {
   int consecutiveErrors = 0;                     // consecutive error count
   std::chrono::milliseconds timeToFirstError{0}; // time until first error
 
+  // Scheduler statistics
+  std::chrono::milliseconds queueWaitTime{0}; // time spent queued before start
+  size_t queueDepth = 0; // jobs waiting in the scheduler when sampled
+
   // Performance indicators
   double throughputMBps = 0.0;   // throughput in MB/s
   double memoryEfficiency = 0.0; // records per MB of memory used
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "etl_job_models.hpp"
+#include "transparent_string_hash.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * In-memory index of ETL jobs owned by ETLJobManager. Lookup by id is O(1)
+ * and listings by status or type come from secondary indexes, so readers
+ * never scan the whole job set. Reads take a shared lock; only inserts,
+ * status transitions and evictions take the exclusive lock.
+ *
+ * Finished jobs (COMPLETED, FAILED, CANCELLED) are kept in an LRU list capped
+ * at maxFinishedJobs; the least recently used ones are handed to the eviction
+ * handler (which persists them) and dropped. PENDING and RUNNING jobs are
+ * never evicted. All status changes must go through setStatus() or
+ * transitionStatus() so the indexes stay consistent.
+ */
+class JobRegistry {
+public:
+  using JobPtr = std::shared_ptr<ETLJob>;
+  using EvictionHandler = std::function<void(const JobPtr &)>;
+
+  explicit JobRegistry(size_t maxFinishedJobs = 10000);
+
+  // Returns false if a job with the same id is already registered
+  bool insert(const JobPtr &job);
+  JobPtr find(std::string_view jobId) const;
+  // Like find() but does not refresh the job's LRU position
+  JobPtr peek(std::string_view jobId) const;
+
+  // Results are ordered by registration
+  std::vector<JobPtr> all() const;
+  std::vector<JobPtr> byStatus(JobStatus status) const;
+  std::vector<JobPtr> byType(JobType type) const;
+
+  // Returns the previous status
+  JobStatus setStatus(const JobPtr &job, JobStatus status);
+  // Changes status only if it currently equals expected
+  bool transitionStatus(const JobPtr &job, JobStatus expected,
+                        JobStatus desired);
+
+  size_t size() const;
+  bool empty() const { return size() == 0; }
+  // Jobs dropped so far; non-zero means listings may be incomplete
+  uint64_t evictedCount() const;
+
+  void setMaxFinishedJobs(size_t maxFinishedJobs);
+  void setEvictionHandler(EvictionHandler handler);
+
+private:
+  static constexpr size_t kStatusCount = 5;
+  static constexpr size_t kTypeCount = 4;
+
+  struct Entry {
+    JobPtr job;
+    uint64_t sequence;
+    JobStatus indexedStatus;
+    bool finished = false;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::string, Entry, TransparentStringHash,
+                     std::equal_to<>>
+      byId_;
+  std::map<uint64_t, JobPtr> ordered_;
+  std::array<std::map<uint64_t, JobPtr>, kStatusCount> byStatus_;
+  std::array<std::map<uint64_t, JobPtr>, kTypeCount> byType_;
+  uint64_t nextSequence_ = 0;
+  uint64_t evictedCount_ = 0;
+
+  // Finished job ids, most recently used at the front. Reordered by readers
+  // under the shared lock, so it has its own mutex.
+  mutable std::mutex lruMutex_;
+  mutable std::list<std::string> lru_;
+  size_t maxFinishedJobs_;
+  EvictionHandler evictionHandler_;
+
+  static bool isFinished(JobStatus status);
+  static std::vector<JobPtr> values(const std::map<uint64_t, JobPtr> &index);
+
+  // Callers hold the exclusive lock
+  void reindexStatus(Entry &entry, JobStatus status);
+  std::vector<JobPtr> collectEvictions();
+  // Called after the locks are released so the handler may do I/O
+  static void notifyEvicted(const EvictionHandler &handler,
+                            const std::vector<JobPtr> &evicted);
+};
@@ -3,7 +3,6 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
-#include <curl/curl.h>
 #include <filesystem>
 #include <fstream>
 #include <functional>
@@ -17,6 +16,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "async_http_client.hpp"
 #include "logger.hpp"
 #include "nlohmann/json.hpp"
 
@@ -40,6 +40,7 @@ struct LogDestinationConfig {
   std::string endpoint;
   std::string auth_token;
   std::unordered_map<std::string, std::string> headers;
+  bool compress_payload = false; // gzip HTTP bodies (Content-Encoding)
 
   // Elasticsearch specific
   std::string index_pattern = "logs-%Y.%m.%d";
@@ -139,49 +140,14 @@ private:
   }
 };
 
-// RAII wrapper for CURL handles
-class CurlHandle {
-public:
-  CurlHandle() : handle_(curl_easy_init()) {
-    if (!handle_) {
-      throw std::runtime_error("Failed to initialize CURL handle");
-    }
-  }
-
-  CurlHandle(const CurlHandle &) = delete;
-  CurlHandle &operator=(const CurlHandle &) = delete;
-
-  CurlHandle(CurlHandle &&other) noexcept : handle_(other.handle_) {
-    other.handle_ = nullptr;
-  }
-
-  CurlHandle &operator=(CurlHandle &&other) noexcept {
-    if (this != &other) {
-      if (handle_) {
-        curl_easy_cleanup(handle_);
-      }
-      handle_ = other.handle_;
-      other.handle_ = nullptr;
-    }
-    return *this;
-  }
-
-  ~CurlHandle() {
-    if (handle_) {
-      curl_easy_cleanup(handle_);
-    }
-  }
-
-  CURL *get() const { return handle_; }
-
-private:
-  CURL *handle_;
-};
-
-// Main log aggregator class
+// Main log aggregator class. HTTP destinations (Elasticsearch, HTTP
+// endpoints, CloudWatch, Splunk) are shipped through an AsyncHttpClient, so
+// a slow destination does not hold up the processing thread or the others.
 class LogAggregator {
 public:
   explicit LogAggregator(const std::vector<LogDestinationConfig> &destinations);
+  LogAggregator(const std::vector<LogDestinationConfig> &destinations,
+                std::shared_ptr<AsyncHttpClient> http_client);
   ~LogAggregator();
 
   // Initialize the aggregator
@@ -205,6 +171,8 @@ public:
     std::atomic<uint64_t> entries_shipped{0};
     std::atomic<uint64_t> entries_failed{0};
     std::atomic<uint64_t> batches_sent{0};
+    std::atomic<uint64_t> bytes_shipped{0};      // HTTP bodies as sent
+    std::atomic<uint64_t> bytes_uncompressed{0}; // the same before gzip
     std::chrono::steady_clock::time_point start_time;
   };
 
@@ -254,12 +222,14 @@ private:
   bool shipToSplunk(const LogDestinationConfig &dest,
                     const std::vector<StructuredLogEntry> &batch);
 
-  // HTTP request helper
-  bool
-  makeHttpRequest(const std::string &url, const std::string &method,
-                  const std::string &data,
-                  const std::unordered_map<std::string, std::string> &headers,
-                  std::string &response);
+  // Whether the destination is shipped by shipOverHttp(), whose outcome is
+  // counted in stats_ when the response arrives
+  static bool shipsOverHttp(LogDestinationType type);
+
+  // POSTs data for entries log entries without waiting for the response
+  void shipOverHttp(const std::string &url, std::string data,
+                    std::unordered_map<std::string, std::string> headers,
+                    bool gzip, size_t entries);
 
   // File rotation helper
   void rotateLogFile(const std::string &file_path);
@@ -282,11 +252,11 @@ private:
 
   AggregatorStats stats_;
 
-  // CURL handle for HTTP requests
-  // CURL handle for HTTP requests (protected by curl_mutex_)
-  // CURL handle for HTTP requests (protected by curl_mutex_)
-  CurlHandle curl_handle_;
-  mutable std::mutex curl_mutex_;
+  // HTTP shipments; shutdown() waits until none is in flight
+  std::shared_ptr<AsyncHttpClient> http_client_;
+  size_t http_in_flight_ = 0;
+  std::mutex http_mutex_;
+  std::condition_variable http_idle_;
 
   // File streams for file destinations
   std::unordered_map<std::string, std::ofstream> file_streams_;
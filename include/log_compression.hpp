@@ -0,0 +1,152 @@
+#pragma once
+
+#include "log_file_manager.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Whether this build can read and write the given format (gzip always;
+// zstd and lz4 when their libraries were found)
+bool isCompressionSupported(CompressionType type);
+
+// One complete stream of the given format holding data, appended to out
+bool compressLogBuffer(CompressionType type, int level, std::string_view data,
+                       std::string &out);
+
+// Decodes every frame (or gzip member) in data, appending to out
+bool decompressLogBuffer(CompressionType type, std::string_view data,
+                         std::string &out);
+
+/**
+ * @brief One independently decompressible frame of a seekable log file,
+ * with a summary of the lines inside it.
+ */
+struct SeekableLogFrame {
+  uint64_t rawOffset = 0;        // in the uncompressed log
+  uint64_t compressedOffset = 0; // in the compressed file
+  uint32_t rawBytes = 0;
+  uint32_t compressedBytes = 0;
+  uint32_t lines = 0;    // newlines in the frame
+  int64_t minTimeMs = 0; // of the lines parseLogLine() understands;
+  int64_t maxTimeMs = 0; // min > max when there are none
+  uint8_t levels = 0;    // bit (1 << level) for every level seen
+};
+
+/**
+ * @brief Streams a log into a seekable compressed file.
+ *
+ * The output is a series of frames of about frameBytes of the log each,
+ * cut at line ends, followed by a seek table. Every frame is a complete
+ * gzip member / zstd frame / lz4 frame, and the seek table sits where the
+ * format's own tools ignore it (an empty gzip member with an extra field, or
+ * a skippable zstd/lz4 frame), so `gzip -d`, `zstd -d` and `lz4 -d` read
+ * the file as usual. Seek tables that would not fit a gzip extra field
+ * (over about 1400 frames) are left out.
+ */
+class SeekableLogWriter {
+public:
+  static constexpr size_t kDefaultFrameBytes = 1024 * 1024;
+
+  SeekableLogWriter(std::ostream &out, CompressionType type, int level,
+                    size_t frameBytes = kDefaultFrameBytes);
+
+  bool write(std::string_view data);
+  // Writes the last frame and the seek table; the stream is then complete
+  bool finish();
+
+  uint64_t rawBytes() const { return rawBytes_; }
+  uint64_t compressedBytes() const { return compressedBytes_; }
+  const std::vector<SeekableLogFrame> &frames() const { return frames_; }
+
+private:
+  bool writeFrame(size_t bytes);
+  bool writeSeekTable();
+
+  std::ostream &out_;
+  CompressionType type_;
+  int level_;
+  size_t frameBytes_;
+  std::string pending_;
+  std::string compressed_;
+  std::vector<SeekableLogFrame> frames_;
+  uint64_t rawBytes_ = 0;
+  uint64_t compressedBytes_ = 0;
+  bool ok_ = true;
+};
+
+/**
+ * @brief Reads a compressed log, by frame when it has a seek table.
+ *
+ * The format is taken from the file's magic bytes. Files written by other
+ * tools have no seek table and can only be read whole. Frames are read
+ * with pread(), so readFrame() may be called from several threads.
+ */
+class SeekableLogReader {
+public:
+  explicit SeekableLogReader(const std::string &path);
+  ~SeekableLogReader();
+
+  SeekableLogReader(const SeekableLogReader &) = delete;
+  SeekableLogReader &operator=(const SeekableLogReader &) = delete;
+
+  // NONE for a missing or uncompressed file
+  CompressionType type() const { return type_; }
+  const std::vector<SeekableLogFrame> &frames() const { return frames_; }
+
+  // Replaces out with the uncompressed bytes of frames()[index]
+  bool readFrame(size_t index, std::string &out) const;
+
+  // Decompresses the whole file in pieces; stops early if sink returns false
+  bool readAll(const std::function<bool(std::string_view)> &sink) const;
+
+private:
+  void loadSeekTable();
+  bool readAt(uint64_t offset, size_t bytes, std::string &out) const;
+
+  int fd_ = -1;
+  uint64_t size_ = 0;
+  CompressionType type_ = CompressionType::NONE;
+  std::vector<SeekableLogFrame> frames_;
+};
+
+/**
+ * @brief Runs compression jobs in order on one background thread, so log
+ * rotation does not wait for them.
+ *
+ * The thread starts with the first job. Jobs still queued at destruction
+ * are run before the thread is joined.
+ */
+class LogCompressionQueue {
+public:
+  LogCompressionQueue() = default;
+  ~LogCompressionQueue();
+
+  LogCompressionQueue(const LogCompressionQueue &) = delete;
+  LogCompressionQueue &operator=(const LogCompressionQueue &) = delete;
+
+  void enqueue(std::function<void()> job);
+
+  // Waits until every queued job has finished; false on timeout
+  bool waitIdle(std::chrono::milliseconds timeout);
+  size_t pending() const;
+
+private:
+  void run();
+
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable idle_;
+  std::deque<std::function<void()>> jobs_;
+  bool busy_ = false;
+  bool stop_ = false;
+  std::thread worker_;
+};
@@ -5,6 +5,7 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <functional>
@@ -60,6 +61,24 @@ struct LogQueryParams {
   LogQueryParams() = default;
 };
 
+/**
+ * @brief Fields of one formatted log line, viewing into the line.
+ *
+ * Understands the text layout of Logger and FileLogHandler
+ * ("[ts] [LEVEL] [Component] [Job: id] message") and their JSON layout.
+ */
+struct ParsedLogLine {
+  int64_t timestampMs = 0; // milliseconds since the epoch
+  LogLevel level = LogLevel::INFO;
+  std::string_view component;
+  std::string_view jobId;
+  std::string_view message;
+};
+
+// Nullopt for lines that carry no timestamp and level (continuations,
+// stack traces, foreign formats)
+std::optional<ParsedLogLine> parseLogLine(std::string_view line);
+
 struct LogFileInfo;
 
 /**
@@ -210,12 +229,12 @@ struct CompressionResult {
   size_t originalSize = 0;
   size_t compressedSize = 0;
   double compressionRatio = 0.0;
-  std::chrono::milliseconds compressionTime{0};
+  std::chrono::microseconds compressionTime{0};
   std::string errorMessage;
 
   CompressionResult() = default;
   CompressionResult(bool s, size_t orig, size_t comp, double ratio,
-                    std::chrono::milliseconds time)
+                    std::chrono::microseconds time)
       : success(s), originalSize(orig), compressedSize(comp),
         compressionRatio(ratio), compressionTime(time) {}
 };
@@ -246,6 +265,7 @@ struct LogIndexingPolicy {
   std::vector<std::string> stopWords; // Words to exclude from full-text index
 
   // Performance optimization
+  size_t indexBlockLines = 64;     // Lines per sparse index block
   size_t indexFlushInterval = 100; // Flush index every N entries
   bool compressIndex = true;
   size_t indexCacheSize = 1024 * 1024; // 1MB index cache
@@ -288,6 +308,13 @@ struct LogPerformanceConfig {
   bool enableReadAhead = true;
   size_t readAheadSize = 128 * 1024; // 128KB
 
+  // Unindexed search
+  size_t searchThreads = 0; // 0 = hardware concurrency
+  size_t searchChunkSize = 8 * 1024 * 1024; // Bytes per parallel scan task
+
+  // Compression
+  size_t compressionFrameSize = 1024 * 1024; // Log bytes per seekable frame
+
   // Error resilience
   size_t maxRetryAttempts = 3;
   std::chrono::milliseconds retryDelay = std::chrono::milliseconds(100);
@@ -386,7 +413,8 @@ struct LogFileMetrics {
   std::atomic<uint64_t> bufferFlushes{0};
   std::atomic<uint64_t> bufferOverflows{0};
 
-  // Compression statistics
+  // Compression statistics (totalBytesCompressed counts input bytes)
+  std::atomic<uint64_t> totalBytesAfterCompression{0};
   std::atomic<double> averageCompressionRatio{0.0};
   std::atomic<uint64_t> compressionTime{0};   // microseconds
   std::atomic<uint64_t> decompressionTime{0}; // microseconds
@@ -427,6 +455,7 @@ struct LogFileMetrics {
         cacheMisses(other.cacheMisses.load()),
         bufferFlushes(other.bufferFlushes.load()),
         bufferOverflows(other.bufferOverflows.load()),
+        totalBytesAfterCompression(other.totalBytesAfterCompression.load()),
         averageCompressionRatio(other.averageCompressionRatio.load()),
         compressionTime(other.compressionTime.load()),
         decompressionTime(other.decompressionTime.load()) {}
@@ -468,6 +497,8 @@ struct LogFileMetrics {
       cacheMisses.store(other.cacheMisses.load());
       bufferFlushes.store(other.bufferFlushes.load());
       bufferOverflows.store(other.bufferOverflows.load());
+      totalBytesAfterCompression.store(
+          other.totalBytesAfterCompression.load());
       averageCompressionRatio.store(other.averageCompressionRatio.load());
       compressionTime.store(other.compressionTime.load());
       decompressionTime.store(other.decompressionTime.load());
@@ -476,10 +507,19 @@ struct LogFileMetrics {
   }
 
   // Helper methods for calculations
+  // Compressed size over original size, across every file compressed
   double getCompressionRatio() const {
-    auto compressed = totalBytesCompressed.load();
-    auto written = totalBytesWritten.load();
-    return written > 0 ? static_cast<double>(compressed) / written : 0.0;
+    auto original = totalBytesCompressed.load();
+    auto compressed = totalBytesAfterCompression.load();
+    return original > 0 ? static_cast<double>(compressed) / original : 0.0;
+  }
+
+  // Megabytes of input compressed per second spent compressing
+  double getCompressionThroughput() const {
+    auto micros = compressionTime.load();
+    return micros > 0 ? static_cast<double>(totalBytesCompressed.load()) /
+                            micros
+                      : 0.0;
   }
 
   double getErrorRate() const {
@@ -502,7 +542,9 @@ struct LogFileMetrics {
 // Forward declarations for utility classes
 class LogFileArchiver;
 class LogFileIndexer;
+class LogSearchEngine;
 class LogFileCompressor;
+class LogCompressionQueue;
 class LogFileValidator;
 
 /**
@@ -910,6 +952,11 @@ public:
 
   /**
    * @brief Compress log file with specified algorithm
+   *
+   * Writes filename plus the type's extension next to the original, which
+   * is kept. The result is seekable (see SeekableLogWriter), so searches
+   * only decompress the frames a query can match.
+   *
    * @param filename File to compress
    * @param compressionType Type of compression to use
    * @param compressionLevel Compression level (1-9)
@@ -928,6 +975,14 @@ public:
   bool decompressLogFile(const std::string &compressedFilename,
                          const std::string &outputFilename = "");
 
+  /**
+   * @brief Wait for rotated files queued for background compression
+   * @param timeout How long to wait
+   * @return true if no compression is pending
+   */
+  bool waitForPendingCompression(
+      std::chrono::milliseconds timeout = std::chrono::seconds(30));
+
   /**
    * @brief Compress all eligible files based on policies
    * @return Number of files successfully compressed
@@ -1270,6 +1325,9 @@ private:
   std::unordered_map<std::string, std::chrono::system_clock::time_point>
       lastRotationTimes_;
   mutable std::shared_mutex filesMutex_;
+  // Numbers the pending files of compressed rotations; guarded by
+  // filesMutex_
+  uint64_t rotationSequence_ = 0;
 
   std::string currentLogFile_;
   mutable std::shared_mutex currentFileMutex_;
@@ -1280,7 +1338,9 @@ private:
 
   std::unique_ptr<LogFileArchiver> archiver_;
   std::unique_ptr<LogFileIndexer> indexer_;
+  std::unique_ptr<LogSearchEngine> searchEngine_;
   std::unique_ptr<LogFileCompressor> compressor_;
+  std::unique_ptr<LogCompressionQueue> compressionQueue_;
   std::unique_ptr<LogFileValidator> validator_;
 
   // ========================================================================
@@ -1334,6 +1394,7 @@ private:
   // ========================================================================
 
   bool createDirectoryStructure(const std::string &filePath);
+  std::string resolveLogPath(const std::string &filename) const;
   bool validateFilePath(const std::string &filePath) const;
   std::string generateBackupFileName(const std::string &baseFilename,
                                      int index) const;
@@ -1416,6 +1477,7 @@ private:
                            std::chrono::microseconds latency);
   double calculateMovingAverage(double currentAvg, double newValue,
                                 uint64_t count);
+  void recordCompression(const CompressionResult &result);
 
   // ========================================================================
   // Helper Methods - Validation and Security
@@ -1494,18 +1556,33 @@ private:
 };
 
 /**
- * @brief High-performance log file indexing operations
+ * @brief Sparse block index over log files, persisted as a ".idx" sidecar.
+ *
+ * Each file is cut into blocks of indexBlockLines lines. A block records its
+ * byte range, first line number, time span, the levels it contains and a
+ * checksum of its bytes; job ids and components (and words, with full-text
+ * indexing) map to posting lists of block numbers. A query reads only the
+ * blocks that can match, so its I/O is proportional to the answer rather
+ * than to the log directory.
  */
 class LogFileIndexer {
 public:
   explicit LogFileIndexer(const LogIndexingPolicy &policy);
-  ~LogFileIndexer() = default;
+  ~LogFileIndexer(); // saves unsaved indexes
 
   // Core indexing operations
+  // Loads the sidecar (or builds the index) and indexes lines added since
   bool indexFile(const std::string &logFile);
+  // Indexes data the caller just appended at offset, without reading the
+  // file back. On a gap the index goes stale until the next indexFile().
+  void appendToIndex(const std::string &logFile, std::string_view data,
+                     uint64_t offset);
   bool removeIndex(const std::string &logFile);
   std::vector<HistoricalLogEntry>
   searchIndex(const LogQueryParams &params) const;
+  // Whether the index can skip blocks for this query; when it cannot, a
+  // full scan with LogSearchEngine is faster than reading every block
+  bool canNarrow(const LogQueryParams &params) const;
 
   // Index maintenance
   bool optimizeIndex();
@@ -1516,27 +1593,55 @@ public:
   std::unordered_map<std::string, uint64_t> getIndexStatistics() const;
   bool verifyIndexIntegrity(const std::string &indexFile) const;
 
+  bool isIndexFile(const std::filesystem::path &path) const;
+
 private:
-  LogIndexingPolicy policy_;
-  mutable std::shared_mutex indexMutex_;
+  struct Block {
+    uint64_t offset = 0; // of the first line
+    uint64_t bytes = 0;
+    uint64_t firstLine = 0; // 1-based
+    uint32_t lines = 0;
+    int64_t minTimeMs = 0;
+    int64_t maxTimeMs = 0;
+    uint8_t levels = 0; // bit per LogLevel
+    uint32_t checksum = 0;
+  };
 
-  struct IndexEntry {
-    std::chrono::system_clock::time_point timestamp;
-    LogLevel level;
-    std::string component;
-    std::string jobId;
-    std::string filename;
-    size_t lineNumber;
-    size_t fileOffset;
-    uint32_t checksum;
+  // key -> ascending block numbers
+  using Postings =
+      std::unordered_map<std::string, std::vector<uint32_t>,
+                         TransparentStringHash, std::equal_to<>>;
+
+  struct FileIndex {
+    uint64_t indexedBytes = 0; // complete lines covered by blocks
+    uint64_t lineCount = 0;
+    bool fullText = false;
+    bool stale = false; // missed an append; catch up from the file
+    std::vector<Block> blocks;
+    Postings jobs;
+    Postings components;
+    Postings terms;
+    std::string partialLine; // appended bytes after the last newline
+    size_t unsavedLines = 0;
   };
 
-  std::vector<IndexEntry> loadIndex(const std::string &indexFile) const;
-  bool saveIndex(const std::string &indexFile,
-                 const std::vector<IndexEntry> &entries);
+  void indexLine(FileIndex &index, std::string_view line) const;
+  void indexBytes(FileIndex &index, std::string_view data) const;
+  bool catchUp(const std::string &logFile, FileIndex &index) const;
+  bool matchesLog(const std::string &logFile, const FileIndex &index) const;
+  std::vector<uint32_t> candidateBlocks(const FileIndex &index,
+                                        const LogQueryParams &params) const;
+  void maybeSave(const std::string &logFile, FileIndex &index);
+
+  std::optional<FileIndex> loadIndex(const std::string &indexFile) const;
+  bool saveIndex(const std::string &indexFile, const FileIndex &index) const;
   std::string getIndexFilePath(const std::string &logFile) const;
   bool createFullTextIndex(const std::string &logFile);
-  std::vector<std::string> tokenizeText(const std::string &text) const;
+  std::vector<std::string> tokenizeText(std::string_view text) const;
+
+  LogIndexingPolicy policy_;
+  mutable std::shared_mutex indexMutex_;
+  std::unordered_map<std::string, FileIndex> indexes_; // by log file path
 };
 
 /**
@@ -1544,13 +1649,24 @@ private:
  */
 class LogFileCompressor {
 public:
-  LogFileCompressor() = default;
+  /**
+   * @param frameBytes Uncompressed bytes per independently readable frame
+   * of the files it writes (see SeekableLogWriter)
+   */
+  explicit LogFileCompressor(size_t frameBytes = 1024 * 1024)
+      : frameBytes_(frameBytes) {}
   ~LogFileCompressor() = default;
 
-  // Core compression operations
+  // Core compression operations. Files are streamed in frames, never
+  // loaded whole; GZIP, ZSTD and LZ4 are supported, ZIP and BZIP2 are not.
   bool compressFile(const std::string &sourceFile,
                     const std::string &targetFile, CompressionType type,
                     int level = 6);
+  CompressionResult compressFileWithResult(const std::string &sourceFile,
+                                           const std::string &targetFile,
+                                           CompressionType type,
+                                           int level = 6);
+  // The format is taken from the file contents, not its name
   bool decompressFile(const std::string &compressedFile,
                       const std::string &targetFile);
 
@@ -1569,7 +1685,13 @@ public:
                           CompressionType type);
 
 private:
-  mutable std::mutex compressionMutex_;
+  size_t frameBytes_;
+
+  CompressionResult compressSeekable(const std::string &sourceFile,
+                                     const std::string &targetFile,
+                                     CompressionType type, int level);
+  bool decompressStream(const std::string &sourceFile,
+                        const std::string &targetFile);
 
   // Algorithm-specific implementations
   bool compressGzip(const std::string &sourceFile,
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+// Defined in logger.hpp, which includes this header
+enum class LogLevel;
+enum class LogFormat;
+
+// How a value is stored in a LogRecord
+enum class LogRecordTag : uint8_t {
+  LITERAL = 0, // pointer and length of a string with static storage
+  STRING = 1,  // length and bytes, copied
+  INT = 2,
+  UINT = 3,
+  DOUBLE = 4,
+  BOOL = 5,
+  CHAR = 6
+};
+
+// The format text of a log call. Only a string literal is marked literal
+// and kept by address; any other text, a char buffer included, is copied.
+struct LogFormatText {
+  std::string_view text;
+  bool literal = false;
+};
+
+// Whether text is a string literal; a char array or a pointer to one is
+// not. Compilers without the builtin have every format copied.
+#if defined(__GNUC__) || defined(__clang__)
+#define ETL_IS_STRING_LITERAL(text) __builtin_constant_p(text)
+#else
+#define ETL_IS_STRING_LITERAL(text) false
+#endif
+
+// Tags a log macro's message; text is evaluated once
+#define ETL_LOG_FORMAT_TEXT(text)                                              \
+  (LogFormatText{std::string_view(text), ETL_IS_STRING_LITERAL(text)})
+
+/**
+ * Builds the binary record of one log call on the calling thread; the writer
+ * thread renders it to text or JSON later with renderLogRecord().
+ *
+ * A record is a fixed header (time, level, argument and context counts)
+ * followed by tagged values: the component, the format string, each
+ * argument, then every context key and value. String literals are kept as
+ * a pointer, so a call with a literal format and numeric arguments copies a
+ * few dozen bytes and formats nothing. Everything else is copied: a record
+ * may be rendered after the caller's buffers are gone.
+ */
+class LogRecordWriter {
+public:
+  struct Header {
+    int64_t timeUs; // system_clock, since the epoch
+    uint8_t level;
+    uint8_t args;
+    uint16_t contexts;
+  };
+
+  // The header of a finished record
+  static Header readHeader(std::string_view record) {
+    Header header;
+    std::memcpy(&header, record.data(), sizeof(header));
+    return header;
+  }
+
+  // Reuses out's buffer; the record is everything appended to it
+  explicit LogRecordWriter(std::string &out) : out_(out) { out_.clear(); }
+
+  // A per-thread buffer for callers that encode and hand off at once
+  static std::string &scratch() {
+    thread_local std::string buffer;
+    return buffer;
+  }
+
+  void begin(LogLevel level, size_t args, size_t contexts) {
+    Header header{};
+    header.timeUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+    header.level = static_cast<uint8_t>(level);
+    header.args = static_cast<uint8_t>(args);
+    header.contexts = static_cast<uint16_t>(contexts < 0xffff ? contexts
+                                                              : 0xffff);
+    put(header);
+  }
+
+  // text must outlive the record: a string literal
+  void literal(const char *text, size_t size) {
+    put(LogRecordTag::LITERAL);
+    put(text);
+    put(static_cast<uint32_t>(size));
+  }
+
+  void string(std::string_view text) {
+    put(LogRecordTag::STRING);
+    put(static_cast<uint32_t>(text.size()));
+    out_.append(text.data(), text.size());
+  }
+
+  void format(LogFormatText format) {
+    if (format.literal) {
+      literal(format.text.data(), format.text.size());
+    } else {
+      string(format.text);
+    }
+  }
+
+  // One "{}" argument, printed as an ostream would print it
+  template <typename T> void arg(const T &value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      tagged(LogRecordTag::BOOL, static_cast<uint8_t>(value));
+    } else if constexpr (std::is_same_v<T, char> ||
+                         std::is_same_v<T, signed char> ||
+                         std::is_same_v<T, unsigned char>) {
+      tagged(LogRecordTag::CHAR, static_cast<char>(value));
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+      tagged(LogRecordTag::INT, static_cast<int64_t>(value));
+    } else if constexpr (std::is_integral_v<T>) {
+      tagged(LogRecordTag::UINT, static_cast<uint64_t>(value));
+    } else if constexpr (std::is_floating_point_v<T>) {
+      tagged(LogRecordTag::DOUBLE, static_cast<double>(value));
+    } else if constexpr (IsStringMap<T>::value) {
+      // Rendered now: the map may be gone by the time the writer runs
+      std::string text = "{";
+      for (const auto &[key, mapped] : value) {
+        if (text.size() > 1) {
+          text += ", ";
+        }
+        text += key;
+        text += ": ";
+        text += mapped;
+      }
+      text += '}';
+      string(text);
+    } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+      if constexpr (std::is_pointer_v<T>) {
+        if (value == nullptr) {
+          string({});
+          return;
+        }
+      }
+      string(std::string_view(value));
+    } else if constexpr (std::is_convertible_v<const T &, std::string>) {
+      string(std::string(value));
+    } else {
+      literal("[object]", 8);
+    }
+  }
+
+private:
+  template <typename T> struct IsStringMap : std::false_type {};
+  template <typename H, typename E, typename A>
+  struct IsStringMap<std::unordered_map<std::string, std::string, H, E, A>>
+      : std::true_type {};
+
+  template <typename T> void put(const T &value) {
+    const size_t offset = out_.size();
+    out_.resize(offset + sizeof(T));
+    std::memcpy(&out_[offset], &value, sizeof(T));
+  }
+
+  template <typename T> void tagged(LogRecordTag tag, T value) {
+    put(tag);
+    put(value);
+  }
+
+  std::string &out_;
+};
+
+// Appends the record as one line, newline included, in Logger's text
+// layout or as a JSON object. "{}" in the format takes the next argument;
+// arguments past the last "{}" are dropped.
+void renderLogRecord(std::string_view record, LogFormat format,
+                     std::string &out);
+
+// Renders only the record's message, for callers that need it as a string
+std::string renderLogMessage(std::string_view record);
+
+// "YYYY-MM-DD HH:MM:SS.mmm" in local time
+void appendLogTimestamp(std::string &out, int64_t timeUs);
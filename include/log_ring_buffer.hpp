@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * Bounded lock-free multi-producer/single-consumer ring of log records.
+ *
+ * Every slot owns a string preallocated to slotBytes, so pushing a record
+ * that fits is a copy with no allocation. Producers claim a slot with one
+ * CAS and publish it through the slot's sequence number; tryPush() fails
+ * instead of waiting when the ring is full, leaving the overflow policy to
+ * the caller.
+ *
+ * The consumer reads published records in order with peek() and hands their
+ * slots back with release() once it is done with them, so a batch is read
+ * straight from the slots.
+ */
+class LogRingBuffer {
+public:
+  explicit LogRingBuffer(size_t capacity, size_t slotBytes = 256)
+      : mask_(roundUp(capacity) - 1),
+        slots_(std::make_unique<Slot[]>(mask_ + 1)) {
+    for (size_t i = 0; i <= mask_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+      slots_[i].record.reserve(slotBytes);
+    }
+  }
+
+  LogRingBuffer(const LogRingBuffer &) = delete;
+  LogRingBuffer &operator=(const LogRingBuffer &) = delete;
+
+  size_t capacity() const { return mask_ + 1; }
+
+  // Copies record into a free slot; false when full
+  bool tryPush(std::string_view record) {
+    size_t position = head_.load(std::memory_order_relaxed);
+    Slot *slot;
+    for (;;) {
+      slot = &slots_[position & mask_];
+      const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      if (sequence == position) {
+        if (head_.compare_exchange_weak(position, position + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (static_cast<intptr_t>(sequence - position) < 0) {
+        return false; // still holds a record from the previous lap
+      } else {
+        position = head_.load(std::memory_order_relaxed);
+      }
+    }
+    slot->record.assign(record);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Records claimed by producers and not yet released by the consumer
+  size_t size() const {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    return head > tail ? head - tail : 0;
+  }
+
+  // Total records ever claimed; flush() waits for released() to reach it
+  size_t pushed() const { return head_.load(std::memory_order_acquire); }
+  size_t released() const { return tail_.load(std::memory_order_acquire); }
+
+  // Consumer only. Calls visit(record) for up to max published records
+  // after the ones already peeked, in push order, and returns how many it
+  // saw.
+  template <typename Visit> size_t peek(size_t max, Visit &&visit) {
+    size_t count = 0;
+    while (count < max) {
+      const Slot &slot = slots_[peeked_ & mask_];
+      if (slot.sequence.load(std::memory_order_acquire) != peeked_ + 1) {
+        break;
+      }
+      visit(std::string_view(slot.record));
+      ++peeked_;
+      ++count;
+    }
+    return count;
+  }
+
+  // Consumer only. Frees every peeked slot for producers to reuse.
+  void release() {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    for (; tail != peeked_; ++tail) {
+      slots_[tail & mask_].sequence.store(tail + mask_ + 1,
+                                          std::memory_order_release);
+    }
+    tail_.store(tail, std::memory_order_release);
+  }
+
+private:
+  // Sized to a cache line so neighbouring producers do not false-share
+  struct alignas(64) Slot {
+    std::atomic<size_t> sequence{0};
+    std::string record;
+  };
+
+  static size_t roundUp(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+  const size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+  size_t peeked_ = 0; // consumer's read position, ahead of tail_
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "log_file_manager.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class WorkStealingPool;
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The mapping covers the file as it was when opened; later appends are not
+ * visible. Empty (and not open) when the file is missing, empty or cannot
+ * be mapped.
+ */
+class MappedLogFile {
+public:
+  explicit MappedLogFile(const std::string &path);
+  ~MappedLogFile();
+
+  MappedLogFile(const MappedLogFile &) = delete;
+  MappedLogFile &operator=(const MappedLogFile &) = delete;
+
+  bool isOpen() const { return data_ != nullptr; }
+  std::string_view contents() const { return {data_, size_}; }
+
+private:
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/**
+ * @brief Exact per-line test of every LogQueryParams filter, with the regex
+ * compiled once per query.
+ *
+ * Lines parseLogLine() does not understand (continuations, stack traces)
+ * only match queries that filter on text alone. Formatted lines carry no
+ * thread id, so threadId is not filtered on.
+ */
+class LogQueryMatcher {
+public:
+  explicit LogQueryMatcher(const LogQueryParams &params);
+
+  // False when useRegex is set and searchText does not compile
+  bool isValid() const { return valid_; }
+
+  // Plain searchText every matching line contains, or empty; lets a scan
+  // jump from one occurrence to the next instead of visiting every line
+  std::string_view requiredSubstring() const;
+
+  bool matches(const std::optional<ParsedLogLine> &parsed,
+               std::string_view line) const;
+
+  // Whether any line of a span whose parsed lines have timestamps in
+  // [minTimeMs, maxTimeMs] and levels in the bit set (1 << level) can match;
+  // false lets a scan skip the span without reading it
+  bool mayMatchSpan(int64_t minTimeMs, int64_t maxTimeMs,
+                    uint8_t levels) const;
+
+private:
+  const LogQueryParams &params_;
+  std::optional<std::regex> pattern_;
+  int64_t startMs_;
+  int64_t endMs_;
+  bool structured_;
+  bool valid_ = true;
+};
+
+/**
+ * @brief The page of results a query asked for: entries in sortBy order,
+ * after skipping offset, at most maxResults.
+ *
+ * Holds only the best offset + maxResults entries seen so far in a bounded
+ * heap, so a scan never materialises the full result set. Ties in the sort
+ * key go to file order (fileRank), then to position within the file.
+ */
+class LogResultWindow {
+public:
+  explicit LogResultWindow(const LogQueryParams &params);
+
+  // Whether an entry with these keys would currently be kept; lets callers
+  // skip building entries that would be dropped straight away
+  bool wouldAccept(int64_t timestampMs, LogLevel level,
+                   std::string_view component, size_t fileRank,
+                   uint64_t position) const;
+
+  // tag is carried through for the caller, e.g. to fix up line numbers
+  void add(HistoricalLogEntry entry, size_t fileRank, uint64_t position,
+           uint32_t tag = 0);
+  void merge(LogResultWindow &&other);
+
+  struct Result {
+    HistoricalLogEntry entry;
+    uint32_t tag;
+  };
+  // The requested page, in order; leaves the window empty
+  std::vector<Result> takePage();
+
+private:
+  struct Slot {
+    HistoricalLogEntry entry;
+    int64_t timestampMs;
+    size_t fileRank;
+    uint64_t position;
+    uint32_t tag;
+  };
+
+  // Whether a belongs before b in the requested order
+  bool before(int64_t timestampMs, LogLevel level, std::string_view component,
+              size_t fileRank, uint64_t position, const Slot &b) const;
+  bool before(const Slot &a, const Slot &b) const;
+  void push(Slot slot);
+
+  const LogQueryParams &params_;
+  size_t capacity_;
+  std::vector<Slot> heap_; // worst kept entry on top
+};
+
+/**
+ * @brief Parallel scan of log files for LogFileManager::searchLogEntries
+ * when there is no index to consult.
+ *
+ * Files are memory-mapped and cut into line-aligned chunks that run on a
+ * work-stealing pool. A plain searchText is found with the SIMD substring
+ * kernel, so only lines containing it are parsed; other queries parse every
+ * line. Each chunk keeps its own result window, merged as chunks finish.
+ *
+ * Compressed files with a seek table (see SeekableLogWriter) are searched
+ * a frame per chunk, and frames whose time range and levels rule them out
+ * are never decompressed. Other compressed files are decompressed whole.
+ */
+class LogSearchEngine {
+public:
+  static constexpr size_t kDefaultChunkBytes = 8 * 1024 * 1024;
+
+  /**
+   * @param threads Worker threads (0 = hardware concurrency), started on
+   * the first search
+   * @param chunkBytes Approximate bytes per unit of parallel work
+   */
+  explicit LogSearchEngine(size_t threads = 0,
+                           size_t chunkBytes = kDefaultChunkBytes);
+  ~LogSearchEngine();
+
+  LogSearchEngine(const LogSearchEngine &) = delete;
+  LogSearchEngine &operator=(const LogSearchEngine &) = delete;
+
+  // Searches the files in the given order, which is also the tie-break
+  // order between entries with equal sort keys
+  std::vector<HistoricalLogEntry> search(const std::vector<std::string> &files,
+                                         const LogQueryParams &params) const;
+
+private:
+  WorkStealingPool &pool() const;
+
+  size_t threads_;
+  size_t chunkBytes_;
+  mutable std::once_flag poolOnce_;
+  mutable std::unique_ptr<WorkStealingPool> pool_;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "log_record.hpp"
 #include "transparent_string_hash.hpp"
 #include <atomic>
 #include <chrono>
@@ -12,6 +13,7 @@
 #include <optional>
 #include <queue>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
@@ -25,11 +27,19 @@ struct LogMessage;
 struct LogQueryParams;
 struct HistoricalLogEntry;
 struct LogFileInfo;
+class LogCompressionQueue;
+struct LogStagingBuffer;
 
 enum class LogLevel { DEBUG = 0, INFO = 1, WARN = 2, ERROR = 3, FATAL = 4 };
 
 enum class LogFormat { TEXT = 0, JSON = 1 };
 
+// What an async log call does when the writer thread has fallen behind
+enum class LogOverflowPolicy {
+  DROP = 0, // discard the line and count it in droppedMessages
+  BLOCK = 1 // wait for the writer to free a slot
+};
+
 // Enhanced log rotation and retention configuration
 struct LogRotationConfig {
   bool enableRotation = true;
@@ -42,8 +52,8 @@ struct LogRotationConfig {
   std::chrono::hours retentionPeriod = std::chrono::hours(24 * 7); // 7 days
 
   // Compression settings
-  bool compressOldLogs = false;
-  std::string compressionFormat = "gzip"; // gzip, zip, none
+  bool compressOldLogs = false; // in the background, after rotation
+  std::string compressionFormat = "gzip"; // gzip, zstd, lz4, none
 
   // Cleanup settings
   bool enableAutoCleanup = true;
@@ -65,6 +75,14 @@ struct LogConfig {
   bool includeMetrics = false;
   int flushInterval = 1000; // milliseconds
 
+  // Async logging: each logging thread stages records in its own ring of
+  // this many slots, and the writer thread renders and appends them in one
+  // write() per flushInterval, or sooner once a ring is half full. The
+  // interval is read when the writer starts and a thread's ring is sized
+  // when that thread first logs asynchronously.
+  size_t asyncQueueSize = 1024;
+  LogOverflowPolicy asyncOverflowPolicy = LogOverflowPolicy::DROP;
+
   // Real-time streaming configuration
   bool enableRealTimeStreaming = false;
   size_t streamingQueueSize = 1000;
@@ -156,6 +174,59 @@ public:
       const std::unordered_map<std::string, std::string, TransparentStringHash,
                                std::equal_to<>> &context = {});
 
+  // Whether a message at level from component would be written; callers
+  // check it before building a message. Lock-free unless a component
+  // filter is set.
+  bool isEnabled(LogLevel level, std::string_view component) const {
+    if (static_cast<int>(level) < minLevel_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    return !componentFilterActive_.load(std::memory_order_relaxed) ||
+           passesComponentFilter(component);
+  }
+
+  // Whether job log calls at level are streamed, written or not
+  bool isStreamingEnabled(LogLevel level) const {
+    return static_cast<int>(level) >=
+           streamingMinLevel_.load(std::memory_order_relaxed);
+  }
+
+  // The lowest level written for component, as an int, or above FATAL when
+  // the component filter leaves it out. Every configuration change updates
+  // it, so ComponentLogger checks its level with one relaxed load.
+  const std::atomic<int> &componentThreshold(const char *component);
+
+  // Fast logging: format has a "{}" per argument. The call stores the
+  // format and the arguments as a binary record; the text or JSON line is
+  // rendered by whichever thread writes it, the async writer when async
+  // logging is on. Only a format tagged literal by ETL_LOG_FORMAT_TEXT is
+  // kept by address; any other is copied.
+  template <typename Format, typename... Args>
+  void logFormat(LogLevel level, const char *component, const Format &format,
+                 const Args &...args) {
+    if (isEnabled(level, component)) {
+      writeFormat(level, component, format, args...);
+    }
+  }
+
+  // logFormat() for callers that have already checked the level
+  template <typename... Args>
+  void writeFormat(LogLevel level, const char *component,
+                   LogFormatText format, const Args &...args) {
+    LogRecordWriter record(LogRecordWriter::scratch());
+    record.begin(level, sizeof...(Args), 0);
+    record.literal(component, std::char_traits<char>::length(component));
+    record.format(format);
+    (record.arg(args), ...);
+    writeRecord(LogRecordWriter::scratch());
+  }
+
+  template <typename... Args>
+  void writeFormat(LogLevel level, const char *component,
+                   std::string_view format, const Args &...args) {
+    writeFormat(level, component, LogFormatText{format}, args...);
+  }
+
   // Metrics and performance logging
   void logMetric(const std::string &name, double value,
                  const std::string &unit = "");
@@ -239,23 +310,45 @@ private:
   LogConfig config_;
   mutable std::mutex configMutex_;
 
-  // File handling
-  std::ofstream fileStream_;
+  // File handling; an O_APPEND descriptor so batches go out in one write()
+  int fileFd_ = -1;
   std::string currentLogFile_;
   size_t currentFileSize_ = 0;
   mutable std::mutex fileMutex_;
 
-  // Async logging
-  std::queue<std::string> messageQueue_;
+  // Level checks without configMutex_, kept in step with config_ by
+  // updateThresholds()
+  static constexpr int kLevelOff = static_cast<int>(LogLevel::FATAL) + 1;
+  std::atomic<int> minLevel_{static_cast<int>(LogLevel::INFO)};
+  std::atomic<bool> componentFilterActive_{false};
+  std::atomic<int> streamingMinLevel_{kLevelOff};
+  std::unordered_map<std::string, std::unique_ptr<std::atomic<int>>,
+                     TransparentStringHash, std::equal_to<>>
+      componentThresholds_; // guarded by configMutex_
+
+  // Async logging: each logging thread stages records in its own ring,
+  // which the writer thread drains
+  std::vector<std::shared_ptr<LogStagingBuffer>> stagingBuffers_;
+  mutable std::mutex stagingMutex_; // guards the list, not the rings
   std::thread asyncThread_;
   std::condition_variable asyncCondition_;
+  std::condition_variable asyncFlushed_;
   std::mutex asyncMutex_;
+  bool flushRequested_ = false; // guarded by asyncMutex_
+  std::chrono::milliseconds asyncInterval_{1000}; // flushInterval at start
+  std::atomic<bool> asyncWakePending_{false};
   std::atomic<bool> stopAsync_{false};
   std::atomic<bool> asyncStarted_{false};
 
   // Metrics
   LogMetrics metrics_;
 
+  // Compression of rotated files, started on first use. Renames within the
+  // backup chain, by rotation and by finished jobs, hold backupMutex_.
+  std::mutex backupMutex_;
+  uint64_t rotations_ = 0; // guarded by backupMutex_
+  std::unique_ptr<LogCompressionQueue> compressionQueue_;
+
   // Real-time streaming
   std::shared_ptr<WebSocketManager> wsManager_;
   std::queue<std::shared_ptr<LogMessage>> streamingQueue_;
@@ -268,25 +361,24 @@ private:
   // Helper methods
   std::string formatTimestamp();
   std::string levelToString(LogLevel level);
-  std::string formatMessage(
-      LogLevel level, const std::string &component, const std::string &message,
-      const std::unordered_map<std::string, std::string, TransparentStringHash,
-                               std::equal_to<>> &context);
-  std::string formatTextMessage(
-      LogLevel level, const std::string &component, const std::string &message,
-      const std::unordered_map<std::string, std::string, TransparentStringHash,
-                               std::equal_to<>> &context);
-  std::string formatJsonMessage(
-      LogLevel level, const std::string &component, const std::string &message,
-      const std::unordered_map<std::string, std::string, TransparentStringHash,
-                               std::equal_to<>> &context);
-  void writeLog(const std::string &formattedMessage);
-  void writeLogSync(const std::string &formattedMessage);
-  void writeLogAsync(const std::string &formattedMessage);
+  void writeRecord(std::string_view record);
+  void writeLogSync(std::string_view record);
+  bool writeLogAsync(std::string_view record);
+  void startAsyncWriter();
+  void stopAsyncWriter();
+  void wakeAsyncWriter();
   void asyncWorker();
+  LogStagingBuffer &stagingBuffer();
+  void drainStagingBuffers();
+  void retireStagingBuffers();
+  void writeBatch(const std::string &lines, const std::vector<size_t> &ends);
+  void updateThresholds();
+  bool passesComponentFilter(std::string_view component) const;
+  bool openFileSink(bool truncate);
+  void closeFileSink();
+  void writeFileLine(const std::string &line);
+  void writeFileBytes(std::string_view bytes);
   void rotateLogFile();
-  bool shouldLog(LogLevel level, const std::string &component) const;
-  std::string escapeJson(const std::string &str);
 
   // Real-time streaming helpers
   void streamingWorker();
@@ -355,97 +447,3 @@ private:
 
 // Include the new ComponentLogger template system
 #include "component_logger.hpp"
-
-// Backward compatibility - redirect old macros to new ComponentLogger system
-// Note: These are deprecated and should be replaced with ComponentLogger
-// template calls
-
-#define CONFIG_LOG_DEBUG(message, ...)                                         \
-  etl::ConfigLogger::debug(message, ##__VA_ARGS__)
-#define CONFIG_LOG_INFO(message, ...)                                          \
-  etl::ConfigLogger::info(message, ##__VA_ARGS__)
-#define CONFIG_LOG_WARN(message, ...)                                          \
-  etl::ConfigLogger::warn(message, ##__VA_ARGS__)
-#define CONFIG_LOG_ERROR(message, ...)                                         \
-  etl::ConfigLogger::error(message, ##__VA_ARGS__)
-
-#define DB_LOG_DEBUG(message, ...)                                             \
-  etl::DatabaseLogger::debug(message, ##__VA_ARGS__)
-#define DB_LOG_INFO(message, ...)                                              \
-  etl::DatabaseLogger::info(message, ##__VA_ARGS__)
-#define DB_LOG_WARN(message, ...)                                              \
-  etl::DatabaseLogger::warn(message, ##__VA_ARGS__)
-#define DB_LOG_ERROR(message, ...)                                             \
-  etl::DatabaseLogger::error(message, ##__VA_ARGS__)
-
-#define ETL_LOG_DEBUG(message, ...)                                            \
-  etl::ETLJobLogger::debug(message, ##__VA_ARGS__)
-#define ETL_LOG_INFO(message, ...)                                             \
-  etl::ETLJobLogger::info(message, ##__VA_ARGS__)
-#define ETL_LOG_WARN(message, ...)                                             \
-  etl::ETLJobLogger::warn(message, ##__VA_ARGS__)
-#define ETL_LOG_ERROR(message, ...)                                            \
-  etl::ETLJobLogger::error(message, ##__VA_ARGS__)
-
-#define ETL_LOG_DEBUG_JOB(message, jobId, ...)                                 \
-  etl::ETLJobLogger::debugJob(message, jobId, ##__VA_ARGS__)
-#define ETL_LOG_INFO_JOB(message, jobId, ...)                                  \
-  etl::ETLJobLogger::infoJob(message, jobId, ##__VA_ARGS__)
-#define ETL_LOG_WARN_JOB(message, jobId, ...)                                  \
-  etl::ETLJobLogger::warnJob(message, jobId, ##__VA_ARGS__)
-#define ETL_LOG_ERROR_JOB(message, jobId, ...)                                 \
-  etl::ETLJobLogger::errorJob(message, jobId, ##__VA_ARGS__)
-
-#define WS_LOG_DEBUG(message, ...)                                             \
-  etl::WebSocketLogger::debug(message, ##__VA_ARGS__)
-#define WS_LOG_INFO(message, ...)                                              \
-  etl::WebSocketLogger::info(message, ##__VA_ARGS__)
-#define WS_LOG_WARN(message, ...)                                              \
-  etl::WebSocketLogger::warn(message, ##__VA_ARGS__)
-#define WS_LOG_ERROR(message, ...)                                             \
-  etl::WebSocketLogger::error(message, ##__VA_ARGS__)
-
-#define AUTH_LOG_DEBUG(message, ...)                                           \
-  etl::AuthLogger::debug(message, ##__VA_ARGS__)
-#define AUTH_LOG_INFO(message, ...)                                            \
-  etl::AuthLogger::info(message, ##__VA_ARGS__)
-#define AUTH_LOG_WARN(message, ...)                                            \
-  etl::AuthLogger::warn(message, ##__VA_ARGS__)
-#define AUTH_LOG_ERROR(message, ...)                                           \
-  etl::AuthLogger::error(message, ##__VA_ARGS__)
-
-#define HTTP_LOG_DEBUG(message, ...)                                           \
-  etl::HttpLogger::debug(message, ##__VA_ARGS__)
-#define HTTP_LOG_INFO(message, ...)                                            \
-  etl::HttpLogger::info(message, ##__VA_ARGS__)
-#define HTTP_LOG_WARN(message, ...)                                            \
-  etl::HttpLogger::warn(message, ##__VA_ARGS__)
-#define HTTP_LOG_ERROR(message, ...)                                           \
-  etl::HttpLogger::error(message, ##__VA_ARGS__)
-
-#define REQ_LOG_DEBUG(message, ...)                                            \
-  etl::ComponentLogger<etl::RequestHandler>::debug(message, ##__VA_ARGS__)
-#define REQ_LOG_INFO(message, ...)                                             \
-  etl::ComponentLogger<etl::RequestHandler>::info(message, ##__VA_ARGS__)
-#define REQ_LOG_WARN(message, ...)                                             \
-  etl::ComponentLogger<etl::RequestHandler>::warn(message, ##__VA_ARGS__)
-#define REQ_LOG_ERROR(message, ...)                                            \
-  etl::ComponentLogger<etl::RequestHandler>::error(message, ##__VA_ARGS__)
-
-#define TRANSFORM_LOG_DEBUG(message, ...)                                      \
-  etl::DataTransformerLogger::debug(message, ##__VA_ARGS__)
-#define TRANSFORM_LOG_INFO(message, ...)                                       \
-  etl::DataTransformerLogger::info(message, ##__VA_ARGS__)
-#define TRANSFORM_LOG_WARN(message, ...)                                       \
-  etl::DataTransformerLogger::warn(message, ##__VA_ARGS__)
-#define TRANSFORM_LOG_ERROR(message, ...)                                      \
-  etl::DataTransformerLogger::error(message, ##__VA_ARGS__)
-
-#define JOB_LOG_DEBUG(message, ...)                                            \
-  etl::JobMonitorLogger::debug(message, ##__VA_ARGS__)
-#define JOB_LOG_INFO(message, ...)                                             \
-  etl::JobMonitorLogger::info(message, ##__VA_ARGS__)
-#define JOB_LOG_WARN(message, ...)                                             \
-  etl::JobMonitorLogger::warn(message, ##__VA_ARGS__)
-#define JOB_LOG_ERROR(message, ...)                                            \
-  etl::JobMonitorLogger::error(message, ##__VA_ARGS__)
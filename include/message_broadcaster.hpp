@@ -2,6 +2,7 @@
 
 #include "connection_pool.hpp"
 #include "job_monitoring_models.hpp"
+#include "subscription_index.hpp"
 #include "websocket_connection.hpp"
 #include <atomic>
 #include <chrono>
@@ -50,7 +51,7 @@ struct MessageBroadcasterStats {
  * @brief Internal message structure for queuing
  */
 struct QueuedMessage {
-  std::string message;
+  SharedMessage message; // serialised once, shared by every recipient
   MessageType type;
   std::string jobId;
   std::string logLevel;
@@ -90,6 +91,12 @@ public:
   void sendToConnection(const std::string &connectionId,
                         const std::string &message);
 
+  // Subscription index membership; filter changes made through this class
+  // keep a registered connection's entry current
+  void
+  registerConnection(const std::shared_ptr<WebSocketConnection> &connection);
+  void unregisterConnection(const std::string &connectionId);
+
   // Enhanced broadcasting with filtering
   void broadcastJobUpdate(const std::string &message, const std::string &jobId);
   void broadcastLogMessage(const std::string &message, const std::string &jobId,
@@ -167,6 +174,9 @@ private:
   std::condition_variable queueCondition_;
   std::atomic<size_t> activeBroadcasts_{0};
 
+  // Routing index over connection filters
+  SubscriptionIndex<std::weak_ptr<WebSocketConnection>> subscriptions_;
+
   // Statistics
   mutable std::mutex statsMutex_;
   MessageBroadcasterStats stats_;
@@ -174,18 +184,29 @@ private:
   // Internal helper methods
   void processMessageQueue();
   void processQueuedMessage(const QueuedMessage &msg);
+  // Hands msg to the processing threads; false if async processing is off
+  // or the queue is full, in which case the caller delivers it directly
+  bool enqueueMessage(QueuedMessage msg);
+  void deliverToAll(const SharedMessage &message);
+  void
+  indexConnection(const std::shared_ptr<WebSocketConnection> &connection);
+  // Calls send(connection) for each open subscriber to the message and
+  // drops index entries whose connection is gone
+  template <class Send>
+  size_t forEachSubscriber(MessageType type, const std::string &jobId,
+                           const std::string &logLevel, Send &&send);
+  // Returns the number of connections the message was sent to
+  size_t deliverFiltered(const SharedMessage &message, MessageType type,
+                         const std::string &jobId,
+                         const std::string &logLevel);
   void broadcastToConnections(
-      const std::string &message,
+      const SharedMessage &message,
       const std::vector<std::shared_ptr<WebSocketConnection>> &connections);
   void sendMessageToConnection(
       const std::shared_ptr<WebSocketConnection> &connection,
-      const std::string &message);
+      const SharedMessage &message, uint64_t supersedeKey = 0);
   void updateStats(size_t messagesSent, size_t messagesDropped = 0);
   bool
-  shouldProcessMessage(const std::shared_ptr<WebSocketConnection> &connection,
-                       MessageType type, const std::string &jobId = "",
-                       const std::string &logLevel = "") const;
-  bool
   shouldProcessMessage(const std::shared_ptr<WebSocketConnection> &connection,
                        const WebSocketMessage &message) const;
 
@@ -16,6 +16,7 @@
 #include <vector>
 
 // Forward declarations
+class AsyncHttpClient;
 class ConfigManager;
 
 // Notification types
@@ -97,6 +98,7 @@ struct NotificationConfig {
   int timeoutWarningThresholdMinutes =
       25;                   // Warn when job runs longer than this
   int queueMaxSize = 10000; // Maximum notification queue size
+  int deliveryWorkers = 2;  // Threads handing notifications to delivery
 
   // Resource alert thresholds
   double memoryUsageThreshold = 0.85; // 85% memory usage
@@ -130,11 +132,32 @@ struct NotificationConfig {
   bool isValid() const;
 };
 
+// Snapshot of NotificationServiceImpl counters
+struct NotificationStats {
+  size_t processed = 0;
+  size_t failed = 0;
+  size_t queued = 0;         // waiting for a delivery worker
+  size_t retriesPending = 0; // waiting out their backoff
+  size_t inFlight = 0;       // handed to delivery, outcome not back yet
+  // From entering the queue until the last delivery method reported back,
+  // over the most recent deliveries
+  std::chrono::microseconds queueToDeliveryP50{0};
+  std::chrono::microseconds queueToDeliveryP99{0};
+  std::chrono::microseconds averageDeliveryLatency{0};
+  std::chrono::microseconds maxDeliveryLatency{0};
+};
+
 // Notification delivery interface
 class NotificationDelivery {
 public:
   virtual ~NotificationDelivery() = default;
   virtual bool deliver(const NotificationMessage &message) = 0;
+  // Delivers without waiting for the result; done(success) may run on
+  // another thread. The default delivers synchronously.
+  virtual void deliverAsync(const NotificationMessage &message,
+                            std::function<void(bool)> done) {
+    done(deliver(message));
+  }
   virtual NotificationMethod getMethod() const = 0;
   virtual bool isConfigured() const = 0;
 };
@@ -168,10 +191,16 @@ private:
                  const std::string &body);
 };
 
+// Posts notifications through a shared AsyncHttpClient, so a slow webhook
+// holds no thread and connections to it are reused
 class WebhookNotificationDelivery : public NotificationDelivery {
 public:
   explicit WebhookNotificationDelivery(const NotificationConfig &config);
+  WebhookNotificationDelivery(const NotificationConfig &config,
+                              std::shared_ptr<AsyncHttpClient> client);
   bool deliver(const NotificationMessage &message) override;
+  void deliverAsync(const NotificationMessage &message,
+                    std::function<void(bool)> done) override;
   NotificationMethod getMethod() const override {
     return NotificationMethod::WEBHOOK;
   }
@@ -179,7 +208,8 @@ public:
 
 private:
   NotificationConfig config_;
-  bool sendWebhook(const std::string &payload);
+  std::shared_ptr<AsyncHttpClient> client_;
+  void sendWebhook(const std::string &payload, std::function<void(bool)> done);
 };
 
 // Base NotificationService interface (matches existing interface in
@@ -204,7 +234,9 @@ public:
  * - Retry logic with exponential backoff
  * - Priority-based notification routing
  * - Configurable thresholds and settings
- * - Asynchronous notification processing
+ * - Asynchronous notification processing: a small pool of workers takes
+ *   the highest-priority notification as soon as it is queued, and failed
+ *   deliveries wait out their backoff on a timer wheel
  * - Resource monitoring and alerting
  */
 class NotificationServiceImpl : public NotificationService {
@@ -248,6 +280,10 @@ public:
   size_t getQueueSize() const;
   size_t getProcessedCount() const;
   size_t getFailedCount() const;
+  // From the start of delivery until the last delivery method reported back
+  std::chrono::microseconds getAverageDeliveryLatency() const;
+  std::chrono::microseconds getMaxDeliveryLatency() const;
+  NotificationStats getStats() const;
 
   // Resource monitoring (to be called by monitoring components)
   void checkMemoryUsage(double currentUsage);
@@ -272,17 +308,48 @@ private:
   notification_recovery::RetryConfig retryConfig_;
   notification_recovery::ServiceRecoveryState recoveryState_;
   notification_recovery::NotificationCircuitBreaker circuitBreaker_;
-  notification_recovery::RetryQueueManager retryManager_;
 
   // Statistics
   std::atomic<size_t> processedCount_;
   std::atomic<size_t> failedCount_;
-
-  // Notification queue and processing
-  std::queue<NotificationMessage> notificationQueue_;
+  std::atomic<uint64_t> latencySamples_{0};
+  std::atomic<uint64_t> totalLatencyUs_{0};
+  std::atomic<uint64_t> maxLatencyUs_{0};
+  // Ring of recent queue-to-delivery latencies for the percentiles
+  std::vector<uint32_t> queueLatencyUs_;
+  size_t queueLatencyNext_ = 0;
+  mutable std::mutex latencyMutex_;
+
+  // Deliveries whose outcome has not come back yet; stop() waits for them
+  size_t deliveriesInFlight_ = 0;
+  mutable std::mutex deliveryMutex_;
+  std::condition_variable deliveriesDone_;
+
+  // Notification queue and processing; notifications of equal priority
+  // keep their queueing order
+  struct QueuedNotification {
+    NotificationMessage message;
+    uint64_t sequence = 0;
+    std::chrono::steady_clock::time_point enqueued;
+  };
+  struct QueueOrder {
+    bool operator()(const QueuedNotification &a,
+                    const QueuedNotification &b) const {
+      if (a.message.priority != b.message.priority) {
+        return a.message.priority < b.message.priority;
+      }
+      return a.sequence > b.sequence;
+    }
+  };
+  std::priority_queue<QueuedNotification, std::vector<QueuedNotification>,
+                      QueueOrder>
+      notificationQueue_;
+  notification_recovery::RetryTimerWheel<NotificationMessage> retryWheel_;
+  uint64_t nextSequence_ = 0;
   mutable std::mutex queueMutex_;
   std::condition_variable queueCondition_;
-  std::thread processingThread_;
+  std::condition_variable retryCondition_;
+  std::vector<std::thread> deliveryWorkers_;
   std::thread retryThread_;
 
   // Recent notifications for debugging
@@ -300,13 +367,17 @@ private:
   // Private methods
   void processNotifications();
   void processRetries();
-  bool deliverNotification(const NotificationMessage &message);
+  void enqueueLocked(NotificationMessage message);
+  void dispatchNotification(QueuedNotification queued);
+  void deliverNotification(const NotificationMessage &message,
+                           std::function<void(bool)> done);
+  void recordDeliveryLatency(std::chrono::microseconds latency,
+                             std::chrono::microseconds queueLatency);
   void handleDeliveryFailure(const NotificationMessage &message,
                              const std::string &reason,
                              NotificationMethod failedMethod);
-  void scheduleRetry(const NotificationMessage &message,
-                     const std::string &reason,
-                     NotificationMethod failedMethod);
+  void scheduleRetry(NotificationMessage message);
+  std::chrono::milliseconds retryDelay(int retryCount) const;
   void addToRecentNotifications(const NotificationMessage &message);
   bool shouldSendResourceAlert(ResourceAlertType type);
   void recordResourceAlert(ResourceAlertType type);
@@ -1,14 +1,17 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <queue>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 // Forward declarations - actual definitions in notification_service.hpp
 enum class NotificationMethod;
@@ -299,4 +302,110 @@ private:
   std::queue<FailedNotification> retryQueue_;
 };
 
+/**
+ * @brief Hashed timer wheel holding retries until their backoff expires
+ *
+ * Each slot collects the entries due in one tick, so scheduling and expiry
+ * cost the same however many retries wait; entries more than one turn of
+ * the wheel away stay in their slot until their tick comes round. Not
+ * synchronized: the owner locks around every call.
+ */
+template <typename T> class RetryTimerWheel {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit RetryTimerWheel(
+      std::chrono::milliseconds tick = std::chrono::milliseconds(10),
+      size_t slots = 512)
+      : tick_(tick), start_(Clock::now()), slots_(slots) {}
+
+  // Due times are rounded up to the next tick
+  void schedule(T item, Clock::time_point due) {
+    const uint64_t tick = std::max(tickAt(due, true), current_ + 1);
+    slots_[tick % slots_.size()].push_back({tick, std::move(item)});
+    size_++;
+  }
+
+  // Moves every entry due by now into out
+  void advance(Clock::time_point now, std::vector<T> &out) {
+    const uint64_t target = tickAt(now, false);
+    if (target <= current_) {
+      return;
+    }
+    // After a long gap every slot is visited once
+    const uint64_t steps =
+        std::min<uint64_t>(target - current_, slots_.size());
+    for (uint64_t step = 1; step <= steps; ++step) {
+      auto &slot = slots_[(current_ + step) % slots_.size()];
+      for (size_t i = 0; i < slot.size();) {
+        if (slot[i].tick <= target) {
+          out.push_back(std::move(slot[i].item));
+          slot[i] = std::move(slot.back());
+          slot.pop_back();
+          size_--;
+        } else {
+          ++i;
+        }
+      }
+    }
+    current_ = target;
+  }
+
+  // When advance() next has something to return; time_point::max() when
+  // the wheel is empty
+  Clock::time_point nextDue() const {
+    if (size_ == 0) {
+      return Clock::time_point::max();
+    }
+    for (uint64_t tick = current_ + 1; tick <= current_ + slots_.size();
+         ++tick) {
+      for (const auto &entry : slots_[tick % slots_.size()]) {
+        if (entry.tick == tick) {
+          return timeOf(tick);
+        }
+      }
+    }
+    // Nothing due this turn of the wheel
+    return timeOf(current_ + slots_.size());
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void clear() {
+    for (auto &slot : slots_) {
+      slot.clear();
+    }
+    size_ = 0;
+  }
+
+private:
+  struct Entry {
+    uint64_t tick;
+    T item;
+  };
+
+  uint64_t tickAt(Clock::time_point time, bool roundUp) const {
+    if (time <= start_) {
+      return 0;
+    }
+    const auto elapsed = time - start_;
+    uint64_t tick = static_cast<uint64_t>(elapsed / tick_);
+    if (roundUp && elapsed % tick_ != Clock::duration::zero()) {
+      tick++;
+    }
+    return tick;
+  }
+
+  Clock::time_point timeOf(uint64_t tick) const {
+    return start_ + tick_ * static_cast<int64_t>(tick);
+  }
+
+  const std::chrono::milliseconds tick_;
+  const Clock::time_point start_;
+  std::vector<std::vector<Entry>> slots_;
+  uint64_t current_ = 0; // last tick advance() has passed
+  size_t size_ = 0;
+};
+
 } // namespace notification_recovery
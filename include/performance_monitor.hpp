@@ -35,6 +35,12 @@ public:
     std::atomic<size_t> activeRequests{0};
     std::atomic<double> averageResponseTime{0.0};
 
+    // Handler executor metrics (milliseconds). Queue wait is the time a
+    // request waited for a handler thread; handler time excludes it.
+    std::atomic<double> averageQueueWaitTime{0.0};
+    std::atomic<double> averageHandlerTime{0.0};
+    std::atomic<size_t> rejectedRequests{0};
+
     // Connection metrics
     std::atomic<size_t> connectionReuses{0};
     std::atomic<size_t> totalConnections{0};
@@ -62,6 +68,9 @@ public:
         : totalRequests(other.totalRequests.load()),
           activeRequests(other.activeRequests.load()),
           averageResponseTime(other.averageResponseTime.load()),
+          averageQueueWaitTime(other.averageQueueWaitTime.load()),
+          averageHandlerTime(other.averageHandlerTime.load()),
+          rejectedRequests(other.rejectedRequests.load()),
           connectionReuses(other.connectionReuses.load()),
           totalConnections(other.totalConnections.load()),
           connectionTimeouts(other.connectionTimeouts.load()),
@@ -78,6 +87,9 @@ public:
         totalRequests.store(other.totalRequests.load());
         activeRequests.store(other.activeRequests.load());
         averageResponseTime.store(other.averageResponseTime.load());
+        averageQueueWaitTime.store(other.averageQueueWaitTime.load());
+        averageHandlerTime.store(other.averageHandlerTime.load());
+        rejectedRequests.store(other.rejectedRequests.load());
         connectionReuses.store(other.connectionReuses.load());
         totalConnections.store(other.totalConnections.load());
         connectionTimeouts.store(other.connectionTimeouts.load());
@@ -124,7 +136,7 @@ public:
     metrics_.activeRequests.fetch_sub(1, std::memory_order_relaxed);
 
     // Update average response time using thread-safe approach
-    updateAverageResponseTime(duration.count());
+    updateAverage(metrics_.averageResponseTime, duration.count());
 
     // Store individual response time for detailed analysis
     {
@@ -141,6 +153,29 @@ public:
     }
   }
 
+  /**
+   * @brief Record how long a request waited for a handler thread
+   * @param wait Time between admission to the executor and handler start
+   */
+  void recordQueueWait(std::chrono::microseconds wait) {
+    updateAverage(metrics_.averageQueueWaitTime, wait.count() / 1000.0);
+  }
+
+  /**
+   * @brief Record how long the request handler itself ran
+   * @param duration Handler run time, excluding queue wait and the write
+   */
+  void recordHandlerTime(std::chrono::microseconds duration) {
+    updateAverage(metrics_.averageHandlerTime, duration.count() / 1000.0);
+  }
+
+  /**
+   * @brief Record a request turned away because the executor was full
+   */
+  void recordRejectedRequest() {
+    metrics_.rejectedRequests.fetch_add(1, std::memory_order_relaxed);
+  }
+
   /**
    * @brief Record a connection reuse event
    * Thread-safe operation for tracking connection pool efficiency
@@ -208,6 +243,9 @@ public:
     metrics_.totalRequests.store(0, std::memory_order_relaxed);
     metrics_.activeRequests.store(0, std::memory_order_relaxed);
     metrics_.averageResponseTime.store(0.0, std::memory_order_relaxed);
+    metrics_.averageQueueWaitTime.store(0.0, std::memory_order_relaxed);
+    metrics_.averageHandlerTime.store(0.0, std::memory_order_relaxed);
+    metrics_.rejectedRequests.store(0, std::memory_order_relaxed);
     metrics_.connectionReuses.store(0, std::memory_order_relaxed);
     metrics_.totalConnections.store(0, std::memory_order_relaxed);
     metrics_.connectionTimeouts.store(0, std::memory_order_relaxed);
@@ -268,6 +306,12 @@ public:
     json << "  \"activeRequests\": " << metrics.activeRequests.load() << ",\n";
     json << "  \"averageResponseTime\": " << metrics.averageResponseTime.load()
          << ",\n";
+    json << "  \"averageQueueWaitTime\": "
+         << metrics.averageQueueWaitTime.load() << ",\n";
+    json << "  \"averageHandlerTime\": " << metrics.averageHandlerTime.load()
+         << ",\n";
+    json << "  \"rejectedRequests\": " << metrics.rejectedRequests.load()
+         << ",\n";
     json << "  \"connectionReuses\": " << metrics.connectionReuses.load()
          << ",\n";
     json << "  \"totalConnections\": " << metrics.totalConnections.load()
@@ -314,6 +358,24 @@ public:
     prometheus << "http_request_duration_ms "
                << metrics.averageResponseTime.load() << "\n\n";
 
+    prometheus << "# HELP http_request_queue_wait_ms Average time requests "
+                  "waited for a handler thread in milliseconds\n";
+    prometheus << "# TYPE http_request_queue_wait_ms gauge\n";
+    prometheus << "http_request_queue_wait_ms "
+               << metrics.averageQueueWaitTime.load() << "\n\n";
+
+    prometheus << "# HELP http_request_handler_duration_ms Average request "
+                  "handler run time in milliseconds\n";
+    prometheus << "# TYPE http_request_handler_duration_ms gauge\n";
+    prometheus << "http_request_handler_duration_ms "
+               << metrics.averageHandlerTime.load() << "\n\n";
+
+    prometheus << "# HELP http_requests_rejected_total Total number of "
+                  "requests rejected because the handler queue was full\n";
+    prometheus << "# TYPE http_requests_rejected_total counter\n";
+    prometheus << "http_requests_rejected_total "
+               << metrics.rejectedRequests.load() << "\n\n";
+
     prometheus << "# HELP http_connections_reused_total Total number of "
                   "connection reuses\n";
     prometheus << "# TYPE http_connections_reused_total counter\n";
@@ -371,33 +433,33 @@ private:
   std::vector<std::chrono::milliseconds> responseTimes_;
 
   /**
-   * @brief Update average response time using exponential moving average
-   * @param newResponseTime New response time in milliseconds
-   * Thread-safe helper method for maintaining running average
+   * @brief Update a running average using exponential moving average
+   * @param average The metric to update
+   * @param newValue New sample in milliseconds
+   * Thread-safe helper method for maintaining running averages
    */
-  void updateAverageResponseTime(double newResponseTime) {
+  static void updateAverage(std::atomic<double> &average, double newValue) {
     // Use exponential moving average with alpha = 0.1 for smooth updates
     constexpr double alpha = 0.1;
 
-    double currentAvg =
-        metrics_.averageResponseTime.load(std::memory_order_relaxed);
+    double currentAvg = average.load(std::memory_order_relaxed);
     double newAvg;
 
     // Handle first measurement
     if (currentAvg == 0.0) {
-      newAvg = newResponseTime;
+      newAvg = newValue;
     } else {
-      newAvg = alpha * newResponseTime + (1.0 - alpha) * currentAvg;
+      newAvg = alpha * newValue + (1.0 - alpha) * currentAvg;
     }
 
     // Atomic update with compare-and-swap loop for thread safety
-    while (!metrics_.averageResponseTime.compare_exchange_weak(
-        currentAvg, newAvg, std::memory_order_relaxed)) {
+    while (!average.compare_exchange_weak(currentAvg, newAvg,
+                                          std::memory_order_relaxed)) {
       // Recalculate with updated current average
       if (currentAvg == 0.0) {
-        newAvg = newResponseTime;
+        newAvg = newValue;
       } else {
-        newAvg = alpha * newResponseTime + (1.0 - alpha) * currentAvg;
+        newAvg = alpha * newValue + (1.0 - alpha) * currentAvg;
       }
     }
   }
@@ -7,7 +7,9 @@
 #include <boost/beast/version.hpp>
 #include <boost/beast/websocket.hpp>
 #include <boost/config.hpp>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -20,6 +22,7 @@ class RequestHandler;
 class WebSocketManager;
 class TimeoutManager;
 class PerformanceMonitor;
+class RequestExecutor;
 
 /**
  * PooledSession extends the basic Session functionality with connection pooling
@@ -35,12 +38,15 @@ public:
    * @param wsManager WebSocket manager for handling WebSocket upgrades
    * @param timeoutManager Timeout manager for connection and request timeouts
    * @param performanceMonitor Performance monitor for metrics collection
+   * @param executor Executor that runs the request handler off the I/O
+   * thread; when null the handler runs inline
    */
   PooledSession(
       tcp::socket &&socket, std::shared_ptr<RequestHandler> handler,
       std::shared_ptr<WebSocketManager> wsManager,
       std::shared_ptr<TimeoutManager> timeoutManager,
-      std::shared_ptr<PerformanceMonitor> performanceMonitor = nullptr);
+      std::shared_ptr<PerformanceMonitor> performanceMonitor = nullptr,
+      std::shared_ptr<RequestExecutor> executor = nullptr);
 
   /**
    * Destructor - ensures proper cleanup
@@ -106,6 +112,7 @@ private:
   std::shared_ptr<WebSocketManager> wsManager_;
   std::shared_ptr<TimeoutManager> timeoutManager_;
   std::shared_ptr<PerformanceMonitor> performanceMonitor_;
+  std::shared_ptr<RequestExecutor> executor_;
 
   // Pooling and state management
   std::chrono::steady_clock::time_point lastActivity_;
@@ -113,9 +120,17 @@ private:
   bool isIdle_;
   bool processingRequest_;
 
+  // Offloaded handlers finish after a 408 may already have been sent; the
+  // sequence lets their late response be dropped
+  std::atomic<uint64_t> requestSequence_{0};
+  std::atomic<uint64_t> timedOutRequest_{0};
+
   // Session lifecycle methods
   void doRead();
   void onRead(beast::error_code ec, std::size_t bytes_transferred);
+  void dispatchToExecutor();
+  http::response<http::string_body>
+  runHandler(http::request<http::string_body> &&req);
   void sendResponse(http::response<http::string_body> &&msg);
   void onWrite(bool close, beast::error_code ec, std::size_t bytes_transferred);
   void doClose();
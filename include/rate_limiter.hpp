@@ -1,10 +1,14 @@
 #pragma once
 
+#include "http_router.hpp"
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 struct RateLimitRule {
@@ -20,15 +24,34 @@ struct RateLimitInfo {
   int limit;     // Request limit for the minute window
 };
 
+struct RateLimiterConfig {
+  // Buckets for (client, rule) pairs; rounded up to a power of two. This is
+  // the limiter's whole memory footprint, whatever the number of clients.
+  size_t slotCount = 65536;
+};
+
+/**
+ * Per-client rate limiting with one GCRA ("virtual scheduling" token
+ * bucket) per (client, rule) pair and window. Each bucket is a single
+ * atomic theoretical arrival time, so isAllowed() is a couple of
+ * compare-and-swaps on the caller's own slot and never takes a lock.
+ *
+ * Buckets live in a fixed open-addressed table indexed by a hash of the
+ * client and rule. A bucket that has fully refilled is indistinguishable
+ * from a fresh one, so its slot can be handed to another client without
+ * resetting it. If every slot near a client's home slot is busy, the
+ * client shares the home bucket, which only makes limiting stricter. A
+ * shared bucket is not cleared by resetClient() until it is reclaimed.
+ */
 class RateLimiter {
 public:
   RateLimiter();
+  explicit RateLimiter(RateLimiterConfig config);
   /**
    * @brief Default destructor.
    *
-   * Performs normal destruction of the RateLimiter instance. As the class
-   * manages no RAII resources that require custom teardown beyond member
-   * destructors, the default destructor is sufficient.
+   * Performs normal destruction of the RateLimiter instance. Retired rule
+   * sets and the bucket table are released by their owning members.
    */
   ~RateLimiter() = default;
 
@@ -37,24 +60,25 @@ public:
    * instances.
    *
    * Making the class non-copyable avoids accidental duplication of internal
-   * state (including mutexes and client tracking), ensuring a single
-   * authoritative instance.
+   * state (the bucket slot table and the published rule sets), ensuring a
+   * single authoritative instance.
    */
   RateLimiter(const RateLimiter &) = delete;
   /**
    * @brief Deleted copy-assignment operator to prevent copying.
    *
    * The copy-assignment operator is explicitly deleted to make RateLimiter
-   * non-copyable. This ensures internal state (client counters, rules, mutex)
+   * non-copyable. This ensures internal state (bucket slots, rule sets)
    * cannot be duplicated.
    */
   RateLimiter &operator=(const RateLimiter &) = delete;
   /**
    * @brief Deleted move constructor; RateLimiter instances cannot be moved.
    *
-   * Prevents transfer of internal state (mutexes, client counters, rules) by
-   * disabling move semantics. Use the default-constructed instance and explicit
-   * initialization methods rather than moving.
+   * Prevents transfer of internal state (the slot table and rule sets that
+   * lock-free readers may be using) by disabling move semantics. Use the
+   * default-constructed instance and explicit initialization methods rather
+   * than moving.
    */
   RateLimiter(RateLimiter &&) = delete;
   /**
@@ -68,37 +92,80 @@ public:
   // Initialize with default rules
   void initializeDefaultRules();
 
-  // Add custom rate limit rule
+  // Add custom rate limit rule, replacing any rule for the same endpoint.
+  // Meant for setup: each call that changes the rules publishes a new rule
+  // set and keeps the old one until destruction, since lock-free readers
+  // may still hold it, so memory grows with every such call.
   void addRule(const RateLimitRule &rule);
 
-  // Check if request is allowed
-  bool isAllowed(const std::string &clientId, const std::string &endpoint);
+  // Check if request is allowed. The query string of `endpoint`, if any, is
+  // ignored.
+  bool isAllowed(std::string_view clientId, std::string_view endpoint);
 
   // Get rate limit info for client
-  RateLimitInfo getRateLimitInfo(const std::string &clientId,
-                                 const std::string &endpoint);
+  RateLimitInfo getRateLimitInfo(std::string_view clientId,
+                                 std::string_view endpoint) const;
 
-  // Reset rate limits for a client
-  void resetClient(const std::string &clientId);
+  // Reset rate limits for a client. Only buckets the client owns are
+  // cleared: one it shares with other clients (the table was full around
+  // its home slot) is left to refill, as clearing it would lift their
+  // limits too.
+  void resetClient(std::string_view clientId);
 
-  // Clean up expired entries
-  // This method should be called periodically (e.g., every hour) by a
-  // background task to remove stale client data and prevent memory leaks
+  // Frees the slots of buckets that have fully refilled. Optional: such
+  // slots are reclaimed on demand anyway.
   void cleanupExpiredEntries();
 
 private:
-  struct ClientData {
-    std::unordered_map<std::string, int> minuteCounters;
-    std::unordered_map<std::string, int> hourCounters;
+  // Immutable once published; replaced wholesale by addRule()
+  struct RuleSet {
+    std::vector<RateLimitRule> rules;
+    std::vector<uint64_t> ruleHashes; // hash of rules[i].endpoint
+    RadixRouter<size_t> router;       // endpoint prefix -> rule index
+  };
+
+  // GCRA parameters for one window, in microseconds
+  struct Window {
+    int64_t interval; // emission interval: window / limit
+    int64_t burst;    // tolerance: window - interval
   };
 
-  std::unordered_map<std::string, ClientData> clientData_;
-  std::vector<RateLimitRule> rules_;
-  mutable std::mutex mutex_;
+  struct Slot {
+    std::atomic<uint64_t> key{0}; // 0 marks a never-used slot
+    std::atomic<int64_t> minuteTat{0};
+    std::atomic<int64_t> hourTat{0};
+    // Set once a client other than `key` falls back to this bucket
+    std::atomic<bool> shared{false};
+  };
+
+  static constexpr size_t kMaxProbe = 8;
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t slotMask_;
+
+  std::atomic<const RuleSet *> rules_{nullptr};
+  std::vector<std::unique_ptr<RuleSet>> ruleSets_; // current and retired
+  std::mutex rulesMutex_;                           // serialises writers
+
+  void publishRules(std::vector<RateLimitRule> rules);
+
+  // Index of the rule for the longest matching endpoint prefix
+  static std::optional<size_t> findRule(const RuleSet &set,
+                                        std::string_view endpoint);
+
+  static uint64_t slotKey(std::string_view clientId, uint64_t ruleHash);
+
+  // Slot for `key`, claiming a free or refilled one if it has none yet
+  Slot &slotFor(uint64_t key, int64_t now);
+  Slot *findSlot(uint64_t key) const;
+
+  static Window minuteWindow(const RateLimitRule &rule);
+  static Window hourWindow(const RateLimitRule &rule);
 
-  // Get rule for endpoint
-  const RateLimitRule *getRuleForEndpoint(const std::string &endpoint) const;
+  static bool tryConsume(std::atomic<int64_t> &tat, int64_t now,
+                         Window window);
+  static int remaining(int64_t tat, int64_t now, Window window, int limit);
 
-  // Get current minute/hour window
-  std::pair<int64_t, int64_t> getCurrentWindows() const;
+  // Microseconds on the steady clock
+  static int64_t nowMicros();
 };
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "transparent_string_hash.hpp"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct DataRecord;
+
+enum class ColumnType { INT64, DOUBLE, STRING };
+
+// Formats doubles without trailing zeros (the text form used by transforms)
+std::string formatNumericValue(double value);
+
+class Column;
+
+// PostgreSQL COPY text format: tab-separated, backslash escapes, \N for NULL.
+// A null entry in sources (a column the batch lacks) is written as NULL.
+void appendCopyText(std::string &line, std::string_view value);
+void formatCopyRow(std::string &line,
+                   const std::vector<const Column *> &sources, size_t row);
+
+struct FieldDescriptor {
+  std::string name;
+  ColumnType type = ColumnType::STRING;
+};
+
+/**
+ * Immutable description of the columns in a RecordBatch. Shared between
+ * batches produced from the same source so the field lookup table is built
+ * only once per extract, not once per row.
+ */
+class BatchSchema {
+public:
+  BatchSchema() = default;
+  explicit BatchSchema(std::vector<FieldDescriptor> fields);
+
+  size_t fieldCount() const { return fields_.size(); }
+  const FieldDescriptor &field(size_t index) const { return fields_[index]; }
+  const std::vector<FieldDescriptor> &fields() const { return fields_; }
+
+  std::optional<size_t> fieldIndex(std::string_view name) const;
+
+  // Returns a new schema with the field appended or its type replaced
+  std::shared_ptr<const BatchSchema>
+  withField(const FieldDescriptor &field) const;
+
+private:
+  std::vector<FieldDescriptor> fields_;
+  std::unordered_map<std::string, size_t, TransparentStringHash,
+                     std::equal_to<>>
+      index_;
+};
+
+/**
+ * A single typed column. Fixed-width values live in contiguous vectors;
+ * strings are stored Arrow-style as one character buffer plus an offsets
+ * array of size() + 1 entries. Nulls are tracked in a bitmap, one bit per row.
+ */
+class Column {
+public:
+  explicit Column(ColumnType type = ColumnType::STRING) : type_(type) {
+    if (type_ == ColumnType::STRING) {
+      offsets_.push_back(0);
+    }
+  }
+
+  ColumnType type() const { return type_; }
+  size_t size() const { return size_; }
+  size_t nullCount() const { return nullCount_; }
+
+  void reserve(size_t rows, size_t stringBytes = 0);
+
+  void appendInt64(int64_t value);
+  void appendDouble(double value);
+  void appendString(std::string_view value);
+  void appendNull();
+  // Appends row `row` of `other`, converting to text if the types differ
+  void appendFrom(const Column &other, size_t row);
+
+  bool isNull(size_t row) const {
+    return (nulls_[row >> 6] >> (row & 63)) & 1u;
+  }
+  int64_t int64At(size_t row) const { return int64Values_[row]; }
+  double doubleAt(size_t row) const { return doubleValues_[row]; }
+  std::string_view stringAt(size_t row) const {
+    return std::string_view(stringData_).substr(
+        offsets_[row], offsets_[row + 1] - offsets_[row]);
+  }
+
+  // Text rendering compatible with DataTransformer's row-based output
+  std::string valueAsString(size_t row) const;
+
+  // Raw buffers for column-at-a-time kernels
+  std::string &stringData() { return stringData_; }
+  const std::string &stringData() const { return stringData_; }
+  const std::vector<uint32_t> &stringOffsets() const { return offsets_; }
+  std::vector<double> &doubleValues() { return doubleValues_; }
+  const std::vector<double> &doubleValues() const { return doubleValues_; }
+  const std::vector<int64_t> &int64Values() const { return int64Values_; }
+
+private:
+  ColumnType type_;
+  size_t size_ = 0;
+  size_t nullCount_ = 0;
+  std::vector<uint64_t> nulls_;
+  std::vector<int64_t> int64Values_;
+  std::vector<double> doubleValues_;
+  std::vector<uint32_t> offsets_;
+  std::string stringData_;
+
+  void pushNullBit(bool isNull);
+};
+
+/**
+ * Columnar batch of records used by the bulk transform path. Replaces the
+ * map-per-row DataRecord representation: a batch of N rows with F fields costs
+ * O(F) allocations instead of O(N * F).
+ */
+class RecordBatch {
+public:
+  RecordBatch();
+  RecordBatch(std::shared_ptr<const BatchSchema> schema,
+              std::vector<Column> columns);
+
+  // Adapters to and from the row-based representation
+  static RecordBatch fromRecords(const std::vector<DataRecord> &records);
+  static RecordBatch
+  fromRecords(const std::vector<DataRecord> &records,
+              std::shared_ptr<const BatchSchema> schema);
+  std::vector<DataRecord> toRecords() const;
+
+  size_t numRows() const { return numRows_; }
+  size_t numColumns() const { return columns_.size(); }
+  const std::shared_ptr<const BatchSchema> &schema() const { return schema_; }
+
+  const Column &column(size_t index) const { return columns_[index]; }
+  Column &column(size_t index) { return columns_[index]; }
+  const Column *column(std::string_view name) const;
+
+  // Adds a column or replaces an existing one with the same name
+  void setColumn(const FieldDescriptor &field, Column column);
+
+private:
+  std::shared_ptr<const BatchSchema> schema_;
+  std::vector<Column> columns_;
+  size_t numRows_ = 0;
+};
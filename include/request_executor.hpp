@@ -0,0 +1,93 @@
+#pragma once
+
+#include "transparent_string_hash.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct RequestExecutorConfig {
+  size_t workerCount = 8;
+  size_t maxQueueSize = 256; // waiting requests across all routes
+  size_t maxQueuePerRoute = 64;
+  // Per-route overrides of maxQueuePerRoute, keyed by routeKey()
+  std::unordered_map<std::string, size_t> routeQueueLimits;
+};
+
+struct RequestExecutorStats {
+  size_t queued = 0;
+  size_t running = 0;
+  uint64_t completed = 0;
+  uint64_t rejected = 0;
+  std::chrono::microseconds averageQueueWait{0};
+  std::chrono::microseconds maxQueueWait{0};
+};
+
+/**
+ * Bounded thread pool for HTTP handlers that block (database, auth, job
+ * manager). Sessions hand requests over here so the Beast I/O threads keep
+ * serving other connections while a handler waits.
+ *
+ * Admission is bounded twice: by the total queue size and by a per-route
+ * limit, so one slow endpoint cannot fill the queue and starve the others.
+ * A rejected submit() is the caller's signal to answer 503 immediately.
+ */
+class RequestExecutor {
+public:
+  // Called on a worker with the time the task spent queued
+  using Task = std::function<void(std::chrono::microseconds queueWait)>;
+
+  explicit RequestExecutor(RequestExecutorConfig config = {});
+  ~RequestExecutor();
+
+  RequestExecutor(const RequestExecutor &) = delete;
+  RequestExecutor &operator=(const RequestExecutor &) = delete;
+
+  // Returns false if the route's or the global queue is full, or after
+  // shutdown()
+  bool submit(std::string_view route, Task task);
+
+  // Stops admission, runs the tasks already queued and joins the workers
+  void shutdown();
+
+  // Route used for queue limits: the first two path segments, e.g.
+  // "/api/jobs/42/status?x=1" -> "/api/jobs"
+  static std::string routeKey(std::string_view target);
+
+  size_t routeQueueDepth(std::string_view route) const;
+  RequestExecutorStats getStats() const;
+
+private:
+  struct Entry {
+    std::string route;
+    Task task;
+    std::chrono::steady_clock::time_point enqueuedAt;
+  };
+
+  const RequestExecutorConfig config_;
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<Entry> queue_;
+  std::unordered_map<std::string, size_t, TransparentStringHash,
+                     std::equal_to<>>
+      queuedByRoute_;
+  std::vector<std::thread> workers_;
+  bool stopping_ = false;
+
+  size_t running_ = 0;
+  uint64_t completed_ = 0;
+  uint64_t rejected_ = 0;
+  std::chrono::microseconds totalQueueWait_{0};
+  std::chrono::microseconds maxQueueWait_{0};
+
+  size_t routeLimit(std::string_view route) const;
+  void workerLoop();
+};
@@ -4,14 +4,15 @@
 #include "etl_job_manager.hpp"
 #include "exception_mapper.hpp"
 #include "hana_exception_handling.hpp"
+#include "http_router.hpp"
 #include "input_validator.hpp"
 #include "job_monitoring_models.hpp"
 #include "logger.hpp"
 #include "rate_limiter.hpp"
-#include "transparent_string_hash.hpp"
 #include "websocket_manager.hpp"
 #include <boost/beast/http.hpp>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <optional>
@@ -92,6 +93,31 @@ private:
   // Common initialization helper
   void initCommon();
 
+  // Endpoints the route table dispatches to
+  enum class Endpoint : uint8_t {
+    Auth,
+    Logs,
+    Jobs,
+    JobById,
+    JobStatus,
+    JobMetrics,
+    Monitor,
+    Health
+  };
+
+  // What a handler sees of a request. Path, query and route parameters are
+  // views into the request, which must outlive the context.
+  struct RequestContext {
+    const http::request<http::string_body> &req;
+    Endpoint endpoint;
+    std::string_view path;
+    QueryView query;
+    RouteParams params;
+  };
+
+  // Built from a static table on first use and shared by all handlers
+  static const RadixRouter<Endpoint> &routes();
+
   // JWT validation middleware
 #ifdef ETL_ENABLE_JWT
   std::optional<std::string>
@@ -107,38 +133,32 @@ private:
                            const std::string &clientId,
                            const std::string &endpoint);
 
+  // Rate-limit headers and exception mapping around validateAndHandleRequest
+  http::response<http::string_body>
+  processRequest(const http::request<http::string_body> &req);
+
   // Enhanced validation methods
   http::response<http::string_body>
   validateAndHandleRequest(const http::request<http::string_body> &req) const;
   InputValidator::ValidationResult
-  validateRequestBasics(const http::request<http::string_body> &req) const;
-  std::unordered_map<std::string, std::string, TransparentStringHash,
-                     std::equal_to<>>
-  extractHeaders(const http::request<http::string_body> &req) const;
-  std::unordered_map<std::string, std::string, TransparentStringHash,
-                     std::equal_to<>>
-  extractQueryParams(std::string_view target) const;
+  validateRequestBasics(const http::request<http::string_body> &req,
+                        std::string_view path, std::string_view query) const;
 
   // Request handlers with validation
+  http::response<http::string_body> handleAuth(const RequestContext &ctx) const;
+  http::response<http::string_body> handleLogs(const RequestContext &ctx) const;
   http::response<http::string_body>
-  handleAuth(const http::request<http::string_body> &req) const;
-  http::response<http::string_body>
-  handleLogs(const http::request<http::string_body> &req) const;
-  http::response<http::string_body>
-  handleETLJobs(const http::request<http::string_body> &req) const;
+  handleETLJobs(const RequestContext &ctx) const;
   http::response<http::string_body>
-  handleMonitoring(const http::request<http::string_body> &req) const;
+  handleMonitoring(const RequestContext &ctx) const;
   http::response<http::string_body>
-  handleHealth(const http::request<http::string_body> &req) const;
+  handleHealth(const RequestContext &ctx) const;
 
   // Response creation methods
   http::response<http::string_body>
   createSuccessResponse(std::string_view data, unsigned int version) const;
 
   // Utility methods for job monitoring endpoints
-  std::string extractJobIdFromPath(std::string_view target,
-                                   std::string_view prefix,
-                                   std::string_view suffix) const;
   std::string jobStatusToString(JobStatus status) const;
   JobStatus stringToJobStatus(std::string_view statusStr) const;
   std::string jobTypeToString(JobType type) const;
@@ -33,6 +33,11 @@ struct ServerConfig {
   std::chrono::seconds maxQueueWaitTime{
       30}; // Maximum time a request can wait in queue
 
+  // Handler Executor Settings (blocking handlers run off the I/O threads)
+  size_t handlerThreads = 8; // 0 runs handlers inline on the I/O thread
+  size_t handlerQueueSize = 256;     // Requests waiting for a handler thread
+  size_t handlerRouteQueueSize = 64; // Requests waiting per route
+
   // Validation and default value handling
   struct ValidationResult {
     bool isValid = true;
@@ -130,6 +135,20 @@ struct ServerConfig {
                         "s), clients may timeout");
     }
 
+    // Validate handler executor settings
+    if (handlerThreads > 0 && handlerQueueSize == 0) {
+      result.addError("handlerQueueSize must be greater than 0");
+    }
+
+    if (handlerThreads > 0 && handlerRouteQueueSize == 0) {
+      result.addError("handlerRouteQueueSize must be greater than 0");
+    }
+
+    if (handlerRouteQueueSize > handlerQueueSize) {
+      result.addWarning("handlerRouteQueueSize is greater than "
+                        "handlerQueueSize, so one route can fill the queue");
+    }
+
     return result;
   }
 
@@ -177,6 +196,15 @@ struct ServerConfig {
     if (maxQueueWaitTime.count() <= 0) {
       maxQueueWaitTime = std::chrono::seconds{30};
     }
+
+    // Apply defaults for handler executor settings
+    if (handlerQueueSize == 0) {
+      handlerQueueSize = 256;
+    }
+
+    if (handlerRouteQueueSize == 0) {
+      handlerRouteQueueSize = 64;
+    }
   }
 
   /**
@@ -225,7 +253,10 @@ struct ServerConfig {
            maxRequestBodySize == other.maxRequestBodySize &&
            enableMetrics == other.enableMetrics &&
            maxQueueSize == other.maxQueueSize &&
-           maxQueueWaitTime == other.maxQueueWaitTime;
+           maxQueueWaitTime == other.maxQueueWaitTime &&
+           handlerThreads == other.handlerThreads &&
+           handlerQueueSize == other.handlerQueueSize &&
+           handlerRouteQueueSize == other.handlerRouteQueueSize;
   }
 
   /**
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace etl {
+namespace string_kernels {
+
+/**
+ * ASCII string kernels used by the transform and log search paths. Case
+ * mapping only touches bytes 'a'-'z' / 'A'-'Z' and leaves every other byte
+ * (including UTF-8 continuation bytes) unchanged, so results do not depend
+ * on the process locale. The widest instruction set supported by the CPU is picked once at
+ * runtime; a scalar fallback is always available.
+ */
+enum class SimdLevel { SCALAR, SSE2, AVX2 };
+
+// Widest level supported by the running CPU (detected once, then cached)
+SimdLevel detectedSimdLevel() noexcept;
+const char *simdLevelName(SimdLevel level) noexcept;
+
+// In-place case mapping using the detected level
+void asciiToUpper(char *data, std::size_t length) noexcept;
+void asciiToLower(char *data, std::size_t length) noexcept;
+
+// Explicit-level variants for tests and benchmarks. A level the CPU does not
+// support falls back to the widest supported one.
+void asciiToUpper(char *data, std::size_t length, SimdLevel level) noexcept;
+void asciiToLower(char *data, std::size_t length, SimdLevel level) noexcept;
+
+// Strips leading/trailing ' ', '\t', '\n' and '\r'
+std::string_view trimAsciiWhitespace(std::string_view value) noexcept;
+std::string_view trimAsciiWhitespace(std::string_view value,
+                                     SimdLevel level) noexcept;
+
+// Position of the first occurrence of needle, or std::string_view::npos;
+// the same result as haystack.find(needle)
+std::size_t findSubstring(std::string_view haystack,
+                          std::string_view needle) noexcept;
+std::size_t findSubstring(std::string_view haystack, std::string_view needle,
+                          SimdLevel level) noexcept;
+
+// Number of occurrences of byte in data
+std::size_t countByte(std::string_view data, char byte) noexcept;
+std::size_t countByte(std::string_view data, char byte,
+                      SimdLevel level) noexcept;
+
+} // namespace string_kernels
+} // namespace etl
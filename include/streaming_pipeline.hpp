@@ -0,0 +1,117 @@
+#pragma once
+
+#include "bounded_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+/**
+ * Runs extract, transform and load as three concurrent stages joined by
+ * BoundedQueues: extract and transform on their own threads, load on the
+ * caller's. The queues' capacity bounds how far a fast stage runs ahead.
+ *
+ * Whenever a stage stops early, because it threw or because stopRequested()
+ * turned true, both queues are cancelled so no stage stays blocked on a
+ * queue nobody drains any more. run() rethrows the first stage's error.
+ */
+template <typename Batch> class StreamingPipeline {
+public:
+  // Returns the next batch, or std::nullopt when the source is exhausted
+  using Extract = std::function<std::optional<Batch>()>;
+  using Transform = std::function<Batch(Batch)>;
+  using Load = std::function<void(Batch)>;
+
+  StreamingPipeline(size_t queueCapacity, std::function<bool()> stopRequested)
+      : extracted_(queueCapacity), transformed_(queueCapacity),
+        stopRequested_(std::move(stopRequested)) {}
+
+  void run(const Extract &extract, const Transform &transform,
+           const Load &load) {
+    std::thread extractThread([&] {
+      try {
+        while (!stopped()) {
+          std::optional<Batch> batch = extract();
+          if (!batch || !extracted_.push(std::move(*batch))) {
+            break;
+          }
+        }
+        extracted_.close();
+      } catch (...) {
+        fail(std::current_exception());
+      }
+    });
+
+    std::thread transformThread([&] {
+      try {
+        while (auto batch = extracted_.pop()) {
+          if (stopped()) {
+            cancel();
+            break;
+          }
+          if (!transformed_.push(transform(std::move(*batch)))) {
+            break;
+          }
+        }
+        transformed_.close();
+      } catch (...) {
+        fail(std::current_exception());
+      }
+    });
+
+    try {
+      while (auto batch = transformed_.pop()) {
+        if (stopped()) {
+          cancel();
+          break;
+        }
+        load(std::move(*batch));
+      }
+    } catch (...) {
+      fail(std::current_exception());
+    }
+
+    extractThread.join();
+    transformThread.join();
+    if (firstError_) {
+      std::rethrow_exception(firstError_);
+    }
+  }
+
+  // Time extract and transform spent blocked on a full queue
+  std::chrono::nanoseconds extractBlocked() const {
+    return extracted_.producerWaitTime();
+  }
+  std::chrono::nanoseconds transformBlocked() const {
+    return transformed_.producerWaitTime();
+  }
+
+private:
+  bool stopped() const { return aborted_.load() || stopRequested_(); }
+
+  void cancel() {
+    extracted_.cancel();
+    transformed_.cancel();
+  }
+
+  void fail(std::exception_ptr error) {
+    {
+      std::lock_guard<std::mutex> lock(errorMutex_);
+      if (!firstError_) {
+        firstError_ = error;
+      }
+    }
+    aborted_ = true;
+    cancel();
+  }
+
+  BoundedQueue<Batch> extracted_;
+  BoundedQueue<Batch> transformed_;
+  std::function<bool()> stopRequested_;
+  std::atomic<bool> aborted_{false};
+  std::mutex errorMutex_;
+  std::exception_ptr firstError_;
+};
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "job_monitoring_models.hpp"
+#include "transparent_string_hash.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Inverted index from job id, message type and log level to the connections
+ * whose ConnectionFilters accept them. A connection with no filter in a
+ * dimension sits in that dimension's wildcard set, so a lookup walks only
+ * the smallest of "keyed subscribers + wildcard subscribers" across the
+ * dimensions the message constrains, and checks the rest per candidate.
+ *
+ * Handle is whatever the caller needs to reach a connection (the
+ * broadcaster stores a weak_ptr). Thread-safe; callbacks run under a shared
+ * lock and must not modify the index.
+ */
+template <class Handle> class SubscriptionIndex {
+public:
+  // Adds the connection, or replaces its handle and filters
+  void update(const std::string &id, Handle handle,
+              const ConnectionFilters &filters) {
+    std::unique_lock lock(mutex_);
+    auto [it, inserted] = entries_.try_emplace(id);
+    Entry &entry = it->second;
+    if (!inserted) {
+      unindex(entry);
+    }
+    entry.id = &it->first;
+    entry.handle = std::move(handle);
+    entry.filters = filters;
+    index(entry);
+  }
+
+  bool remove(std::string_view id) {
+    std::unique_lock lock(mutex_);
+    auto it = entries_.find(id);
+    if (it == entries_.end()) {
+      return false;
+    }
+    unindex(it->second);
+    entries_.erase(it);
+    return true;
+  }
+
+  void clear() {
+    std::unique_lock lock(mutex_);
+    entries_.clear();
+    byJob_.clear();
+    byLevel_.clear();
+    for (auto &set : byType_) {
+      set.clear();
+    }
+    anyJob_.clear();
+    anyLevel_.clear();
+    anyType_.clear();
+  }
+
+  size_t size() const {
+    std::shared_lock lock(mutex_);
+    return entries_.size();
+  }
+
+  /**
+   * Calls fn(id, handle) for every connection that should receive a message
+   * of this type for this job and level (empty = not job/level specific),
+   * with the same rules as ConnectionFilters::shouldReceiveMessage(). fn
+   * returns whether it delivered; the number of deliveries is returned.
+   */
+  template <class Fn>
+  size_t forEachSubscriber(MessageType type, std::string_view jobId,
+                           std::string_view logLevel, Fn &&fn) const {
+    std::shared_lock lock(mutex_);
+
+    Candidates best{&byType_[typeIndex(type)], &anyType_};
+    if (!jobId.empty()) {
+      best = smaller(best, {find(byJob_, jobId), &anyJob_});
+    }
+    if (!logLevel.empty()) {
+      best = smaller(best, {find(byLevel_, logLevel), &anyLevel_});
+    }
+
+    size_t delivered = 0;
+    for (const EntrySet *set : {best.keyed, best.wildcard}) {
+      if (!set) {
+        continue;
+      }
+      for (const Entry *entry : *set) {
+        if (accepts(entry->filters, type, jobId, logLevel) &&
+            fn(*entry->id, entry->handle)) {
+          ++delivered;
+        }
+      }
+    }
+    return delivered;
+  }
+
+  // Connection ids whose filters accept the job / type / level
+  std::vector<std::string> subscribersForJob(std::string_view jobId) const {
+    std::shared_lock lock(mutex_);
+    return collect(find(byJob_, jobId), anyJob_);
+  }
+
+  std::vector<std::string> subscribersForMessageType(MessageType type) const {
+    std::shared_lock lock(mutex_);
+    return collect(&byType_[typeIndex(type)], anyType_);
+  }
+
+  std::vector<std::string>
+  subscribersForLogLevel(std::string_view logLevel) const {
+    std::shared_lock lock(mutex_);
+    return collect(find(byLevel_, logLevel), anyLevel_);
+  }
+
+private:
+  struct Entry {
+    const std::string *id = nullptr; // key of the entries_ node
+    Handle handle{};
+    ConnectionFilters filters;
+  };
+
+  // Entries are node-based map values, so their addresses are stable
+  using EntrySet = std::unordered_set<const Entry *>;
+  using KeyedSets = std::unordered_map<std::string, EntrySet,
+                                       TransparentStringHash, std::equal_to<>>;
+
+  static constexpr size_t kMessageTypeCount =
+      static_cast<size_t>(MessageType::ERROR_MESSAGE) + 1;
+
+  struct Candidates {
+    const EntrySet *keyed; // null when nobody filters on the key
+    const EntrySet *wildcard;
+
+    size_t size() const {
+      return (keyed ? keyed->size() : 0) + wildcard->size();
+    }
+  };
+
+  static size_t typeIndex(MessageType type) {
+    return static_cast<size_t>(type);
+  }
+
+  static Candidates smaller(const Candidates &a, const Candidates &b) {
+    return b.size() < a.size() ? b : a;
+  }
+
+  static const EntrySet *find(const KeyedSets &sets, std::string_view key) {
+    auto it = sets.find(key);
+    return it == sets.end() ? nullptr : &it->second;
+  }
+
+  template <class T, class V>
+  static bool acceptsValue(const std::vector<T> &filter, const V &value) {
+    return filter.empty() ||
+           std::find(filter.begin(), filter.end(), value) != filter.end();
+  }
+
+  static bool accepts(const ConnectionFilters &filters, MessageType type,
+                      std::string_view jobId, std::string_view logLevel) {
+    return acceptsValue(filters.messageTypes, type) &&
+           (jobId.empty() || acceptsValue(filters.jobIds, jobId)) &&
+           (logLevel.empty() || acceptsValue(filters.logLevels, logLevel)) &&
+           (type != MessageType::SYSTEM_NOTIFICATION ||
+            filters.includeSystemNotifications);
+  }
+
+  static std::vector<std::string> collect(const EntrySet *keyed,
+                                          const EntrySet &wildcard) {
+    std::vector<std::string> ids;
+    ids.reserve((keyed ? keyed->size() : 0) + wildcard.size());
+    if (keyed) {
+      for (const Entry *entry : *keyed) {
+        ids.push_back(*entry->id);
+      }
+    }
+    for (const Entry *entry : wildcard) {
+      ids.push_back(*entry->id);
+    }
+    return ids;
+  }
+
+  static void link(KeyedSets &sets, EntrySet &wildcard,
+                   const std::vector<std::string> &keys, const Entry *entry) {
+    if (keys.empty()) {
+      wildcard.insert(entry);
+    }
+    for (const auto &key : keys) {
+      sets[key].insert(entry);
+    }
+  }
+
+  static void unlink(KeyedSets &sets, EntrySet &wildcard,
+                     const std::vector<std::string> &keys,
+                     const Entry *entry) {
+    wildcard.erase(entry);
+    for (const auto &key : keys) {
+      auto it = sets.find(key);
+      if (it != sets.end() && it->second.erase(entry) &&
+          it->second.empty()) {
+        sets.erase(it);
+      }
+    }
+  }
+
+  void index(const Entry &entry) {
+    const ConnectionFilters &filters = entry.filters;
+    link(byJob_, anyJob_, filters.jobIds, &entry);
+    link(byLevel_, anyLevel_, filters.logLevels, &entry);
+    if (filters.messageTypes.empty()) {
+      anyType_.insert(&entry);
+    }
+    for (MessageType type : filters.messageTypes) {
+      byType_[typeIndex(type)].insert(&entry);
+    }
+  }
+
+  void unindex(const Entry &entry) {
+    const ConnectionFilters &filters = entry.filters;
+    unlink(byJob_, anyJob_, filters.jobIds, &entry);
+    unlink(byLevel_, anyLevel_, filters.logLevels, &entry);
+    anyType_.erase(&entry);
+    for (MessageType type : filters.messageTypes) {
+      byType_[typeIndex(type)].erase(&entry);
+    }
+  }
+
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::string, Entry, TransparentStringHash,
+                     std::equal_to<>>
+      entries_;
+  KeyedSets byJob_;
+  KeyedSets byLevel_;
+  std::array<EntrySet, kMessageTypeCount> byType_;
+  EntrySet anyJob_;
+  EntrySet anyLevel_;
+  EntrySet anyType_;
+};
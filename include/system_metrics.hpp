@@ -3,6 +3,7 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -153,6 +154,28 @@ public:
   void setMetricsUpdateCallback(MetricsUpdateCallback callback);
   void setUpdateInterval(std::chrono::milliseconds interval);
 
+  // Per-stage counters for pipelined (streaming) execution
+  enum class PipelineStage { EXTRACT = 0, TRANSFORM = 1, LOAD = 2 };
+  static constexpr size_t kPipelineStageCount = 3;
+
+  struct StageMetrics {
+    uint64_t batches = 0;
+    uint64_t records = 0;
+    std::chrono::milliseconds busyTime{0};    // time spent doing work
+    std::chrono::milliseconds blockedTime{0}; // time stalled on backpressure
+    double recordsPerSecond = 0.0;            // records / busyTime
+  };
+
+  void recordStageBatch(PipelineStage stage, size_t records,
+                        std::chrono::nanoseconds busyTime);
+  void recordStageBlocked(PipelineStage stage,
+                          std::chrono::nanoseconds blockedTime);
+  StageMetrics getStageMetrics(PipelineStage stage) const;
+
+  // Cooperative cancellation, polled by running stages between batches
+  void requestCancellation();
+  bool isCancellationRequested() const;
+
 private:
   std::string jobId_;
   std::shared_ptr<SystemMetrics> systemMetrics_;
@@ -181,6 +204,16 @@ private:
   std::thread updateThread_;
   std::atomic<bool> shouldStopUpdates_{false};
 
+  // Pipeline stage counters, indexed by PipelineStage
+  struct StageCounters {
+    std::atomic<uint64_t> batches{0};
+    std::atomic<uint64_t> records{0};
+    std::atomic<int64_t> busyNs{0};
+    std::atomic<int64_t> blockedNs{0};
+  };
+  StageCounters stages_[kPipelineStageCount];
+  std::atomic<bool> cancellationRequested_{false};
+
   // Update loop for real-time broadcasting
   void updateLoop();
 
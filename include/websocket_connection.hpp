@@ -2,6 +2,7 @@
 
 #include "job_monitoring_models.hpp"
 #include "websocket_connection_recovery.hpp"
+#include "websocket_write_batcher.hpp"
 #include <atomic>
 #include <boost/asio/dispatch.hpp>
 #include <boost/asio/steady_timer.hpp>
@@ -11,7 +12,6 @@
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -38,8 +38,16 @@ public:
 
   void start();
   void send(const std::string &message);
+  // supersedeKey: see supersedeKeyFor(); 0 never squashes
+  void send(SharedMessage message, uint64_t supersedeKey = 0);
   void close();
 
+  // Outbound batching, compression and slow-consumer policy. Compression is
+  // negotiated during the handshake, so set this before start().
+  void setWriteBatchingConfig(const WriteBatchingConfig &config);
+  WriteBatchingConfig getWriteBatchingConfig() const;
+  WebSocketWriteStats getWriteStats() const;
+
   const std::string &getId() const { return connectionId_; }
   bool isOpen() const { return isOpen_.load(); }
   bool isHealthy() const;
@@ -66,6 +74,7 @@ public:
   // Connection filtering methods
   void setFilters(const ConnectionFilters &filters);
   const ConnectionFilters &getFilters() const { return filters_; }
+  ConnectionFilters copyFilters() const; // consistent copy, under the lock
   bool shouldReceiveMessage(MessageType type, const std::string &jobId = "",
                             const std::string &logLevel = "") const;
   bool shouldReceiveMessage(const WebSocketMessage &message) const;
@@ -93,8 +102,12 @@ private:
   std::weak_ptr<WebSocketManager> manager_;
   std::string connectionId_;
   beast::flat_buffer buffer_;
-  std::queue<std::string> messageQueue_;
-  std::mutex queueMutex_;
+  WriteBatcher outbox_;
+  WriteBatch inFlight_; // kept alive until its async_write completes
+  WebSocketWriteStats writeStats_;
+  std::unique_ptr<boost::asio::steady_timer> flushTimer_;
+  bool flushTimerArmed_ = false;
+  mutable std::mutex queueMutex_; // outbox_, inFlight_, writeStats_, timer
   std::atomic<bool> isOpen_{false};
   std::atomic<bool> isWriting_{false};
   ConnectionFilters filters_;
@@ -116,6 +129,8 @@ private:
   void doRead();
   void onRead(beast::error_code ec, std::size_t bytes_transferred);
   void doWrite();
+  void startWrite();
+  void scheduleFlush(WriteBatcher::Clock::time_point deadline);
   void onWrite(beast::error_code ec, std::size_t bytes_transferred);
   void doClose();
 
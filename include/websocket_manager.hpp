@@ -14,13 +14,20 @@
 namespace net = boost::asio;
 using tcp = boost::asio::ip::tcp;
 
+class ConfigManager;
+
 /**
  * @brief Configuration for WebSocketManager behavior
  */
 struct WebSocketManagerConfig {
   ConnectionPoolConfig connectionPoolConfig;
   MessageBroadcasterConfig messageBroadcasterConfig;
+  WriteBatchingConfig writeBatchingConfig; // applied to each new connection
   bool autoStartComponents = true; // Automatically start pool and broadcaster
+
+  // Reads monitoring.websocket.write_batching; everything else keeps its
+  // default
+  static WebSocketManagerConfig fromConfig(const ConfigManager &config);
 };
 
 /**
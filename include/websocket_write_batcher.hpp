@@ -0,0 +1,146 @@
+#pragma once
+
+#include "job_monitoring_models.hpp"
+#include <boost/asio/buffer.hpp>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// A serialised message, shared read-only by every connection queue it is
+// sent to so a broadcast copies the payload once, not once per connection
+using SharedMessage = std::shared_ptr<const std::string>;
+
+inline SharedMessage makeSharedMessage(std::string message) {
+  return std::make_shared<const std::string>(std::move(message));
+}
+
+/**
+ * @brief How several queued messages are joined into one WebSocket frame
+ */
+enum class BatchFraming {
+  JsonArray,       // [m1,m2,...]; every message must be a JSON value
+  NewlineDelimited // m1\nm2\n...; one message per line
+};
+
+/**
+ * @brief What a connection does with messages it cannot write fast enough
+ */
+enum class SlowConsumerPolicy {
+  DropOldest,      // a full queue evicts its oldest message
+  SquashSuperseded // a newer progress/metrics update for the same job
+                   // replaces the queued one in place; then DropOldest
+};
+
+/**
+ * @brief Per-connection outbound write behaviour. Batching and compression
+ * change what clients receive, so both are off by default.
+ */
+struct WriteBatchingConfig {
+  bool enableBatching = false; // coalesce queued messages into one frame
+  BatchFraming framing = BatchFraming::JsonArray;
+  size_t maxBatchBytes = 64 * 1024; // payload budget per frame
+  size_t maxBatchMessages = 256;
+  // Longest an idle connection holds a message back waiting for company
+  std::chrono::milliseconds maxBatchDelay{5};
+  bool enableCompression = false; // offer permessage-deflate
+  size_t maxQueuedMessages = 1000;
+  SlowConsumerPolicy slowConsumerPolicy = SlowConsumerPolicy::DropOldest;
+};
+
+/**
+ * @brief Outbound write counters for one connection
+ */
+struct WebSocketWriteStats {
+  size_t framesSent = 0;
+  size_t messagesSent = 0;
+  size_t bytesSent = 0; // frame payload bytes, before compression
+  size_t messagesSquashed = 0;
+  size_t messagesDropped = 0;
+};
+
+// Non-zero for updates where only the latest per job matters
+// (JOB_PROGRESS_UPDATE, JOB_METRICS_UPDATE), so a newer one may replace a
+// queued older one under SlowConsumerPolicy::SquashSuperseded
+uint64_t supersedeKeyFor(MessageType type, std::string_view jobId);
+
+/**
+ * @brief One outgoing frame: the payloads it references and the gather
+ * buffers (payloads plus separators) handed to async_write
+ */
+class WriteBatch {
+public:
+  const std::vector<boost::asio::const_buffer> &buffers() const {
+    return buffers_;
+  }
+  size_t messageCount() const { return messages_.size(); }
+  size_t bytes() const { return bytes_; }
+  bool empty() const { return messages_.empty(); }
+  void clear();
+
+private:
+  friend class WriteBatcher;
+
+  void append(std::string_view bytes);
+
+  std::vector<SharedMessage> messages_; // keep the buffers alive
+  std::vector<boost::asio::const_buffer> buffers_;
+  size_t bytes_ = 0;
+};
+
+/**
+ * @brief Bounded outbound queue of a WebSocket connection.
+ *
+ * Decides when queued messages should be written and packs them into
+ * frames within the configured byte/message budget. With batching off each
+ * message is its own frame, as before. Not thread-safe: the connection
+ * guards it with its queue mutex.
+ */
+class WriteBatcher {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class PushResult { Queued, Squashed, DroppedOldest };
+
+  explicit WriteBatcher(const WriteBatchingConfig &config = {});
+
+  void setConfig(const WriteBatchingConfig &config) { config_ = config; }
+  const WriteBatchingConfig &getConfig() const { return config_; }
+
+  PushResult push(SharedMessage message, uint64_t supersedeKey,
+                  Clock::time_point now);
+
+  bool empty() const { return queue_.empty(); }
+  size_t size() const { return queue_.size(); }
+  size_t queuedBytes() const { return queuedBytes_; }
+
+  // Whether to write now rather than wait for more messages: always with
+  // batching off, otherwise once a budget is full or the oldest message
+  // has waited maxBatchDelay
+  bool readyToFlush(Clock::time_point now) const;
+  Clock::time_point flushDeadline() const;
+
+  // Moves the next frame's worth of messages into batch. A batch of one is
+  // sent unwrapped, so a quiet connection sees the same frames as before.
+  void takeBatch(WriteBatch &batch);
+
+private:
+  struct Pending {
+    SharedMessage message;
+    uint64_t supersedeKey;
+    Clock::time_point enqueued;
+  };
+
+  void popFront();
+
+  WriteBatchingConfig config_;
+  std::deque<Pending> queue_;
+  // supersede key -> sequence number of the queued message carrying it
+  std::unordered_map<uint64_t, uint64_t> latestByKey_;
+  uint64_t frontSequence_ = 0; // sequence number of queue_.front()
+  size_t queuedBytes_ = 0;
+};
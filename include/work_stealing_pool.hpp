@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed-size thread pool with one task deque per worker. A worker pops its
+ * own deque from the back (LIFO, cache-warm) and, when empty, steals from the
+ * front of its siblings' deques. External submissions are distributed
+ * round-robin across the worker deques.
+ *
+ * parallelFor() blocks until every index has run; the calling thread helps
+ * execute tasks while it waits, so nested calls from inside a worker cannot
+ * deadlock the pool.
+ */
+class WorkStealingPool {
+public:
+  using Task = std::function<void()>;
+
+  /**
+   * @param workerCount Number of worker threads (0 = hardware concurrency)
+   */
+  explicit WorkStealingPool(size_t workerCount = 0);
+  ~WorkStealingPool();
+
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+  void submit(Task task);
+
+  // Runs body(i) for every i in [0, count) and waits for completion.
+  // The first exception thrown by a task is rethrown on the calling thread.
+  void parallelFor(size_t count, const std::function<void(size_t)> &body);
+
+  size_t workerCount() const { return workers_.size(); }
+  uint64_t stolenTaskCount() const {
+    return stolenTasks_.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  std::mutex sleepMutex_;
+  std::condition_variable sleepCondition_;
+  std::atomic<size_t> pendingTasks_{0};
+  std::atomic<size_t> nextQueue_{0};
+  std::atomic<uint64_t> stolenTasks_{0};
+  std::atomic<bool> stopping_{false};
+
+  void workerLoop(size_t index);
+  bool tryRunOne(size_t preferredQueue);
+  bool popLocal(size_t index, Task &task);
+  bool steal(size_t thiefIndex, Task &task);
+};
@@ -0,0 +1,326 @@
+#include "async_http_client.hpp"
+#include "log_compression.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// scheme://host[:port] of url; requests to it share a limit and connections
+std::string destinationOf(const std::string &url) {
+  const size_t scheme = url.find("://");
+  const size_t start = scheme == std::string::npos ? 0 : scheme + 3;
+  return url.substr(0, url.find_first_of("/?#", start));
+}
+
+size_t appendResponse(char *data, size_t size, size_t count, void *out) {
+  static_cast<std::string *>(out)->append(data, size * count);
+  return size * count;
+}
+
+} // namespace
+
+struct AsyncHttpClient::Transfer {
+  HttpRequest request;
+  Callback done;
+  std::string destination;
+  std::chrono::steady_clock::time_point submitted;
+  size_t rawBytes = 0; // body size before gzip
+  CURL *easy = nullptr;
+  curl_slist *headers = nullptr;
+  std::string response;
+  char error[CURL_ERROR_SIZE] = {};
+};
+
+AsyncHttpClient::AsyncHttpClient() : AsyncHttpClient(Config{}) {}
+
+AsyncHttpClient::AsyncHttpClient(const Config &config) : config_(config) {
+  static std::once_flag curlInit;
+  std::call_once(curlInit, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
+  multi_ = curl_multi_init();
+  if (!multi_) {
+    throw std::runtime_error("Failed to initialize CURL multi handle");
+  }
+  curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+  curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS,
+                    static_cast<long>(config_.maxConnectionsPerHost));
+  curl_multi_setopt(multi_, CURLMOPT_MAX_TOTAL_CONNECTIONS,
+                    static_cast<long>(config_.maxTotalConnections));
+  curl_multi_setopt(multi_, CURLMOPT_MAXCONNECTS,
+                    static_cast<long>(config_.maxTotalConnections));
+  loop_ = std::thread(&AsyncHttpClient::run, this);
+}
+
+AsyncHttpClient::~AsyncHttpClient() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  curl_multi_wakeup(multi_);
+  if (loop_.joinable()) {
+    loop_.join();
+  }
+  for (CURL *easy : idleHandles_) {
+    curl_easy_cleanup(easy);
+  }
+  curl_multi_cleanup(multi_);
+}
+
+std::shared_ptr<AsyncHttpClient> AsyncHttpClient::shared() {
+  static std::shared_ptr<AsyncHttpClient> client =
+      std::make_shared<AsyncHttpClient>();
+  return client;
+}
+
+void AsyncHttpClient::send(HttpRequest request, Callback done) {
+  auto transfer = std::make_unique<Transfer>();
+  transfer->destination = destinationOf(request.url);
+  transfer->submitted = std::chrono::steady_clock::now();
+  transfer->rawBytes = request.body.size();
+  // Compressed here rather than on the event loop, which serves everyone
+  if (request.gzipBody && !request.body.empty()) {
+    std::string compressed;
+    if (compressLogBuffer(CompressionType::GZIP, 6, request.body,
+                          compressed) &&
+        compressed.size() < request.body.size()) {
+      request.body = std::move(compressed);
+      request.headers["Content-Encoding"] = "gzip";
+    }
+  }
+  transfer->request = std::move(request);
+  transfer->done = std::move(done);
+  stats_.requests++;
+
+  const char *rejection = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Destination &destination = destinations_[transfer->destination];
+    if (stop_) {
+      rejection = "HTTP client is shutting down";
+    } else if (destination.active < config_.maxConnectionsPerHost) {
+      destination.active++;
+      ready_.push_back(std::move(transfer));
+      pending_++;
+    } else if (destination.waiting.size() < config_.maxQueuedPerHost) {
+      destination.waiting.push_back(std::move(transfer));
+      pending_++;
+    } else {
+      rejection = "too many requests queued for destination";
+    }
+  }
+
+  if (rejection) {
+    stats_.rejected++;
+    HttpResponse response;
+    response.error = rejection;
+    transfer->done(std::move(response));
+    return;
+  }
+  curl_multi_wakeup(multi_);
+}
+
+std::future<HttpResponse> AsyncHttpClient::send(HttpRequest request) {
+  auto promise = std::make_shared<std::promise<HttpResponse>>();
+  auto future = promise->get_future();
+  send(std::move(request), [promise](HttpResponse response) {
+    promise->set_value(std::move(response));
+  });
+  return future;
+}
+
+size_t AsyncHttpClient::pending() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_;
+}
+
+void AsyncHttpClient::run() {
+  for (;;) {
+    if (!startTransfers()) {
+      break;
+    }
+    int running = 0;
+    curl_multi_perform(multi_, &running);
+
+    int queued = 0;
+    while (CURLMsg *message = curl_multi_info_read(multi_, &queued)) {
+      if (message->msg == CURLMSG_DONE) {
+        finishTransfer(message->easy_handle, message->data.result);
+      }
+    }
+
+    // Finished transfers may have admitted waiting ones; start those first
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!ready_.empty() || stop_) {
+        continue;
+      }
+    }
+    curl_multi_poll(multi_, nullptr, 0, 1000, nullptr);
+  }
+  failAll("HTTP client is shutting down");
+}
+
+// Adds admitted transfers to the multi handle; false once stopping
+bool AsyncHttpClient::startTransfers() {
+  std::vector<std::unique_ptr<Transfer>> ready;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_) {
+      return false;
+    }
+    ready.swap(ready_);
+  }
+
+  for (auto &transfer : ready) {
+    CURL *easy = nullptr;
+    if (idleHandles_.empty()) {
+      easy = curl_easy_init();
+    } else {
+      easy = idleHandles_.back();
+      idleHandles_.pop_back();
+      curl_easy_reset(easy);
+    }
+    if (!easy) {
+      HttpResponse response;
+      response.error = "Failed to initialize CURL handle";
+      release(*transfer);
+      complete(*transfer, std::move(response));
+      continue;
+    }
+
+    const HttpRequest &request = transfer->request;
+    transfer->easy = easy;
+    for (const auto &[key, value] : request.headers) {
+      transfer->headers = curl_slist_append(transfer->headers,
+                                            (key + ": " + value).c_str());
+    }
+    // No "Expect: 100-continue" round trip before larger bodies
+    transfer->headers = curl_slist_append(transfer->headers, "Expect:");
+
+    curl_easy_setopt(easy, CURLOPT_URL, request.url.c_str());
+    if (request.method == "GET") {
+      curl_easy_setopt(easy, CURLOPT_HTTPGET, 1L);
+    } else {
+      curl_easy_setopt(easy, CURLOPT_POST, 1L);
+      curl_easy_setopt(easy, CURLOPT_POSTFIELDS, request.body.data());
+      curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE_LARGE,
+                       static_cast<curl_off_t>(request.body.size()));
+      if (request.method != "POST") {
+        curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, request.method.c_str());
+      }
+    }
+    curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->headers);
+    curl_easy_setopt(easy, CURLOPT_USERAGENT, config_.userAgent.c_str());
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, appendResponse);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer->response);
+    curl_easy_setopt(easy, CURLOPT_ERRORBUFFER, transfer->error);
+    curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS,
+                     static_cast<long>(request.timeout.count()));
+    curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT_MS,
+                     static_cast<long>(request.connectTimeout.count()));
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(easy, CURLOPT_MAXAGE_CONN,
+                     static_cast<long>(config_.maxConnectionAge.count()));
+    // HTTP/2 over TLS when the server offers it; wait for a connection to
+    // multiplex on rather than opening another
+    curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+
+    curl_multi_add_handle(multi_, easy);
+    running_.emplace(easy, std::move(transfer));
+  }
+  return true;
+}
+
+void AsyncHttpClient::finishTransfer(CURL *easy, CURLcode result) {
+  auto it = running_.find(easy);
+  if (it == running_.end()) {
+    return;
+  }
+  std::unique_ptr<Transfer> transfer = std::move(it->second);
+  running_.erase(it);
+  curl_multi_remove_handle(multi_, easy);
+
+  HttpResponse response;
+  if (result == CURLE_OK) {
+    curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &response.status);
+  } else {
+    response.error = transfer->error[0] ? transfer->error
+                                        : curl_easy_strerror(result);
+  }
+  long connects = 0;
+  curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &connects);
+  stats_.connectionsOpened += static_cast<uint64_t>(connects);
+  response.body = std::move(transfer->response);
+
+  release(*transfer);
+  complete(*transfer, std::move(response));
+}
+
+// Gives the transfer's slot to the next request waiting for its destination
+void AsyncHttpClient::release(const Transfer &transfer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Destination &destination = destinations_[transfer.destination];
+  pending_--;
+  if (!destination.waiting.empty()) {
+    ready_.push_back(std::move(destination.waiting.front()));
+    destination.waiting.pop_front();
+  } else {
+    destination.active--;
+  }
+}
+
+void AsyncHttpClient::complete(Transfer &transfer, HttpResponse response) {
+  if (transfer.headers) {
+    curl_slist_free_all(transfer.headers);
+    transfer.headers = nullptr;
+  }
+  if (transfer.easy) {
+    idleHandles_.push_back(transfer.easy);
+    transfer.easy = nullptr;
+  }
+
+  response.latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - transfer.submitted);
+  response.bytesSent = transfer.request.body.size();
+  stats_.bytesSent += response.bytesSent;
+  stats_.bytesBeforeGzip += transfer.rawBytes;
+  stats_.totalLatencyUs += static_cast<uint64_t>(response.latency.count());
+  if (response.succeeded()) {
+    stats_.succeeded++;
+  } else {
+    stats_.failed++;
+  }
+  transfer.done(std::move(response));
+}
+
+// Ends every request still running, admitted or waiting with error
+void AsyncHttpClient::failAll(const std::string &error) {
+  std::vector<std::unique_ptr<Transfer>> remaining;
+  for (auto &[easy, transfer] : running_) {
+    curl_multi_remove_handle(multi_, easy);
+    remaining.push_back(std::move(transfer));
+  }
+  running_.clear();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &transfer : ready_) {
+      remaining.push_back(std::move(transfer));
+    }
+    ready_.clear();
+    for (auto &[name, destination] : destinations_) {
+      for (auto &transfer : destination.waiting) {
+        remaining.push_back(std::move(transfer));
+      }
+    }
+    destinations_.clear();
+    pending_ = 0;
+  }
+
+  for (auto &transfer : remaining) {
+    HttpResponse response;
+    response.error = error;
+    complete(*transfer, std::move(response));
+  }
+}
@@ -138,6 +138,12 @@ LogConfig ConfigManager::getLoggingConfig() const {
   config.componentFilter = getStringSet("logging.component_filter");
   config.includeMetrics = getBool("logging.include_metrics", false);
   config.flushInterval = getInt("logging.flush_interval", 1000);
+  config.asyncQueueSize =
+      static_cast<size_t>(getInt("logging.async_queue_size", 1024));
+  config.asyncOverflowPolicy =
+      getString("logging.async_overflow_policy", "drop") == "block"
+          ? LogOverflowPolicy::BLOCK
+          : LogOverflowPolicy::DROP;
 
   return config;
 }
@@ -53,13 +53,18 @@ void ConnectionPool::stop() {
   stopHealthMonitoring();
 
   // Close all connections
-  SCOPED_LOCK_TIMEOUT(connectionsMutex_, 2000);
-  for (auto &[id, connection] : connections_) {
-    if (connection && connection->isOpen()) {
-      connection->close();
+  std::vector<std::string> removed;
+  {
+    SCOPED_LOCK_TIMEOUT(connectionsMutex_, 2000);
+    for (auto &[id, connection] : connections_) {
+      if (connection && connection->isOpen()) {
+        connection->close();
+      }
+      removed.push_back(id);
     }
+    connections_.clear();
   }
-  connections_.clear();
+  notifyRemoved(removed);
 
   WS_LOG_INFO("Connection pool stopped");
 }
@@ -152,23 +157,25 @@ std::vector<std::string> ConnectionPool::getConnectionIds() const {
 }
 
 void ConnectionPool::removeInactiveConnections() {
-  SCOPED_LOCK_TIMEOUT(connectionsMutex_, 1000);
-
-  size_t removedCount = 0;
-  for (auto it = connections_.begin(); it != connections_.end();) {
-    auto &connection = it->second;
-    if (!connection || !connection->isOpen()) {
-      WS_LOG_DEBUG("Removing inactive connection from pool: " + it->first);
-      it = connections_.erase(it);
-      removedCount++;
-    } else {
-      ++it;
+  std::vector<std::string> removed;
+  {
+    SCOPED_LOCK_TIMEOUT(connectionsMutex_, 1000);
+    for (auto it = connections_.begin(); it != connections_.end();) {
+      auto &connection = it->second;
+      if (!connection || !connection->isOpen()) {
+        WS_LOG_DEBUG("Removing inactive connection from pool: " + it->first);
+        removed.push_back(it->first);
+        it = connections_.erase(it);
+      } else {
+        ++it;
+      }
     }
   }
 
-  if (removedCount > 0) {
-    WS_LOG_INFO("Removed " + std::to_string(removedCount) +
+  if (!removed.empty()) {
+    WS_LOG_INFO("Removed " + std::to_string(removed.size()) +
                 " inactive connections from pool");
+    notifyRemoved(removed);
   }
 }
 
@@ -421,46 +428,70 @@ void ConnectionPool::cleanupStaleConnections() {
     return;
   }
 
-  SCOPED_LOCK_TIMEOUT(connectionsMutex_, 1000);
-
-  size_t cleanedCount = 0;
-  size_t batchSize = 0;
-
-  for (auto it = connections_.begin();
-       it != connections_.end() && batchSize < config_.cleanupBatchSize;) {
-    auto &connection = it->second;
-    if (isConnectionStale(connection)) {
-      WS_LOG_DEBUG("Cleaning up stale connection: " + it->first);
-      it = connections_.erase(it);
-      cleanedCount++;
-      batchSize++;
-    } else {
-      ++it;
+  std::vector<std::string> removed;
+  {
+    SCOPED_LOCK_TIMEOUT(connectionsMutex_, 1000);
+    for (auto it = connections_.begin();
+         it != connections_.end() &&
+         removed.size() < config_.cleanupBatchSize;) {
+      auto &connection = it->second;
+      if (isConnectionStale(connection)) {
+        WS_LOG_DEBUG("Cleaning up stale connection: " + it->first);
+        removed.push_back(it->first);
+        it = connections_.erase(it);
+      } else {
+        ++it;
+      }
     }
   }
 
-  if (cleanedCount > 0) {
-    WS_LOG_INFO("Cleaned up " + std::to_string(cleanedCount) +
+  if (!removed.empty()) {
+    WS_LOG_INFO("Cleaned up " + std::to_string(removed.size()) +
                 " stale connections");
+    notifyRemoved(removed);
   }
 }
 
 void ConnectionPool::forceCleanup(size_t maxToRemove) {
-  SCOPED_LOCK_TIMEOUT(connectionsMutex_, 1000);
-
-  size_t removedCount = 0;
-  size_t targetRemovals = maxToRemove > 0 ? maxToRemove : connections_.size();
-
-  for (auto it = connections_.begin();
-       it != connections_.end() && removedCount < targetRemovals;) {
-    WS_LOG_DEBUG("Force removing connection: " + it->first);
-    it = connections_.erase(it);
-    removedCount++;
+  std::vector<std::string> removed;
+  {
+    SCOPED_LOCK_TIMEOUT(connectionsMutex_, 1000);
+    size_t targetRemovals =
+        maxToRemove > 0 ? maxToRemove : connections_.size();
+
+    for (auto it = connections_.begin();
+         it != connections_.end() && removed.size() < targetRemovals;) {
+      WS_LOG_DEBUG("Force removing connection: " + it->first);
+      removed.push_back(it->first);
+      it = connections_.erase(it);
+    }
   }
 
-  if (removedCount > 0) {
-    WS_LOG_INFO("Force cleaned up " + std::to_string(removedCount) +
+  if (!removed.empty()) {
+    WS_LOG_INFO("Force cleaned up " + std::to_string(removed.size()) +
                 " connections");
+    notifyRemoved(removed);
+  }
+}
+
+void ConnectionPool::setRemovalListener(
+    std::function<void(const std::string &)> listener) {
+  std::lock_guard<std::mutex> lock(listenerMutex_);
+  removalListener_ = std::move(listener);
+}
+
+void ConnectionPool::notifyRemoved(
+    const std::vector<std::string> &connectionIds) {
+  std::function<void(const std::string &)> listener;
+  {
+    std::lock_guard<std::mutex> lock(listenerMutex_);
+    listener = removalListener_;
+  }
+  if (!listener) {
+    return;
+  }
+  for (const auto &connectionId : connectionIds) {
+    listener(connectionId);
   }
 }
 
@@ -442,6 +442,13 @@ void ConnectionPoolManager::resetStatistics() {
                             "Statistics reset");
 }
 
+void ConnectionPoolManager::setRequestExecutor(
+    std::shared_ptr<RequestExecutor> executor) {
+  etl_plus::ScopedTimedLock<etl_plus::ContainerMutex> lock(
+      poolMutex_, std::chrono::milliseconds(5000), "poolMutex");
+  requestExecutor_ = std::move(executor);
+}
+
 // Private methods
 
 std::shared_ptr<PooledSession>
@@ -453,9 +460,9 @@ ConnectionPoolManager::createNewSession(tcp::socket &&socket) {
     return nullptr;
   }
 
-  auto session =
-      std::make_shared<PooledSession>(std::move(socket), handler_, wsManager_,
-                                      timeoutManager_, performanceMonitor_);
+  auto session = std::make_shared<PooledSession>(
+      std::move(socket), handler_, wsManager_, timeoutManager_,
+      performanceMonitor_, requestExecutor_);
 
   ++totalConnectionsCreated_;
 
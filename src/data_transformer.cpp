@@ -1,32 +1,131 @@
 #include "data_transformer.hpp"
+#include "simd_string_kernels.hpp"
+#include "work_stealing_pool.hpp"
 #include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <regex>
 #include <sstream>
 
-// Helper function to format doubles without trailing zeros
-static std::string to_string_no_trailing_zeros(double v) {
-  std::ostringstream oss;
-  oss << std::setprecision(15) << v; // not fixed => no forced trailing zeros
-  auto s = oss.str();
-  auto dot = s.find('.');
-  if (dot != std::string::npos) {
-    // trim trailing zeros
-    auto last = s.find_last_not_of('0');
-    if (last != std::string::npos) {
-      if (s[last] == '.')
-        last--;
-      s.erase(last + 1);
+namespace {
+
+TransformOp resolveOp(const std::string &type) {
+  if (type == "uppercase")
+    return TransformOp::UPPERCASE;
+  if (type == "lowercase")
+    return TransformOp::LOWERCASE;
+  if (type == "trim")
+    return TransformOp::TRIM;
+  if (type == "multiply")
+    return TransformOp::MULTIPLY;
+  if (type == "add")
+    return TransformOp::ADD;
+  return TransformOp::NONE;
+}
+
+Column toStringColumn(const Column &source) {
+  if (source.type() == ColumnType::STRING) {
+    return source;
+  }
+  Column result(ColumnType::STRING);
+  result.reserve(source.size(), source.size() * 8);
+  for (size_t row = 0; row < source.size(); ++row) {
+    result.appendFrom(source, row);
+  }
+  return result;
+}
+
+// Rows where the rule's source was absent keep the target's previous value,
+// mirroring transformRecord() which only writes targets for present sources.
+Column mergeUntouchedRows(const Column &transformed, const Column &source,
+                          const Column &previousTarget) {
+  ColumnType type = transformed.type() == previousTarget.type()
+                        ? transformed.type()
+                        : ColumnType::STRING;
+  Column merged(type);
+  merged.reserve(transformed.size());
+  for (size_t row = 0; row < transformed.size(); ++row) {
+    if (source.isNull(row)) {
+      merged.appendFrom(previousTarget, row);
+    } else {
+      merged.appendFrom(transformed, row);
+    }
+  }
+  return merged;
+}
+
+// Target working set per chunk; keeps a chunk's input and output records
+// resident in a typical per-core L2 cache.
+constexpr size_t kTargetChunkBytes = 256 * 1024;
+// Rough cost of one map node (bucket pointer, node header, std::string) on
+// top of the key/value characters.
+constexpr size_t kPerFieldOverheadBytes = 96;
+
+} // namespace
+
+// TransformationPlan
+
+size_t TransformationPlan::internField(const std::string &name) {
+  auto it = std::find(fields_.begin(), fields_.end(), name);
+  if (it != fields_.end()) {
+    return static_cast<size_t>(it - fields_.begin());
+  }
+  fields_.push_back(name);
+  return fields_.size() - 1;
+}
+
+std::shared_ptr<const TransformationPlan>
+TransformationPlan::compile(const std::vector<TransformationRule> &rules) {
+  auto plan = std::make_shared<TransformationPlan>();
+  plan->steps_.reserve(rules.size());
+
+  for (const auto &rule : rules) {
+    CompiledTransformation step;
+    step.op = resolveOp(rule.transformationType);
+    step.sourceIndex = plan->internField(rule.sourceField);
+    step.targetIndex = plan->internField(rule.targetField);
+
+    if (step.op == TransformOp::MULTIPLY || step.op == TransformOp::ADD) {
+      const char *paramName =
+          step.op == TransformOp::MULTIPLY ? "factor" : "addend";
+      auto it = rule.parameters.find(paramName);
+      if (it == rule.parameters.end()) {
+        // Without its parameter a numeric rule copies the value through
+        step.op = TransformOp::NONE;
+      } else {
+        try {
+          step.operand = std::stod(it->second);
+        } catch (const std::exception &e) {
+          std::cerr << "Invalid '" << paramName << "' parameter '"
+                    << it->second << "' for rule " << rule.sourceField
+                    << " -> " << rule.targetField << ": " << e.what()
+                    << std::endl;
+          step.op = TransformOp::NONE;
+        }
+      }
+    }
+
+    auto itReq = rule.parameters.find("required");
+    if (itReq != rule.parameters.end() && itReq->second == "true") {
+      plan->requiredFields_.push_back(step.sourceIndex);
     }
+
+    plan->steps_.push_back(step);
   }
-  return s;
+
+  return plan;
 }
 
-DataTransformer::DataTransformer() {}
+// DataTransformer
+
+DataTransformer::DataTransformer()
+    : plan_(TransformationPlan::compile(rules_)) {}
+
+DataTransformer::~DataTransformer() = default;
 
 void DataTransformer::addTransformationRule(const TransformationRule &rule) {
   rules_.push_back(rule);
+  recompilePlan();
   std::cout << "Added transformation rule: " << rule.sourceField << " -> "
             << rule.targetField << std::endl;
 }
@@ -38,12 +137,94 @@ void DataTransformer::removeTransformationRule(const std::string &sourceField) {
                                 return rule.sourceField == sourceField;
                               }),
                rules_.end());
+  recompilePlan();
 }
 
-void DataTransformer::clearRules() { rules_.clear(); }
+void DataTransformer::clearRules() {
+  rules_.clear();
+  recompilePlan();
+}
+
+void DataTransformer::recompilePlan() {
+  plan_ = TransformationPlan::compile(rules_);
+}
+
+void DataTransformer::setParallelConfig(
+    const ParallelTransformConfig &config) {
+  bool resizePool =
+      !pool_ || (config.enabled && config.workerCount != 0 &&
+                 config.workerCount != pool_->workerCount());
+  parallelConfig_ = config;
+
+  if (!config.enabled) {
+    pool_.reset();
+  } else if (resizePool) {
+    pool_ = std::make_shared<WorkStealingPool>(config.workerCount);
+  }
+
+  std::cout << "Parallel transform "
+            << (config.enabled ? "enabled with " +
+                                     std::to_string(pool_->workerCount()) +
+                                     " workers"
+                               : std::string("disabled"))
+            << std::endl;
+}
+
+size_t DataTransformer::resolveChunkSize(
+    const std::vector<DataRecord> &inputData) const {
+  if (parallelConfig_.chunkSize > 0) {
+    return parallelConfig_.chunkSize;
+  }
+
+  // Estimate record size from a small sample
+  size_t sampled = std::min<size_t>(inputData.size(), 16);
+  size_t bytes = 0;
+  for (size_t i = 0; i < sampled; ++i) {
+    for (const auto &[key, value] : inputData[i].fields) {
+      bytes += key.size() + value.size() + kPerFieldOverheadBytes;
+    }
+  }
+  size_t bytesPerRecord =
+      sampled > 0 ? std::max<size_t>(1, bytes / sampled) : 1;
+  // Input and output copies of each record share the chunk budget
+  return std::max<size_t>(64, kTargetChunkBytes / (2 * bytesPerRecord));
+}
+
+std::vector<DataRecord> DataTransformer::transformParallel(
+    const std::vector<DataRecord> &inputData) const {
+  auto pool = pool_;
+  if (!pool || inputData.size() < parallelConfig_.minParallelRecords) {
+    std::vector<DataRecord> result;
+    result.reserve(inputData.size());
+    for (const auto &record : inputData) {
+      result.push_back(transformRecord(record));
+    }
+    return result;
+  }
+
+  const size_t chunkSize = resolveChunkSize(inputData);
+  const size_t numChunks = (inputData.size() + chunkSize - 1) / chunkSize;
+
+  // Every chunk writes into its own slice of a pre-sized output vector, so
+  // order is preserved without any merge step.
+  std::vector<DataRecord> result(inputData.size());
+  pool->parallelFor(numChunks, [&](size_t chunk) {
+    size_t begin = chunk * chunkSize;
+    size_t end = std::min(begin + chunkSize, inputData.size());
+    for (size_t i = begin; i < end; ++i) {
+      result[i] = transformRecord(inputData[i]);
+    }
+  });
+
+  return result;
+}
 
 std::vector<DataRecord>
 DataTransformer::transform(const std::vector<DataRecord> &inputData) const {
+  if (parallelConfig_.enabled) {
+    return transformParallel(inputData);
+  }
+
   std::vector<DataRecord> result;
   result.reserve(inputData.size());
 
@@ -54,14 +235,49 @@ DataTransformer::transform(const std::vector<DataRecord> &inputData) const {
   return result;
 }
 
+RecordBatch DataTransformer::transformBatch(const RecordBatch &batch) const {
+  auto plan = plan_;
+  RecordBatch result = batch;
+
+  for (const auto &step : plan->steps()) {
+    const auto &sourceField = plan->fieldName(step.sourceIndex);
+    const auto &targetField = plan->fieldName(step.targetIndex);
+
+    auto sourceIdx = result.schema()->fieldIndex(sourceField);
+    if (!sourceIdx) {
+      continue;
+    }
+    const Column &source = result.column(*sourceIdx);
+    Column transformed = transformColumn(source, step, sourceField);
+
+    auto targetIdx = result.schema()->fieldIndex(targetField);
+    if (targetIdx && *targetIdx != *sourceIdx && source.nullCount() > 0) {
+      transformed =
+          mergeUntouchedRows(transformed, source, result.column(*targetIdx));
+    }
+
+    result.setColumn({targetField, transformed.type()},
+                     std::move(transformed));
+  }
+
+  return result;
+}
+
 DataRecord DataTransformer::transformRecord(const DataRecord &record) const {
+  const auto &plan = *plan_;
   DataRecord result = record; // Start with original data
 
-  for (const auto &rule : rules_) {
-    auto it = result.fields.find(rule.sourceField);
-    if (it != result.fields.end()) {
-      std::string transformedValue = applyTransformation(it->second, rule);
-      result.fields[rule.targetField] = transformedValue;
+  for (const auto &step : plan.steps()) {
+    auto it = result.fields.find(plan.fieldName(step.sourceIndex));
+    if (it == result.fields.end()) {
+      continue;
+    }
+    std::string transformedValue = applyStep(it->second, step);
+    if (step.targetIndex == step.sourceIndex) {
+      it->second = std::move(transformedValue);
+    } else {
+      result.fields.insert_or_assign(plan.fieldName(step.targetIndex),
+                                     std::move(transformedValue));
     }
   }
 
@@ -80,17 +296,15 @@ bool DataTransformer::validateData(const std::vector<DataRecord> &data) const {
 
 std::vector<std::string>
 DataTransformer::getValidationErrors(const DataRecord &record) const {
+  const auto &plan = *plan_;
   std::vector<std::string> errors;
 
   // Basic validation - check for empty required fields
-  for (const auto &rule : rules_) {
-    auto itReq = rule.parameters.find("required");
-    if (itReq != rule.parameters.end() && itReq->second == "true") {
-      auto it = record.fields.find(rule.sourceField);
-      if (it == record.fields.end() || it->second.empty()) {
-        errors.push_back("Required field '" + rule.sourceField +
-                         "' is missing or empty");
-      }
+  for (size_t fieldIndex : plan.requiredFields()) {
+    const auto &field = plan.fieldName(fieldIndex);
+    auto it = record.fields.find(field);
+    if (it == record.fields.end() || it->second.empty()) {
+      errors.push_back("Required field '" + field + "' is missing or empty");
     }
   }
 
@@ -98,76 +312,135 @@ DataTransformer::getValidationErrors(const DataRecord &record) const {
 }
 
 std::string
-DataTransformer::applyTransformation(const std::string &value,
-                                     const TransformationRule &rule) const {
-  if (rule.transformationType == "uppercase") {
-    return applyStringTransformation(value, "uppercase", rule.parameters);
-  } else if (rule.transformationType == "lowercase") {
-    return applyStringTransformation(value, "lowercase", rule.parameters);
-  } else if (rule.transformationType == "trim") {
-    return applyStringTransformation(value, "trim", rule.parameters);
-  } else if (rule.transformationType == "multiply") {
-    return applyNumericTransformation(value, "multiply", rule.parameters);
-  } else if (rule.transformationType == "add") {
-    return applyNumericTransformation(value, "add", rule.parameters);
-  } else {
-    return value; // No transformation
-  }
-}
-
-std::string DataTransformer::applyStringTransformation(
-    const std::string &value, const std::string &type,
-    const std::unordered_map<std::string, std::string, TransparentStringHash,
-                             std::equal_to<>> &params) const {
-  if (type == "uppercase") {
-    std::string result = value;
-    std::transform(result.begin(), result.end(), result.begin(), ::toupper);
-    return result;
-  } else if (type == "lowercase") {
+DataTransformer::applyStep(const std::string &value,
+                           const CompiledTransformation &step) const {
+  switch (step.op) {
+  case TransformOp::UPPERCASE: {
     std::string result = value;
-    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+    etl::string_kernels::asciiToUpper(result.data(), result.size());
     return result;
-  } else if (type == "trim") {
+  }
+  case TransformOp::LOWERCASE: {
     std::string result = value;
-    auto start = result.find_first_not_of(" \t\n\r");
-    if (start == std::string::npos)
-      return std::string{};
-    result.erase(0, start);
-    auto end = result.find_last_not_of(" \t\n\r");
-    if (end == std::string::npos)
-      return std::string{};
-    result.erase(end + 1);
+    etl::string_kernels::asciiToLower(result.data(), result.size());
     return result;
   }
-  return value;
+  case TransformOp::TRIM:
+    return std::string(etl::string_kernels::trimAsciiWhitespace(value));
+  case TransformOp::MULTIPLY:
+  case TransformOp::ADD:
+    try {
+      double numValue = std::stod(value);
+      return formatNumericValue(step.op == TransformOp::MULTIPLY
+                                    ? numValue * step.operand
+                                    : numValue + step.operand);
+    } catch (const std::exception &e) {
+      // Log the exception and return original value
+      std::cerr << "Numeric transformation failed for value '" << value
+                << "': " << e.what() << std::endl;
+      return value;
+    }
+  case TransformOp::NONE:
+    break;
+  }
+  return value; // No transformation
 }
 
-std::string DataTransformer::applyNumericTransformation(
-    const std::string &value, const std::string &type,
-    const std::unordered_map<std::string, std::string, TransparentStringHash,
-                             std::equal_to<>> &params) const {
-  try {
-    double numValue = std::stod(value);
+Column DataTransformer::transformColumn(const Column &source,
+                                        const CompiledTransformation &step,
+                                        const std::string &sourceField) const {
+  switch (step.op) {
+  case TransformOp::UPPERCASE:
+  case TransformOp::LOWERCASE: {
+    // Case mapping preserves byte length, so the whole character buffer is
+    // rewritten in place by one SIMD pass and the offsets are reused as-is.
+    Column result = toStringColumn(source);
+    auto &data = result.stringData();
+    if (step.op == TransformOp::UPPERCASE) {
+      etl::string_kernels::asciiToUpper(data.data(), data.size());
+    } else {
+      etl::string_kernels::asciiToLower(data.data(), data.size());
+    }
+    return result;
+  }
 
-    if (type == "multiply") {
-      auto it = params.find("factor");
-      if (it != params.end()) {
-        double factor = std::stod(it->second);
-        return to_string_no_trailing_zeros(numValue * factor);
+  case TransformOp::TRIM: {
+    Column text = toStringColumn(source);
+    Column result(ColumnType::STRING);
+    result.reserve(text.size(), text.stringData().size());
+    for (size_t row = 0; row < text.size(); ++row) {
+      if (text.isNull(row)) {
+        result.appendNull();
+      } else {
+        result.appendString(
+            etl::string_kernels::trimAsciiWhitespace(text.stringAt(row)));
       }
-    } else if (type == "add") {
-      auto it = params.find("addend");
-      if (it != params.end()) {
-        double addend = std::stod(it->second);
-        return to_string_no_trailing_zeros(numValue + addend);
+    }
+    return result;
+  }
+
+  case TransformOp::MULTIPLY:
+  case TransformOp::ADD: {
+    const bool multiply = step.op == TransformOp::MULTIPLY;
+    std::vector<double> values(source.size(), 0.0);
+    std::vector<bool> parsed(source.size(), false);
+    size_t failures = 0;
+    for (size_t row = 0; row < source.size(); ++row) {
+      if (source.isNull(row)) {
+        continue;
+      }
+      double v = 0.0;
+      switch (source.type()) {
+      case ColumnType::INT64:
+        v = static_cast<double>(source.int64At(row));
+        break;
+      case ColumnType::DOUBLE:
+        v = source.doubleAt(row);
+        break;
+      case ColumnType::STRING:
+        try {
+          v = std::stod(std::string(source.stringAt(row)));
+        } catch (const std::exception &) {
+          ++failures;
+          continue;
+        }
+        break;
+      }
+      values[row] = multiply ? v * step.operand : v + step.operand;
+      parsed[row] = true;
+    }
+
+    if (failures == 0) {
+      Column result(ColumnType::DOUBLE);
+      result.reserve(source.size());
+      for (size_t row = 0; row < source.size(); ++row) {
+        if (parsed[row]) {
+          result.appendDouble(values[row]);
+        } else {
+          result.appendNull();
+        }
       }
+      return result;
     }
-  } catch (const std::exception &e) {
-    // Log the exception and return original value
-    std::cerr << "Numeric transformation failed for value '" << value
-              << "' with type '" << type << "': " << e.what() << std::endl;
-    return value;
+
+    // Unparseable values pass through unchanged, so the column stays textual
+    std::cerr << "Numeric transformation failed for " << failures
+              << " value(s) in column '" << sourceField << "'" << std::endl;
+    Column result(ColumnType::STRING);
+    result.reserve(source.size(), source.stringData().size());
+    for (size_t row = 0; row < source.size(); ++row) {
+      if (parsed[row]) {
+        result.appendString(formatNumericValue(values[row]));
+      } else {
+        result.appendFrom(source, row);
+      }
+    }
+    return result;
+  }
+
+  case TransformOp::NONE:
+    break;
   }
 
-  return value;
+  return source; // No transformation
 }
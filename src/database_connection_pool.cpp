@@ -79,6 +79,7 @@ std::shared_ptr<pqxx::connection> DatabaseConnectionPool::acquireConnection() {
   if (!idleConnections_.empty()) {
     pooledConn = idleConnections_.front();
     idleConnections_.pop();
+    activeConnections_.push_back(pooledConn);
   } else if (activeConnections_.size() < config_.maxConnections) {
     // Release lock temporarily during connection creation
     lock.unlock();
@@ -118,8 +119,6 @@ std::shared_ptr<pqxx::connection> DatabaseConnectionPool::acquireConnection() {
 
   if (pooledConn) {
     pooledConn->lastUsedTime = std::chrono::steady_clock::now();
-    // Note: pooledConn is already in activeConnections_ (replaced nullptr
-    // placeholder)
 
     // Record wait time using circular buffer
     auto waitTime = std::chrono::steady_clock::now() - startTime;
@@ -173,6 +172,66 @@ void DatabaseConnectionPool::releaseConnection(
   poolCondition_.notify_one();
 }
 
+std::string DatabaseConnectionPool::prepareStatement(
+    const std::shared_ptr<pqxx::connection> &conn, const std::string &sql) {
+  size_t maxStatements;
+  std::shared_ptr<PooledConnection> pooledConn;
+  {
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    maxStatements = config_.maxPreparedStatements;
+    pooledConn = findActive(conn);
+  }
+  if (!pooledConn || maxStatements == 0) {
+    return {};
+  }
+
+  // The caller holds the connection, so its cache needs no lock
+  auto &statements = pooledConn->preparedStatements;
+  auto it = statements.find(sql);
+  if (it != statements.end()) {
+    preparedHits_.fetch_add(1, std::memory_order_relaxed);
+    return it->second;
+  }
+  if (statements.size() >= maxStatements) {
+    // Ad-hoc SQL must not grow server-side state without bound
+    return {};
+  }
+
+  // Ids are never reused, so a name cannot clash with a statement the server
+  // still holds after invalidatePreparedStatements()
+  std::string name =
+      "etl_stmt_" + std::to_string(pooledConn->nextStatementId++);
+  conn->prepare(name, sql);
+  statements.emplace(sql, name);
+  preparedMisses_.fetch_add(1, std::memory_order_relaxed);
+  return name;
+}
+
+void DatabaseConnectionPool::invalidatePreparedStatements(
+    const std::shared_ptr<pqxx::connection> &conn) {
+  std::shared_ptr<PooledConnection> pooledConn;
+  {
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    pooledConn = findActive(conn);
+  }
+  if (pooledConn) {
+    DB_LOG_WARN("Discarding " +
+                std::to_string(pooledConn->preparedStatements.size()) +
+                " cached prepared statements");
+    pooledConn->preparedStatements.clear();
+  }
+}
+
+std::shared_ptr<DatabaseConnectionPool::PooledConnection>
+DatabaseConnectionPool::findActive(
+    const std::shared_ptr<pqxx::connection> &conn) const {
+  auto it = std::find_if(activeConnections_.begin(), activeConnections_.end(),
+                         [&conn](const std::shared_ptr<PooledConnection> &pc) {
+                           return pc && pc->connection == conn;
+                         });
+  return it == activeConnections_.end() ? nullptr : *it;
+}
+
 void DatabaseConnectionPool::closeAll() {
   shutdown_.store(true);
   stopHealthMonitoring();
@@ -286,6 +345,10 @@ DatabaseConnectionPool::PoolMetrics DatabaseConnectionPool::getMetrics() const {
   PoolMetrics metrics = metrics_;
   metrics.activeConnections = activeConnections_.size();
   metrics.idleConnections = idleConnections_.size();
+  metrics.preparedStatementHits =
+      preparedHits_.load(std::memory_order_relaxed);
+  metrics.preparedStatementMisses =
+      preparedMisses_.load(std::memory_order_relaxed);
 
   if (!waitTimes_.empty()) {
     metrics.averageWaitTimeMs =
@@ -1,7 +1,13 @@
 #include "database_manager.hpp"
 #include "database_schema.hpp"
+#include "etl_exceptions.hpp"
 #include "logger.hpp"
+#include "record_batch.hpp"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
 #include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <pqxx/pqxx>
 #include <thread>
@@ -10,8 +16,186 @@ struct DatabaseManager::Impl {
   bool connected = false;
   DatabaseConnectionConfig poolConfig;
   std::unique_ptr<DatabaseConnectionPool> connectionPool;
+
+  void copyRange(const std::string &table,
+                 const std::vector<std::string> &columns,
+                 const std::vector<const Column *> &sources, size_t begin,
+                 size_t end, const BulkLoadOptions &options,
+                 BulkLoadResult &result);
+  pqxx::result execParams(const std::string &query,
+                          const std::vector<std::string> &params);
+};
+
+namespace {
+
+// Returns a pooled connection on every exit path
+class PooledConnectionGuard {
+public:
+  PooledConnectionGuard(DatabaseConnectionPool &pool,
+                        std::shared_ptr<pqxx::connection> conn)
+      : pool_(pool), conn_(std::move(conn)) {}
+  ~PooledConnectionGuard() {
+    if (conn_) {
+      pool_.releaseConnection(conn_);
+    }
+  }
+  PooledConnectionGuard(const PooledConnectionGuard &) = delete;
+  PooledConnectionGuard &operator=(const PooledConnectionGuard &) = delete;
+
+private:
+  DatabaseConnectionPool &pool_;
+  std::shared_ptr<pqxx::connection> conn_;
 };
 
+// Lowercase identifiers are unaffected by quoting, so they behave the same
+// whether or not the libpqxx version quotes COPY targets.
+bool isPlainIdentifier(const std::string &name) {
+  if (name.empty() || name.size() > 63 ||
+      !(name[0] == '_' || (name[0] >= 'a' && name[0] <= 'z'))) {
+    return false;
+  }
+  for (char c : name) {
+    if (!(c == '_' || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9'))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Built-in type OIDs (pg_type.h) that map onto typed batch columns
+constexpr pqxx::oid kInt2Oid = 21;
+constexpr pqxx::oid kInt4Oid = 23;
+constexpr pqxx::oid kInt8Oid = 20;
+constexpr pqxx::oid kFloat4Oid = 700;
+constexpr pqxx::oid kFloat8Oid = 701;
+
+ColumnType columnTypeForOid(pqxx::oid type) {
+  switch (type) {
+  case kInt2Oid:
+  case kInt4Oid:
+  case kInt8Oid:
+    return ColumnType::INT64;
+  case kFloat4Oid:
+  case kFloat8Oid:
+    return ColumnType::DOUBLE;
+  default:
+    return ColumnType::STRING;
+  }
+}
+
+void appendField(Column &column, const pqxx::field &field) {
+  if (field.is_null()) {
+    column.appendNull();
+    return;
+  }
+  const char *text = field.c_str();
+  switch (column.type()) {
+  case ColumnType::INT64: {
+    int64_t value = 0;
+    std::from_chars(text, text + field.size(), value);
+    column.appendInt64(value);
+    break;
+  }
+  case ColumnType::DOUBLE:
+    // strtod also handles the NaN/Infinity spellings PostgreSQL emits
+    column.appendDouble(std::strtod(text, nullptr));
+    break;
+  case ColumnType::STRING:
+    column.appendString(std::string_view(text, field.size()));
+    break;
+  }
+}
+
+} // namespace
+
+struct QueryCursor::State {
+  DatabaseConnectionPool *pool = nullptr;
+  std::shared_ptr<pqxx::connection> conn;
+  std::unique_ptr<pqxx::work> txn;
+  std::string name;
+  size_t batchSize = 0;
+  size_t rowsFetched = 0;
+  // Built from the first batch and shared by the rest
+  std::shared_ptr<const BatchSchema> schema;
+};
+
+QueryCursor::QueryCursor(std::unique_ptr<State> state)
+    : state_(std::move(state)) {}
+
+QueryCursor::~QueryCursor() { close(); }
+
+bool QueryCursor::fetch(RecordBatch &batch) {
+  if (!isOpen()) {
+    return false;
+  }
+
+  pqxx::result result;
+  try {
+    result = state_->txn->exec("FETCH FORWARD " +
+                               std::to_string(state_->batchSize) + " FROM " +
+                               state_->name);
+  } catch (const std::exception &e) {
+    close();
+    etl::ErrorContext context;
+    context["cursor"] = state_->name;
+    context["error"] = e.what();
+    throw etl::SystemException(etl::ErrorCode::DATABASE_ERROR,
+                               "Cursor fetch failed", "DatabaseManager",
+                               context);
+  }
+
+  if (!state_->schema) {
+    std::vector<FieldDescriptor> fields;
+    for (size_t col = 0; col < result.columns(); ++col) {
+      fields.push_back({result.column_name(col),
+                        columnTypeForOid(result.column_type(col))});
+    }
+    state_->schema = std::make_shared<const BatchSchema>(std::move(fields));
+  }
+
+  std::vector<Column> columns;
+  columns.reserve(state_->schema->fieldCount());
+  for (const auto &field : state_->schema->fields()) {
+    columns.emplace_back(field.type);
+    columns.back().reserve(result.size());
+  }
+  for (const auto &row : result) {
+    for (size_t col = 0; col < columns.size(); ++col) {
+      appendField(columns[col], row[col]);
+    }
+  }
+  batch = RecordBatch(state_->schema, std::move(columns));
+  state_->rowsFetched += result.size();
+
+  // A short batch means the cursor is exhausted; give the connection back
+  // now rather than on the caller's next fetch
+  if (result.size() < state_->batchSize) {
+    close();
+  }
+  return result.size() > 0;
+}
+
+void QueryCursor::close() {
+  if (!isOpen()) {
+    return;
+  }
+  try {
+    // Read-only work; ending the transaction also drops the cursor
+    state_->txn->abort();
+  } catch (const std::exception &e) {
+    DB_LOG_WARN("Failed to close cursor " + state_->name + ": " + e.what());
+  }
+  state_->txn.reset();
+  state_->pool->releaseConnection(state_->conn);
+  state_->conn.reset();
+}
+
+bool QueryCursor::isOpen() const { return state_ && state_->txn != nullptr; }
+
+size_t QueryCursor::rowsFetched() const {
+  return state_ ? state_->rowsFetched : 0;
+}
+
 DatabaseManager::DatabaseManager() : pImpl(std::make_unique<Impl>()) {}
 
 DatabaseManager::~DatabaseManager() { disconnect(); }
@@ -162,15 +346,7 @@ bool DatabaseManager::executeQuery(const std::string &query,
                (query.length() > 100 ? "..." : ""));
 
   try {
-    auto conn = pImpl->connectionPool->acquireConnection();
-    pqxx::work txn(*conn);
-    pqxx::params pqxx_params;
-    for (const auto &param : params) {
-      pqxx_params.append(param);
-    }
-    txn.exec_params(query, pqxx_params);
-    txn.commit();
-    pImpl->connectionPool->releaseConnection(conn);
+    pImpl->execParams(query, params);
     DB_LOG_DEBUG("Parameterized query executed successfully");
     return true;
   } catch (const std::exception &e) {
@@ -238,15 +414,7 @@ DatabaseManager::selectQuery(const std::string &query,
                (query.length() > 100 ? "..." : ""));
 
   try {
-    auto conn = pImpl->connectionPool->acquireConnection();
-    pqxx::work txn(*conn);
-    pqxx::params pqxx_params;
-    for (const auto &param : params) {
-      pqxx_params.append(param);
-    }
-    pqxx::result result = txn.exec_params(query, pqxx_params);
-    txn.commit();
-    pImpl->connectionPool->releaseConnection(conn);
+    pqxx::result result = pImpl->execParams(query, params);
 
     std::vector<std::vector<std::string>> rows;
 
@@ -277,6 +445,48 @@ DatabaseManager::selectQuery(const std::string &query,
   }
 }
 
+std::unique_ptr<QueryCursor>
+DatabaseManager::openCursor(const std::string &query,
+                            const std::vector<std::string> &params,
+                            size_t batchSize) {
+  static std::atomic<uint64_t> nextCursorId{0};
+
+  etl::ErrorContext context;
+  context["operation"] = "openCursor";
+  if (!isConnected()) {
+    throw etl::SystemException(etl::ErrorCode::DATABASE_ERROR,
+                               "Cannot open cursor: database not connected",
+                               "DatabaseManager", context);
+  }
+
+  DB_LOG_DEBUG("Opening cursor for query: " + query.substr(0, 100) +
+               (query.length() > 100 ? "..." : ""));
+
+  auto state = std::make_unique<QueryCursor::State>();
+  state->pool = pImpl->connectionPool.get();
+  state->batchSize = std::max<size_t>(1, batchSize);
+  state->name = "etl_cursor_" + std::to_string(nextCursorId++);
+  state->conn = pImpl->connectionPool->acquireConnection();
+  try {
+    state->txn = std::make_unique<pqxx::work>(*state->conn);
+    pqxx::params pqxx_params;
+    for (const auto &param : params) {
+      pqxx_params.append(param);
+    }
+    state->txn->exec_params("DECLARE " + state->name +
+                                " NO SCROLL CURSOR FOR " + query,
+                            pqxx_params);
+  } catch (const std::exception &e) {
+    state->txn.reset();
+    pImpl->connectionPool->releaseConnection(state->conn);
+    context["error"] = e.what();
+    throw etl::SystemException(etl::ErrorCode::DATABASE_ERROR,
+                               "Failed to open cursor", "DatabaseManager",
+                               context);
+  }
+  return std::make_unique<QueryCursor>(std::move(state));
+}
+
 bool DatabaseManager::beginTransaction() {
   if (!isConnected()) {
     DB_LOG_ERROR("Cannot begin transaction: database not connected");
@@ -327,3 +537,153 @@ bool DatabaseManager::isPoolHealthy() const {
   return pImpl->connected && pImpl->connectionPool &&
          pImpl->connectionPool->isHealthy();
 }
+
+BulkLoadResult
+DatabaseManager::bulkLoad(const std::string &table,
+                          const std::vector<std::string> &columns,
+                          const RecordBatch &batch,
+                          const BulkLoadOptions &options) {
+  BulkLoadResult result;
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::string> targetColumns = columns;
+  if (targetColumns.empty()) {
+    for (const auto &field : batch.schema()->fields()) {
+      targetColumns.push_back(field.name);
+    }
+  }
+
+  auto rejectAll = [&](const std::string &reason) {
+    DB_LOG_ERROR("Bulk load into " + table + " rejected: " + reason);
+    result.rowsFailed = batch.numRows();
+    result.batchesFailed = batch.numRows() > 0 ? 1 : 0;
+    result.errors.push_back(reason);
+    return result;
+  };
+
+  if (!isConnected()) {
+    return rejectAll("database not connected");
+  }
+  if (!isPlainIdentifier(table)) {
+    return rejectAll("invalid table name");
+  }
+  for (const auto &column : targetColumns) {
+    if (!isPlainIdentifier(column)) {
+      return rejectAll("invalid column name: " + column);
+    }
+  }
+  if (batch.numRows() == 0) {
+    return result;
+  }
+
+  // Resolve each target column to its batch column once, not once per row
+  std::vector<const Column *> sources;
+  sources.reserve(targetColumns.size());
+  for (const auto &column : targetColumns) {
+    sources.push_back(batch.column(column));
+  }
+
+  size_t batchSize = std::max<size_t>(1, options.batchSize);
+  for (size_t begin = 0; begin < batch.numRows(); begin += batchSize) {
+    size_t end = std::min(batch.numRows(), begin + batchSize);
+    pImpl->copyRange(table, targetColumns, sources, begin, end, options,
+                     result);
+  }
+
+  result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  DB_LOG_INFO("Bulk loaded " + std::to_string(result.rowsLoaded) + " rows (" +
+              std::to_string(result.rowsFailed) + " failed) into " + table +
+              " in " + std::to_string(result.elapsed.count()) + "ms");
+  return result;
+}
+
+pqxx::result
+DatabaseManager::Impl::execParams(const std::string &query,
+                                  const std::vector<std::string> &params) {
+  pqxx::params pqxx_params;
+  for (const auto &param : params) {
+    pqxx_params.append(param);
+  }
+
+  // Runs through the connection's prepared statement cache. If the server
+  // no longer knows a cached statement (e.g. after DISCARD ALL), the cache
+  // is dropped and the query retried once, preparing it again.
+  for (int attempt = 0;; ++attempt) {
+    auto conn = connectionPool->acquireConnection();
+    PooledConnectionGuard guard(*connectionPool, conn);
+    std::string statement = connectionPool->prepareStatement(conn, query);
+    try {
+      pqxx::work txn(*conn);
+      pqxx::result result = statement.empty()
+                                ? txn.exec_params(query, pqxx_params)
+                                : txn.exec_prepared(statement, pqxx_params);
+      txn.commit();
+      return result;
+    } catch (const pqxx::sql_error &e) {
+      // 26000: invalid_sql_statement_name
+      if (statement.empty() || attempt > 0 || e.sqlstate() != "26000") {
+        throw;
+      }
+      connectionPool->invalidatePreparedStatements(conn);
+    }
+  }
+}
+
+void DatabaseManager::Impl::copyRange(
+    const std::string &table, const std::vector<std::string> &columns,
+    const std::vector<const Column *> &sources, size_t begin, size_t end,
+    const BulkLoadOptions &options, BulkLoadResult &result) {
+  bool rowError = false;
+  try {
+    auto conn = connectionPool->acquireConnection();
+    if (!conn) {
+      throw pqxx::broken_connection("no database connection available");
+    }
+    PooledConnectionGuard guard(*connectionPool, conn);
+
+    pqxx::work txn(*conn);
+    pqxx::stream_to stream(txn, table, columns);
+    std::string line;
+    for (size_t row = begin; row < end; ++row) {
+      formatCopyRow(line, sources, row);
+      stream.write_raw_line(line);
+    }
+    stream.complete();
+    txn.commit();
+
+    result.rowsLoaded += end - begin;
+    ++result.batchesCommitted;
+    return;
+  } catch (const pqxx::broken_connection &e) {
+    if (result.errors.size() < options.maxErrorMessages) {
+      result.errors.push_back(e.what());
+    }
+  } catch (const pqxx::sql_error &e) {
+    // Only data exceptions (22) and integrity violations (23) come from
+    // individual rows; anything else would fail every half again
+    const std::string &state = e.sqlstate();
+    rowError = state.rfind("22", 0) == 0 || state.rfind("23", 0) == 0;
+    if (result.errors.size() < options.maxErrorMessages) {
+      result.errors.push_back(e.what());
+    }
+  } catch (const std::exception &e) {
+    if (result.errors.size() < options.maxErrorMessages) {
+      result.errors.push_back(e.what());
+    }
+  }
+
+  // A bad row aborts the whole COPY; split the range until the failing rows
+  // are isolated so the rest still loads.
+  size_t count = end - begin;
+  if (!options.isolateFailedRows || count == 1 || !rowError) {
+    DB_LOG_WARN("Bulk load of " + std::to_string(count) + " rows into " +
+                table + " failed");
+    result.rowsFailed += count;
+    ++result.batchesFailed;
+    return;
+  }
+  size_t mid = begin + count / 2;
+  copyRange(table, columns, sources, begin, mid, options, result);
+  copyRange(table, columns, sources, mid, end, options, result);
+}
@@ -89,6 +89,18 @@ std::vector<std::string> DatabaseSchema::getCreateTableStatements() {
             timestamp TIMESTAMP WITH TIME ZONE DEFAULT CURRENT_TIMESTAMP,
             context JSONB
         );
+        )",
+
+          // Bulk-loaded job output (target of LOAD and FULL_ETL jobs)
+          R"(
+        CREATE TABLE IF NOT EXISTS processed_data (
+            id BIGSERIAL PRIMARY KEY,
+            job_id VARCHAR(255) NOT NULL,
+            record_id VARCHAR(255),
+            name TEXT,
+            age INTEGER,
+            loaded_at TIMESTAMP WITH TIME ZONE DEFAULT CURRENT_TIMESTAMP
+        );
         )",
 
           // Configuration table (for dynamic configuration storage)
@@ -111,6 +123,11 @@ std::vector<std::string> DatabaseSchema::getIndexStatements() {
       "CREATE INDEX IF NOT EXISTS idx_etl_jobs_status ON etl_jobs(status);",
       "CREATE INDEX IF NOT EXISTS idx_etl_jobs_created_at ON "
       "etl_jobs(created_at);",
+      // Keyset pagination (scanned backwards), overall and per status
+      "CREATE INDEX IF NOT EXISTS idx_etl_jobs_page ON "
+      "etl_jobs(created_at, job_id);",
+      "CREATE INDEX IF NOT EXISTS idx_etl_jobs_status_page ON "
+      "etl_jobs(status, created_at, job_id);",
       "CREATE INDEX IF NOT EXISTS idx_etl_jobs_job_type ON etl_jobs(job_type);",
       "CREATE INDEX IF NOT EXISTS idx_job_monitoring_job_id ON "
       "job_monitoring(job_id);",
@@ -118,6 +135,8 @@ std::vector<std::string> DatabaseSchema::getIndexStatements() {
       "CREATE INDEX IF NOT EXISTS idx_job_logs_timestamp ON "
       "job_logs(timestamp);",
       "CREATE INDEX IF NOT EXISTS idx_job_logs_level ON job_logs(level);",
+      "CREATE INDEX IF NOT EXISTS idx_processed_data_job_id ON "
+      "processed_data(job_id);",
       "CREATE INDEX IF NOT EXISTS idx_configuration_category ON "
       "configuration(category);"};
 }
@@ -1,6 +1,8 @@
 #include "etl_job_repository.hpp"
 #include "database_manager.hpp"
 #include "logger.hpp"
+#include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <ctime>
 #include <iomanip>
@@ -366,6 +368,140 @@ std::vector<ETLJob> ETLJobRepository::getActiveJobs() {
   return jobs;
 }
 
+JobPage ETLJobRepository::listJobs(const JobPageQuery &query) {
+  JobPage page;
+
+  if (!dbManager_ || !dbManager_->isConnected()) {
+    ETL_LOG_ERROR("Database not connected");
+    return page;
+  }
+
+  int64_t afterMicros = 0;
+  std::string afterJobId;
+  if (!query.cursor.empty() &&
+      !decodePageCursor(query.cursor, afterMicros, afterJobId)) {
+    ETL_LOG_WARN("Ignoring request with invalid job page cursor");
+    return page;
+  }
+
+  try {
+    // Only the list-view columns; created_at travels as integer
+    // microseconds so the cursor round-trips exactly.
+    std::string sql =
+        "SELECT job_id, job_type, status, records_processed, "
+        "records_successful, records_failed, "
+        "(EXTRACT(EPOCH FROM created_at) * 1000000)::BIGINT FROM etl_jobs";
+    std::vector<std::string> params;
+    std::vector<std::string> conditions;
+    if (query.status) {
+      params.push_back(jobStatusToString(*query.status));
+      conditions.push_back("status = $" + std::to_string(params.size()));
+    }
+    if (!query.cursor.empty()) {
+      params.push_back(std::to_string(afterMicros));
+      std::string micros = "$" + std::to_string(params.size());
+      params.push_back(afterJobId);
+      std::string jobId = "$" + std::to_string(params.size());
+      conditions.push_back("(created_at, job_id) < (TIMESTAMPTZ 'epoch' + " +
+                           micros + "::BIGINT * INTERVAL '1 microsecond', " +
+                           jobId + ")");
+    }
+    for (size_t i = 0; i < conditions.size(); ++i) {
+      sql += (i == 0 ? " WHERE " : " AND ") + conditions[i];
+    }
+
+    // One extra row tells whether another page follows
+    size_t limit = std::max<size_t>(1, query.limit);
+    params.push_back(std::to_string(limit + 1));
+    sql += " ORDER BY created_at DESC, job_id DESC LIMIT $" +
+           std::to_string(params.size());
+
+    auto result = dbManager_->selectQuery(sql, params);
+    int64_t lastMicros = 0;
+    for (size_t i = 1; i < result.size() && page.jobs.size() < limit; ++i) {
+      const auto &row = result[i];
+      if (row.size() < 7) {
+        throw std::runtime_error("Invalid job summary row data");
+      }
+      JobSummary summary;
+      summary.jobId = row[0];
+      summary.type = stringToJobType(row[1]);
+      summary.status = stringToJobStatus(row[2]);
+      summary.recordsProcessed = std::stoi(row[3]);
+      summary.recordsSuccessful = std::stoi(row[4]);
+      summary.recordsFailed = std::stoi(row[5]);
+      lastMicros = std::stoll(row[6]);
+      summary.createdAt = std::chrono::system_clock::time_point(
+          std::chrono::duration_cast<std::chrono::system_clock::duration>(
+              std::chrono::microseconds(lastMicros)));
+      page.jobs.push_back(std::move(summary));
+    }
+
+    // Row 0 is the header, so more than limit + 1 rows means a next page
+    if (result.size() > limit + 1) {
+      page.nextCursor = encodePageCursor(lastMicros, page.jobs.back().jobId);
+    }
+  } catch (const std::exception &e) {
+    ETL_LOG_ERROR("Failed to list jobs: " + std::string(e.what()));
+    page = JobPage{};
+  }
+
+  return page;
+}
+
+std::string ETLJobRepository::encodePageCursor(int64_t createdAtMicros,
+                                               const std::string &jobId) {
+  static constexpr char kHex[] = "0123456789abcdef";
+  std::string plain = std::to_string(createdAtMicros) + ":" + jobId;
+  std::string cursor;
+  cursor.reserve(plain.size() * 2);
+  for (unsigned char c : plain) {
+    cursor += kHex[c >> 4];
+    cursor += kHex[c & 0x0F];
+  }
+  return cursor;
+}
+
+bool ETLJobRepository::decodePageCursor(const std::string &cursor,
+                                        int64_t &createdAtMicros,
+                                        std::string &jobId) {
+  auto nibble = [](char c) -> int {
+    if (c >= '0' && c <= '9')
+      return c - '0';
+    if (c >= 'a' && c <= 'f')
+      return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+      return c - 'A' + 10;
+    return -1;
+  };
+
+  if (cursor.empty() || cursor.size() % 2 != 0) {
+    return false;
+  }
+  std::string plain;
+  plain.reserve(cursor.size() / 2);
+  for (size_t i = 0; i < cursor.size(); i += 2) {
+    int high = nibble(cursor[i]);
+    int low = nibble(cursor[i + 1]);
+    if (high < 0 || low < 0) {
+      return false;
+    }
+    plain += static_cast<char>((high << 4) | low);
+  }
+
+  size_t colon = plain.find(':');
+  if (colon == 0 || colon == std::string::npos || colon + 1 == plain.size()) {
+    return false;
+  }
+  auto [end, ec] =
+      std::from_chars(plain.data(), plain.data() + colon, createdAtMicros);
+  if (ec != std::errc() || end != plain.data() + colon) {
+    return false;
+  }
+  jobId = plain.substr(colon + 1);
+  return true;
+}
+
 ETLJob ETLJobRepository::jobFromRow(const std::vector<std::string> &row) {
   if (row.size() < 30) {
     throw std::runtime_error("Invalid job row data");
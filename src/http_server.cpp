@@ -2,7 +2,9 @@
 #include "connection_pool_manager.hpp"
 #include "etl_exceptions.hpp"
 #include "logger.hpp"
+#include "performance_monitor.hpp"
 #include "pooled_session.hpp"
+#include "request_executor.hpp"
 #include "request_handler.hpp"
 #include "server_config.hpp"
 #include "timeout_manager.hpp"
@@ -145,11 +147,24 @@ struct HttpServer::Impl {
   std::shared_ptr<WebSocketManager> wsManager;
   std::shared_ptr<ConnectionPoolManager> poolManager;
   std::shared_ptr<TimeoutManager> timeoutManager;
+  std::shared_ptr<PerformanceMonitor> performanceMonitor;
+  // Runs request handlers so blocking calls don't stall the I/O threads
+  std::shared_ptr<RequestExecutor> requestExecutor;
   std::unique_ptr<net::io_context> ioc;
   std::vector<std::thread> threadPool;
   std::shared_ptr<Listener>
       listener; // keep handle to listener for proper shutdown
   bool running = false;
+
+  void createPoolManager() {
+    poolManager = std::make_shared<ConnectionPoolManager>(
+        *ioc, config.minConnections, config.maxConnections,
+        config.idleTimeout, handler, wsManager, timeoutManager,
+        ConnectionPoolManager::MonitorConfig{performanceMonitor},
+        ConnectionPoolManager::QueueConfig{config.maxQueueSize,
+                                           config.maxQueueWaitTime});
+    poolManager->setRequestExecutor(requestExecutor);
+  }
 };
 
 HttpServer::HttpServer(const std::string &address, unsigned short port,
@@ -217,15 +232,27 @@ void HttpServer::start() {
         *pImpl->ioc, pImpl->config.connectionTimeout,
         pImpl->config.requestTimeout);
 
+    if (pImpl->config.enableMetrics) {
+      pImpl->performanceMonitor = std::make_shared<PerformanceMonitor>();
+    }
+
+    // Blocking handlers run on their own bounded pool; 0 threads keeps
+    // them inline on the I/O threads
+    if (pImpl->config.handlerThreads > 0) {
+      HTTP_LOG_DEBUG("HttpServer::start() - Creating request executor with " +
+                     std::to_string(pImpl->config.handlerThreads) +
+                     " threads");
+      RequestExecutorConfig executorConfig;
+      executorConfig.workerCount = pImpl->config.handlerThreads;
+      executorConfig.maxQueueSize = pImpl->config.handlerQueueSize;
+      executorConfig.maxQueuePerRoute = pImpl->config.handlerRouteQueueSize;
+      pImpl->requestExecutor =
+          std::make_shared<RequestExecutor>(std::move(executorConfig));
+    }
+
     // Initialize ConnectionPoolManager
     HTTP_LOG_DEBUG("HttpServer::start() - Creating ConnectionPoolManager");
-    pImpl->poolManager = std::make_shared<ConnectionPoolManager>(
-        *pImpl->ioc, pImpl->config.minConnections, pImpl->config.maxConnections,
-        pImpl->config.idleTimeout, pImpl->handler, pImpl->wsManager,
-        pImpl->timeoutManager,
-        ConnectionPoolManager::MonitorConfig{nullptr}, // performanceMonitor
-        ConnectionPoolManager::QueueConfig{pImpl->config.maxQueueSize,
-                                           pImpl->config.maxQueueWaitTime});
+    pImpl->createPoolManager();
 
     // Start the cleanup timer for the connection pool
     pImpl->poolManager->startCleanupTimer();
@@ -292,6 +319,14 @@ void HttpServer::stop() {
     pImpl->listener->stop();
   }
 
+  // Let queued handlers finish while the IO context can still write their
+  // responses
+  if (pImpl->requestExecutor) {
+    HTTP_LOG_DEBUG("HttpServer::stop() - Draining request executor");
+    pImpl->requestExecutor->shutdown();
+    pImpl->requestExecutor.reset();
+  }
+
   // Stop the IO context
   pImpl->ioc->stop();
 
@@ -334,13 +369,7 @@ void HttpServer::setRequestHandler(std::shared_ptr<RequestHandler> handler) {
     HTTP_LOG_DEBUG("HttpServer::setRequestHandler() - Recreating connection "
                    "pool with new handler");
     pImpl->poolManager->shutdown();
-    pImpl->poolManager = std::make_shared<ConnectionPoolManager>(
-        *pImpl->ioc, pImpl->config.minConnections, pImpl->config.maxConnections,
-        pImpl->config.idleTimeout, pImpl->handler, pImpl->wsManager,
-        pImpl->timeoutManager,
-        ConnectionPoolManager::MonitorConfig{nullptr}, // performanceMonitor
-        ConnectionPoolManager::QueueConfig{pImpl->config.maxQueueSize,
-                                           pImpl->config.maxQueueWaitTime});
+    pImpl->createPoolManager();
     if (pImpl->running) {
       pImpl->poolManager->startCleanupTimer();
     }
@@ -357,13 +386,7 @@ void HttpServer::setWebSocketManager(
     HTTP_LOG_DEBUG("HttpServer::setWebSocketManager() - Recreating connection "
                    "pool with new WebSocket manager");
     pImpl->poolManager->shutdown();
-    pImpl->poolManager = std::make_shared<ConnectionPoolManager>(
-        *pImpl->ioc, pImpl->config.minConnections, pImpl->config.maxConnections,
-        pImpl->config.idleTimeout, pImpl->handler, pImpl->wsManager,
-        pImpl->timeoutManager,
-        ConnectionPoolManager::MonitorConfig{nullptr}, // performanceMonitor
-        ConnectionPoolManager::QueueConfig{pImpl->config.maxQueueSize,
-                                           pImpl->config.maxQueueWaitTime});
+    pImpl->createPoolManager();
     if (pImpl->running) {
       pImpl->poolManager->startCleanupTimer();
     }
@@ -412,6 +435,10 @@ std::shared_ptr<TimeoutManager> HttpServer::getTimeoutManager() {
   return pImpl->timeoutManager;
 }
 
+std::shared_ptr<PerformanceMonitor> HttpServer::getPerformanceMonitor() {
+  return pImpl->performanceMonitor;
+}
+
 std::shared_ptr<ETLJobManager> HttpServer::getJobManager() {
   if (pImpl && pImpl->handler) {
     return pImpl->handler->getJobManager();
@@ -18,6 +18,30 @@ const std::regex InputValidator::tokenPattern_(R"(^[a-zA-Z0-9._-]{10,512}$)");
 const std::regex InputValidator::pathPattern_(R"(^/api/[a-zA-Z0-9/_-]*$)");
 
 namespace {
+// Case-insensitive substring search; `lowerNeedle` must be lowercase
+bool containsIgnoreCase(std::string_view haystack,
+                        std::string_view lowerNeedle) {
+  if (lowerNeedle.size() > haystack.size()) {
+    return false;
+  }
+  for (size_t i = 0; i + lowerNeedle.size() <= haystack.size(); ++i) {
+    size_t j = 0;
+    while (j < lowerNeedle.size() &&
+           std::tolower(static_cast<unsigned char>(haystack[i + j])) ==
+               lowerNeedle[j]) {
+      ++j;
+    }
+    if (j == lowerNeedle.size()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view lowerB) {
+  return a.size() == lowerB.size() && containsIgnoreCase(a, lowerB);
+}
+
 // Utility function to normalize status values to uppercase
 std::string normalizeStatus(const std::string &status) {
   std::string normalized = status;
@@ -343,22 +367,17 @@ InputValidator::ValidationResult InputValidator::validateJobQueryParams(
         result.addError("limit", "Limit must be a valid integer",
                         "INVALID_LIMIT");
       }
-    } else if (key == "offset") {
-      try {
-        int offset = std::stoi(value);
-        if (offset < 0) {
-          result.addError("offset", "Offset must be non-negative",
-                          "INVALID_OFFSET");
-        }
-      } catch (const std::exception &) {
-        result.addError("offset", "Offset must be a valid integer",
-                        "INVALID_OFFSET");
-      }
-    } else if (key == "job_id") {
-      if (!isValidJobId(value)) {
-        result.addError("job_id", "Invalid job ID format", "INVALID_JOB_ID");
+    } else if (key == "cursor") {
+      // Page cursors are hex strings issued by a previous response
+      bool isHex = !value.empty() && value.size() <= 1024 &&
+                   std::all_of(value.begin(), value.end(), [](char c) {
+                     return std::isxdigit(static_cast<unsigned char>(c));
+                   });
+      if (!isHex) {
+        result.addError("cursor", "Invalid page cursor", "INVALID_CURSOR");
       }
     } else {
+      // offset and job_id too: the list pages by cursor only
       result.addError(key, "Unknown query parameter", "UNKNOWN_PARAMETER");
     }
   }
@@ -391,7 +410,7 @@ InputValidator::ValidationResult InputValidator::validateMetricsParams(
 }
 
 InputValidator::ValidationResult
-InputValidator::validateEndpointPath(const std::string &path) {
+InputValidator::validateEndpointPath(std::string_view path) {
   ValidationResult result;
 
   if (path.empty()) {
@@ -404,14 +423,14 @@ InputValidator::validateEndpointPath(const std::string &path) {
     return result;
   }
 
-  if (!std::regex_match(path, pathPattern_)) {
+  if (!std::regex_match(path.begin(), path.end(), pathPattern_)) {
     result.addError("path", "Invalid path format", "INVALID_PATH");
     return result;
   }
 
   // Check for path traversal attempts
-  if (path.find("..") != std::string::npos ||
-      path.find("//") != std::string::npos) {
+  if (path.find("..") != std::string_view::npos ||
+      path.find("//") != std::string_view::npos) {
     result.addError("path", "Path traversal detected", "SECURITY_VIOLATION");
     return result;
   }
@@ -420,7 +439,7 @@ InputValidator::validateEndpointPath(const std::string &path) {
 }
 
 InputValidator::ValidationResult
-InputValidator::validateQueryParameters(const std::string &queryString) {
+InputValidator::validateQueryParameters(std::string_view queryString) {
   ValidationResult result;
 
   if (queryString.length() > 2048) {
@@ -428,10 +447,20 @@ InputValidator::validateQueryParameters(const std::string &queryString) {
     return result;
   }
 
-  auto params = parseQueryString(queryString);
+  // Check for parameter injection, scanning the pairs in place
+  while (!queryString.empty()) {
+    size_t amp = queryString.find('&');
+    std::string_view param = queryString.substr(0, amp);
+    queryString = amp == std::string_view::npos ? std::string_view{}
+                                                : queryString.substr(amp + 1);
+
+    size_t equalPos = param.find('=');
+    if (equalPos == std::string_view::npos) {
+      continue;
+    }
+    std::string_view key = param.substr(0, equalPos);
+    std::string_view value = param.substr(equalPos + 1);
 
-  // Check for parameter injection
-  for (const auto &[key, value] : params) {
     if (containsSqlInjection(key) || containsSqlInjection(value)) {
       result.addError("query", "Potential SQL injection in query parameters",
                       "SECURITY_VIOLATION");
@@ -454,11 +483,11 @@ bool InputValidator::isValidHttpMethod(
          allowedMethods.end();
 }
 
-bool InputValidator::isValidContentType(const std::string &contentType) {
+bool InputValidator::isValidContentType(std::string_view contentType) {
   return contentType == "application/json" ||
          contentType == "application/x-www-form-urlencoded" ||
-         contentType.find("application/json;") == 0 ||
-         contentType.find("application/x-www-form-urlencoded;") == 0;
+         contentType.starts_with("application/json;") ||
+         contentType.starts_with("application/x-www-form-urlencoded;");
 }
 
 InputValidator::ValidationResult
@@ -497,42 +526,31 @@ bool InputValidator::isValidRequestSize(size_t contentLength, size_t maxSize) {
 InputValidator::ValidationResult InputValidator::validateRequestHeaders(
     const std::unordered_map<std::string, std::string> &headers) {
   ValidationResult result;
+  for (const auto &[key, value] : headers) {
+    validateRequestHeader(key, value, result);
+  }
+  return result;
+}
 
-  // Helper function for case-insensitive header lookup
-  auto findHeader = [&](const std::string &target)
-      -> std::unordered_map<std::string, std::string>::const_iterator {
-    for (auto it = headers.begin(); it != headers.end(); ++it) {
-      std::string lowerKey = it->first;
-      std::transform(lowerKey.begin(), lowerKey.end(), lowerKey.begin(),
-                     ::tolower);
-      if (lowerKey == target) {
-        return it;
-      }
-    }
-    return headers.end();
-  };
-
-  // Check for required headers (case-insensitive)
-  auto contentTypeIt = findHeader("content-type");
-  if (contentTypeIt != headers.end()) {
-    if (!isValidContentType(contentTypeIt->second)) {
-      result.addError("content-type", "Unsupported content type",
-                      "INVALID_CONTENT_TYPE");
-    }
+void InputValidator::validateRequestHeader(std::string_view name,
+                                           std::string_view value,
+                                           ValidationResult &result) {
+  // Header names are case-insensitive
+  if (equalsIgnoreCase(name, "content-type") && !isValidContentType(value)) {
+    result.addError("content-type", "Unsupported content type",
+                    "INVALID_CONTENT_TYPE");
   }
 
   // Check for suspicious headers
-  for (const auto &[key, value] : headers) {
-    if (containsXss(key) || containsXss(value)) {
-      result.addError(key, "Potential XSS in header", "SECURITY_VIOLATION");
-    }
-
-    if (value.length() > 8192) { // 8KB limit per header
-      result.addError(key, "Header value too long", "HEADER_TOO_LONG");
-    }
+  if (containsXss(name) || containsXss(value)) {
+    result.addError(std::string(name), "Potential XSS in header",
+                    "SECURITY_VIOLATION");
   }
 
-  return result;
+  if (value.length() > 8192) { // 8KB limit per header
+    result.addError(std::string(name), "Header value too long",
+                    "HEADER_TOO_LONG");
+  }
 }
 
 std::string InputValidator::extractJsonField(const std::string &json,
@@ -679,25 +697,14 @@ std::string InputValidator::extractJsonValue(const std::string &json,
   return value;
 }
 
-bool InputValidator::containsSqlInjection(const std::string &input) {
-  std::string lowerInput = input;
-  std::transform(lowerInput.begin(), lowerInput.end(), lowerInput.begin(),
-                 ::tolower);
-
+bool InputValidator::containsSqlInjection(std::string_view input) {
   // Common SQL injection patterns
-  std::vector<std::string> sqlPatterns = {"' or '1'='1",
-                                          "' or 1=1",
-                                          "'; drop table",
-                                          "'; delete from",
-                                          "union select",
-                                          "' union select",
-                                          "/*",
-                                          "*/",
-                                          "xp_",
-                                          "sp_"};
-
-  for (const auto &pattern : sqlPatterns) {
-    if (lowerInput.find(pattern) != std::string::npos) {
+  static constexpr std::string_view sqlPatterns[] = {
+      "' or '1'='1", "' or 1=1", "'; drop table", "'; delete from",
+      "union select", "' union select", "/*", "*/", "xp_", "sp_"};
+
+  for (auto pattern : sqlPatterns) {
+    if (containsIgnoreCase(input, pattern)) {
       return true;
     }
   }
@@ -705,13 +712,8 @@ bool InputValidator::containsSqlInjection(const std::string &input) {
   return false;
 }
 
-bool InputValidator::containsXss(const std::string &input) {
-  std::string lowerInput = input;
-  std::transform(lowerInput.begin(), lowerInput.end(), lowerInput.begin(),
-                 ::tolower);
-
-  // Static set for O(1) lookups instead of linear search
-  static const std::unordered_set<std::string> xssPatterns = {
+bool InputValidator::containsXss(std::string_view input) {
+  static constexpr std::string_view xssPatterns[] = {
       "<script",
       "</script>",
       "javascript:",
@@ -746,8 +748,8 @@ bool InputValidator::containsXss(const std::string &input) {
       "onmouseenter=",
       "onmouseleave="};
 
-  for (const auto &pattern : xssPatterns) {
-    if (lowerInput.find(pattern) != std::string::npos) {
+  for (auto pattern : xssPatterns) {
+    if (containsIgnoreCase(input, pattern)) {
       return true;
     }
   }
@@ -40,6 +40,10 @@ std::string JobMetrics::toJson() const {
        << "\"timeToFirstError\":" << timeToFirstError.count()
        << ","
 
+       // Scheduler statistics
+       << "\"queueWaitTime\":" << queueWaitTime.count() << ","
+       << "\"queueDepth\":" << queueDepth << ","
+
        // Performance indicators
        << "\"throughputMBps\":" << std::fixed << std::setprecision(2)
        << throughputMBps << ","
@@ -75,6 +79,8 @@ JobMetrics JobMetrics::fromJson(const std::string &json) {
   std::regex errorRateRegex("\"errorRate\"\\s*:\\s*([0-9.]+)");
   std::regex consecutiveErrorsRegex("\"consecutiveErrors\"\\s*:\\s*(\\d+)");
   std::regex timeToFirstErrorRegex("\"timeToFirstError\"\\s*:\\s*(\\d+)");
+  std::regex queueWaitTimeRegex("\"queueWaitTime\"\\s*:\\s*(\\d+)");
+  std::regex queueDepthRegex("\"queueDepth\"\\s*:\\s*(\\d+)");
   std::regex throughputMBpsRegex("\"throughputMBps\"\\s*:\\s*([0-9.]+)");
   std::regex memoryEfficiencyRegex("\"memoryEfficiency\"\\s*:\\s*([0-9.]+)");
   std::regex cpuEfficiencyRegex("\"cpuEfficiency\"\\s*:\\s*([0-9.]+)");
@@ -137,6 +143,13 @@ JobMetrics JobMetrics::fromJson(const std::string &json) {
     metrics.timeToFirstError =
         std::chrono::milliseconds(std::stoll(match[1].str()));
   }
+  if (std::regex_search(json, match, queueWaitTimeRegex)) {
+    metrics.queueWaitTime =
+        std::chrono::milliseconds(std::stoll(match[1].str()));
+  }
+  if (std::regex_search(json, match, queueDepthRegex)) {
+    metrics.queueDepth = std::stoull(match[1].str());
+  }
   if (std::regex_search(json, match, throughputMBpsRegex)) {
     metrics.throughputMBps = std::stod(match[1].str());
   }
@@ -273,6 +286,9 @@ void JobMetrics::reset() {
   consecutiveErrors = 0;
   timeToFirstError = std::chrono::milliseconds(0);
 
+  queueWaitTime = std::chrono::milliseconds(0);
+  queueDepth = 0;
+
   throughputMBps = 0.0;
   memoryEfficiency = 0.0;
   cpuEfficiency = 0.0;
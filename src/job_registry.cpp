@@ -0,0 +1,214 @@
+#include "job_registry.hpp"
+
+JobRegistry::JobRegistry(size_t maxFinishedJobs)
+    : maxFinishedJobs_(maxFinishedJobs) {}
+
+bool JobRegistry::insert(const JobPtr &job) {
+  if (!job) {
+    return false;
+  }
+
+  std::vector<JobPtr> evicted;
+  EvictionHandler handler;
+  {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (byId_.find(job->jobId) != byId_.end()) {
+      return false;
+    }
+
+    uint64_t sequence = nextSequence_++;
+    auto &entry = byId_[job->jobId];
+    entry.job = job;
+    entry.sequence = sequence;
+    entry.indexedStatus = job->status;
+
+    ordered_.emplace(sequence, job);
+    byStatus_[static_cast<size_t>(job->status)].emplace(sequence, job);
+    byType_[static_cast<size_t>(job->type)].emplace(sequence, job);
+
+    if (isFinished(job->status)) {
+      std::lock_guard<std::mutex> lruLock(lruMutex_);
+      entry.finished = true;
+      entry.lruPosition = lru_.insert(lru_.begin(), job->jobId);
+    }
+
+    evicted = collectEvictions();
+    handler = evictionHandler_;
+  }
+
+  notifyEvicted(handler, evicted);
+  return true;
+}
+
+JobRegistry::JobPtr JobRegistry::find(std::string_view jobId) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = byId_.find(jobId);
+  if (it == byId_.end()) {
+    return nullptr;
+  }
+
+  if (it->second.finished) {
+    std::lock_guard<std::mutex> lruLock(lruMutex_);
+    lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+  }
+  return it->second.job;
+}
+
+JobRegistry::JobPtr JobRegistry::peek(std::string_view jobId) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = byId_.find(jobId);
+  return it == byId_.end() ? nullptr : it->second.job;
+}
+
+std::vector<JobRegistry::JobPtr> JobRegistry::all() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return values(ordered_);
+}
+
+std::vector<JobRegistry::JobPtr>
+JobRegistry::byStatus(JobStatus status) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return values(byStatus_[static_cast<size_t>(status)]);
+}
+
+std::vector<JobRegistry::JobPtr> JobRegistry::byType(JobType type) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return values(byType_[static_cast<size_t>(type)]);
+}
+
+JobStatus JobRegistry::setStatus(const JobPtr &job, JobStatus status) {
+  std::vector<JobPtr> evicted;
+  EvictionHandler handler;
+  JobStatus previous;
+  {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    previous = job->status;
+    job->status = status;
+
+    auto it = byId_.find(job->jobId);
+    if (it == byId_.end() || it->second.job != job) {
+      return previous; // Not registered; nothing to index
+    }
+    reindexStatus(it->second, status);
+    evicted = collectEvictions();
+    handler = evictionHandler_;
+  }
+
+  notifyEvicted(handler, evicted);
+  return previous;
+}
+
+bool JobRegistry::transitionStatus(const JobPtr &job, JobStatus expected,
+                                   JobStatus desired) {
+  std::vector<JobPtr> evicted;
+  EvictionHandler handler;
+  {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (job->status != expected) {
+      return false;
+    }
+    job->status = desired;
+
+    auto it = byId_.find(job->jobId);
+    if (it != byId_.end() && it->second.job == job) {
+      reindexStatus(it->second, desired);
+      evicted = collectEvictions();
+      handler = evictionHandler_;
+    }
+  }
+
+  notifyEvicted(handler, evicted);
+  return true;
+}
+
+size_t JobRegistry::size() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return byId_.size();
+}
+
+uint64_t JobRegistry::evictedCount() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return evictedCount_;
+}
+
+void JobRegistry::setMaxFinishedJobs(size_t maxFinishedJobs) {
+  std::vector<JobPtr> evicted;
+  EvictionHandler handler;
+  {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    maxFinishedJobs_ = maxFinishedJobs;
+    evicted = collectEvictions();
+    handler = evictionHandler_;
+  }
+
+  notifyEvicted(handler, evicted);
+}
+
+void JobRegistry::setEvictionHandler(EvictionHandler handler) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  evictionHandler_ = std::move(handler);
+}
+
+bool JobRegistry::isFinished(JobStatus status) {
+  return status == JobStatus::COMPLETED || status == JobStatus::FAILED ||
+         status == JobStatus::CANCELLED;
+}
+
+std::vector<JobRegistry::JobPtr>
+JobRegistry::values(const std::map<uint64_t, JobPtr> &index) {
+  std::vector<JobPtr> result;
+  result.reserve(index.size());
+  for (const auto &[sequence, job] : index) {
+    result.push_back(job);
+  }
+  return result;
+}
+
+void JobRegistry::reindexStatus(Entry &entry, JobStatus status) {
+  if (entry.indexedStatus != status) {
+    byStatus_[static_cast<size_t>(entry.indexedStatus)].erase(entry.sequence);
+    byStatus_[static_cast<size_t>(status)].emplace(entry.sequence, entry.job);
+    entry.indexedStatus = status;
+  }
+
+  std::lock_guard<std::mutex> lruLock(lruMutex_);
+  if (isFinished(status) && !entry.finished) {
+    entry.finished = true;
+    entry.lruPosition = lru_.insert(lru_.begin(), entry.job->jobId);
+  } else if (!isFinished(status) && entry.finished) {
+    // Re-run jobs become active again and must not be evicted
+    lru_.erase(entry.lruPosition);
+    entry.finished = false;
+  }
+}
+
+void JobRegistry::notifyEvicted(const EvictionHandler &handler,
+                                const std::vector<JobPtr> &evicted) {
+  if (!handler) {
+    return;
+  }
+  for (const auto &job : evicted) {
+    handler(job);
+  }
+}
+
+std::vector<JobRegistry::JobPtr> JobRegistry::collectEvictions() {
+  std::vector<JobPtr> evicted;
+  std::lock_guard<std::mutex> lruLock(lruMutex_);
+  while (lru_.size() > maxFinishedJobs_) {
+    auto it = byId_.find(lru_.back());
+    lru_.pop_back();
+    if (it == byId_.end()) {
+      continue;
+    }
+
+    Entry &entry = it->second;
+    ordered_.erase(entry.sequence);
+    byStatus_[static_cast<size_t>(entry.indexedStatus)].erase(entry.sequence);
+    byType_[static_cast<size_t>(entry.job->type)].erase(entry.sequence);
+    evicted.push_back(std::move(entry.job));
+    byId_.erase(it);
+    ++evictedCount_;
+  }
+  return evicted;
+}
@@ -0,0 +1,179 @@
+#include "job_scheduler.hpp"
+#include <algorithm>
+
+JobScheduler::JobScheduler(JobSchedulerConfig config)
+    : config_(std::move(config)) {}
+
+void JobScheduler::setConfig(const JobSchedulerConfig &config) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+  }
+  // Raised limits may unblock waiting workers
+  condition_.notify_all();
+}
+
+JobSchedulerConfig JobScheduler::getConfig() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return config_;
+}
+
+void JobScheduler::enqueue(std::shared_ptr<ETLJob> job) {
+  if (!job) {
+    return;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  size_t priority = std::min(static_cast<size_t>(job->priority),
+                             kJobPriorityCount - 1);
+  size_t type = static_cast<size_t>(job->type) % kJobTypeCount;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job->queuedAt = now;
+    queues_[priority][type].push_back(Entry{std::move(job), now});
+    ++queued_;
+  }
+  condition_.notify_one();
+}
+
+std::shared_ptr<ETLJob> JobScheduler::acquireNext() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    if (shutdown_) {
+      return nullptr;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    bool found = false;
+    size_t bestPriority = 0;
+    size_t bestType = 0;
+    size_t bestEffective = 0;
+    std::chrono::steady_clock::time_point bestQueuedAt;
+
+    // Each bucket is FIFO, so only its head can be the best candidate
+    for (size_t p = 0; p < kJobPriorityCount; ++p) {
+      for (size_t t = 0; t < kJobTypeCount; ++t) {
+        const auto &queue = queues_[p][t];
+        if (queue.empty() || !typeAvailable(t)) {
+          continue;
+        }
+        const auto &head = queue.front();
+        size_t effective = effectivePriority(p, head.queuedAt, now);
+        if (!found || effective > bestEffective ||
+            (effective == bestEffective && head.queuedAt < bestQueuedAt)) {
+          found = true;
+          bestPriority = p;
+          bestType = t;
+          bestEffective = effective;
+          bestQueuedAt = head.queuedAt;
+        }
+      }
+    }
+
+    if (found) {
+      auto &queue = queues_[bestPriority][bestType];
+      Entry entry = std::move(queue.front());
+      queue.pop_front();
+      --queued_;
+      ++running_[bestType];
+
+      auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+          now - entry.queuedAt);
+      ++dispatched_;
+      totalWait_ += wait;
+      maxWait_ = std::max(maxWait_, wait);
+      entry.job->metrics.queueWaitTime = wait;
+      return entry.job;
+    }
+
+    // Either nothing is queued or every queued type is at its limit; both
+    // enqueue() and release() signal the condition.
+    condition_.wait(lock);
+  }
+}
+
+void JobScheduler::release(const ETLJob &job) {
+  size_t type = static_cast<size_t>(job.type) % kJobTypeCount;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_[type] > 0) {
+      --running_[type];
+    }
+  }
+  condition_.notify_all();
+}
+
+bool JobScheduler::remove(const std::string &jobId) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &byType : queues_) {
+    for (auto &queue : byType) {
+      auto it = std::find_if(queue.begin(), queue.end(), [&](const Entry &e) {
+        return e.job->jobId == jobId;
+      });
+      if (it != queue.end()) {
+        queue.erase(it);
+        --queued_;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void JobScheduler::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  condition_.notify_all();
+}
+
+void JobScheduler::restart() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  shutdown_ = false;
+}
+
+size_t JobScheduler::queueDepth() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queued_;
+}
+
+JobSchedulerMetrics JobScheduler::getMetrics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  JobSchedulerMetrics metrics;
+  for (size_t p = 0; p < kJobPriorityCount; ++p) {
+    for (const auto &queue : queues_[p]) {
+      metrics.queuedByPriority[p] += queue.size();
+    }
+  }
+  metrics.runningByType = running_;
+  metrics.queueDepth = queued_;
+  for (size_t count : running_) {
+    metrics.runningJobs += count;
+  }
+  metrics.dispatchedJobs = dispatched_;
+  metrics.maxWaitTime = maxWait_;
+  if (dispatched_ > 0) {
+    metrics.averageWaitTime = std::chrono::milliseconds(
+        totalWait_.count() / static_cast<int64_t>(dispatched_));
+  }
+  return metrics;
+}
+
+bool JobScheduler::typeAvailable(size_t typeIndex) const {
+  size_t limit = config_.maxConcurrentByType[typeIndex];
+  return limit == 0 || running_[typeIndex] < limit;
+}
+
+size_t JobScheduler::effectivePriority(
+    size_t priorityIndex, std::chrono::steady_clock::time_point queuedAt,
+    std::chrono::steady_clock::time_point now) const {
+  if (config_.agingInterval.count() <= 0) {
+    return priorityIndex;
+  }
+  auto promotions = static_cast<size_t>((now - queuedAt) /
+                                        config_.agingInterval);
+  return std::min(priorityIndex + promotions, kJobPriorityCount - 1);
+}
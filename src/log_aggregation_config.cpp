@@ -91,6 +91,10 @@ LogDestinationConfig LogAggregationConfigLoader::loadDestinationConfig(
     }
   }
 
+  if (dest_config.contains("compress_payload")) {
+    config.compress_payload = dest_config["compress_payload"];
+  }
+
   // Elasticsearch specific
   if (dest_config.contains("index_pattern")) {
     config.index_pattern = dest_config["index_pattern"];
@@ -1,7 +1,6 @@
 #include "log_aggregator.hpp"
 #include <algorithm>
 #include <chrono>
-#include <curl/curl.h>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
@@ -13,17 +12,16 @@
 
 #include "logger.hpp"
 
-// CURL callback for writing response data
-static size_t writeCallback(void *contents, size_t size, size_t nmemb,
-                            void *userp) {
-  ((std::string *)userp)->append((char *)contents, size * nmemb);
-  return size * nmemb;
-}
-
 // LogAggregator implementation
 LogAggregator::LogAggregator(
     const std::vector<LogDestinationConfig> &destinations)
-    : destinations_(destinations), stats_() {
+    : LogAggregator(destinations, AsyncHttpClient::shared()) {}
+
+LogAggregator::LogAggregator(
+    const std::vector<LogDestinationConfig> &destinations,
+    std::shared_ptr<AsyncHttpClient> http_client)
+    : destinations_(destinations), stats_(),
+      http_client_(std::move(http_client)) {
   stats_.start_time = std::chrono::steady_clock::now();
 }
 
@@ -34,11 +32,6 @@ bool LogAggregator::initialize() {
     return true; // Already initialized
   }
 
-  // Initialize CURL global state
-  curl_global_init(CURL_GLOBAL_DEFAULT);
-
-  // CURL handle is automatically initialized by CurlHandle RAII wrapper
-
   // Start processing thread
   running_ = true;
   processing_thread_ = std::thread(&LogAggregator::processingWorker, this);
@@ -58,6 +51,12 @@ void LogAggregator::shutdown() {
     processing_thread_.join();
   }
 
+  // The last batches may still be on their way to HTTP destinations
+  {
+    std::unique_lock<std::mutex> lock(http_mutex_);
+    http_idle_.wait(lock, [this] { return http_in_flight_ == 0; });
+  }
+
   // Close all file streams
   {
     std::lock_guard<std::mutex> lock(file_mutex_);
@@ -69,9 +68,6 @@ void LogAggregator::shutdown() {
     file_streams_.clear();
   }
 
-  // Cleanup CURL
-  // CurlHandle automatically cleans up the CURL handle
-  curl_global_cleanup();
   running_ = false;
 }
 
@@ -165,7 +161,10 @@ void LogAggregator::processingWorker() {
         }
 
         if (!filtered_batch.empty()) {
-          if (shipToDestination(dest, filtered_batch)) {
+          if (shipsOverHttp(dest.type)) {
+            // Counted when the response arrives
+            shipToDestination(dest, filtered_batch);
+          } else if (shipToDestination(dest, filtered_batch)) {
             stats_.entries_shipped += filtered_batch.size();
             stats_.batches_sent++;
           } else {
@@ -204,9 +203,6 @@ bool LogAggregator::shipToDestination(
 bool LogAggregator::shipToElasticsearch(
     const LogDestinationConfig &dest,
     const std::vector<StructuredLogEntry> &batch) {
-  if (!curl_handle_.get())
-    return false;
-
   // Create bulk request body
   std::string bulk_data;
   std::string index_name = generateIndexName(dest.index_pattern);
@@ -222,31 +218,26 @@ bool LogAggregator::shipToElasticsearch(
     bulk_data += entry.toJson().dump() + "\n";
   }
 
-  std::string url = dest.endpoint + "/_bulk";
-  std::string response;
-
   std::unordered_map<std::string, std::string> headers = dest.headers;
   headers["Content-Type"] = "application/x-ndjson";
 
-  return makeHttpRequest(url, "POST", bulk_data, headers, response);
+  shipOverHttp(dest.endpoint + "/_bulk", std::move(bulk_data),
+               std::move(headers), dest.compress_payload, batch.size());
+  return true;
 }
 
 bool LogAggregator::shipToHttpEndpoint(
     const LogDestinationConfig &dest,
     const std::vector<StructuredLogEntry> &batch) {
-  if (!curl_handle_.get())
-    return false;
-
   // Create JSON array of log entries
   nlohmann::json json_batch = nlohmann::json::array();
   for (const auto &entry : batch) {
     json_batch.push_back(entry.toJson());
   }
 
-  std::string data = json_batch.dump();
-  std::string response;
-
-  return makeHttpRequest(dest.endpoint, "POST", data, dest.headers, response);
+  shipOverHttp(dest.endpoint, json_batch.dump(), dest.headers,
+               dest.compress_payload, batch.size());
+  return true;
 }
 
 bool LogAggregator::shipToFile(const LogDestinationConfig &dest,
@@ -332,9 +323,6 @@ bool LogAggregator::shipToCloudWatch(
     const std::vector<StructuredLogEntry> &batch) {
   // Note: This is a simplified implementation
   // In a real implementation, you'd use AWS SDK for CloudWatch Logs
-  if (!curl_handle_.get())
-    return false;
-
   nlohmann::json cloudwatch_batch = {{"logGroupName", "etlplus-logs"},
                                      {"logStreamName", "application-logs"},
                                      {"logEvents", nlohmann::json::array()}};
@@ -348,21 +336,17 @@ bool LogAggregator::shipToCloudWatch(
     cloudwatch_batch["logEvents"].push_back(log_event);
   }
 
-  std::string data = cloudwatch_batch.dump();
-  std::string response;
-
   std::unordered_map<std::string, std::string> headers = dest.headers;
   headers["X-Amz-Target"] = "Logs_20140328.PutLogEvents";
   headers["Content-Type"] = "application/x-amz-json-1.1";
 
-  return makeHttpRequest(dest.endpoint, "POST", data, headers, response);
+  shipOverHttp(dest.endpoint, cloudwatch_batch.dump(), std::move(headers),
+               false, batch.size());
+  return true;
 }
 
 bool LogAggregator::shipToSplunk(const LogDestinationConfig &dest,
                                  const std::vector<StructuredLogEntry> &batch) {
-  if (!curl_handle_.get())
-    return false;
-
   // Create JSON array for Splunk HEC
   nlohmann::json splunk_batch = nlohmann::json::array();
   for (const auto &entry : batch) {
@@ -372,62 +356,54 @@ bool LogAggregator::shipToSplunk(const LogDestinationConfig &dest,
     splunk_batch.push_back(splunk_event);
   }
 
-  std::string data = splunk_batch.dump();
-  std::string response;
-
   std::unordered_map<std::string, std::string> headers = dest.headers;
   headers["Content-Type"] = "application/json";
 
-  return makeHttpRequest(dest.endpoint, "POST", data, headers, response);
+  shipOverHttp(dest.endpoint, splunk_batch.dump(), std::move(headers),
+               dest.compress_payload, batch.size());
+  return true;
 }
 
-bool LogAggregator::makeHttpRequest(
-    const std::string &url, const std::string &method, const std::string &data,
-    const std::unordered_map<std::string, std::string> &headers,
-    std::string &response) {
-  if (!curl_handle_.get())
-    return false;
-
-  curl_easy_reset(curl_handle_.get());
-
-  // Set URL
-  curl_easy_setopt(curl_handle_.get(), CURLOPT_URL, url.c_str());
-
-  // Set method
-  if (method == "POST") {
-    curl_easy_setopt(curl_handle_.get(), CURLOPT_POST, 1L);
-    curl_easy_setopt(curl_handle_.get(), CURLOPT_POSTFIELDS, data.c_str());
-    curl_easy_setopt(curl_handle_.get(), CURLOPT_POSTFIELDSIZE, data.length());
-  }
-
-  // Set headers
-  struct curl_slist *header_list = nullptr;
-  std::unique_ptr<curl_slist, decltype(&curl_slist_free_all)> header_guard(
-      nullptr, curl_slist_free_all);
-  for (const auto &[key, value] : headers) {
-    std::string header = key + ": " + value;
-    header_list = curl_slist_append(header_list, header.c_str());
-  }
-  header_guard.reset(header_list);
-  curl_easy_setopt(curl_handle_.get(), CURLOPT_HTTPHEADER, header_list);
-
-  // Set response callback
-  curl_easy_setopt(curl_handle_.get(), CURLOPT_WRITEFUNCTION, writeCallback);
-  curl_easy_setopt(curl_handle_.get(), CURLOPT_WRITEDATA, &response);
-
-  // Set timeouts
-  curl_easy_setopt(curl_handle_.get(), CURLOPT_TIMEOUT, 30L);
-  curl_easy_setopt(curl_handle_.get(), CURLOPT_CONNECTTIMEOUT, 10L);
+bool LogAggregator::shipsOverHttp(LogDestinationType type) {
+  return type == LogDestinationType::ELASTICSEARCH ||
+         type == LogDestinationType::HTTP_ENDPOINT ||
+         type == LogDestinationType::CLOUDWATCH ||
+         type == LogDestinationType::SPLUNK;
+}
 
-  // Perform request
-  CURLcode res = curl_easy_perform(curl_handle_.get());
+void LogAggregator::shipOverHttp(
+    const std::string &url, std::string data,
+    std::unordered_map<std::string, std::string> headers, bool gzip,
+    size_t entries) {
+  HttpRequest request;
+  request.url = url;
+  request.body = std::move(data);
+  request.headers = std::move(headers);
+  request.gzipBody = gzip;
+  request.timeout = std::chrono::seconds(30);
+  request.connectTimeout = std::chrono::seconds(10);
 
-  // Cleanup
-  if (header_list) {
-    curl_slist_free_all(header_list);
+  {
+    std::lock_guard<std::mutex> lock(http_mutex_);
+    http_in_flight_++;
   }
+  const size_t raw_bytes = request.body.size();
+  http_client_->send(std::move(request), [this, entries, raw_bytes](
+                                             HttpResponse response) {
+    if (response.succeeded()) {
+      stats_.entries_shipped += entries;
+      stats_.batches_sent++;
+      stats_.bytes_shipped += response.bytesSent;
+      stats_.bytes_uncompressed += raw_bytes;
+    } else {
+      stats_.entries_failed += entries;
+    }
 
-  return (res == CURLE_OK);
+    std::lock_guard<std::mutex> lock(http_mutex_);
+    if (--http_in_flight_ == 0) {
+      http_idle_.notify_all();
+    }
+  });
 }
 
 void LogAggregator::rotateLogFile(const std::string &file_path) {
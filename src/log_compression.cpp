@@ -0,0 +1,686 @@
+#include "log_compression.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <memory>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#ifndef ETL_ENABLE_ZSTD
+#define ETL_ENABLE_ZSTD 0
+#endif
+#ifndef ETL_ENABLE_LZ4
+#define ETL_ENABLE_LZ4 0
+#endif
+
+#if ETL_ENABLE_ZSTD
+#include <zstd.h>
+#endif
+#if ETL_ENABLE_LZ4
+#include <lz4frame.h>
+#endif
+
+namespace {
+
+using Sink = std::function<bool(std::string_view)>;
+
+constexpr size_t kDecodeBufferBytes = 256 * 1024;
+
+// Seek table: one entry per frame, then the frame count, an FNV-1a checksum
+// of the entries and the magic. All integers are little-endian.
+constexpr size_t kSeekEntryBytes = 45;
+constexpr size_t kSeekFooterBytes = 16;
+constexpr char kSeekMagic[] = "ETLSEEK1";
+
+// Largest gzip extra field, less the subfield header
+constexpr size_t kMaxGzipSeekTable = 65535 - 4;
+
+// Skippable frame magic numbers; zstd and lz4 both ignore these frames
+constexpr uint32_t kZstdSkippableMagic = 0x184D2A5E;
+constexpr uint32_t kLz4SkippableMagic = 0x184D2A50;
+
+// Bytes of the empty gzip member after its extra field: an empty final
+// deflate block, CRC-32 and size (both zero)
+constexpr std::array<unsigned char, 10> kEmptyGzipTail = {3, 0, 0, 0, 0,
+                                                          0, 0, 0, 0, 0};
+
+void putLE(std::string &out, uint64_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+uint64_t getLE(std::string_view in, size_t offset, size_t bytes) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < bytes; ++i) {
+    value |= static_cast<uint64_t>(static_cast<unsigned char>(in[offset + i]))
+             << (8 * i);
+  }
+  return value;
+}
+
+uint32_t fnv1a(std::string_view bytes) {
+  uint32_t hash = 2166136261u;
+  for (unsigned char c : bytes) {
+    hash = (hash ^ c) * 16777619u;
+  }
+  return hash;
+}
+
+CompressionType typeFromMagic(std::string_view head) {
+  if (head.size() >= 2 && static_cast<unsigned char>(head[0]) == 0x1f &&
+      static_cast<unsigned char>(head[1]) == 0x8b) {
+    return CompressionType::GZIP;
+  }
+  if (head.size() >= 4) {
+    const uint32_t magic = static_cast<uint32_t>(getLE(head, 0, 4));
+    if (magic == 0xFD2FB528) {
+      return CompressionType::ZSTD;
+    }
+    if (magic == 0x184D2204) {
+      return CompressionType::LZ4;
+    }
+  }
+  return CompressionType::NONE;
+}
+
+// Streaming decoder for one format. Input may be split anywhere; several
+// frames / members in a row are decoded one after the other.
+class Decoder {
+public:
+  virtual ~Decoder() = default;
+  // False on corrupt input or when sink returns false
+  virtual bool decode(std::string_view input, const Sink &sink) = 0;
+  // Whether the input so far ended exactly at the end of a frame
+  virtual bool complete() const = 0;
+
+protected:
+  std::vector<char> buffer_ = std::vector<char>(kDecodeBufferBytes);
+};
+
+class GzipDecoder : public Decoder {
+public:
+  GzipDecoder() { ok_ = inflateInit2(&stream_, 15 + 16) == Z_OK; }
+  ~GzipDecoder() override { inflateEnd(&stream_); }
+
+  bool decode(std::string_view input, const Sink &sink) override {
+    if (!ok_) {
+      return false;
+    }
+    stream_.next_in =
+        reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+    stream_.avail_in = static_cast<uInt>(input.size());
+    do {
+      const uInt before = stream_.avail_in;
+      stream_.next_out = reinterpret_cast<Bytef *>(buffer_.data());
+      stream_.avail_out = static_cast<uInt>(buffer_.size());
+      const int result = inflate(&stream_, Z_NO_FLUSH);
+      if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+        return false;
+      }
+      const size_t produced = buffer_.size() - stream_.avail_out;
+      if (produced > 0 && !sink({buffer_.data(), produced})) {
+        return false;
+      }
+      if (result == Z_STREAM_END) {
+        // The next member, if any, starts a fresh stream
+        complete_ = true;
+        inflateReset(&stream_);
+      } else if (result == Z_BUF_ERROR) {
+        break; // needs more input
+      } else if (stream_.avail_in != before || produced > 0) {
+        complete_ = false;
+      }
+    } while (stream_.avail_in > 0 || stream_.avail_out == 0);
+    return true;
+  }
+
+  bool complete() const override { return complete_; }
+
+private:
+  z_stream stream_{};
+  bool ok_ = false;
+  bool complete_ = false;
+};
+
+#if ETL_ENABLE_ZSTD
+class ZstdDecoder : public Decoder {
+public:
+  bool decode(std::string_view input, const Sink &sink) override {
+    if (!stream_) {
+      return false;
+    }
+    ZSTD_inBuffer in{input.data(), input.size(), 0};
+    bool full = false;
+    while (in.pos < in.size || full) {
+      ZSTD_outBuffer out{buffer_.data(), buffer_.size(), 0};
+      const size_t result = ZSTD_decompressStream(stream_.get(), &out, &in);
+      if (ZSTD_isError(result)) {
+        return false;
+      }
+      if (out.pos > 0 && !sink({buffer_.data(), out.pos})) {
+        return false;
+      }
+      complete_ = result == 0;
+      full = out.pos == out.size;
+    }
+    return true;
+  }
+
+  bool complete() const override { return complete_; }
+
+private:
+  std::unique_ptr<ZSTD_DStream, decltype(&ZSTD_freeDStream)> stream_{
+      ZSTD_createDStream(), ZSTD_freeDStream};
+  bool complete_ = false;
+};
+#endif
+
+#if ETL_ENABLE_LZ4
+class Lz4Decoder : public Decoder {
+public:
+  Lz4Decoder() {
+    LZ4F_dctx *context = nullptr;
+    if (!LZ4F_isError(LZ4F_createDecompressionContext(&context,
+                                                      LZ4F_VERSION))) {
+      context_.reset(context);
+    }
+  }
+
+  bool decode(std::string_view input, const Sink &sink) override {
+    if (!context_) {
+      return false;
+    }
+    const char *next = input.data();
+    size_t remaining = input.size();
+    bool full = false;
+    while (remaining > 0 || full) {
+      size_t produced = buffer_.size();
+      size_t consumed = remaining;
+      const size_t result = LZ4F_decompress(context_.get(), buffer_.data(),
+                                            &produced, next, &consumed,
+                                            nullptr);
+      if (LZ4F_isError(result)) {
+        return false;
+      }
+      next += consumed;
+      remaining -= consumed;
+      if (produced > 0 && !sink({buffer_.data(), produced})) {
+        return false;
+      }
+      complete_ = result == 0;
+      full = produced == buffer_.size();
+      if (consumed == 0 && produced == 0) {
+        break;
+      }
+    }
+    return true;
+  }
+
+  bool complete() const override { return complete_; }
+
+private:
+  std::unique_ptr<LZ4F_dctx, decltype(&LZ4F_freeDecompressionContext)>
+      context_{nullptr, LZ4F_freeDecompressionContext};
+  bool complete_ = false;
+};
+#endif
+
+std::unique_ptr<Decoder> makeDecoder(CompressionType type) {
+  switch (type) {
+  case CompressionType::GZIP:
+    return std::make_unique<GzipDecoder>();
+#if ETL_ENABLE_ZSTD
+  case CompressionType::ZSTD:
+    return std::make_unique<ZstdDecoder>();
+#endif
+#if ETL_ENABLE_LZ4
+  case CompressionType::LZ4:
+    return std::make_unique<Lz4Decoder>();
+#endif
+  default:
+    return nullptr;
+  }
+}
+
+bool compressGzip(int level, std::string_view data, std::string &out) {
+  z_stream stream{};
+  if (deflateInit2(&stream, std::clamp(level, 1, 9), Z_DEFLATED, 15 + 16, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+  const size_t start = out.size();
+  out.resize(start + deflateBound(&stream, static_cast<uLong>(data.size())));
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+  stream.avail_in = static_cast<uInt>(data.size());
+  stream.next_out = reinterpret_cast<Bytef *>(out.data() + start);
+  stream.avail_out = static_cast<uInt>(out.size() - start);
+  const int result = deflate(&stream, Z_FINISH);
+  out.resize(start + stream.total_out);
+  deflateEnd(&stream);
+  return result == Z_STREAM_END;
+}
+
+#if ETL_ENABLE_ZSTD
+bool compressZstd(int level, std::string_view data, std::string &out) {
+  // Contexts are reused across frames written by the same thread
+  thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(
+      ZSTD_createCCtx(), ZSTD_freeCCtx);
+  if (!context) {
+    return false;
+  }
+  const size_t start = out.size();
+  out.resize(start + ZSTD_compressBound(data.size()));
+  const size_t written = ZSTD_compressCCtx(
+      context.get(), out.data() + start, out.size() - start, data.data(),
+      data.size(), std::clamp(level, 1, ZSTD_maxCLevel()));
+  if (ZSTD_isError(written)) {
+    out.resize(start);
+    return false;
+  }
+  out.resize(start + written);
+  return true;
+}
+#endif
+
+#if ETL_ENABLE_LZ4
+bool compressLz4(std::string_view data, std::string &out) {
+  LZ4F_preferences_t preferences{};
+  preferences.frameInfo.contentSize = data.size();
+  const size_t start = out.size();
+  out.resize(start + LZ4F_compressFrameBound(data.size(), &preferences));
+  const size_t written =
+      LZ4F_compressFrame(out.data() + start, out.size() - start, data.data(),
+                         data.size(), &preferences);
+  if (LZ4F_isError(written)) {
+    out.resize(start);
+    return false;
+  }
+  out.resize(start + written);
+  return true;
+}
+#endif
+
+} // namespace
+
+bool isCompressionSupported(CompressionType type) {
+  switch (type) {
+  case CompressionType::GZIP:
+    return true;
+  case CompressionType::ZSTD:
+    return ETL_ENABLE_ZSTD;
+  case CompressionType::LZ4:
+    return ETL_ENABLE_LZ4;
+  default:
+    return false;
+  }
+}
+
+bool compressLogBuffer(CompressionType type, int level, std::string_view data,
+                       std::string &out) {
+  switch (type) {
+  case CompressionType::GZIP:
+    return compressGzip(level, data, out);
+#if ETL_ENABLE_ZSTD
+  case CompressionType::ZSTD:
+    return compressZstd(level, data, out);
+#endif
+#if ETL_ENABLE_LZ4
+  case CompressionType::LZ4:
+    return compressLz4(data, out);
+#endif
+  default:
+    return false;
+  }
+}
+
+bool decompressLogBuffer(CompressionType type, std::string_view data,
+                         std::string &out) {
+  auto decoder = makeDecoder(type);
+  if (!decoder) {
+    return false;
+  }
+  return decoder->decode(data,
+                         [&out](std::string_view piece) {
+                           out.append(piece);
+                           return true;
+                         }) &&
+         decoder->complete();
+}
+
+// SeekableLogWriter
+
+SeekableLogWriter::SeekableLogWriter(std::ostream &out, CompressionType type,
+                                     int level, size_t frameBytes)
+    : out_(out), type_(type), level_(level),
+      frameBytes_(std::clamp<size_t>(frameBytes, 4096, 64 * 1024 * 1024)) {
+  ok_ = isCompressionSupported(type);
+}
+
+bool SeekableLogWriter::write(std::string_view data) {
+  pending_.append(data);
+  while (ok_ && pending_.size() >= frameBytes_) {
+    // Cut after the last full line that fits; a line longer than four
+    // frames is split rather than buffered without bound
+    size_t cut = pending_.rfind('\n', frameBytes_ - 1);
+    if (cut == std::string::npos) {
+      cut = pending_.find('\n', frameBytes_);
+    }
+    if (cut == std::string::npos) {
+      if (pending_.size() < 4 * frameBytes_) {
+        break;
+      }
+      cut = 4 * frameBytes_ - 1;
+    }
+    ok_ = writeFrame(cut + 1);
+  }
+  return ok_;
+}
+
+bool SeekableLogWriter::finish() {
+  if (ok_ && (!pending_.empty() || frames_.empty())) {
+    ok_ = writeFrame(pending_.size());
+  }
+  if (ok_) {
+    ok_ = writeSeekTable();
+  }
+  out_.flush();
+  return ok_ && static_cast<bool>(out_);
+}
+
+bool SeekableLogWriter::writeFrame(size_t bytes) {
+  const std::string_view raw(pending_.data(), bytes);
+  SeekableLogFrame frame;
+  frame.rawOffset = rawBytes_;
+  frame.compressedOffset = compressedBytes_;
+  frame.rawBytes = static_cast<uint32_t>(bytes);
+  frame.minTimeMs = std::numeric_limits<int64_t>::max();
+  frame.maxTimeMs = std::numeric_limits<int64_t>::min();
+
+  for (size_t start = 0; start < raw.size();) {
+    size_t end = raw.find('\n', start);
+    if (end == std::string_view::npos) {
+      end = raw.size();
+    } else {
+      ++frame.lines;
+    }
+    if (auto parsed = parseLogLine(raw.substr(start, end - start))) {
+      frame.minTimeMs = std::min(frame.minTimeMs, parsed->timestampMs);
+      frame.maxTimeMs = std::max(frame.maxTimeMs, parsed->timestampMs);
+      frame.levels |= static_cast<uint8_t>(1u << static_cast<int>(
+                                               parsed->level));
+    }
+    start = end + 1;
+  }
+
+  compressed_.clear();
+  if (!compressLogBuffer(type_, level_, raw, compressed_)) {
+    return false;
+  }
+  frame.compressedBytes = static_cast<uint32_t>(compressed_.size());
+  out_.write(compressed_.data(),
+             static_cast<std::streamsize>(compressed_.size()));
+  if (!out_) {
+    return false;
+  }
+
+  frames_.push_back(frame);
+  rawBytes_ += bytes;
+  compressedBytes_ += compressed_.size();
+  pending_.erase(0, bytes);
+  return true;
+}
+
+bool SeekableLogWriter::writeSeekTable() {
+  std::string table;
+  for (const auto &frame : frames_) {
+    putLE(table, frame.rawOffset, 8);
+    putLE(table, frame.compressedOffset, 8);
+    putLE(table, frame.rawBytes, 4);
+    putLE(table, frame.compressedBytes, 4);
+    putLE(table, frame.lines, 4);
+    putLE(table, static_cast<uint64_t>(frame.minTimeMs), 8);
+    putLE(table, static_cast<uint64_t>(frame.maxTimeMs), 8);
+    putLE(table, frame.levels, 1);
+  }
+  const uint32_t checksum = fnv1a(table);
+  putLE(table, frames_.size(), 4);
+  putLE(table, checksum, 4);
+  table.append(kSeekMagic, 8);
+
+  std::string trailer;
+  if (type_ == CompressionType::GZIP) {
+    if (table.size() > kMaxGzipSeekTable) {
+      return true; // still a valid gzip file, just not seekable
+    }
+    // Empty member: FLG.FEXTRA, no mtime, unknown OS, subfield "ES"
+    trailer.append("\x1f\x8b\x08\x04\0\0\0\0\0\xff", 10);
+    putLE(trailer, table.size() + 4, 2);
+    trailer.append("ES", 2);
+    putLE(trailer, table.size(), 2);
+    trailer.append(table);
+    trailer.append(reinterpret_cast<const char *>(kEmptyGzipTail.data()),
+                   kEmptyGzipTail.size());
+  } else {
+    putLE(trailer,
+          type_ == CompressionType::ZSTD ? kZstdSkippableMagic
+                                         : kLz4SkippableMagic,
+          4);
+    putLE(trailer, table.size(), 4);
+    trailer.append(table);
+  }
+  out_.write(trailer.data(), static_cast<std::streamsize>(trailer.size()));
+  compressedBytes_ += trailer.size();
+  return static_cast<bool>(out_);
+}
+
+// SeekableLogReader
+
+SeekableLogReader::SeekableLogReader(const std::string &path) {
+  fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  struct stat info {};
+  if (fd_ < 0 || ::fstat(fd_, &info) != 0) {
+    return;
+  }
+  size_ = static_cast<uint64_t>(info.st_size);
+  std::string head;
+  if (readAt(0, 4, head)) {
+    type_ = typeFromMagic(head);
+  }
+  if (type_ != CompressionType::NONE) {
+    loadSeekTable();
+  }
+}
+
+SeekableLogReader::~SeekableLogReader() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+bool SeekableLogReader::readAt(uint64_t offset, size_t bytes,
+                               std::string &out) const {
+  out.resize(bytes);
+  size_t done = 0;
+  while (done < bytes) {
+    const ssize_t got = ::pread(fd_, out.data() + done, bytes - done,
+                                static_cast<off_t>(offset + done));
+    if (got <= 0) {
+      out.resize(done);
+      return false;
+    }
+    done += static_cast<size_t>(got);
+  }
+  return true;
+}
+
+void SeekableLogReader::loadSeekTable() {
+  // Everything after the table that locates it
+  const size_t tail =
+      type_ == CompressionType::GZIP ? kEmptyGzipTail.size() : 0;
+  std::string bytes;
+  if (size_ < tail + kSeekFooterBytes ||
+      !readAt(size_ - tail, tail, bytes) ||
+      (tail > 0 &&
+       std::memcmp(bytes.data(), kEmptyGzipTail.data(), tail) != 0) ||
+      !readAt(size_ - tail - kSeekFooterBytes, kSeekFooterBytes, bytes) ||
+      bytes.compare(8, 8, kSeekMagic) != 0) {
+    return;
+  }
+  const uint64_t count = getLE(bytes, 0, 4);
+  const uint32_t checksum = static_cast<uint32_t>(getLE(bytes, 4, 4));
+  const uint64_t tableBytes = count * kSeekEntryBytes + kSeekFooterBytes;
+  // The header in front of the table: gzip member header, XLEN and the
+  // subfield id and length; or the skippable frame's magic and size
+  const uint64_t header = type_ == CompressionType::GZIP ? 16 : 8;
+  if (size_ < tail + tableBytes + header) {
+    return;
+  }
+  const uint64_t trailerStart = size_ - tail - tableBytes - header;
+  std::string headerBytes;
+  if (!readAt(trailerStart, header, headerBytes)) {
+    return;
+  }
+  if (type_ == CompressionType::GZIP) {
+    if (static_cast<unsigned char>(headerBytes[0]) != 0x1f ||
+        static_cast<unsigned char>(headerBytes[1]) != 0x8b ||
+        headerBytes[3] != 0x04 || getLE(headerBytes, 10, 2) != tableBytes + 4 ||
+        headerBytes.compare(12, 2, "ES") != 0 ||
+        getLE(headerBytes, 14, 2) != tableBytes) {
+      return;
+    }
+  } else {
+    const uint32_t magic = type_ == CompressionType::ZSTD ? kZstdSkippableMagic
+                                                          : kLz4SkippableMagic;
+    if (getLE(headerBytes, 0, 4) != magic ||
+        getLE(headerBytes, 4, 4) != tableBytes) {
+      return;
+    }
+  }
+
+  std::string table;
+  if (!readAt(trailerStart + header, count * kSeekEntryBytes, table) ||
+      fnv1a(table) != checksum) {
+    return;
+  }
+  std::vector<SeekableLogFrame> frames(count);
+  uint64_t rawOffset = 0;
+  uint64_t compressedOffset = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const size_t at = i * kSeekEntryBytes;
+    SeekableLogFrame &frame = frames[i];
+    frame.rawOffset = getLE(table, at, 8);
+    frame.compressedOffset = getLE(table, at + 8, 8);
+    frame.rawBytes = static_cast<uint32_t>(getLE(table, at + 16, 4));
+    frame.compressedBytes = static_cast<uint32_t>(getLE(table, at + 20, 4));
+    frame.lines = static_cast<uint32_t>(getLE(table, at + 24, 4));
+    frame.minTimeMs = static_cast<int64_t>(getLE(table, at + 28, 8));
+    frame.maxTimeMs = static_cast<int64_t>(getLE(table, at + 36, 8));
+    frame.levels = static_cast<uint8_t>(getLE(table, at + 44, 1));
+    // Frames must tile the file up to the trailer
+    if (frame.rawOffset != rawOffset ||
+        frame.compressedOffset != compressedOffset) {
+      return;
+    }
+    rawOffset += frame.rawBytes;
+    compressedOffset += frame.compressedBytes;
+  }
+  if (compressedOffset != trailerStart) {
+    return;
+  }
+  frames_ = std::move(frames);
+}
+
+bool SeekableLogReader::readFrame(size_t index, std::string &out) const {
+  out.clear();
+  if (index >= frames_.size()) {
+    return false;
+  }
+  const SeekableLogFrame &frame = frames_[index];
+  std::string compressed;
+  if (!readAt(frame.compressedOffset, frame.compressedBytes, compressed)) {
+    return false;
+  }
+  out.reserve(frame.rawBytes);
+  return decompressLogBuffer(type_, compressed, out) &&
+         out.size() == frame.rawBytes;
+}
+
+bool SeekableLogReader::readAll(const Sink &sink) const {
+  auto decoder = makeDecoder(type_);
+  if (!decoder) {
+    return false;
+  }
+  bool stopped = false;
+  auto forward = [&](std::string_view piece) {
+    stopped = !sink(piece);
+    return !stopped;
+  };
+  std::string input;
+  for (uint64_t offset = 0; offset < size_; offset += input.size()) {
+    const size_t bytes = static_cast<size_t>(
+        std::min<uint64_t>(kDecodeBufferBytes, size_ - offset));
+    if (!readAt(offset, bytes, input) || !decoder->decode(input, forward)) {
+      return stopped;
+    }
+  }
+  return decoder->complete();
+}
+
+// LogCompressionQueue
+
+LogCompressionQueue::~LogCompressionQueue() {
+  {
+    std::lock_guard lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void LogCompressionQueue::enqueue(std::function<void()> job) {
+  {
+    std::lock_guard lock(mutex_);
+    jobs_.push_back(std::move(job));
+    if (!worker_.joinable()) {
+      worker_ = std::thread(&LogCompressionQueue::run, this);
+    }
+  }
+  wake_.notify_one();
+}
+
+bool LogCompressionQueue::waitIdle(std::chrono::milliseconds timeout) {
+  std::unique_lock lock(mutex_);
+  return idle_.wait_for(lock, timeout,
+                        [this] { return jobs_.empty() && !busy_; });
+}
+
+size_t LogCompressionQueue::pending() const {
+  std::lock_guard lock(mutex_);
+  return jobs_.size() + (busy_ ? 1 : 0);
+}
+
+void LogCompressionQueue::run() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+    if (jobs_.empty()) {
+      return; // stopping, nothing left to run
+    }
+    auto job = std::move(jobs_.front());
+    jobs_.pop_front();
+    busy_ = true;
+    lock.unlock();
+    job();
+    lock.lock();
+    busy_ = false;
+    if (jobs_.empty()) {
+      idle_.notify_all();
+    }
+  }
+}
@@ -1,11 +1,29 @@
 #include "log_file_manager.hpp"
+#include "log_compression.hpp"
+#include "log_search_engine.hpp"
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <ctime>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <regex>
 #include <sstream>
+#include <type_traits>
+
+namespace {
+
+// A rotated backup waiting for the compression queue ("<backup>.<n>.pending").
+// It goes away once compressed, so it is neither listed nor indexed.
+bool isPendingRotation(const std::filesystem::path &path) {
+  return path.extension() == ".pending";
+}
+
+} // namespace
 
 // LogFileManager implementation
 
@@ -18,7 +36,11 @@ LogFileManager::LogFileManager(const LogFileManagerConfig &config)
   // Initialize utility components
   archiver_ = std::make_unique<LogFileArchiver>(config_.archive);
   indexer_ = std::make_unique<LogFileIndexer>(config_.indexing);
-  compressor_ = std::make_unique<LogFileCompressor>();
+  searchEngine_ = std::make_unique<LogSearchEngine>(
+      config_.performance.searchThreads, config_.performance.searchChunkSize);
+  compressor_ = std::make_unique<LogFileCompressor>(
+      config_.performance.compressionFrameSize);
+  compressionQueue_ = std::make_unique<LogCompressionQueue>();
   validator_ = std::make_unique<LogFileValidator>();
 
   // Start background maintenance if enabled
@@ -29,6 +51,7 @@ LogFileManager::LogFileManager(const LogFileManagerConfig &config)
 
 LogFileManager::~LogFileManager() {
   stopBackgroundMaintenance();
+  compressionQueue_.reset(); // finishes queued compressions
   closeAllFiles();
 }
 
@@ -49,15 +72,14 @@ LogFileManagerConfig LogFileManager::getConfig() const {
 }
 
 bool LogFileManager::initializeLogFile(const std::string &filename) {
-  std::string fullPath = filename;
-  if (!std::filesystem::path(filename).is_absolute()) {
-    fullPath = config_.logDirectory + "/" + filename;
-  }
+  const std::string fullPath = resolveLogPath(filename);
 
   if (!createDirectoryStructure(fullPath)) {
     return false;
   }
 
+  // getFileSize() takes filesMutex_ itself
+  const size_t existingSize = getFileSize(fullPath);
   std::unique_lock lock(filesMutex_);
 
   auto stream = std::make_unique<std::ofstream>(fullPath, std::ios::app);
@@ -66,10 +88,15 @@ bool LogFileManager::initializeLogFile(const std::string &filename) {
   }
 
   openFiles_[filename] = std::move(stream);
-  fileSizes_[filename] = getFileSize(fullPath);
+  fileSizes_[filename] = existingSize;
   fileCreationTimes_[filename] = std::chrono::system_clock::now();
   lastRotationTimes_[filename] = std::chrono::system_clock::now();
 
+  // Index what is already there; writeToFile() reports appends from now on
+  if (indexer_ && config_.indexing.enabled) {
+    indexer_->indexFile(fullPath);
+  }
+
   {
     std::unique_lock currentLock(currentFileMutex_);
     if (currentLogFile_.empty()) {
@@ -102,11 +129,18 @@ size_t LogFileManager::writeToFile(const std::string &filename,
 
   auto it = openFiles_.find(filename);
   if (it == openFiles_.end()) {
+    // initializeLogFile() takes filesMutex_ itself
+    lock.unlock();
     if (!initializeLogFile(filename)) {
       metrics_.writeErrors++;
       return 0;
     }
+    lock.lock();
     it = openFiles_.find(filename);
+    if (it == openFiles_.end()) {
+      metrics_.writeErrors++;
+      return 0;
+    }
   }
 
   if (!it->second || !it->second->is_open()) {
@@ -114,6 +148,7 @@ size_t LogFileManager::writeToFile(const std::string &filename,
     return 0;
   }
 
+  const size_t offset = fileSizes_[filename];
   it->second->write(data.c_str(), data.size());
   if (it->second->fail()) {
     metrics_.writeErrors++;
@@ -122,6 +157,9 @@ size_t LogFileManager::writeToFile(const std::string &filename,
 
   // Update metrics and tracking
   fileSizes_[filename] += data.size();
+  if (indexer_ && config_.indexing.enabled) {
+    indexer_->appendToIndex(resolveLogPath(filename), data, offset);
+  }
   lastAccessTimes_[filename] = std::chrono::system_clock::now();
 
   if (forceFlush) {
@@ -174,6 +212,12 @@ bool LogFileManager::rotateLogFile() {
 }
 
 bool LogFileManager::rotateLogFile(const std::string &filename) {
+  std::shared_lock cLock(configMutex_);
+  const auto rotation = config_.rotation;
+  cLock.unlock();
+  const bool compress = rotation.compressRotatedFiles &&
+                        isCompressionSupported(rotation.compressionType);
+
   std::unique_lock lock(filesMutex_);
 
   auto it = openFiles_.find(filename);
@@ -192,7 +236,38 @@ bool LogFileManager::rotateLogFile(const std::string &filename) {
   std::string backupPath = config_.logDirectory + "/" + backupName;
 
   try {
-    std::filesystem::rename(fullPath, backupPath);
+    // The backup's index is rebuilt from the file when it is next searched
+    if (indexer_) {
+      indexer_->removeIndex(resolveLogPath(backupName));
+      indexer_->removeIndex(resolveLogPath(filename));
+    }
+    if (!compress) {
+      std::filesystem::rename(fullPath, backupPath);
+    } else {
+      // Compressed from a name of its own, so a later rotation cannot
+      // replace the file while a job still reads it and rotation never
+      // waits for the queue
+      const std::string pendingPath = backupPath + "." +
+                                      std::to_string(++rotationSequence_) +
+                                      ".pending";
+      std::filesystem::rename(fullPath, pendingPath);
+      const std::string target =
+          backupPath + compressor_->getCompressedExtension(
+                           rotation.compressionType);
+      compressionQueue_->enqueue([this, pendingPath, backupPath, target,
+                                  type = rotation.compressionType] {
+        auto result =
+            compressor_->compressFileWithResult(pendingPath, target, type);
+        recordCompression(result);
+        std::error_code ec;
+        if (result.success) {
+          std::filesystem::remove(pendingPath, ec);
+        } else if (!std::filesystem::exists(backupPath, ec)) {
+          // Kept uncompressed; a newer backup is never replaced
+          std::filesystem::rename(pendingPath, backupPath, ec);
+        }
+      });
+    }
 
     // Create new file
     auto newStream = std::make_unique<std::ofstream>(fullPath, std::ios::out);
@@ -221,7 +296,7 @@ LogFileManager::listLogFiles(bool includeArchived, bool includeCompressed,
   try {
     for (const auto &entry :
          std::filesystem::directory_iterator(config_.logDirectory)) {
-      if (entry.is_regular_file()) {
+      if (entry.is_regular_file() && !isPendingRotation(entry.path())) {
         LogFileInfo info;
         info.filename = entry.path().filename().string();
         info.fullPath = entry.path().string();
@@ -433,12 +508,24 @@ bool LogFileManager::createDirectoryStructure(const std::string &filePath) {
     if (path.has_filename()) {
       path = path.parent_path();
     }
-    return std::filesystem::create_directories(path);
+    if (path.empty()) {
+      return true;
+    }
+    // create_directories() is false when the directory already exists
+    std::filesystem::create_directories(path);
+    return std::filesystem::is_directory(path);
   } catch (const std::exception &) {
     return false;
   }
 }
 
+std::string LogFileManager::resolveLogPath(const std::string &filename) const {
+  if (std::filesystem::path(filename).is_absolute()) {
+    return filename;
+  }
+  return (std::filesystem::path(config_.logDirectory) / filename).string();
+}
+
 std::string
 LogFileManager::generateBackupFileName(const std::string &baseFilename,
                                        int index) const {
@@ -543,6 +630,18 @@ double LogFileManager::calculateMovingAverage(double currentAvg,
   return ((currentAvg * (count - 1)) + newValue) / count;
 }
 
+void LogFileManager::recordCompression(const CompressionResult &result) {
+  if (!result.success) {
+    metrics_.compressionErrors++;
+    return;
+  }
+  metrics_.totalFilesCompressed++;
+  metrics_.totalBytesCompressed += result.originalSize;
+  metrics_.totalBytesAfterCompression += result.compressedSize;
+  metrics_.compressionTime += result.compressionTime.count();
+  metrics_.averageCompressionRatio.store(metrics_.getCompressionRatio());
+}
+
 void LogFileManager::maintenanceWorker() {
   while (!stopMaintenance_.load()) {
     std::unique_lock lock(maintenanceMutex_);
@@ -685,48 +784,111 @@ bool LogFileManager::performMaintenance() {
 
 std::vector<HistoricalLogEntry>
 LogFileManager::searchLogEntries(const LogQueryParams &params) const {
-  // Basic implementation - would use indexer in full version
-  std::vector<HistoricalLogEntry> results;
-
+  std::vector<std::string> files;
+  // Searched without an index: compressed backups and rotated files that
+  // wait for compression (an index of those would outlive them)
+  std::vector<std::string> unindexed;
   try {
     for (const auto &entry :
          std::filesystem::directory_iterator(config_.logDirectory)) {
-      if (entry.is_regular_file()) {
-        std::ifstream file(entry.path());
-        std::string line;
-        size_t lineNumber = 1;
-
-        while (std::getline(file, line) && results.size() < params.maxResults) {
-          // Simple text search
-          if (params.searchText && !params.searchText->empty()) {
-            if (line.find(*params.searchText) != std::string::npos) {
-              HistoricalLogEntry logEntry;
-              logEntry.timestamp = std::chrono::system_clock::now();
-              logEntry.level = LogLevel::INFO;
-              logEntry.message = line;
-              logEntry.filename = entry.path().filename().string();
-              logEntry.lineNumber = lineNumber;
-              results.push_back(logEntry);
-            }
-          }
-          lineNumber++;
-        }
+      LogFileInfo info;
+      info.filename = entry.path().filename().string();
+      if (!entry.is_regular_file() || entry.path().extension() == ".tmp" ||
+          (indexer_ && indexer_->isIndexFile(entry.path()))) {
+        continue;
+      }
+      if (isPendingRotation(entry.path())) {
+        unindexed.push_back(entry.path().string());
+      } else if (!info.isCompressedFile()) {
+        files.push_back(entry.path().string());
+      } else if (isCompressionSupported(
+                     compressor_->detectCompressionType(info.filename))) {
+        unindexed.push_back(entry.path().string());
       }
     }
   } catch (const std::exception &) {
-    // Handle filesystem errors
+    // Search what was listed
   }
+  std::sort(files.begin(), files.end());
+  std::sort(unindexed.begin(), unindexed.end());
 
-  return results;
+  const bool useIndex =
+      indexer_ && config_.indexing.enabled && indexer_->canNarrow(params);
+  {
+    // Appends are indexed before they are flushed. Writers wait while the
+    // files are flushed and checked, so none is shorter than its index
+    // (which catchUp() would take for a truncation)
+    std::unique_lock lock(filesMutex_);
+    for (const auto &[filename, stream] : openFiles_) {
+      if (stream && stream->is_open()) {
+        stream->flush();
+      }
+    }
+    // Files nobody wrote through this manager (rotated backups, files from
+    // earlier runs) are indexed here; for current ones this is a stat()
+    if (useIndex) {
+      for (const auto &file : files) {
+        indexer_->indexFile(file);
+      }
+    }
+  }
+
+  if (!useIndex) {
+    files.insert(files.end(), unindexed.begin(), unindexed.end());
+    std::sort(files.begin(), files.end());
+    return searchEngine_->search(files, params);
+  }
+  if (unindexed.empty()) {
+    return indexer_->searchIndex(params);
+  }
+
+  // Compressed backups are searched through their seek tables instead of
+  // an index, pending rotations by a plain scan. Each side returns its best offset + maxResults entries and
+  // the requested page is cut from both, in the same file order the
+  // engine and the indexer use.
+  LogQueryParams wide = params;
+  wide.offset = 0;
+  wide.maxResults =
+      params.maxResults > std::numeric_limits<size_t>::max() - params.offset
+          ? std::numeric_limits<size_t>::max()
+          : params.offset + params.maxResults;
+  auto indexed = indexer_->searchIndex(wide);
+  auto scanned = searchEngine_->search(unindexed, wide);
+
+  std::vector<std::string> all = files;
+  all.insert(all.end(), unindexed.begin(), unindexed.end());
+  std::sort(all.begin(), all.end());
+  std::unordered_map<std::string, size_t> rank;
+  for (size_t i = 0; i < all.size(); ++i) {
+    rank[std::filesystem::path(all[i]).filename().string()] = i;
+  }
+
+  LogResultWindow window(params);
+  for (auto *part : {&indexed, &scanned}) {
+    for (auto &entry : *part) {
+      auto it = rank.find(entry.filename);
+      const size_t fileRank = it == rank.end() ? all.size() : it->second;
+      const uint64_t line = entry.lineNumber;
+      window.add(std::move(entry), fileRank, line);
+    }
+  }
+  std::vector<HistoricalLogEntry> entries;
+  for (auto &result : window.takePage()) {
+    entries.push_back(std::move(result.entry));
+  }
+  return entries;
 }
 
 std::unordered_map<std::string, std::unordered_map<std::string, uint64_t>>
 LogFileManager::getIndexStatistics() const {
   std::unordered_map<std::string, std::unordered_map<std::string, uint64_t>>
       stats;
-  // Basic implementation - would use indexer in full version
-  stats["index"]["totalEntries"] = 0;
-  stats["index"]["totalFiles"] = listLogFiles().size();
+  if (indexer_) {
+    for (const auto &[name, value] : indexer_->getIndexStatistics()) {
+      stats["index"][name] = value;
+    }
+  }
+  stats["index"]["logFiles"] = listLogFiles().size();
   return stats;
 }
 
@@ -762,6 +924,17 @@ bool LogFileArchiver::archiveFile(const std::string &sourceFile,
     }
 
     std::filesystem::path targetFile = archivePath / source.filename();
+    LogFileCompressor compressor;
+    if (policy_.compressOnArchive &&
+        isCompressionSupported(policy_.compressionType) &&
+        compressor.detectCompressionType(sourceFile) ==
+            CompressionType::NONE) {
+      return compressor.compressFile(
+          sourceFile,
+          targetFile.string() +
+              compressor.getCompressedExtension(policy_.compressionType),
+          policy_.compressionType, policy_.compressionLevel);
+    }
     std::filesystem::copy_file(
         source, targetFile, std::filesystem::copy_options::overwrite_existing);
 
@@ -784,6 +957,13 @@ bool LogFileArchiver::archiveFiles(const std::vector<std::string> &sourceFiles,
 
 bool LogFileArchiver::restoreFile(const std::string &archivedFile,
                                   const std::string &targetFile) {
+  // Archives compressed on the way in are restored as plain logs
+  LogFileCompressor compressor;
+  if (compressor.detectCompressionType(archivedFile) !=
+          CompressionType::NONE &&
+      compressor.detectCompressionType(targetFile) == CompressionType::NONE) {
+    return compressor.decompressFile(archivedFile, targetFile);
+  }
   try {
     std::filesystem::copy_file(
         archivedFile, targetFile,
@@ -870,101 +1050,981 @@ LogFileArchiver::calculateArchiveChecksum(const std::string &archiveFile,
   return "checksum";
 }
 
+// Log line parsing
+
+namespace {
+
+constexpr uint32_t kFnvOffset32 = 2166136261u;
+constexpr uint32_t kFnvPrime32 = 16777619u;
+
+uint32_t fnv1a(uint32_t hash, std::string_view bytes) {
+  for (unsigned char c : bytes) {
+    hash = (hash ^ c) * kFnvPrime32;
+  }
+  return hash;
+}
+
+std::string_view trimSpaces(std::string_view text) {
+  while (!text.empty() && text.front() == ' ') {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && text.back() == ' ') {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+std::optional<LogLevel> parseLevel(std::string_view text) {
+  text = trimSpaces(text);
+  if (text == "DEBUG")
+    return LogLevel::DEBUG;
+  if (text == "INFO")
+    return LogLevel::INFO;
+  if (text == "WARN" || text == "WARNING")
+    return LogLevel::WARN;
+  if (text == "ERROR")
+    return LogLevel::ERROR;
+  if (text == "FATAL")
+    return LogLevel::FATAL;
+  return std::nullopt;
+}
+
+bool parseDigits(std::string_view text, size_t pos, size_t len, int &out) {
+  if (pos + len > text.size()) {
+    return false;
+  }
+  const char *end = text.data() + pos + len;
+  auto [ptr, ec] = std::from_chars(text.data() + pos, end, out);
+  return ec == std::errc() && ptr == end;
+}
+
+// "YYYY-MM-DD HH:MM:SS[.mmm]" in local time, as formatTimestamp() writes it
+std::optional<int64_t> parseTimestamp(std::string_view text) {
+  int year, month, day, hour, minute, second, millis = 0;
+  if (text.size() < 19 || text[4] != '-' || text[7] != '-' ||
+      (text[10] != ' ' && text[10] != 'T') || text[13] != ':' ||
+      text[16] != ':' || !parseDigits(text, 0, 4, year) ||
+      !parseDigits(text, 5, 2, month) || !parseDigits(text, 8, 2, day) ||
+      !parseDigits(text, 11, 2, hour) || !parseDigits(text, 14, 2, minute) ||
+      !parseDigits(text, 17, 2, second)) {
+    return std::nullopt;
+  }
+  if (text.size() >= 23 && text[19] == '.' &&
+      !parseDigits(text, 20, 3, millis)) {
+    return std::nullopt;
+  }
+
+  // mktime() is slow and takes a lock; consecutive lines share the hour
+  thread_local std::string cachedHour;
+  thread_local int64_t cachedHourSeconds = 0;
+  const std::string_view hourKey = text.substr(0, 13);
+  if (hourKey != cachedHour) {
+    std::tm tm{};
+    tm.tm_year = year - 1900;
+    tm.tm_mon = month - 1;
+    tm.tm_mday = day;
+    tm.tm_hour = hour;
+    tm.tm_isdst = -1;
+    const std::time_t seconds = std::mktime(&tm);
+    if (seconds == -1) {
+      return std::nullopt;
+    }
+    cachedHour.assign(hourKey);
+    cachedHourSeconds = seconds;
+  }
+  return (cachedHourSeconds + minute * 60 + second) * 1000 + millis;
+}
+
+// Takes "[value] " off the front of text
+std::optional<std::string_view> takeBracketed(std::string_view &text) {
+  if (text.empty() || text.front() != '[') {
+    return std::nullopt;
+  }
+  const size_t close = text.find(']');
+  if (close == std::string_view::npos) {
+    return std::nullopt;
+  }
+  std::string_view value = text.substr(1, close - 1);
+  text.remove_prefix(close + 1);
+  if (!text.empty() && text.front() == ' ') {
+    text.remove_prefix(1);
+  }
+  return value;
+}
+
+// Raw (still escaped) value of a top-level string field
+std::string_view jsonStringField(std::string_view line, std::string_view key) {
+  size_t pos = 0;
+  while ((pos = line.find(key, pos)) != std::string_view::npos) {
+    const size_t start = pos + key.size();
+    if (pos > 0 && line[pos - 1] == '"' && line.substr(start, 3) == "\":\"") {
+      const size_t valueStart = start + 3;
+      size_t end = valueStart;
+      while (end < line.size() && line[end] != '"') {
+        end += line[end] == '\\' ? 2 : 1;
+      }
+      return line.substr(valueStart, std::min(end, line.size()) - valueStart);
+    }
+    pos = start;
+  }
+  return {};
+}
+
+std::optional<ParsedLogLine> parseJsonLogLine(std::string_view line) {
+  auto timestamp = parseTimestamp(jsonStringField(line, "timestamp"));
+  auto level = parseLevel(jsonStringField(line, "level"));
+  if (!timestamp || !level) {
+    return std::nullopt;
+  }
+  ParsedLogLine parsed;
+  parsed.timestampMs = *timestamp;
+  parsed.level = *level;
+  parsed.component = jsonStringField(line, "component");
+  parsed.jobId = jsonStringField(line, "jobId");
+  parsed.message = jsonStringField(line, "message");
+  return parsed;
+}
+
+} // namespace
+
+std::optional<ParsedLogLine> parseLogLine(std::string_view line) {
+  if (!line.empty() && line.back() == '\r') {
+    line.remove_suffix(1);
+  }
+  if (!line.empty() && line.front() == '{') {
+    return parseJsonLogLine(line);
+  }
+
+  std::string_view rest = line;
+  auto timestamp = takeBracketed(rest);
+  auto level = timestamp ? takeBracketed(rest) : std::nullopt;
+  auto component = level ? takeBracketed(rest) : std::nullopt;
+  if (!component) {
+    return std::nullopt;
+  }
+  auto timestampMs = parseTimestamp(*timestamp);
+  auto parsedLevel = parseLevel(*level);
+  if (!timestampMs || !parsedLevel) {
+    return std::nullopt;
+  }
+
+  ParsedLogLine parsed;
+  parsed.timestampMs = *timestampMs;
+  parsed.level = *parsedLevel;
+  parsed.component = *component;
+  constexpr std::string_view kJobPrefix = "[Job: ";
+  if (rest.substr(0, kJobPrefix.size()) == kJobPrefix) {
+    if (auto value = takeBracketed(rest)) {
+      parsed.jobId = value->substr(kJobPrefix.size() - 1);
+    }
+  }
+  parsed.message = rest;
+  return parsed;
+}
+
 // LogFileIndexer implementations
+
+namespace {
+
+// Sidecar layout: magic, indexed byte/line counts, blocks, posting lists,
+// then an FNV-1a checksum of everything before it
+constexpr std::string_view kIndexMagic = "ETLIDX01";
+constexpr size_t kReadChunkBytes = 64 * 1024;
+
+class IndexWriter {
+public:
+  template <class T> void put(T value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    bytes_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+  void putString(std::string_view text) {
+    put(static_cast<uint32_t>(text.size()));
+    bytes_.append(text);
+  }
+  void putRaw(std::string_view text) { bytes_.append(text); }
+  std::string finish() {
+    put(fnv1a(kFnvOffset32, bytes_));
+    return std::move(bytes_);
+  }
+
+private:
+  std::string bytes_;
+};
+
+class IndexReader {
+public:
+  explicit IndexReader(std::string_view bytes) : bytes_(bytes) {}
+
+  template <class T> bool get(T &value) {
+    if (bytes_.size() - pos_ < sizeof(value)) {
+      return false;
+    }
+    std::memcpy(&value, bytes_.data() + pos_, sizeof(value));
+    pos_ += sizeof(value);
+    return true;
+  }
+  bool getString(std::string &text) {
+    uint32_t size = 0;
+    if (!get(size) || bytes_.size() - pos_ < size) {
+      return false;
+    }
+    text.assign(bytes_.substr(pos_, size));
+    pos_ += size;
+    return true;
+  }
+  bool atEnd() const { return pos_ == bytes_.size(); }
+
+private:
+  std::string_view bytes_;
+  size_t pos_ = 0;
+};
+
+void addPosting(std::vector<uint32_t> &postings, uint32_t block) {
+  if (postings.empty() || postings.back() != block) {
+    postings.push_back(block);
+  }
+}
+
+int64_t toMillis(std::chrono::system_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+uint8_t levelBit(LogLevel level) {
+  return static_cast<uint8_t>(1u << static_cast<unsigned>(level));
+}
+
+} // namespace
+
 LogFileIndexer::LogFileIndexer(const LogIndexingPolicy &policy)
-    : policy_(policy) {}
+    : policy_(policy) {
+  policy_.indexBlockLines = std::max<size_t>(policy_.indexBlockLines, 1);
+}
+
+LogFileIndexer::~LogFileIndexer() {
+  std::unique_lock lock(indexMutex_);
+  for (const auto &[logFile, index] : indexes_) {
+    if (index.unsavedLines > 0) {
+      saveIndex(getIndexFilePath(logFile), index);
+    }
+  }
+}
 
 bool LogFileIndexer::indexFile(const std::string &logFile) {
-  // Stub implementation
+  if (!policy_.enabled || isPendingRotation(logFile)) {
+    return false;
+  }
+
+  std::unique_lock lock(indexMutex_);
+  auto it = indexes_.find(logFile);
+  if (it == indexes_.end()) {
+    auto loaded = loadIndex(getIndexFilePath(logFile));
+    if (loaded && !matchesLog(logFile, *loaded)) {
+      loaded.reset();
+    }
+    if (loaded && policy_.enableFullTextIndex && !loaded->fullText) {
+      return createFullTextIndex(logFile);
+    }
+    if (!loaded) {
+      loaded.emplace();
+      loaded->fullText = policy_.enableFullTextIndex;
+    }
+    it = indexes_.emplace(logFile, std::move(*loaded)).first;
+  }
+
+  if (!catchUp(logFile, it->second)) {
+    indexes_.erase(it);
+    return false;
+  }
+  maybeSave(logFile, it->second);
   return true;
 }
 
+void LogFileIndexer::appendToIndex(const std::string &logFile,
+                                   std::string_view data, uint64_t offset) {
+  if (!policy_.enabled) {
+    return;
+  }
+
+  std::unique_lock lock(indexMutex_);
+  auto it = indexes_.find(logFile);
+  if (it == indexes_.end()) {
+    // A fresh file can be indexed from its first byte; anything else
+    // needs indexFile() to look at what is already there
+    if (offset != 0) {
+      return;
+    }
+    it = indexes_.try_emplace(logFile).first;
+    it->second.fullText = policy_.enableFullTextIndex;
+  }
+
+  FileIndex &index = it->second;
+  if (index.stale) {
+    return;
+  }
+  if (offset != index.indexedBytes + index.partialLine.size()) {
+    index.stale = true;
+    return;
+  }
+  indexBytes(index, data);
+  maybeSave(logFile, index);
+}
+
 bool LogFileIndexer::removeIndex(const std::string &logFile) {
-  // Stub implementation
-  return true;
+  std::unique_lock lock(indexMutex_);
+  indexes_.erase(logFile);
+  std::error_code ec;
+  std::filesystem::remove(getIndexFilePath(logFile), ec);
+  return !ec;
 }
 
 std::vector<HistoricalLogEntry>
 LogFileIndexer::searchIndex(const LogQueryParams &params) const {
-  // Stub implementation
-  return std::vector<HistoricalLogEntry>();
+  LogQueryMatcher matcher(params);
+  if (!matcher.isValid()) {
+    return {};
+  }
+  LogResultWindow results(params);
+
+  // A run of adjacent candidate blocks, read with one seek
+  struct Range {
+    uint64_t offset = 0;
+    uint64_t bytes = 0;
+    uint64_t firstLine = 0;
+    int64_t firstTimeMs = 0; // for unparsed lines at the start
+  };
+  struct FileRanges {
+    std::string logFile;
+    std::vector<Range> ranges;
+  };
+
+  // Only the ranges are copied under the lock: appendToIndex, and so every
+  // log write, must not wait for a search's disk reads
+  std::vector<FileRanges> files;
+  {
+    std::shared_lock lock(indexMutex_);
+    for (const auto &[logFile, index] : indexes_) {
+      const std::vector<uint32_t> blocks = candidateBlocks(index, params);
+      if (blocks.empty()) {
+        continue;
+      }
+      FileRanges &file = files.emplace_back();
+      file.logFile = logFile;
+      for (size_t first = 0; first < blocks.size();) {
+        size_t last = first;
+        while (last + 1 < blocks.size() &&
+               blocks[last + 1] == blocks[last] + 1) {
+          ++last;
+        }
+        const Block &start = index.blocks[blocks[first]];
+        const Block &end = index.blocks[blocks[last]];
+        file.ranges.push_back(
+            {start.offset, end.offset + end.bytes - start.offset,
+             start.firstLine,
+             start.minTimeMs <= start.maxTimeMs ? start.minTimeMs : 0});
+        first = last + 1;
+      }
+    }
+  }
+  // Files rank by path, as LogFileManager hands them to LogSearchEngine
+  std::sort(files.begin(), files.end(),
+            [](const FileRanges &a, const FileRanges &b) {
+              return a.logFile < b.logFile;
+            });
+
+  std::string buffer;
+  for (size_t rank = 0; rank < files.size(); ++rank) {
+    const FileRanges &ranges = files[rank];
+    std::ifstream file(ranges.logFile, std::ios::binary);
+    if (!file.is_open()) {
+      continue;
+    }
+    const std::string filename =
+        std::filesystem::path(ranges.logFile).filename().string();
+
+    for (const Range &range : ranges.ranges) {
+      buffer.resize(range.bytes);
+      file.clear();
+      file.seekg(static_cast<std::streamoff>(range.offset));
+      file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      // Appends not yet flushed to disk are indexed but not readable
+      buffer.resize(static_cast<size_t>(file.gcount()));
+
+      std::string_view view(buffer);
+      size_t lineNumber = range.firstLine;
+      // Unparsed lines take the time of the line before them
+      int64_t lastTimeMs = range.firstTimeMs;
+      for (size_t newline; (newline = view.find('\n')) != view.npos;
+           view.remove_prefix(newline + 1), ++lineNumber) {
+        const std::string_view line = view.substr(0, newline);
+        const auto parsed = parseLogLine(line);
+        if (parsed) {
+          lastTimeMs = parsed->timestampMs;
+        }
+        if (!matcher.matches(parsed, line)) {
+          continue;
+        }
+        const LogLevel level = parsed ? parsed->level : LogLevel::INFO;
+        const std::string_view component =
+            parsed ? parsed->component : std::string_view();
+        const uint64_t position = range.offset + (line.data() - buffer.data());
+        if (!results.wouldAccept(lastTimeMs, level, component, rank,
+                                 position)) {
+          continue;
+        }
+
+        HistoricalLogEntry entry;
+        entry.timestamp = std::chrono::system_clock::time_point(
+            std::chrono::milliseconds(lastTimeMs));
+        entry.level = level;
+        entry.component = component;
+        entry.message = parsed ? parsed->message : line;
+        if (parsed) {
+          entry.jobId = parsed->jobId;
+        }
+        entry.filename = filename;
+        entry.lineNumber = lineNumber;
+        results.add(std::move(entry), rank, position);
+      }
+    }
+  }
+
+  std::vector<HistoricalLogEntry> entries;
+  for (auto &result : results.takePage()) {
+    entries.push_back(std::move(result.entry));
+  }
+  return entries;
 }
 
 bool LogFileIndexer::optimizeIndex() {
-  // Stub implementation
-  return true;
+  std::unique_lock lock(indexMutex_);
+  bool allSaved = true;
+  for (auto it = indexes_.begin(); it != indexes_.end();) {
+    const std::string &logFile = it->first;
+    FileIndex &index = it->second;
+    std::error_code ec;
+    if (!std::filesystem::exists(logFile, ec)) {
+      std::filesystem::remove(getIndexFilePath(logFile), ec);
+      it = indexes_.erase(it);
+      continue;
+    }
+
+    index.blocks.shrink_to_fit();
+    for (Postings *postings :
+         {&index.jobs, &index.components, &index.terms}) {
+      for (auto &[key, blocks] : *postings) {
+        blocks.shrink_to_fit();
+      }
+    }
+    if (index.unsavedLines > 0) {
+      if (saveIndex(getIndexFilePath(logFile), index)) {
+        index.unsavedLines = 0;
+      } else {
+        allSaved = false;
+      }
+    }
+    ++it;
+  }
+  return allSaved;
 }
 
 bool LogFileIndexer::rebuildIndex(const std::string &logFile) {
-  // Stub implementation
+  removeIndex(logFile);
+  if (!indexFile(logFile)) {
+    return false;
+  }
+
+  std::unique_lock lock(indexMutex_);
+  auto it = indexes_.find(logFile);
+  if (it == indexes_.end() ||
+      !saveIndex(getIndexFilePath(logFile), it->second)) {
+    return false;
+  }
+  it->second.unsavedLines = 0;
   return true;
 }
 
 bool LogFileIndexer::rebuildAllIndexes(const std::string &logDirectory) {
-  // Stub implementation
-  return true;
+  bool allRebuilt = true;
+  std::error_code ec;
+  for (const auto &entry :
+       std::filesystem::directory_iterator(logDirectory, ec)) {
+    if (entry.is_regular_file() && !isIndexFile(entry.path()) &&
+        !isPendingRotation(entry.path()) &&
+        !rebuildIndex(entry.path().string())) {
+      allRebuilt = false;
+    }
+  }
+  return allRebuilt && !ec;
 }
 
 std::unordered_map<std::string, uint64_t>
 LogFileIndexer::getIndexStatistics() const {
   std::unordered_map<std::string, uint64_t> stats;
+  std::shared_lock lock(indexMutex_);
+  stats["totalFiles"] = indexes_.size();
   stats["totalEntries"] = 0;
-  stats["totalFiles"] = 0;
+  stats["totalBlocks"] = 0;
+  stats["indexedBytes"] = 0;
+  stats["jobIds"] = 0;
+  stats["staleFiles"] = 0;
+  for (const auto &[logFile, index] : indexes_) {
+    stats["totalEntries"] += index.lineCount;
+    stats["totalBlocks"] += index.blocks.size();
+    stats["indexedBytes"] += index.indexedBytes;
+    stats["jobIds"] += index.jobs.size();
+    stats["staleFiles"] += index.stale ? 1 : 0;
+  }
   return stats;
 }
 
 bool LogFileIndexer::verifyIndexIntegrity(const std::string &indexFile) const {
-  // Stub implementation
+  return loadIndex(indexFile).has_value();
+}
+
+bool LogFileIndexer::isIndexFile(const std::filesystem::path &path) const {
+  return path.extension() == policy_.indexFileExtension;
+}
+
+void LogFileIndexer::indexLine(FileIndex &index, std::string_view line) const {
+  if (index.blocks.empty() ||
+      index.blocks.back().lines >= policy_.indexBlockLines) {
+    Block &block = index.blocks.emplace_back();
+    block.offset = index.indexedBytes;
+    block.firstLine = index.lineCount + 1;
+    block.minTimeMs = std::numeric_limits<int64_t>::max();
+    block.maxTimeMs = std::numeric_limits<int64_t>::min();
+    block.checksum = kFnvOffset32;
+  }
+  Block &block = index.blocks.back();
+  const auto blockNumber = static_cast<uint32_t>(index.blocks.size() - 1);
+
+  if (auto parsed = parseLogLine(line)) {
+    block.minTimeMs = std::min(block.minTimeMs, parsed->timestampMs);
+    block.maxTimeMs = std::max(block.maxTimeMs, parsed->timestampMs);
+    block.levels |= levelBit(parsed->level);
+    if (policy_.indexByJobId && !parsed->jobId.empty()) {
+      auto job = index.jobs.find(parsed->jobId);
+      if (job == index.jobs.end()) {
+        job = index.jobs.try_emplace(std::string(parsed->jobId)).first;
+      }
+      addPosting(job->second, blockNumber);
+    }
+    if (policy_.indexByComponent && !parsed->component.empty()) {
+      auto component = index.components.find(parsed->component);
+      if (component == index.components.end()) {
+        component =
+            index.components.try_emplace(std::string(parsed->component)).first;
+      }
+      addPosting(component->second, blockNumber);
+    }
+  }
+  if (index.fullText) {
+    for (auto &term : tokenizeText(line)) {
+      addPosting(index.terms[std::move(term)], blockNumber);
+    }
+  }
+
+  block.checksum = fnv1a(fnv1a(block.checksum, line), "\n");
+  block.bytes += line.size() + 1;
+  block.lines++;
+  index.lineCount++;
+  index.indexedBytes += line.size() + 1;
+  index.unsavedLines++;
+}
+
+void LogFileIndexer::indexBytes(FileIndex &index,
+                                std::string_view data) const {
+  for (size_t newline; (newline = data.find('\n')) != data.npos;
+       data.remove_prefix(newline + 1)) {
+    if (index.partialLine.empty()) {
+      indexLine(index, data.substr(0, newline));
+    } else {
+      index.partialLine.append(data.substr(0, newline));
+      indexLine(index, index.partialLine);
+      index.partialLine.clear();
+    }
+  }
+  index.partialLine.append(data);
+}
+
+bool LogFileIndexer::catchUp(const std::string &logFile,
+                             FileIndex &index) const {
+  std::error_code ec;
+  const uint64_t size = std::filesystem::file_size(logFile, ec);
+  if (ec) {
+    return false;
+  }
+  if (!index.stale &&
+      size == index.indexedBytes + index.partialLine.size()) {
+    return true;
+  }
+  if (size < index.indexedBytes) {
+    // Truncated or replaced: start over
+    const bool fullText = index.fullText;
+    index = FileIndex{};
+    index.fullText = fullText;
+  }
+
+  std::ifstream file(logFile, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  file.seekg(static_cast<std::streamoff>(index.indexedBytes));
+  index.partialLine.clear();
+  index.stale = false;
+
+  std::string chunk(kReadChunkBytes, '\0');
+  uint64_t remaining = size - index.indexedBytes;
+  while (remaining > 0) {
+    file.read(chunk.data(), static_cast<std::streamsize>(
+                                std::min<uint64_t>(remaining, chunk.size())));
+    const auto got = static_cast<size_t>(file.gcount());
+    if (got == 0) {
+      break;
+    }
+    indexBytes(index, std::string_view(chunk.data(), got));
+    remaining -= got;
+  }
   return true;
 }
 
-std::vector<LogFileIndexer::IndexEntry>
+bool LogFileIndexer::matchesLog(const std::string &logFile,
+                                const FileIndex &index) const {
+  std::error_code ec;
+  const uint64_t size = std::filesystem::file_size(logFile, ec);
+  if (ec || size < index.indexedBytes) {
+    return false;
+  }
+  if (index.blocks.empty()) {
+    return true;
+  }
+
+  // The last block is the one a rotation or rewrite would have replaced
+  const Block &last = index.blocks.back();
+  std::ifstream file(logFile, std::ios::binary);
+  std::string bytes(last.bytes, '\0');
+  file.seekg(static_cast<std::streamoff>(last.offset));
+  file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  return static_cast<size_t>(file.gcount()) == bytes.size() &&
+         fnv1a(kFnvOffset32, bytes) == last.checksum;
+}
+
+std::vector<uint32_t>
+LogFileIndexer::candidateBlocks(const FileIndex &index,
+                                const LogQueryParams &params) const {
+  // Start from the shortest posting list the query can use
+  static const std::vector<uint32_t> kNoBlocks;
+  const std::vector<uint32_t> *postings = nullptr;
+  auto narrow = [&postings](const Postings &map, std::string_view key) {
+    auto it = map.find(key);
+    const auto *list = it == map.end() ? &kNoBlocks : &it->second;
+    if (!postings || list->size() < postings->size()) {
+      postings = list;
+    }
+  };
+  if (params.jobId && policy_.indexByJobId) {
+    narrow(index.jobs, *params.jobId);
+  }
+  if (params.component && policy_.indexByComponent) {
+    narrow(index.components, *params.component);
+  }
+  if (index.fullText && params.searchText && !params.searchText->empty() &&
+      !params.useRegex) {
+    // A substring search may cut its first and last word short, so only
+    // the words strictly inside the search text must be whole in the line
+    std::vector<std::string> terms = tokenizeText(*params.searchText);
+    const std::string &text = *params.searchText;
+    const bool cutStart =
+        std::isalnum(static_cast<unsigned char>(text.front()));
+    const bool cutEnd = std::isalnum(static_cast<unsigned char>(text.back()));
+    for (size_t i = 0; i < terms.size(); ++i) {
+      if ((i == 0 && cutStart) || (i + 1 == terms.size() && cutEnd)) {
+        continue;
+      }
+      narrow(index.terms, terms[i]);
+    }
+  }
+
+  uint8_t levels = 0xff;
+  if (policy_.indexByLogLevel && (params.minLevel || params.maxLevel)) {
+    levels = 0;
+    for (auto level = static_cast<int>(LogLevel::DEBUG);
+         level <= static_cast<int>(LogLevel::FATAL); ++level) {
+      if ((!params.minLevel || level >= static_cast<int>(*params.minLevel)) &&
+          (!params.maxLevel || level <= static_cast<int>(*params.maxLevel))) {
+        levels |= levelBit(static_cast<LogLevel>(level));
+      }
+    }
+  }
+  const bool byTime =
+      policy_.indexByTimestamp && (params.startTime || params.endTime);
+  const int64_t startMs = params.startTime
+                              ? toMillis(*params.startTime)
+                              : std::numeric_limits<int64_t>::min();
+  const int64_t endMs = params.endTime ? toMillis(*params.endTime)
+                                       : std::numeric_limits<int64_t>::max();
+
+  std::vector<uint32_t> candidates;
+  auto consider = [&](uint32_t number) {
+    const Block &block = index.blocks[number];
+    if ((byTime && (block.maxTimeMs < startMs || block.minTimeMs > endMs)) ||
+        (levels != 0xff && (block.levels & levels) == 0)) {
+      return;
+    }
+    candidates.push_back(number);
+  };
+  if (postings) {
+    for (uint32_t number : *postings) {
+      consider(number);
+    }
+  } else {
+    for (uint32_t number = 0; number < index.blocks.size(); ++number) {
+      consider(number);
+    }
+  }
+  return candidates;
+}
+
+bool LogFileIndexer::canNarrow(const LogQueryParams &params) const {
+  // The same filters candidateBlocks() uses
+  return (params.jobId && policy_.indexByJobId) ||
+         (params.component && policy_.indexByComponent) ||
+         (policy_.enableFullTextIndex && params.searchText &&
+          !params.searchText->empty() && !params.useRegex) ||
+         (policy_.indexByLogLevel && (params.minLevel || params.maxLevel)) ||
+         (policy_.indexByTimestamp && (params.startTime || params.endTime));
+}
+
+void LogFileIndexer::maybeSave(const std::string &logFile, FileIndex &index) {
+  // Each save rewrites the sidecar, so let the interval grow with the
+  // index; lines indexed but not saved are simply re-read after a restart
+  const size_t interval =
+      std::max<size_t>(policy_.indexFlushInterval, index.lineCount / 16);
+  if (index.unsavedLines >= interval &&
+      saveIndex(getIndexFilePath(logFile), index)) {
+    index.unsavedLines = 0;
+  }
+}
+
+std::optional<LogFileIndexer::FileIndex>
 LogFileIndexer::loadIndex(const std::string &indexFile) const {
-  return std::vector<IndexEntry>();
+  std::ifstream file(indexFile, std::ios::binary);
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+  const std::string bytes((std::istreambuf_iterator<char>(file)),
+                          std::istreambuf_iterator<char>());
+  if (bytes.size() < kIndexMagic.size() + sizeof(uint32_t) ||
+      std::string_view(bytes).substr(0, kIndexMagic.size()) != kIndexMagic) {
+    return std::nullopt;
+  }
+  const std::string_view body(bytes.data(), bytes.size() - sizeof(uint32_t));
+  uint32_t checksum = 0;
+  std::memcpy(&checksum, bytes.data() + body.size(), sizeof(checksum));
+  if (fnv1a(kFnvOffset32, body) != checksum) {
+    return std::nullopt;
+  }
+
+  IndexReader reader(body.substr(kIndexMagic.size()));
+  FileIndex index;
+  uint8_t fullText = 0;
+  uint32_t blockCount = 0;
+  if (!reader.get(fullText) || !reader.get(index.indexedBytes) ||
+      !reader.get(index.lineCount) || !reader.get(blockCount)) {
+    return std::nullopt;
+  }
+  index.fullText = fullText != 0;
+
+  uint64_t expectedOffset = 0;
+  uint64_t expectedLine = 1;
+  index.blocks.resize(blockCount);
+  for (Block &block : index.blocks) {
+    if (!reader.get(block.offset) || !reader.get(block.bytes) ||
+        !reader.get(block.firstLine) || !reader.get(block.lines) ||
+        !reader.get(block.minTimeMs) || !reader.get(block.maxTimeMs) ||
+        !reader.get(block.levels) || !reader.get(block.checksum) ||
+        block.offset != expectedOffset || block.firstLine != expectedLine) {
+      return std::nullopt;
+    }
+    expectedOffset += block.bytes;
+    expectedLine += block.lines;
+  }
+  if (expectedOffset != index.indexedBytes ||
+      expectedLine != index.lineCount + 1) {
+    return std::nullopt;
+  }
+
+  for (Postings *postings : {&index.jobs, &index.components, &index.terms}) {
+    uint32_t keyCount = 0;
+    if (!reader.get(keyCount)) {
+      return std::nullopt;
+    }
+    for (uint32_t k = 0; k < keyCount; ++k) {
+      std::string key;
+      uint32_t count = 0;
+      if (!reader.getString(key) || !reader.get(count)) {
+        return std::nullopt;
+      }
+      std::vector<uint32_t> &blocks = (*postings)[std::move(key)];
+      blocks.resize(count);
+      for (uint32_t &number : blocks) {
+        if (!reader.get(number) || number >= blockCount) {
+          return std::nullopt;
+        }
+      }
+    }
+  }
+  if (!reader.atEnd()) {
+    return std::nullopt;
+  }
+  return index;
 }
 
 bool LogFileIndexer::saveIndex(const std::string &indexFile,
-                               const std::vector<IndexEntry> &entries) {
-  return true;
+                               const FileIndex &index) const {
+  IndexWriter writer;
+  writer.putRaw(kIndexMagic);
+  writer.put(static_cast<uint8_t>(index.fullText));
+  writer.put(index.indexedBytes);
+  writer.put(index.lineCount);
+  writer.put(static_cast<uint32_t>(index.blocks.size()));
+  for (const Block &block : index.blocks) {
+    writer.put(block.offset);
+    writer.put(block.bytes);
+    writer.put(block.firstLine);
+    writer.put(block.lines);
+    writer.put(block.minTimeMs);
+    writer.put(block.maxTimeMs);
+    writer.put(block.levels);
+    writer.put(block.checksum);
+  }
+  for (const Postings *postings :
+       {&index.jobs, &index.components, &index.terms}) {
+    writer.put(static_cast<uint32_t>(postings->size()));
+    for (const auto &[key, blocks] : *postings) {
+      writer.putString(key);
+      writer.put(static_cast<uint32_t>(blocks.size()));
+      for (uint32_t number : blocks) {
+        writer.put(number);
+      }
+    }
+  }
+  const std::string bytes = writer.finish();
+
+  // Write aside and rename, so readers never see a half-written sidecar
+  std::error_code ec;
+  const std::filesystem::path path(indexFile);
+  if (path.has_parent_path()) {
+    std::filesystem::create_directories(path.parent_path(), ec);
+  }
+  const std::string tempFile = indexFile + ".tmp";
+  {
+    std::ofstream file(tempFile, std::ios::binary | std::ios::trunc);
+    if (!file.is_open() ||
+        !file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()))) {
+      return false;
+    }
+  }
+  std::filesystem::rename(tempFile, indexFile, ec);
+  return !ec;
 }
 
 std::string LogFileIndexer::getIndexFilePath(const std::string &logFile) const {
-  return logFile + ".idx";
+  if (policy_.indexDirectory.empty()) {
+    return logFile + policy_.indexFileExtension;
+  }
+  return (std::filesystem::path(policy_.indexDirectory) /
+          (std::filesystem::path(logFile).filename().string() +
+           policy_.indexFileExtension))
+      .string();
 }
 
+// Builds the index afresh with word postings; the caller holds indexMutex_
 bool LogFileIndexer::createFullTextIndex(const std::string &logFile) {
+  FileIndex index;
+  index.fullText = true;
+  if (!catchUp(logFile, index)) {
+    return false;
+  }
+  if (saveIndex(getIndexFilePath(logFile), index)) {
+    index.unsavedLines = 0;
+  }
+  indexes_[logFile] = std::move(index);
   return true;
 }
 
 std::vector<std::string>
-LogFileIndexer::tokenizeText(const std::string &text) const {
-  return std::vector<std::string>();
+LogFileIndexer::tokenizeText(std::string_view text) const {
+  std::vector<std::string> terms;
+  size_t start = 0;
+  while (start < text.size()) {
+    while (start < text.size() &&
+           !std::isalnum(static_cast<unsigned char>(text[start]))) {
+      ++start;
+    }
+    size_t end = start;
+    while (end < text.size() &&
+           std::isalnum(static_cast<unsigned char>(text[end]))) {
+      ++end;
+    }
+    if (end - start >= std::max<size_t>(policy_.minWordLength, 1)) {
+      std::string term(text.substr(start, end - start));
+      std::transform(term.begin(), term.end(), term.begin(), [](char c) {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+      });
+      if (std::find(policy_.stopWords.begin(), policy_.stopWords.end(),
+                    term) == policy_.stopWords.end()) {
+        terms.push_back(std::move(term));
+      }
+    }
+    start = end;
+  }
+  return terms;
 }
 
 // LogFileCompressor implementations
 bool LogFileCompressor::compressFile(const std::string &sourceFile,
                                      const std::string &targetFile,
                                      CompressionType type, int level) {
-  // Stub implementation - just copy file for now
-  try {
-    std::filesystem::copy_file(
-        sourceFile, targetFile,
-        std::filesystem::copy_options::overwrite_existing);
-    return true;
-  } catch (const std::exception &) {
+  switch (type) {
+  case CompressionType::GZIP:
+    return compressGzip(sourceFile, targetFile, level);
+  case CompressionType::ZIP:
+    return compressZip(sourceFile, targetFile, level);
+  case CompressionType::BZIP2:
+    return compressBzip2(sourceFile, targetFile, level);
+  case CompressionType::LZ4:
+    return compressLZ4(sourceFile, targetFile);
+  case CompressionType::ZSTD:
+    return compressZstd(sourceFile, targetFile, level);
+  default:
     return false;
   }
 }
 
+CompressionResult LogFileCompressor::compressFileWithResult(
+    const std::string &sourceFile, const std::string &targetFile,
+    CompressionType type, int level) {
+  if (!isCompressionSupported(type)) {
+    CompressionResult result;
+    result.errorMessage = "Compression type not supported by this build";
+    return result;
+  }
+  return compressSeekable(sourceFile, targetFile, type, level);
+}
+
 bool LogFileCompressor::decompressFile(const std::string &compressedFile,
                                        const std::string &targetFile) {
-  // Stub implementation - just copy file for now
-  try {
-    std::filesystem::copy_file(
-        compressedFile, targetFile,
-        std::filesystem::copy_options::overwrite_existing);
-    return true;
-  } catch (const std::exception &) {
+  switch (SeekableLogReader(compressedFile).type()) {
+  case CompressionType::GZIP:
+    return decompressGzip(compressedFile, targetFile);
+  case CompressionType::LZ4:
+    return decompressLZ4(compressedFile, targetFile);
+  case CompressionType::ZSTD:
+    return decompressZstd(compressedFile, targetFile);
+  default:
     return false;
   }
 }
@@ -1045,69 +2105,149 @@ size_t LogFileCompressor::estimateCompressedSize(const std::string &filename,
 bool LogFileCompressor::compressInMemory(const std::string &data,
                                          std::string &compressedData,
                                          CompressionType type) {
-  // Stub implementation
-  compressedData = data;
-  return true;
+  compressedData.clear();
+  return compressLogBuffer(type, 6, data, compressedData);
 }
 
 bool LogFileCompressor::decompressInMemory(const std::string &compressedData,
                                            std::string &data,
                                            CompressionType type) {
-  // Stub implementation
-  data = compressedData;
+  data.clear();
+  return decompressLogBuffer(type, compressedData, data);
+}
+
+CompressionResult
+LogFileCompressor::compressSeekable(const std::string &sourceFile,
+                                    const std::string &targetFile,
+                                    CompressionType type, int level) {
+  const auto start = std::chrono::steady_clock::now();
+  CompressionResult result;
+  std::ifstream in(sourceFile, std::ios::binary);
+  if (!in.is_open()) {
+    result.errorMessage = "Cannot open " + sourceFile;
+    return result;
+  }
+
+  // Written next to the target and renamed, so readers never see a
+  // partial file under the final name
+  const std::string tempFile = targetFile + ".tmp";
+  bool written = false;
+  {
+    std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+    SeekableLogWriter writer(out, type, level, frameBytes_);
+    std::vector<char> buffer(std::min<size_t>(frameBytes_, 1024 * 1024));
+    bool ok = out.is_open();
+    while (ok && (in.read(buffer.data(),
+                          static_cast<std::streamsize>(buffer.size())) ||
+                  in.gcount() > 0)) {
+      ok = writer.write({buffer.data(), static_cast<size_t>(in.gcount())});
+    }
+    written = ok && !in.bad() && writer.finish();
+    result.originalSize = writer.rawBytes();
+    result.compressedSize = writer.compressedBytes();
+  }
+
+  std::error_code ec;
+  if (written) {
+    std::filesystem::rename(tempFile, targetFile, ec);
+  }
+  if (!written || ec) {
+    std::filesystem::remove(tempFile, ec);
+    result.errorMessage = "Failed to write " + targetFile;
+    return result;
+  }
+
+  result.success = true;
+  result.compressionRatio =
+      result.originalSize > 0
+          ? static_cast<double>(result.compressedSize) / result.originalSize
+          : 0.0;
+  result.compressionTime =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start);
+  return result;
+}
+
+bool LogFileCompressor::decompressStream(const std::string &sourceFile,
+                                         const std::string &targetFile) {
+  SeekableLogReader reader(sourceFile);
+  const std::string tempFile = targetFile + ".tmp";
+  bool ok = false;
+  {
+    std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+    ok = out.is_open() && reader.readAll([&out](std::string_view piece) {
+      out.write(piece.data(), static_cast<std::streamsize>(piece.size()));
+      return static_cast<bool>(out);
+    });
+    out.close();
+    ok = ok && !out.fail();
+  }
+
+  std::error_code ec;
+  if (ok) {
+    std::filesystem::rename(tempFile, targetFile, ec);
+  }
+  if (!ok || ec) {
+    std::filesystem::remove(tempFile, ec);
+    return false;
+  }
   return true;
 }
 
-// Algorithm-specific stub implementations
+// Algorithm-specific implementations
 bool LogFileCompressor::compressGzip(const std::string &sourceFile,
                                      const std::string &targetFile, int level) {
-  return compressFile(sourceFile, targetFile, CompressionType::GZIP, level);
+  return compressFileWithResult(sourceFile, targetFile, CompressionType::GZIP,
+                                level)
+      .success;
 }
 
-bool LogFileCompressor::compressZip(const std::string &sourceFile,
-                                    const std::string &targetFile, int level) {
-  return compressFile(sourceFile, targetFile, CompressionType::ZIP, level);
+bool LogFileCompressor::compressZip(const std::string &, const std::string &,
+                                    int) {
+  return false; // Multi-file archives are not a log stream format
 }
 
-bool LogFileCompressor::compressBzip2(const std::string &sourceFile,
-                                      const std::string &targetFile,
-                                      int level) {
-  return compressFile(sourceFile, targetFile, CompressionType::BZIP2, level);
+bool LogFileCompressor::compressBzip2(const std::string &,
+                                      const std::string &, int) {
+  return false; // Not built in
 }
 
 bool LogFileCompressor::compressLZ4(const std::string &sourceFile,
                                     const std::string &targetFile) {
-  return compressFile(sourceFile, targetFile, CompressionType::LZ4);
+  return compressFileWithResult(sourceFile, targetFile, CompressionType::LZ4)
+      .success;
 }
 
 bool LogFileCompressor::compressZstd(const std::string &sourceFile,
                                      const std::string &targetFile, int level) {
-  return compressFile(sourceFile, targetFile, CompressionType::ZSTD, level);
+  return compressFileWithResult(sourceFile, targetFile, CompressionType::ZSTD,
+                                level)
+      .success;
 }
 
 bool LogFileCompressor::decompressGzip(const std::string &sourceFile,
                                        const std::string &targetFile) {
-  return decompressFile(sourceFile, targetFile);
+  return decompressStream(sourceFile, targetFile);
 }
 
-bool LogFileCompressor::decompressZip(const std::string &sourceFile,
-                                      const std::string &targetFile) {
-  return decompressFile(sourceFile, targetFile);
+bool LogFileCompressor::decompressZip(const std::string &,
+                                      const std::string &) {
+  return false;
 }
 
-bool LogFileCompressor::decompressBzip2(const std::string &sourceFile,
-                                        const std::string &targetFile) {
-  return decompressFile(sourceFile, targetFile);
+bool LogFileCompressor::decompressBzip2(const std::string &,
+                                        const std::string &) {
+  return false;
 }
 
 bool LogFileCompressor::decompressLZ4(const std::string &sourceFile,
                                       const std::string &targetFile) {
-  return decompressFile(sourceFile, targetFile);
+  return decompressStream(sourceFile, targetFile);
 }
 
 bool LogFileCompressor::decompressZstd(const std::string &sourceFile,
                                        const std::string &targetFile) {
-  return decompressFile(sourceFile, targetFile);
+  return decompressStream(sourceFile, targetFile);
 }
 
 // LogFileValidator implementations
@@ -1334,8 +2474,10 @@ bool LogFileManager::compressLogFile(const std::string &filename,
   std::string targetFile =
       sourceFile + getCompressionExtension(compressionType);
 
-  return compressor_->compressFile(sourceFile, targetFile, compressionType,
-                                   compressionLevel);
+  auto result = compressor_->compressFileWithResult(
+      sourceFile, targetFile, compressionType, compressionLevel);
+  recordCompression(result);
+  return result.success;
 }
 
 bool LogFileManager::decompressLogFile(const std::string &compressedFilename,
@@ -1352,7 +2494,22 @@ bool LogFileManager::decompressLogFile(const std::string &compressedFilename,
           ? std::filesystem::path(source).replace_extension("").string()
           : outputFilename;
 
-  return compressor_->decompressFile(source, target);
+  const auto start = std::chrono::steady_clock::now();
+  if (!compressor_->decompressFile(source, target)) {
+    metrics_.compressionErrors++;
+    return false;
+  }
+  metrics_.totalFilesDecompressed++;
+  metrics_.decompressionTime +=
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+  return true;
+}
+
+bool LogFileManager::waitForPendingCompression(
+    std::chrono::milliseconds timeout) {
+  return compressionQueue_->waitIdle(timeout);
 }
 
 size_t LogFileManager::compressEligibleFiles() {
@@ -1710,6 +2867,7 @@ LogFileManager::getPerformanceStats() const {
   stats["cacheHitRate"] = metrics_.getCacheHitRate();
   stats["errorRate"] = metrics_.getErrorRate();
   stats["compressionRatio"] = metrics_.averageCompressionRatio.load();
+  stats["compressionThroughputMBps"] = metrics_.getCompressionThroughput();
   stats["uptime"] = metrics_.getUptime().count();
 
   return stats;
@@ -1754,7 +2912,7 @@ LogFileManager::getEligibleFilesForCompression() const {
   try {
     for (const auto &entry :
          std::filesystem::directory_iterator(config_.logDirectory)) {
-      if (entry.is_regular_file()) {
+      if (entry.is_regular_file() && !isPendingRotation(entry.path())) {
         std::string filename = entry.path().filename().string();
 
         // Skip already compressed files
@@ -0,0 +1,245 @@
+#include "log_record.hpp"
+#include "logger.hpp"
+#include <charconv>
+#include <cstdio>
+#include <ctime>
+
+namespace {
+
+// Reads back what LogRecordWriter wrote; records never leave the process,
+// so the layout is native and unchecked
+class LogRecordReader {
+public:
+  explicit LogRecordReader(std::string_view record) : data_(record.data()) {
+    header_ = get<LogRecordWriter::Header>();
+  }
+
+  const LogRecordWriter::Header &header() const { return header_; }
+
+  // The next value, which must be a string
+  std::string_view text() {
+    const auto tag = get<LogRecordTag>();
+    if (tag == LogRecordTag::LITERAL) {
+      const char *text = get<const char *>();
+      return std::string_view(text, get<uint32_t>());
+    }
+    const uint32_t size = get<uint32_t>();
+    std::string_view text(data_, size);
+    data_ += size;
+    return text;
+  }
+
+  // The next value, appended as an ostream would print it
+  void appendValue(std::string &out) {
+    const char *start = data_;
+    char buffer[32];
+    char *end = buffer;
+    switch (get<LogRecordTag>()) {
+    case LogRecordTag::INT:
+      end = std::to_chars(buffer, buffer + sizeof(buffer), get<int64_t>()).ptr;
+      break;
+    case LogRecordTag::UINT:
+      end = std::to_chars(buffer, buffer + sizeof(buffer), get<uint64_t>()).ptr;
+      break;
+    case LogRecordTag::DOUBLE:
+      end += std::snprintf(buffer, sizeof(buffer), "%g", get<double>());
+      break;
+    case LogRecordTag::BOOL:
+      out += get<uint8_t>() ? '1' : '0';
+      return;
+    case LogRecordTag::CHAR:
+      out += get<char>();
+      return;
+    default:
+      data_ = start;
+      out.append(text());
+      return;
+    }
+    out.append(buffer, end);
+  }
+
+  void skipValue() {
+    std::string ignored;
+    appendValue(ignored);
+  }
+
+private:
+  template <typename T> T get() {
+    T value;
+    std::memcpy(&value, data_, sizeof(T));
+    data_ += sizeof(T);
+    return value;
+  }
+
+  const char *data_;
+  LogRecordWriter::Header header_;
+};
+
+const char *levelName(uint8_t level) {
+  switch (static_cast<LogLevel>(level)) {
+  case LogLevel::DEBUG:
+    return "DEBUG";
+  case LogLevel::INFO:
+    return "INFO ";
+  case LogLevel::WARN:
+    return "WARN ";
+  case LogLevel::ERROR:
+    return "ERROR";
+  case LogLevel::FATAL:
+    return "FATAL";
+  default:
+    return "UNKNOWN";
+  }
+}
+
+// Substitutes the arguments into the format, which reader has just read
+void appendMessage(LogRecordReader &reader, std::string_view format,
+                   std::string &out) {
+  size_t args = reader.header().args;
+  for (; args > 0; --args) {
+    const size_t pos = format.find("{}");
+    if (pos == std::string_view::npos) {
+      break;
+    }
+    out.append(format.substr(0, pos));
+    reader.appendValue(out);
+    format.remove_prefix(pos + 2);
+  }
+  out.append(format);
+  // Unused arguments still sit between the message and the context
+  for (; args > 0; --args) {
+    reader.skipValue();
+  }
+}
+
+void appendJsonEscaped(std::string &out, std::string_view text) {
+  for (char c : text) {
+    switch (c) {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\b':
+      out += "\\b";
+      break;
+    case '\f':
+      out += "\\f";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    case '\r':
+      out += "\\r";
+      break;
+    case '\t':
+      out += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char escaped[8];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+                      static_cast<unsigned char>(c));
+        out += escaped;
+      } else {
+        out += c;
+      }
+      break;
+    }
+  }
+}
+
+} // namespace
+
+void renderLogRecord(std::string_view record, LogFormat format,
+                     std::string &out) {
+  LogRecordReader reader(record);
+  const auto &header = reader.header();
+  const std::string_view component = reader.text();
+  const std::string_view pattern = reader.text();
+
+  if (format == LogFormat::JSON) {
+    thread_local std::string message;
+    message.clear();
+    appendMessage(reader, pattern, message);
+
+    out += "{\"timestamp\":\"";
+    appendLogTimestamp(out, header.timeUs);
+    out += "\",\"level\":\"";
+    out += levelName(header.level);
+    out += "\",\"component\":\"";
+    appendJsonEscaped(out, component);
+    out += "\",\"message\":\"";
+    appendJsonEscaped(out, message);
+    out += '"';
+    if (header.contexts > 0) {
+      out += ",\"context\":{";
+      for (uint16_t i = 0; i < header.contexts; ++i) {
+        out += i == 0 ? "\"" : ",\"";
+        appendJsonEscaped(out, reader.text());
+        out += "\":\"";
+        appendJsonEscaped(out, reader.text());
+        out += '"';
+      }
+      out += '}';
+    }
+    out += "}\n";
+    return;
+  }
+
+  out += '[';
+  appendLogTimestamp(out, header.timeUs);
+  out += "] [";
+  out += levelName(header.level);
+  out += "] [";
+  out.append(component);
+  out += "] ";
+  appendMessage(reader, pattern, out);
+  if (header.contexts > 0) {
+    out += " |";
+    for (uint16_t i = 0; i < header.contexts; ++i) {
+      out += ' ';
+      out.append(reader.text());
+      out += '=';
+      out.append(reader.text());
+    }
+  }
+  out += '\n';
+}
+
+std::string renderLogMessage(std::string_view record) {
+  LogRecordReader reader(record);
+  reader.text(); // component
+  const std::string_view pattern = reader.text();
+  std::string message;
+  appendMessage(reader, pattern, message);
+  return message;
+}
+
+void appendLogTimestamp(std::string &out, int64_t timeUs) {
+  const std::time_t second = static_cast<std::time_t>(timeUs / 1000000);
+  const int millis = static_cast<int>(timeUs / 1000 % 1000);
+
+  // The date and time change once a second; keep them per thread rather
+  // than running localtime and strftime for every line
+  thread_local std::time_t cachedSecond = -1;
+  thread_local char cachedPrefix[32] = {};
+  if (second != cachedSecond) {
+    std::tm tm_buf{};
+#ifdef _WIN32
+    localtime_s(&tm_buf, &second);
+#else
+    localtime_r(&second, &tm_buf);
+#endif
+    std::strftime(cachedPrefix, sizeof(cachedPrefix), "%Y-%m-%d %H:%M:%S",
+                  &tm_buf);
+    cachedSecond = second;
+  }
+
+  out += cachedPrefix;
+  out += '.';
+  out += static_cast<char>('0' + millis / 100);
+  out += static_cast<char>('0' + millis / 10 % 10);
+  out += static_cast<char>('0' + millis % 10);
+}
@@ -0,0 +1,418 @@
+#include "log_search_engine.hpp"
+#include "log_compression.hpp"
+#include "simd_string_kernels.hpp"
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// How far back a continuation line looks for the line it belongs to
+constexpr size_t kTimestampLookbackLines = 64;
+
+int64_t toMillis(std::chrono::system_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+// Time of the nearest parsed line before lineStart: what a stack trace or
+// other continuation line is reported with
+int64_t precedingTimestamp(std::string_view text, size_t lineStart) {
+  size_t end = lineStart;
+  for (size_t step = 0; end > 0 && step < kTimestampLookbackLines; ++step) {
+    const size_t lineEnd = end - 1; // the newline ending the previous line
+    const size_t newline =
+        lineEnd == 0 ? std::string_view::npos : text.rfind('\n', lineEnd - 1);
+    const size_t start = newline == std::string_view::npos ? 0 : newline + 1;
+    if (auto parsed = parseLogLine(text.substr(start, lineEnd - start))) {
+      return parsed->timestampMs;
+    }
+    end = start;
+  }
+  return 0;
+}
+
+} // namespace
+
+// MappedLogFile
+
+MappedLogFile::MappedLogFile(const std::string &path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return;
+  }
+  struct stat info {};
+  if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+    void *data = ::mmap(nullptr, static_cast<size_t>(info.st_size),
+                        PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      ::madvise(data, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+      data_ = static_cast<const char *>(data);
+      size_ = static_cast<size_t>(info.st_size);
+    }
+  }
+  ::close(fd);
+}
+
+MappedLogFile::~MappedLogFile() {
+  if (data_) {
+    ::munmap(const_cast<char *>(data_), size_);
+  }
+}
+
+// LogQueryMatcher
+
+LogQueryMatcher::LogQueryMatcher(const LogQueryParams &params)
+    : params_(params),
+      startMs_(params.startTime ? toMillis(*params.startTime)
+                                : std::numeric_limits<int64_t>::min()),
+      endMs_(params.endTime ? toMillis(*params.endTime)
+                            : std::numeric_limits<int64_t>::max()),
+      structured_(params.startTime || params.endTime || params.minLevel ||
+                  params.maxLevel || params.component || params.jobId) {
+  if (params.useRegex && params.searchText && !params.searchText->empty()) {
+    try {
+      pattern_.emplace(*params.searchText);
+    } catch (const std::regex_error &) {
+      valid_ = false;
+    }
+  }
+}
+
+std::string_view LogQueryMatcher::requiredSubstring() const {
+  if (params_.useRegex || !params_.searchText) {
+    return {};
+  }
+  return *params_.searchText;
+}
+
+bool LogQueryMatcher::matches(const std::optional<ParsedLogLine> &parsed,
+                              std::string_view line) const {
+  if (!parsed) {
+    if (structured_) {
+      return false;
+    }
+  } else if (parsed->timestampMs < startMs_ || parsed->timestampMs > endMs_ ||
+             (params_.minLevel && parsed->level < *params_.minLevel) ||
+             (params_.maxLevel && parsed->level > *params_.maxLevel) ||
+             (params_.component && parsed->component != *params_.component) ||
+             (params_.jobId && parsed->jobId != *params_.jobId)) {
+    return false;
+  }
+
+  if (pattern_) {
+    return std::regex_search(line.begin(), line.end(), *pattern_);
+  }
+  return !params_.searchText ||
+         etl::string_kernels::findSubstring(line, *params_.searchText) !=
+             std::string_view::npos;
+}
+
+bool LogQueryMatcher::mayMatchSpan(int64_t minTimeMs, int64_t maxTimeMs,
+                                   uint8_t levels) const {
+  if (!structured_) {
+    return true; // lines without fields can match too
+  }
+  if (maxTimeMs < startMs_ || minTimeMs > endMs_) {
+    return false;
+  }
+  if (params_.minLevel || params_.maxLevel) {
+    for (auto level = static_cast<int>(LogLevel::DEBUG);
+         level <= static_cast<int>(LogLevel::FATAL); ++level) {
+      if ((levels & (1u << level)) &&
+          (!params_.minLevel || level >= static_cast<int>(*params_.minLevel)) &&
+          (!params_.maxLevel || level <= static_cast<int>(*params_.maxLevel))) {
+        return true;
+      }
+    }
+    return false;
+  }
+  return true;
+}
+
+// LogResultWindow
+
+LogResultWindow::LogResultWindow(const LogQueryParams &params)
+    : params_(params),
+      capacity_(params.maxResults >
+                        std::numeric_limits<size_t>::max() - params.offset
+                    ? std::numeric_limits<size_t>::max()
+                    : params.offset + params.maxResults) {}
+
+bool LogResultWindow::before(int64_t timestampMs, LogLevel level,
+                             std::string_view component, size_t fileRank,
+                             uint64_t position, const Slot &b) const {
+  int order = 0;
+  if (params_.sortBy == "level" && level != b.entry.level) {
+    order = level < b.entry.level ? -1 : 1;
+  } else if (params_.sortBy == "component" && component != b.entry.component) {
+    order = component < b.entry.component ? -1 : 1;
+  } else if (timestampMs != b.timestampMs) {
+    order = timestampMs < b.timestampMs ? -1 : 1;
+  } else if (fileRank != b.fileRank) {
+    order = fileRank < b.fileRank ? -1 : 1;
+  } else if (position != b.position) {
+    order = position < b.position ? -1 : 1;
+  }
+  return params_.ascending ? order < 0 : order > 0;
+}
+
+bool LogResultWindow::before(const Slot &a, const Slot &b) const {
+  return before(a.timestampMs, a.entry.level, a.entry.component, a.fileRank,
+                a.position, b);
+}
+
+bool LogResultWindow::wouldAccept(int64_t timestampMs, LogLevel level,
+                                  std::string_view component, size_t fileRank,
+                                  uint64_t position) const {
+  if (heap_.size() < capacity_) {
+    return true;
+  }
+  return !heap_.empty() &&
+         before(timestampMs, level, component, fileRank, position,
+                heap_.front());
+}
+
+void LogResultWindow::add(HistoricalLogEntry entry, size_t fileRank,
+                          uint64_t position, uint32_t tag) {
+  const int64_t timestampMs = toMillis(entry.timestamp);
+  push({std::move(entry), timestampMs, fileRank, position, tag});
+}
+
+void LogResultWindow::merge(LogResultWindow &&other) {
+  for (Slot &slot : other.heap_) {
+    push(std::move(slot));
+  }
+  other.heap_.clear();
+}
+
+void LogResultWindow::push(Slot slot) {
+  auto worse = [this](const Slot &a, const Slot &b) { return before(a, b); };
+  if (heap_.size() < capacity_) {
+    heap_.push_back(std::move(slot));
+    std::push_heap(heap_.begin(), heap_.end(), worse);
+  } else if (!heap_.empty() && before(slot, heap_.front())) {
+    std::pop_heap(heap_.begin(), heap_.end(), worse);
+    heap_.back() = std::move(slot);
+    std::push_heap(heap_.begin(), heap_.end(), worse);
+  }
+}
+
+std::vector<LogResultWindow::Result> LogResultWindow::takePage() {
+  std::sort_heap(heap_.begin(), heap_.end(),
+                 [this](const Slot &a, const Slot &b) { return before(a, b); });
+  std::vector<Result> page;
+  if (heap_.size() > params_.offset) {
+    page.reserve(heap_.size() - params_.offset);
+    for (auto it = heap_.begin() + params_.offset; it != heap_.end(); ++it) {
+      page.push_back({std::move(it->entry), it->tag});
+    }
+  }
+  heap_.clear();
+  return page;
+}
+
+// LogSearchEngine
+
+namespace {
+
+struct ScanChunk {
+  size_t file;
+  uint64_t begin;
+  uint64_t end;
+  size_t frame; // of a seekable compressed file, or kNoFrame
+};
+
+constexpr size_t kNoFrame = std::numeric_limits<size_t>::max();
+
+// Scans one line-aligned chunk into window and returns the number of
+// newlines in it. Line numbers are chunk-relative until the caller adds
+// the lines of the chunks before it.
+size_t scanChunk(std::string_view text, uint64_t chunkOffset, size_t fileRank,
+                 const std::string &filename, const LogQueryMatcher &matcher,
+                 LogResultWindow &window, uint32_t tag) {
+  using etl::string_kernels::countByte;
+  size_t lines = 0;
+
+  auto consider = [&](size_t start, size_t end) {
+    const std::string_view line = text.substr(start, end - start);
+    const auto parsed = parseLogLine(line);
+    if (!matcher.matches(parsed, line)) {
+      return;
+    }
+    const int64_t timestampMs =
+        parsed ? parsed->timestampMs : precedingTimestamp(text, start);
+    const LogLevel level = parsed ? parsed->level : LogLevel::INFO;
+    const std::string_view component =
+        parsed ? parsed->component : std::string_view();
+    if (!window.wouldAccept(timestampMs, level, component, fileRank,
+                            chunkOffset + start)) {
+      return;
+    }
+
+    HistoricalLogEntry entry;
+    entry.timestamp = std::chrono::system_clock::time_point(
+        std::chrono::milliseconds(timestampMs));
+    entry.level = level;
+    entry.component = component;
+    entry.message = parsed ? parsed->message : line;
+    if (parsed) {
+      entry.jobId = parsed->jobId;
+    }
+    entry.filename = filename;
+    entry.lineNumber = lines + 1;
+    window.add(std::move(entry), fileRank, chunkOffset + start, tag);
+  };
+
+  const std::string_view literal = matcher.requiredSubstring();
+  if (literal.find('\n') != std::string_view::npos) {
+    return countByte(text, '\n'); // no single line can contain it
+  }
+
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t start = pos;
+    if (!literal.empty()) {
+      // Jump to the next line containing the literal, counting the lines
+      // skipped on the way
+      const size_t hit =
+          etl::string_kernels::findSubstring(text.substr(pos), literal);
+      if (hit == std::string_view::npos) {
+        return lines + countByte(text.substr(pos), '\n');
+      }
+      const size_t newline = text.rfind('\n', pos + hit);
+      start = newline == std::string_view::npos || newline < pos
+                  ? pos
+                  : newline + 1;
+      lines += countByte(text.substr(pos, start - pos), '\n');
+    }
+
+    size_t end = text.find('\n', start);
+    if (end == std::string_view::npos) {
+      end = text.size();
+    }
+    consider(start, end);
+    if (end == text.size()) {
+      break;
+    }
+    ++lines;
+    pos = end + 1;
+  }
+  return lines;
+}
+
+} // namespace
+
+LogSearchEngine::LogSearchEngine(size_t threads, size_t chunkBytes)
+    : threads_(threads), chunkBytes_(std::max<size_t>(chunkBytes, 4096)) {}
+
+LogSearchEngine::~LogSearchEngine() = default;
+
+WorkStealingPool &LogSearchEngine::pool() const {
+  std::call_once(poolOnce_, [this] {
+    pool_ = std::make_unique<WorkStealingPool>(threads_);
+  });
+  return *pool_;
+}
+
+std::vector<HistoricalLogEntry>
+LogSearchEngine::search(const std::vector<std::string> &files,
+                        const LogQueryParams &params) const {
+  LogQueryMatcher matcher(params);
+  if (!matcher.isValid() || params.maxResults == 0) {
+    return {};
+  }
+
+  // Map every plain file and cut it into chunks that end on a newline.
+  // Compressed files are read through their seek table a frame at a time,
+  // or decompressed whole when they have none.
+  std::vector<std::unique_ptr<MappedLogFile>> maps(files.size());
+  std::vector<std::unique_ptr<SeekableLogReader>> readers(files.size());
+  std::vector<std::string> inflated(files.size());
+  std::vector<std::string> filenames;
+  std::vector<ScanChunk> chunks;
+  auto contents = [&](size_t file) -> std::string_view {
+    return maps[file] ? maps[file]->contents() : inflated[file];
+  };
+  for (size_t file = 0; file < files.size(); ++file) {
+    filenames.push_back(std::filesystem::path(files[file]).filename().string());
+    auto reader = std::make_unique<SeekableLogReader>(files[file]);
+    if (reader->type() == CompressionType::NONE) {
+      maps[file] = std::make_unique<MappedLogFile>(files[file]);
+    } else if (!reader->frames().empty()) {
+      const auto &frames = reader->frames();
+      for (size_t frame = 0; frame < frames.size(); ++frame) {
+        chunks.push_back({file, frames[frame].rawOffset,
+                          frames[frame].rawOffset + frames[frame].rawBytes,
+                          frame});
+      }
+      readers[file] = std::move(reader);
+      continue;
+    } else {
+      reader->readAll([&](std::string_view piece) {
+        inflated[file].append(piece);
+        return true;
+      });
+    }
+
+    const std::string_view text = contents(file);
+    for (uint64_t begin = 0; begin < text.size();) {
+      uint64_t end = std::min<uint64_t>(begin + chunkBytes_, text.size());
+      if (end < text.size()) {
+        const size_t newline = text.find('\n', end - 1);
+        end = newline == std::string_view::npos ? text.size() : newline + 1;
+      }
+      chunks.push_back({file, begin, end, kNoFrame});
+      begin = end;
+    }
+  }
+
+  std::vector<size_t> chunkLines(chunks.size(), 0);
+  LogResultWindow results(params);
+  std::mutex resultsMutex;
+  pool().parallelFor(chunks.size(), [&](size_t i) {
+    const ScanChunk &chunk = chunks[i];
+    std::string frameText;
+    std::string_view text;
+    if (chunk.frame != kNoFrame) {
+      const SeekableLogReader &reader = *readers[chunk.file];
+      const SeekableLogFrame &frame = reader.frames()[chunk.frame];
+      chunkLines[i] = frame.lines;
+      if (!matcher.mayMatchSpan(frame.minTimeMs, frame.maxTimeMs,
+                                frame.levels) ||
+          !reader.readFrame(chunk.frame, frameText)) {
+        return;
+      }
+      text = frameText;
+    } else {
+      text = contents(chunk.file).substr(chunk.begin, chunk.end - chunk.begin);
+    }
+    LogResultWindow window(params);
+    chunkLines[i] =
+        scanChunk(text, chunk.begin, chunk.file, filenames[chunk.file],
+                  matcher, window, static_cast<uint32_t>(i));
+    std::lock_guard lock(resultsMutex);
+    results.merge(std::move(window));
+  });
+
+  // Lines before each chunk in its file turn chunk-relative line numbers
+  // into file line numbers
+  std::vector<uint64_t> linesBefore(chunks.size(), 0);
+  for (size_t i = 1; i < chunks.size(); ++i) {
+    if (chunks[i].file == chunks[i - 1].file) {
+      linesBefore[i] = linesBefore[i - 1] + chunkLines[i - 1];
+    }
+  }
+
+  std::vector<HistoricalLogEntry> entries;
+  for (auto &result : results.takePage()) {
+    result.entry.lineNumber += linesBefore[result.tag];
+    entries.push_back(std::move(result.entry));
+  }
+  return entries;
+}
@@ -1,13 +1,82 @@
 #include "logger.hpp"
 #include "job_monitoring_models.hpp"
+#include "log_compression.hpp"
+#include "log_ring_buffer.hpp"
 #include "websocket_manager.hpp"
 #include <algorithm>
-#include <ctime>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
 #include <filesystem>
 #include <fstream>
-#include <iomanip>
+#include <functional>
 #include <iostream>
-#include <sstream>
+#include <queue>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <tuple>
+#include <unistd.h>
+
+namespace {
+
+// Records the writer takes from each staging ring per write
+constexpr size_t kMaxWriteBatch = 1024;
+
+// writev() until every byte is out, resuming after short writes
+bool writeAll(int fd, iovec *iov, int count) {
+  while (count > 0) {
+    ssize_t written = ::writev(fd, iov, count);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    while (count > 0 && static_cast<size_t>(written) >= iov->iov_len) {
+      written -= static_cast<ssize_t>(iov->iov_len);
+      ++iov;
+      --count;
+    }
+    if (count > 0) {
+      iov->iov_base = static_cast<char *>(iov->iov_base) + written;
+      iov->iov_len -= static_cast<size_t>(written);
+    }
+  }
+  return true;
+}
+
+void countMessage(LogMetrics &metrics, uint8_t level) {
+  metrics.totalMessages++;
+  if (level >= static_cast<uint8_t>(LogLevel::ERROR)) {
+    metrics.errorCount++;
+  } else if (level == static_cast<uint8_t>(LogLevel::WARN)) {
+    metrics.warningCount++;
+  }
+}
+
+void addMetrics(LogMetrics &into, const LogMetrics &from) {
+  into.totalMessages += from.totalMessages.load();
+  into.errorCount += from.errorCount.load();
+  into.warningCount += from.warningCount.load();
+  into.droppedMessages += from.droppedMessages.load();
+}
+
+} // namespace
+
+/**
+ * One thread's staging ring and the counts of what that thread logged.
+ * Only the owning thread pushes and counts; the writer thread drains the
+ * ring.
+ */
+struct LogStagingBuffer {
+  explicit LogStagingBuffer(size_t capacity) : ring(capacity, 128) {}
+
+  LogRingBuffer ring;
+  alignas(64) LogMetrics metrics; // off the writer's cache lines
+  // Set by the owning thread while it may push; stopAsyncWriter() waits for
+  // it to clear before the writer's last drain
+  std::atomic<bool> pushing{false};
+};
 
 Logger &Logger::getInstance() {
   static Logger instance;
@@ -31,9 +100,7 @@ void Logger::configure(const LogConfig &config) {
   {
     std::lock_guard<std::mutex> fileLock(fileMutex_);
 
-    if (fileStream_.is_open()) {
-      fileStream_.close();
-    }
+    closeFileSink();
 
     config_.logFile = config.logFile;
     currentLogFile_ = config.logFile;
@@ -48,19 +115,10 @@ void Logger::configure(const LogConfig &config) {
         std::filesystem::create_directories(config_.archiveDirectory);
       }
 
-      fileStream_.open(currentLogFile_, std::ios::app);
-
-      if (!fileStream_.is_open()) {
+      if (!openFileSink(false)) {
         std::cerr << "Failed to open log file: " << config.logFile << std::endl;
         config_.fileOutput = false;
       } else {
-        // Get current file size
-        if (std::filesystem::exists(currentLogFile_)) {
-          currentFileSize_ = std::filesystem::file_size(currentLogFile_);
-        } else {
-          currentFileSize_ = 0;
-        }
-
         // Write conditional startup message based on enabled features
         std::string features;
         if (config_.enableHistoricalAccess && config_.enableLogIndexing) {
@@ -76,9 +134,7 @@ void Logger::configure(const LogConfig &config) {
         std::string startupMsg =
             "[" + formatTimestamp() +
             "] [INFO ] [Logger] Enhanced logger initialized with " + features;
-        fileStream_ << startupMsg << std::endl;
-        fileStream_.flush();
-        currentFileSize_ += startupMsg.length() + 1;
+        writeFileLine(startupMsg);
 
         // Index current log file if indexing is enabled - INLINE to avoid
         // deadlock
@@ -105,12 +161,12 @@ void Logger::configure(const LogConfig &config) {
   config_.includeMetrics = config.includeMetrics;
   config_.flushInterval = config.flushInterval;
 
-  // Handle async logging initialization
-  if (config.asyncLogging && !config_.asyncLogging && !asyncStarted_) {
-    config_.asyncLogging = true;
-    stopAsync_ = false;
-    asyncStarted_ = true;
-    asyncThread_ = std::thread(&Logger::asyncWorker, this);
+  // Handle async logging initialization (config_ already holds the new
+  // setting, so the writer's own state decides)
+  if (config.asyncLogging && !asyncStarted_) {
+    startAsyncWriter();
+  } else if (!config.asyncLogging && asyncStarted_) {
+    stopAsyncWriter();
   }
 
   // Handle real-time streaming initialization - INLINE to avoid deadlock
@@ -126,11 +182,14 @@ void Logger::configure(const LogConfig &config) {
     streamingStarted_ = true;
     streamingThread_ = std::thread(&Logger::streamingWorker, this);
   }
+
+  updateThresholds();
 }
 
 void Logger::setLogLevel(LogLevel level) {
   std::lock_guard<std::mutex> lock(configMutex_);
   config_.level = level;
+  updateThresholds();
 }
 
 void Logger::setLogFormat(LogFormat format) {
@@ -141,9 +200,7 @@ void Logger::setLogFormat(LogFormat format) {
 void Logger::setLogFile(const std::string &filename) {
   std::lock_guard<std::mutex> lock(fileMutex_);
 
-  if (fileStream_.is_open()) {
-    fileStream_.close();
-  }
+  closeFileSink();
 
   config_.logFile = filename;
   currentLogFile_ = filename;
@@ -152,26 +209,16 @@ void Logger::setLogFile(const std::string &filename) {
   std::filesystem::path logPath(filename);
   std::filesystem::create_directories(logPath.parent_path());
 
-  fileStream_.open(currentLogFile_, std::ios::app);
-
-  if (!fileStream_.is_open()) {
+  if (!openFileSink(false)) {
     std::cerr << "Failed to open log file: " << filename << std::endl;
     config_.fileOutput = false;
   } else {
     config_.fileOutput = true;
-    // Get current file size
-    if (std::filesystem::exists(currentLogFile_)) {
-      currentFileSize_ = std::filesystem::file_size(currentLogFile_);
-    } else {
-      currentFileSize_ = 0;
-    }
 
     // Write simple startup message to avoid recursion during initialization
     std::string startupMsg = "[" + formatTimestamp() +
                              "] [INFO ] [Logger] Enhanced logger initialized";
-    fileStream_ << startupMsg << std::endl;
-    fileStream_.flush();
-    currentFileSize_ += startupMsg.length() + 1;
+    writeFileLine(startupMsg);
   }
 }
 
@@ -188,19 +235,10 @@ void Logger::enableFileOutput(bool enable) {
 void Logger::enableAsyncLogging(bool enable) {
   std::lock_guard<std::mutex> lock(configMutex_);
 
-  if (enable && !config_.asyncLogging && !asyncStarted_) {
-    config_.asyncLogging = true;
-    stopAsync_ = false;
-    asyncStarted_ = true;
-    asyncThread_ = std::thread(&Logger::asyncWorker, this);
-  } else if (!enable && config_.asyncLogging && asyncStarted_) {
-    config_.asyncLogging = false;
-    stopAsync_ = true;
-    asyncCondition_.notify_all();
-    if (asyncThread_.joinable()) {
-      asyncThread_.join();
-    }
-    asyncStarted_ = false;
+  if (enable && !asyncStarted_) {
+    startAsyncWriter();
+  } else if (!enable && asyncStarted_) {
+    stopAsyncWriter();
   }
 }
 
@@ -209,6 +247,45 @@ void Logger::setComponentFilter(
                              std::equal_to<>> &components) {
   std::lock_guard<std::mutex> lock(configMutex_);
   config_.componentFilter = components;
+  updateThresholds();
+}
+
+const std::atomic<int> &Logger::componentThreshold(const char *component) {
+  std::lock_guard<std::mutex> lock(configMutex_);
+  auto it = componentThresholds_.find(std::string_view(component));
+  if (it == componentThresholds_.end()) {
+    it = componentThresholds_
+             .emplace(component, std::make_unique<std::atomic<int>>())
+             .first;
+    updateThresholds();
+  }
+  return *it->second;
+}
+
+// Called with configMutex_ held, after any change to the level, the
+// component filter or streaming
+void Logger::updateThresholds() {
+  const int level = static_cast<int>(config_.level);
+  minLevel_.store(level, std::memory_order_relaxed);
+  componentFilterActive_.store(!config_.componentFilter.empty(),
+                               std::memory_order_relaxed);
+  streamingMinLevel_.store(
+      !config_.enableRealTimeStreaming ? kLevelOff
+      : config_.streamAllLevels        ? static_cast<int>(LogLevel::DEBUG)
+                                       : level,
+      std::memory_order_relaxed);
+  for (auto &[component, threshold] : componentThresholds_) {
+    const bool included = config_.componentFilter.empty() ||
+                          config_.componentFilter.count(component) > 0;
+    threshold->store(included ? level : kLevelOff, std::memory_order_relaxed);
+  }
+}
+
+bool Logger::passesComponentFilter(std::string_view component) const {
+  std::lock_guard<std::mutex> lock(configMutex_);
+  return config_.componentFilter.empty() ||
+         config_.componentFilter.find(component) !=
+             config_.componentFilter.end();
 }
 
 void Logger::enableRotation(bool enable, size_t maxFileSize,
@@ -223,21 +300,20 @@ void Logger::log(
     LogLevel level, const std::string &component, const std::string &message,
     const std::unordered_map<std::string, std::string, TransparentStringHash,
                              std::equal_to<>> &context) {
-  if (!shouldLog(level, component)) {
+  if (!isEnabled(level, component)) {
     return;
   }
 
-  // Update metrics
-  metrics_.totalMessages++;
-  if (level == LogLevel::ERROR || level == LogLevel::FATAL) {
-    metrics_.errorCount++;
-  } else if (level == LogLevel::WARN) {
-    metrics_.warningCount++;
+  // The message is the record's format, with no arguments to substitute
+  LogRecordWriter record(LogRecordWriter::scratch());
+  record.begin(level, 0, context.size());
+  record.string(component);
+  record.string(message);
+  for (const auto &[key, value] : context) {
+    record.string(key);
+    record.string(value);
   }
-
-  std::string formattedMessage =
-      formatMessage(level, component, message, context);
-  writeLog(formattedMessage);
+  writeRecord(LogRecordWriter::scratch());
 }
 
 void Logger::debug(
@@ -303,19 +379,48 @@ void Logger::logPerformance(
       perfContext);
 }
 
-LogMetrics Logger::getMetrics() const { return metrics_; }
+LogMetrics Logger::getMetrics() const {
+  // Under the lock, so a retiring buffer is counted exactly once
+  std::lock_guard<std::mutex> lock(stagingMutex_);
+  LogMetrics metrics = metrics_;
+  for (const auto &buffer : stagingBuffers_) {
+    addMetrics(metrics, buffer->metrics);
+  }
+  return metrics;
+}
 
 void Logger::flush() {
-  if (config_.asyncLogging) {
-    // For async logging, notify worker to flush
+  if (asyncStarted_) {
+    // Wait for the writer to get every record staged so far out, waking it
+    // again for records whose producers had not finished copying them
+    std::vector<std::pair<std::shared_ptr<LogStagingBuffer>, size_t>> targets;
+    {
+      std::lock_guard<std::mutex> lock(stagingMutex_);
+      for (const auto &buffer : stagingBuffers_) {
+        targets.emplace_back(buffer, buffer->ring.pushed());
+      }
+    }
+    auto pending = [&targets] {
+      for (const auto &[buffer, pushed] : targets) {
+        if (buffer->ring.released() < pushed) {
+          return true;
+        }
+      }
+      return false;
+    };
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
     std::unique_lock<std::mutex> lock(asyncMutex_);
-    asyncCondition_.notify_all();
+    while (pending() && asyncStarted_ &&
+           std::chrono::steady_clock::now() < deadline) {
+      flushRequested_ = true;
+      asyncCondition_.notify_one();
+      asyncFlushed_.wait_for(lock, std::chrono::milliseconds(1));
+    }
   }
 
-  std::lock_guard<std::mutex> lock(fileMutex_);
-  if (fileStream_.is_open()) {
-    fileStream_.flush();
-  }
+  // File writes are unbuffered; only the console stream holds data
+  std::cout.flush();
 }
 
 void Logger::shutdown() {
@@ -328,30 +433,16 @@ void Logger::shutdown() {
   }
 
   std::lock_guard<std::mutex> lock(fileMutex_);
-  if (fileStream_.is_open()) {
-    fileStream_.close();
-  }
+  closeFileSink();
 }
 
 std::string Logger::formatTimestamp() {
-  auto now = std::chrono::system_clock::now();
-  auto time_t = std::chrono::system_clock::to_time_t(now);
-  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now.time_since_epoch()) %
-            1000;
-
-  // Use thread-safe localtime alternative
-  std::tm tm_buf{};
-#ifdef _WIN32
-  localtime_s(&tm_buf, &time_t);
-#else
-  localtime_r(&time_t, &tm_buf);
-#endif
-
-  std::ostringstream oss;
-  oss << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S");
-  oss << "." << std::setfill('0') << std::setw(3) << ms.count();
-  return oss.str();
+  std::string result;
+  appendLogTimestamp(result,
+                     std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count());
+  return result;
 }
 
 std::string Logger::levelToString(LogLevel level) {
@@ -371,224 +462,409 @@ std::string Logger::levelToString(LogLevel level) {
   }
 }
 
-std::string Logger::formatMessage(
-    LogLevel level, const std::string &component, const std::string &message,
-    const std::unordered_map<std::string, std::string, TransparentStringHash,
-                             std::equal_to<>> &context) {
-  return config_.format == LogFormat::JSON
-             ? formatJsonMessage(level, component, message, context)
-             : formatTextMessage(level, component, message, context);
+void Logger::writeRecord(std::string_view record) {
+  if (config_.asyncLogging && asyncStarted_ && writeLogAsync(record)) {
+    return;
+  }
+  countMessage(metrics_, LogRecordWriter::readHeader(record).level);
+  writeLogSync(record);
 }
 
-std::string Logger::formatTextMessage(
-    LogLevel level, const std::string &component, const std::string &message,
-    const std::unordered_map<std::string, std::string, TransparentStringHash,
-                             std::equal_to<>> &context) {
-  std::ostringstream oss;
-  oss << "[" << formatTimestamp() << "] "
-      << "[" << levelToString(level) << "] "
-      << "[" << component << "] " << message;
-
-  if (!context.empty()) {
-    oss << " |";
-    for (const auto &[key, value] : context) {
-      oss << " " << key << "=" << value;
-    }
+void Logger::writeLogSync(std::string_view record) {
+  thread_local std::string line;
+  line.clear();
+  renderLogRecord(record, config_.format, line);
+
+  if (config_.consoleOutput) {
+    std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+    std::cout.flush();
   }
 
-  return oss.str();
+  if (config_.fileOutput) {
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    if (fileFd_ >= 0) {
+      // Check if rotation is needed
+      if (config_.enableRotation &&
+          currentFileSize_ + line.size() > config_.maxFileSize) {
+        rotateLogFile();
+      }
+
+      writeFileBytes(line);
+    }
+  }
 }
 
-std::string Logger::formatJsonMessage(
-    LogLevel level, const std::string &component, const std::string &message,
-    const std::unordered_map<std::string, std::string, TransparentStringHash,
-                             std::equal_to<>> &context) {
-  std::ostringstream oss;
-  oss << "{"
-      << "\"timestamp\":\"" << formatTimestamp() << "\","
-      << "\"level\":\"" << levelToString(level) << "\","
-      << "\"component\":\"" << escapeJson(component) << "\","
-      << "\"message\":\"" << escapeJson(message) << "\"";
-
-  if (!context.empty()) {
-    oss << ",\"context\":{";
-    bool first = true;
-    for (const auto &[key, value] : context) {
-      if (!first)
-        oss << ",";
-      oss << "\"" << escapeJson(key) << "\":\"" << escapeJson(value) << "\"";
-      first = false;
+// No lock and no shared cache line: the record goes into this thread's own
+// ring and is counted in that ring's metrics. Returns false, having staged
+// nothing, if the writer is being stopped; the caller then writes directly.
+bool Logger::writeLogAsync(std::string_view record) {
+  LogStagingBuffer &buffer = stagingBuffer();
+  // Pairs with stopAsyncWriter(): it clears asyncStarted_ and then waits
+  // for pushing to drop, so either this sees the stop or the writer's last
+  // drain sees the record
+  buffer.pushing.store(true);
+  if (!asyncStarted_) {
+    buffer.pushing.store(false, std::memory_order_release);
+    return false;
+  }
+
+  LogRingBuffer &ring = buffer.ring;
+  while (!ring.tryPush(record)) {
+    if (config_.asyncOverflowPolicy == LogOverflowPolicy::DROP) {
+      buffer.metrics.droppedMessages++;
+      buffer.pushing.store(false, std::memory_order_release);
+      return true;
+    }
+    // BLOCK: the ring is full, so the writer is already being woken
+    if (!asyncWakePending_.exchange(true)) {
+      wakeAsyncWriter();
     }
-    oss << "}";
+    std::this_thread::yield();
+  }
+  countMessage(buffer.metrics, LogRecordWriter::readHeader(record).level);
+  buffer.pushing.store(false, std::memory_order_release);
+
+  // The writer sleeps for flushInterval; past half full it is woken early
+  // so producers rarely find their ring full
+  if (ring.size() >= ring.capacity() / 2 &&
+      !asyncWakePending_.exchange(true)) {
+    wakeAsyncWriter();
   }
+  return true;
+}
 
-  oss << "}";
-  return oss.str();
+// This thread's ring, created and registered the first time it logs
+// asynchronously; once the thread exits the writer drains and drops it
+LogStagingBuffer &Logger::stagingBuffer() {
+  thread_local std::shared_ptr<LogStagingBuffer> buffer;
+  if (!buffer) {
+    buffer = std::make_shared<LogStagingBuffer>(
+        std::max<size_t>(config_.asyncQueueSize, 64));
+    std::lock_guard<std::mutex> lock(stagingMutex_);
+    stagingBuffers_.push_back(buffer);
+  }
+  return *buffer;
 }
 
-std::string Logger::escapeJson(const std::string &str) {
-  std::string result;
-  result.reserve(str.length() + 20); // Reserve some extra space for escapes
-
-  for (char c : str) {
-    switch (c) {
-    case '"':
-      result += "\\\"";
-      break;
-    case '\\':
-      result += "\\\\";
-      break;
-    case '\b':
-      result += "\\b";
-      break;
-    case '\f':
-      result += "\\f";
-      break;
-    case '\n':
-      result += "\\n";
-      break;
-    case '\r':
-      result += "\\r";
-      break;
-    case '\t':
-      result += "\\t";
-      break;
-    default:
-      if (c < 0x20) {
-        std::ostringstream oss;
-        oss << "\\u" << std::setfill('0') << std::setw(4) << std::hex
-            << static_cast<int>(c);
-        result += oss.str();
-      } else {
-        result += c;
-      }
-      break;
+// Called with configMutex_ held
+void Logger::startAsyncWriter() {
+  asyncInterval_ =
+      std::chrono::milliseconds(std::max(1, config_.flushInterval));
+  config_.asyncLogging = true;
+  stopAsync_ = false;
+  asyncWakePending_ = false;
+  asyncStarted_ = true;
+  asyncThread_ = std::thread(&Logger::asyncWorker, this);
+}
+
+// Called with configMutex_ held; the writer drains the rings before exiting
+void Logger::stopAsyncWriter() {
+  config_.asyncLogging = false;
+  asyncStarted_ = false;
+  // A producer that got past the check may still be pushing (or, under
+  // BLOCK, waiting for the still running writer to make room)
+  std::vector<std::shared_ptr<LogStagingBuffer>> buffers;
+  {
+    std::lock_guard<std::mutex> lock(stagingMutex_);
+    buffers = stagingBuffers_;
+  }
+  for (const auto &buffer : buffers) {
+    while (buffer->pushing.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
     }
   }
 
-  return result;
+  {
+    std::lock_guard<std::mutex> lock(asyncMutex_);
+    stopAsync_ = true;
+  }
+  asyncCondition_.notify_all();
+  if (asyncThread_.joinable()) {
+    asyncThread_.join();
+  }
 }
 
-void Logger::writeLog(const std::string &formattedMessage) {
-  if (config_.asyncLogging) {
-    writeLogAsync(formattedMessage);
-  } else {
-    writeLogSync(formattedMessage);
-  }
+void Logger::wakeAsyncWriter() {
+  // Taking the mutex orders the wake after the writer's predicate check
+  { std::lock_guard<std::mutex> lock(asyncMutex_); }
+  asyncCondition_.notify_one();
 }
 
-void Logger::writeLogSync(const std::string &formattedMessage) {
-  if (config_.consoleOutput) {
-    std::cout << formattedMessage << std::endl;
+void Logger::asyncWorker() {
+  while (!stopAsync_) {
+    {
+      std::unique_lock<std::mutex> lock(asyncMutex_);
+      // A producer sets asyncWakePending_ before notifying and only the
+      // predicate clears it, so no wake-up is lost
+      asyncCondition_.wait_for(lock, asyncInterval_, [this] {
+        return stopAsync_ || flushRequested_ ||
+               asyncWakePending_.exchange(false);
+      });
+      flushRequested_ = false;
+    }
+
+    drainStagingBuffers();
+    asyncFlushed_.notify_all();
+    retireStagingBuffers();
   }
 
-  if (config_.fileOutput) {
-    std::lock_guard<std::mutex> lock(fileMutex_);
-    if (fileStream_.is_open()) {
-      // Check if rotation is needed
-      if (config_.enableRotation &&
-          currentFileSize_ + formattedMessage.length() > config_.maxFileSize) {
-        rotateLogFile();
+  // Write remaining messages on shutdown
+  drainStagingBuffers();
+  asyncFlushed_.notify_all();
+}
+
+// Group commit: every record staged so far is rendered on this thread and
+// goes out in as few write() calls as rotation allows. Each round merges the
+// rings by record time, keeping every thread's own order.
+void Logger::drainStagingBuffers() {
+  std::vector<std::shared_ptr<LogStagingBuffer>> buffers;
+  {
+    std::lock_guard<std::mutex> lock(stagingMutex_);
+    buffers = stagingBuffers_;
+  }
+  std::vector<std::vector<std::string_view>> records(buffers.size());
+  // (time, ring, position) of the next record from each ring
+  using Next = std::tuple<int64_t, size_t, size_t>;
+  std::priority_queue<Next, std::vector<Next>, std::greater<>> next;
+  std::string lines;
+  std::vector<size_t> ends; // offset past each line's newline
+
+  for (;;) {
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      records[i].clear();
+      buffers[i]->ring.peek(kMaxWriteBatch, [&](std::string_view record) {
+        records[i].push_back(record);
+      });
+      if (!records[i].empty()) {
+        next.emplace(LogRecordWriter::readHeader(records[i][0]).timeUs, i, 0);
       }
+    }
+    if (next.empty()) {
+      return;
+    }
 
-      fileStream_ << formattedMessage << std::endl;
-      fileStream_.flush();
-      currentFileSize_ += formattedMessage.length() + 1;
+    lines.clear();
+    ends.clear();
+    const LogFormat format = config_.format;
+    while (!next.empty()) {
+      const auto [time, ring, position] = next.top();
+      next.pop();
+      renderLogRecord(records[ring][position], format, lines);
+      ends.push_back(lines.size());
+      if (position + 1 < records[ring].size()) {
+        next.emplace(
+            LogRecordWriter::readHeader(records[ring][position + 1]).timeUs,
+            ring, position + 1);
+      }
+    }
+    // Rendered lines no longer need their slots
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      if (!records[i].empty()) {
+        buffers[i]->ring.release();
+      }
     }
+
+    writeBatch(lines, ends);
   }
 }
 
-void Logger::writeLogAsync(const std::string &formattedMessage) {
-  std::lock_guard<std::mutex> lock(asyncMutex_);
+// Drops the rings of threads that have exited once they are empty, keeping
+// their counts
+void Logger::retireStagingBuffers() {
+  std::lock_guard<std::mutex> lock(stagingMutex_);
+  auto retired = std::remove_if(
+      stagingBuffers_.begin(), stagingBuffers_.end(), [this](auto &buffer) {
+        // The registry holds the last reference once the thread is gone
+        if (buffer.use_count() > 1 || buffer->ring.size() > 0) {
+          return false;
+        }
+        addMetrics(metrics_, buffer->metrics);
+        return true;
+      });
+  stagingBuffers_.erase(retired, stagingBuffers_.end());
+}
 
-  // Check queue size to prevent memory issues
-  if (constexpr size_t MAX_QUEUE_SIZE = 10000;
-      messageQueue_.size() > MAX_QUEUE_SIZE) {
-    metrics_.droppedMessages++;
+// Writes rendered lines to the console and the file; ends holds the offset
+// past each line
+void Logger::writeBatch(const std::string &lines,
+                        const std::vector<size_t> &ends) {
+  if (config_.consoleOutput) {
+    std::cout.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+    std::cout.flush();
+  }
+
+  if (!config_.fileOutput) {
     return;
   }
+  std::lock_guard<std::mutex> lock(fileMutex_);
+  // Lines before each rotation point go to the file being rotated out,
+  // as writeLogSync() would have put them
+  const std::string_view batch(lines);
+  size_t first = 0; // start of the lines not written yet
+  for (size_t i = 0; i < ends.size() && fileFd_ >= 0; ++i) {
+    const size_t begin = i == 0 ? 0 : ends[i - 1];
+    if (config_.enableRotation &&
+        currentFileSize_ + ends[i] - first > config_.maxFileSize) {
+      if (begin > first) {
+        writeFileBytes(batch.substr(first, begin - first));
+      }
+      rotateLogFile();
+      first = begin;
+    }
+  }
+  if (fileFd_ >= 0 && first < batch.size()) {
+    writeFileBytes(batch.substr(first));
+  }
+}
 
-  messageQueue_.push(formattedMessage);
-  asyncCondition_.notify_one();
+bool Logger::openFileSink(bool truncate) {
+  fileFd_ = ::open(currentLogFile_.c_str(),
+                   O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC |
+                       (truncate ? O_TRUNC : 0),
+                   0644);
+  if (fileFd_ < 0) {
+    return false;
+  }
+  struct stat info {};
+  currentFileSize_ =
+      ::fstat(fileFd_, &info) == 0 ? static_cast<size_t>(info.st_size) : 0;
+  return true;
 }
 
-void Logger::asyncWorker() {
-  while (!stopAsync_) {
-    std::unique_lock<std::mutex> lock(asyncMutex_);
+void Logger::closeFileSink() {
+  if (fileFd_ >= 0) {
+    ::close(fileFd_);
+    fileFd_ = -1;
+  }
+}
 
-    asyncCondition_.wait(
-        lock, [this] { return !messageQueue_.empty() || stopAsync_; });
+// Complete lines, newlines included; fileMutex_ must be held
+void Logger::writeFileBytes(std::string_view bytes) {
+  iovec part = {const_cast<char *>(bytes.data()), bytes.size()};
+  if (writeAll(fileFd_, &part, 1)) {
+    currentFileSize_ += bytes.size();
+  }
+}
 
-    // Process all messages in queue
-    while (!messageQueue_.empty()) {
-      std::string message = messageQueue_.front();
-      messageQueue_.pop();
-      lock.unlock();
+// One line and its newline in a single write; fileMutex_ must be held
+void Logger::writeFileLine(const std::string &line) {
+  char newline = '\n';
+  iovec parts[2] = {{const_cast<char *>(line.data()), line.size()},
+                    {&newline, 1}};
+  if (writeAll(fileFd_, parts, 2)) {
+    currentFileSize_ += line.size() + 1;
+  }
+}
 
-      writeLogSync(message);
+namespace {
 
-      lock.lock();
-    }
+// LogRotationConfig::compressionFormat as a CompressionType; NONE when the
+// format is off or not available in this build
+CompressionType rotationCompression(const LogRotationConfig &rotation) {
+  if (!rotation.compressOldLogs) {
+    return CompressionType::NONE;
   }
-
-  // Process remaining messages on shutdown
-  std::lock_guard<std::mutex> lock(asyncMutex_);
-  while (!messageQueue_.empty()) {
-    writeLogSync(messageQueue_.front());
-    messageQueue_.pop();
+  CompressionType type = CompressionType::NONE;
+  if (rotation.compressionFormat == "gzip") {
+    type = CompressionType::GZIP;
+  } else if (rotation.compressionFormat == "zstd") {
+    type = CompressionType::ZSTD;
+  } else if (rotation.compressionFormat == "lz4") {
+    type = CompressionType::LZ4;
   }
+  return isCompressionSupported(type) ? type : CompressionType::NONE;
 }
 
+} // namespace
+
 void Logger::rotateLogFile() {
   if (!config_.enableRotation)
     return;
 
-  fileStream_.close();
+  const CompressionType compression = rotationCompression(config_.rotation);
+  const std::string compressedExtension =
+      compression == CompressionType::NONE
+          ? std::string()
+          : LogFileCompressor().getCompressedExtension(compression);
 
-  // Move existing backup files
-  for (int i = config_.maxBackupFiles - 1; i > 0; i--) {
-    std::string oldFile = currentLogFile_ + "." + std::to_string(i);
-    std::string newFile = currentLogFile_ + "." + std::to_string(i + 1);
+  closeFileSink();
+
+  {
+    std::lock_guard<std::mutex> backupLock(backupMutex_);
+    const uint64_t generation = ++rotations_;
 
-    if (std::filesystem::exists(oldFile)) {
-      if (i == config_.maxBackupFiles - 1) {
-        std::filesystem::remove(newFile); // Remove oldest
+    // Move existing backup files, compressed or not
+    std::vector<std::string> suffixes = {""};
+    if (!compressedExtension.empty()) {
+      suffixes.push_back(compressedExtension);
+    }
+    for (int i = config_.maxBackupFiles - 1; i > 0; i--) {
+      for (const auto &suffix : suffixes) {
+        std::string oldFile =
+            currentLogFile_ + "." + std::to_string(i) + suffix;
+        std::string newFile =
+            currentLogFile_ + "." + std::to_string(i + 1) + suffix;
+
+        if (std::filesystem::exists(oldFile)) {
+          if (i == config_.maxBackupFiles - 1) {
+            std::filesystem::remove(newFile); // Remove oldest
+          }
+          std::filesystem::rename(oldFile, newFile);
+        }
       }
-      std::filesystem::rename(oldFile, newFile);
     }
-  }
 
-  // Move current log to .1
-  std::string firstBackup = currentLogFile_ + ".1";
-  if (std::filesystem::exists(currentLogFile_)) {
-    std::filesystem::rename(currentLogFile_, firstBackup);
+    // Move current log to .1, or to a pending name of its own while it is
+    // compressed; the job files the result under the backup number it has
+    // reached by then, so rotation never waits for it
+    if (std::filesystem::exists(currentLogFile_)) {
+      if (compression == CompressionType::NONE) {
+        std::filesystem::rename(currentLogFile_, currentLogFile_ + ".1");
+      } else {
+        const std::string pending = currentLogFile_ + "." +
+                                    std::to_string(generation) + ".pending";
+        std::filesystem::rename(currentLogFile_, pending);
+        if (!compressionQueue_) {
+          compressionQueue_ = std::make_unique<LogCompressionQueue>();
+        }
+        compressionQueue_->enqueue(
+            [this, pending, compression, generation,
+             base = currentLogFile_, extension = compressedExtension,
+             maxBackups = config_.maxBackupFiles] {
+              const std::string compressed = pending + extension;
+              const bool ok = LogFileCompressor().compressFile(
+                  pending, compressed, compression);
+
+              std::lock_guard<std::mutex> lock(backupMutex_);
+              const uint64_t index = rotations_ - generation + 1;
+              std::error_code ec;
+              if (index > static_cast<uint64_t>(std::max(maxBackups, 0))) {
+                // Rotated out of the kept backups meanwhile
+                std::filesystem::remove(compressed, ec);
+                std::filesystem::remove(pending, ec);
+              } else if (ok) {
+                std::filesystem::rename(
+                    compressed, base + "." + std::to_string(index) + extension,
+                    ec);
+                std::filesystem::remove(pending, ec);
+              } else {
+                std::filesystem::remove(compressed, ec);
+                std::filesystem::rename(
+                    pending, base + "." + std::to_string(index), ec);
+              }
+            });
+      }
+    }
   }
 
   // Create new log file
-  fileStream_.open(currentLogFile_, std::ios::out);
-  currentFileSize_ = 0;
-
-  if (!fileStream_.is_open()) {
+  if (!openFileSink(true)) {
     std::cerr << "Failed to create new log file after rotation: "
               << currentLogFile_ << std::endl;
     config_.fileOutput = false;
   }
 }
 
-bool Logger::shouldLog(LogLevel level, const std::string &component) const {
-  if (level < config_.level) {
-    return false;
-  }
-
-  if (!config_.componentFilter.empty() &&
-      config_.componentFilter.find(component) ==
-          config_.componentFilter.end()) {
-    return false;
-  }
-
-  return true;
-}
-
 // Real-time streaming methods implementation
 void Logger::setWebSocketManager(std::shared_ptr<WebSocketManager> wsManager) {
   std::lock_guard<std::mutex> lock(configMutex_);
@@ -612,6 +888,7 @@ void Logger::enableRealTimeStreaming(bool enable) {
     }
     streamingStarted_ = false;
   }
+  updateThresholds();
 }
 
 void Logger::setStreamingJobFilter(
@@ -812,9 +1089,7 @@ void Logger::archiveOldLogs() {
   std::lock_guard<std::mutex> lock(fileMutex_);
 
   // Close the current log file
-  if (fileStream_.is_open()) {
-    fileStream_.close();
-  }
+  closeFileSink();
 
   // Move the current log file to the archive directory
   std::string archiveFile =
@@ -822,11 +1097,8 @@ void Logger::archiveOldLogs() {
       std::filesystem::path(currentLogFile_).filename().string();
   std::filesystem::rename(currentLogFile_, archiveFile);
 
-  // Reopen the log file stream
-  fileStream_.open(currentLogFile_, std::ios::app);
-  currentFileSize_ = 0;
-
-  if (!fileStream_.is_open()) {
+  // Reopen the log file
+  if (!openFileSink(true)) {
     std::cerr << "Failed to open new log file after archiving: "
               << currentLogFile_ << std::endl;
     config_.fileOutput = false;
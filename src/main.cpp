@@ -17,6 +17,7 @@
 #include "log_aggregator.hpp"
 #include "logger.hpp"
 #include "request_handler.hpp"
+#include "server_config.hpp"
 #include "websocket_manager.hpp"
 
 std::unique_ptr<HttpServer> server;
@@ -172,10 +173,38 @@ int main() {
 
     LOG_INFO("Main", "Initializing data transformer...");
     auto dataTransformer = std::make_shared<DataTransformer>();
+    ParallelTransformConfig transformConfig;
+    transformConfig.enabled = config.getBool("etl.parallel_transform", false);
+    transformConfig.workerCount =
+        static_cast<size_t>(config.getInt("etl.transform_workers", 0));
+    transformConfig.chunkSize =
+        static_cast<size_t>(config.getInt("etl.transform_chunk_size", 0));
+    dataTransformer->setParallelConfig(transformConfig);
 
     LOG_INFO("Main", "Initializing ETL job manager...");
     auto etlManager =
         std::make_shared<ETLJobManager>(dbManager, dataTransformer);
+    JobSchedulerConfig schedulerConfig;
+    schedulerConfig.workerCount =
+        static_cast<size_t>(config.getInt("etl.max_concurrent_jobs", 4));
+    schedulerConfig.agingInterval = std::chrono::milliseconds(
+        config.getInt("etl.job_aging_interval_ms", 30000));
+    const char *typeKeys[] = {"extract", "transform", "load", "full_etl"};
+    for (size_t i = 0; i < kJobTypeCount; ++i) {
+      schedulerConfig.maxConcurrentByType[i] = static_cast<size_t>(
+          config.getInt(std::string("etl.max_concurrent_by_type.") +
+                            typeKeys[i],
+                        0));
+    }
+    etlManager->configureScheduler(schedulerConfig);
+    etlManager->setJobCacheCapacity(
+        static_cast<size_t>(config.getInt("etl.job_cache_size", 10000)));
+    BulkLoadOptions loadOptions;
+    loadOptions.batchSize =
+        static_cast<size_t>(config.getInt("etl.load_batch_size", 5000));
+    loadOptions.isolateFailedRows =
+        config.getBool("etl.load_isolate_failed_rows", true);
+    etlManager->setLoadOptions(loadOptions);
 
     // Start ETL job manager
     LOG_INFO("Main", "Starting ETL job manager...");
@@ -184,7 +213,8 @@ int main() {
 
     // Initialize WebSocket manager
     LOG_INFO("Main", "Initializing WebSocket manager...");
-    auto wsManager = std::make_shared<WebSocketManager>();
+    auto wsManager = std::make_shared<WebSocketManager>(
+        WebSocketManagerConfig::fromConfig(config));
     wsManager->start();
     LOG_INFO("Main", "WebSocket manager started successfully");
 
@@ -198,11 +228,19 @@ int main() {
     int port = config.getInt("server.port", 8080);
     int threads = config.getInt("server.threads", 4);
 
+    ServerConfig serverConfig = ServerConfig::create();
+    serverConfig.handlerThreads =
+        static_cast<size_t>(config.getInt("server.handler_threads", 8));
+    serverConfig.handlerQueueSize =
+        static_cast<size_t>(config.getInt("server.handler_queue_size", 256));
+    serverConfig.handlerRouteQueueSize = static_cast<size_t>(
+        config.getInt("server.handler_route_queue_size", 64));
+
     LOG_INFO("Main", "Initializing HTTP server on " + address + ":" +
                          std::to_string(port) + " with " +
                          std::to_string(threads) + " threads");
     server = std::make_unique<HttpServer>(
-        address, static_cast<unsigned short>(port), threads);
+        address, static_cast<unsigned short>(port), threads, serverConfig);
     server->setRequestHandler(requestHandler);
     server->setWebSocketManager(wsManager);
 
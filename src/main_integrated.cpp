@@ -158,7 +158,8 @@ int main() {
 
     // Initialize WebSocket manager
     LOG_INFO("Main", "Initializing WebSocket manager...");
-    wsManager = std::make_shared<WebSocketManager>();
+    wsManager = std::make_shared<WebSocketManager>(
+        WebSocketManagerConfig::fromConfig(config));
 
     // Initialize notification service
     LOG_INFO("Main", "Initializing notification service...");
@@ -35,6 +35,14 @@ void MessageBroadcaster::start() {
 
   running_.store(true);
 
+  // Connections the pool cleans up by itself leave the index too
+  connectionPool_->setRemovalListener(
+      [self = weak_from_this()](const std::string &connectionId) {
+        if (auto broadcaster = self.lock()) {
+          broadcaster->unregisterConnection(connectionId);
+        }
+      });
+
   if (config_.enableAsyncProcessing) {
     startAsyncProcessing();
   }
@@ -52,7 +60,9 @@ void MessageBroadcaster::stop() {
   // Stop async processing
   stopAsyncProcessing();
 
-  // Clear queue
+  // Clear queue. The subscription index stays: registered connections
+  // are still live after a restart, and the pool's removal listener
+  // unregisters the ones it drops
   clearQueue();
 
   WS_LOG_INFO("Message broadcaster stopped");
@@ -64,23 +74,13 @@ void MessageBroadcaster::broadcastMessage(const std::string &message) {
     return;
   }
 
-  if (config_.enableAsyncProcessing && !isQueueFull()) {
-    // Queue for async processing
-    QueuedMessage queuedMsg{message, MessageType::SYSTEM_NOTIFICATION, "", "",
-                            std::chrono::system_clock::now()};
-    {
-      std::lock_guard<std::mutex> lock(queueMutex_);
-      messageQueue_.push(queuedMsg);
-      stats_.totalMessagesQueued++;
-      stats_.currentQueueSize = messageQueue_.size();
-    }
-    queueCondition_.notify_one();
+  auto frame = makeSharedMessage(message);
+  if (enqueueMessage({frame, MessageType::SYSTEM_NOTIFICATION, "", "",
+                      std::chrono::system_clock::now()})) {
     WS_LOG_DEBUG("Message queued for broadcast to all connections");
   } else {
     // Process immediately
-    auto connections = connectionPool_->getActiveConnections();
-    broadcastToConnections(message, connections);
-    updateStats(connections.size());
+    deliverToAll(frame);
   }
 }
 
@@ -93,7 +93,7 @@ void MessageBroadcaster::sendToConnection(const std::string &connectionId,
 
   auto connection = connectionPool_->getConnection(connectionId);
   if (connection && connection->isOpen()) {
-    sendMessageToConnection(connection, message);
+    sendMessageToConnection(connection, makeSharedMessage(message));
     updateStats(1);
     WS_LOG_DEBUG("Message sent to connection: " + connectionId);
   } else {
@@ -101,6 +101,22 @@ void MessageBroadcaster::sendToConnection(const std::string &connectionId,
   }
 }
 
+void MessageBroadcaster::registerConnection(
+    const std::shared_ptr<WebSocketConnection> &connection) {
+  if (connection) {
+    indexConnection(connection);
+    WS_LOG_DEBUG("Connection added to subscription index: " +
+                 connection->getId());
+  }
+}
+
+void MessageBroadcaster::unregisterConnection(const std::string &connectionId) {
+  if (subscriptions_.remove(connectionId)) {
+    WS_LOG_DEBUG("Connection removed from subscription index: " +
+                 connectionId);
+  }
+}
+
 void MessageBroadcaster::broadcastJobUpdate(const std::string &message,
                                             const std::string &jobId) {
   if (!running_.load()) {
@@ -121,31 +137,12 @@ void MessageBroadcaster::broadcastLogMessage(const std::string &message,
     return;
   }
 
-  if (config_.enableAsyncProcessing && !isQueueFull()) {
-    // Queue for async processing
-    QueuedMessage queuedMsg{message, MessageType::JOB_LOG_MESSAGE, jobId,
-                            logLevel, std::chrono::system_clock::now()};
-    {
-      std::lock_guard<std::mutex> lock(queueMutex_);
-      messageQueue_.push(queuedMsg);
-      stats_.totalMessagesQueued++;
-      stats_.currentQueueSize = messageQueue_.size();
-    }
-    queueCondition_.notify_one();
-  } else {
+  auto frame = makeSharedMessage(message);
+  if (!enqueueMessage({frame, MessageType::JOB_LOG_MESSAGE, jobId, logLevel,
+                       std::chrono::system_clock::now()})) {
     // Process immediately
-    auto connections = connectionPool_->getActiveConnections();
-    size_t sentCount = 0;
-
-    for (auto &connection : connections) {
-      if (shouldProcessMessage(connection, MessageType::JOB_LOG_MESSAGE, jobId,
-                               logLevel)) {
-        sendMessageToConnection(connection, message);
-        sentCount++;
-      }
-    }
-
-    updateStats(sentCount);
+    size_t sentCount =
+        deliverFiltered(frame, MessageType::JOB_LOG_MESSAGE, jobId, logLevel);
     WS_LOG_DEBUG("Log message broadcasted to " + std::to_string(sentCount) +
                  " connections (job: " + jobId + ", level: " + logLevel + ")");
   }
@@ -160,30 +157,11 @@ void MessageBroadcaster::broadcastByMessageType(const std::string &message,
     return;
   }
 
-  if (config_.enableAsyncProcessing && !isQueueFull()) {
-    // Queue for async processing
-    QueuedMessage queuedMsg{message, messageType, jobId, "",
-                            std::chrono::system_clock::now()};
-    {
-      std::lock_guard<std::mutex> lock(queueMutex_);
-      messageQueue_.push(queuedMsg);
-      stats_.totalMessagesQueued++;
-      stats_.currentQueueSize = messageQueue_.size();
-    }
-    queueCondition_.notify_one();
-  } else {
+  auto frame = makeSharedMessage(message);
+  if (!enqueueMessage({frame, messageType, jobId, "",
+                       std::chrono::system_clock::now()})) {
     // Process immediately
-    auto connections = connectionPool_->getActiveConnections();
-    size_t sentCount = 0;
-
-    for (auto &connection : connections) {
-      if (shouldProcessMessage(connection, messageType, jobId)) {
-        sendMessageToConnection(connection, message);
-        sentCount++;
-      }
-    }
-
-    updateStats(sentCount);
+    size_t sentCount = deliverFiltered(frame, messageType, jobId, "");
     WS_LOG_DEBUG("Message broadcasted to " + std::to_string(sentCount) +
                  " connections by type");
   }
@@ -203,7 +181,7 @@ void MessageBroadcaster::broadcastToFilteredConnections(
         return filterPredicate(conn->getFilters());
       });
 
-  broadcastToConnections(message, connections);
+  broadcastToConnections(makeSharedMessage(message), connections);
   updateStats(connections.size());
   WS_LOG_DEBUG("Message broadcasted to " + std::to_string(connections.size()) +
                " filtered connections");
@@ -217,15 +195,17 @@ void MessageBroadcaster::broadcastWithAdvancedRouting(
     return;
   }
 
-  auto connections = connectionPool_->getActiveConnections();
-  size_t sentCount = 0;
-
-  for (auto &connection : connections) {
-    if (shouldProcessMessage(connection, message)) {
-      sendMessageToConnection(connection, message.toJson());
-      sentCount++;
-    }
-  }
+  SharedMessage frame; // serialised on the first match
+  size_t sentCount = forEachSubscriber(
+      message.type, message.targetJobId.value_or(""),
+      message.targetLevel.value_or(""),
+      [this, &frame, &message](
+          const std::shared_ptr<WebSocketConnection> &connection) {
+        if (!frame) {
+          frame = makeSharedMessage(message.toJson());
+        }
+        sendMessageToConnection(connection, frame);
+      });
 
   updateStats(sentCount);
   WS_LOG_DEBUG("Advanced routing message broadcasted to " +
@@ -243,11 +223,15 @@ void MessageBroadcaster::sendToMatchingConnections(
   }
 
   auto connections = connectionPool_->getActiveConnections();
+  SharedMessage frame; // serialised on the first match
   size_t sentCount = 0;
 
   for (auto &connection : connections) {
     if (customMatcher(connection->getFilters(), message)) {
-      sendMessageToConnection(connection, message.toJson());
+      if (!frame) {
+        frame = makeSharedMessage(message.toJson());
+      }
+      sendMessageToConnection(connection, frame);
       sentCount++;
     }
   }
@@ -275,6 +259,7 @@ void MessageBroadcaster::setConnectionFilters(
   auto connection = connectionPool_->getConnection(connectionId);
   if (connection && connection->isOpen()) {
     connection->setFilters(filters);
+    indexConnection(connection);
     WS_LOG_INFO("Filters set for connection: " + connectionId);
   } else {
     WS_LOG_WARN("Cannot set filters for connection (not found or inactive): " +
@@ -299,6 +284,7 @@ void MessageBroadcaster::updateConnectionFilters(
   auto connection = connectionPool_->getConnection(connectionId);
   if (connection && connection->isOpen()) {
     connection->updateFilterPreferences(filters);
+    indexConnection(connection);
     WS_LOG_INFO("Filters updated for connection: " + connectionId);
   } else {
     WS_LOG_WARN(
@@ -312,6 +298,7 @@ void MessageBroadcaster::addJobFilterToConnection(
   auto connection = connectionPool_->getConnection(connectionId);
   if (connection && connection->isOpen()) {
     connection->addJobIdFilter(jobId);
+    indexConnection(connection);
     WS_LOG_DEBUG("Added job filter '" + jobId +
                  "' to connection: " + connectionId);
   } else {
@@ -326,6 +313,7 @@ void MessageBroadcaster::removeJobFilterFromConnection(
   auto connection = connectionPool_->getConnection(connectionId);
   if (connection && connection->isOpen()) {
     connection->removeJobIdFilter(jobId);
+    indexConnection(connection);
     WS_LOG_DEBUG("Removed job filter '" + jobId +
                  "' from connection: " + connectionId);
   } else {
@@ -340,6 +328,7 @@ void MessageBroadcaster::addMessageTypeFilterToConnection(
   auto connection = connectionPool_->getConnection(connectionId);
   if (connection && connection->isOpen()) {
     connection->addMessageTypeFilter(messageType);
+    indexConnection(connection);
     WS_LOG_DEBUG("Added message type filter '" +
                  messageTypeToString(messageType) +
                  "' to connection: " + connectionId);
@@ -355,6 +344,7 @@ void MessageBroadcaster::removeMessageTypeFilterFromConnection(
   auto connection = connectionPool_->getConnection(connectionId);
   if (connection && connection->isOpen()) {
     connection->removeMessageTypeFilter(messageType);
+    indexConnection(connection);
     WS_LOG_DEBUG("Removed message type filter '" +
                  messageTypeToString(messageType) +
                  "' from connection: " + connectionId);
@@ -370,6 +360,7 @@ void MessageBroadcaster::addLogLevelFilterToConnection(
   auto connection = connectionPool_->getConnection(connectionId);
   if (connection && connection->isOpen()) {
     connection->addLogLevelFilter(logLevel);
+    indexConnection(connection);
     WS_LOG_DEBUG("Added log level filter '" + logLevel +
                  "' to connection: " + connectionId);
   } else {
@@ -384,6 +375,7 @@ void MessageBroadcaster::removeLogLevelFilterFromConnection(
   auto connection = connectionPool_->getConnection(connectionId);
   if (connection && connection->isOpen()) {
     connection->removeLogLevelFilter(logLevel);
+    indexConnection(connection);
     WS_LOG_DEBUG("Removed log level filter '" + logLevel +
                  "' from connection: " + connectionId);
   } else {
@@ -398,6 +390,7 @@ void MessageBroadcaster::clearConnectionFilters(
   auto connection = connectionPool_->getConnection(connectionId);
   if (connection && connection->isOpen()) {
     connection->clearFilters();
+    indexConnection(connection);
     WS_LOG_INFO("Cleared all filters for connection: " + connectionId);
   } else {
     WS_LOG_WARN(
@@ -408,26 +401,17 @@ void MessageBroadcaster::clearConnectionFilters(
 
 std::vector<std::string>
 MessageBroadcaster::getConnectionsForJob(const std::string &jobId) const {
-  return connectionPool_->getConnectionIdsByFilter(
-      [&jobId](const std::shared_ptr<WebSocketConnection> &conn) {
-        return conn->getFilters().shouldReceiveJob(jobId);
-      });
+  return subscriptions_.subscribersForJob(jobId);
 }
 
 std::vector<std::string> MessageBroadcaster::getConnectionsForMessageType(
     MessageType messageType) const {
-  return connectionPool_->getConnectionIdsByFilter(
-      [messageType](const std::shared_ptr<WebSocketConnection> &conn) {
-        return conn->getFilters().shouldReceiveMessageType(messageType);
-      });
+  return subscriptions_.subscribersForMessageType(messageType);
 }
 
 std::vector<std::string> MessageBroadcaster::getConnectionsForLogLevel(
     const std::string &logLevel) const {
-  return connectionPool_->getConnectionIdsByFilter(
-      [&logLevel](const std::shared_ptr<WebSocketConnection> &conn) {
-        return conn->getFilters().shouldReceiveLogLevel(logLevel);
-      });
+  return subscriptions_.subscribersForLogLevel(logLevel);
 }
 
 size_t MessageBroadcaster::getFilteredConnectionCount() const {
@@ -461,7 +445,8 @@ size_t MessageBroadcaster::getUnfilteredConnectionCount() const {
 }
 
 MessageBroadcasterStats MessageBroadcaster::getStats() const {
-  std::lock_guard<std::mutex> lock(statsMutex_);
+  // The queue counters are kept under queueMutex_
+  std::scoped_lock lock(queueMutex_, statsMutex_);
   return stats_;
 }
 
@@ -566,16 +551,12 @@ void MessageBroadcaster::processMessageQueue() {
 void MessageBroadcaster::processQueuedMessage(const QueuedMessage &msg) {
   activeBroadcasts_++;
   try {
-    switch (msg.type) {
-    case MessageType::SYSTEM_NOTIFICATION:
-      broadcastMessage(msg.message);
-      break;
-    case MessageType::JOB_LOG_MESSAGE:
-      broadcastLogMessage(msg.message, msg.jobId, msg.logLevel);
-      break;
-    default:
-      broadcastByMessageType(msg.message, msg.type, msg.jobId);
-      break;
+    // Deliver directly: going back through the public broadcast methods
+    // would queue the message again
+    if (msg.type == MessageType::SYSTEM_NOTIFICATION) {
+      deliverToAll(msg.message);
+    } else {
+      deliverFiltered(msg.message, msg.type, msg.jobId, msg.logLevel);
     }
   } catch (const std::exception &e) {
     WS_LOG_ERROR("Error processing queued message: " + std::string(e.what()));
@@ -583,8 +564,84 @@ void MessageBroadcaster::processQueuedMessage(const QueuedMessage &msg) {
   activeBroadcasts_--;
 }
 
+bool MessageBroadcaster::enqueueMessage(QueuedMessage msg) {
+  if (!config_.enableAsyncProcessing) {
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    if (messageQueue_.size() >= config_.maxQueueSize) {
+      return false;
+    }
+    messageQueue_.push(std::move(msg));
+    stats_.totalMessagesQueued++;
+    stats_.currentQueueSize = messageQueue_.size();
+  }
+  queueCondition_.notify_one();
+  return true;
+}
+
+void MessageBroadcaster::deliverToAll(const SharedMessage &message) {
+  auto connections = connectionPool_->getActiveConnections();
+  broadcastToConnections(message, connections);
+  updateStats(connections.size());
+}
+
+void MessageBroadcaster::indexConnection(
+    const std::shared_ptr<WebSocketConnection> &connection) {
+  subscriptions_.update(connection->getId(), connection,
+                        connection->copyFilters());
+}
+
+template <class Send>
+size_t MessageBroadcaster::forEachSubscriber(MessageType type,
+                                             const std::string &jobId,
+                                             const std::string &logLevel,
+                                             Send &&send) {
+  std::vector<std::string> expired;
+  size_t sentCount = subscriptions_.forEachSubscriber(
+      type, jobId, logLevel,
+      [&send, &expired](const std::string &id,
+                        const std::weak_ptr<WebSocketConnection> &handle) {
+        auto connection = handle.lock();
+        if (!connection) {
+          expired.push_back(id);
+          return false;
+        }
+        if (!connection->isOpen()) {
+          return false;
+        }
+        send(connection);
+        return true;
+      });
+
+  // Connections released without the pool's removal listener firing
+  for (const auto &id : expired) {
+    subscriptions_.remove(id);
+  }
+  return sentCount;
+}
+
+size_t MessageBroadcaster::deliverFiltered(const SharedMessage &message,
+                                           MessageType type,
+                                           const std::string &jobId,
+                                           const std::string &logLevel) {
+  // Lets a slow connection replace a queued progress update with this one
+  const uint64_t supersedeKey = supersedeKeyFor(type, jobId);
+  size_t sentCount = forEachSubscriber(
+      type, jobId, logLevel,
+      [this, &message,
+       supersedeKey](const std::shared_ptr<WebSocketConnection> &connection) {
+        sendMessageToConnection(connection, message, supersedeKey);
+      });
+
+  updateStats(sentCount);
+  return sentCount;
+}
+
 void MessageBroadcaster::broadcastToConnections(
-    const std::string &message,
+    const SharedMessage &message,
     const std::vector<std::shared_ptr<WebSocketConnection>> &connections) {
   for (const auto &connection : connections) {
     if (connection && connection->isOpen()) {
@@ -595,9 +652,9 @@ void MessageBroadcaster::broadcastToConnections(
 
 void MessageBroadcaster::sendMessageToConnection(
     const std::shared_ptr<WebSocketConnection> &connection,
-    const std::string &message) {
+    const SharedMessage &message, uint64_t supersedeKey) {
   try {
-    connection->send(message);
+    connection->send(message, supersedeKey);
   } catch (const std::exception &e) {
     WS_LOG_ERROR("Failed to send message to connection " + connection->getId() +
                  ": " + e.what());
@@ -624,12 +681,6 @@ void MessageBroadcaster::updateStats(size_t messagesSent,
   }
 }
 
-bool MessageBroadcaster::shouldProcessMessage(
-    const std::shared_ptr<WebSocketConnection> &connection, MessageType type,
-    const std::string &jobId, const std::string &logLevel) const {
-  return connection->shouldReceiveMessage(type, jobId, logLevel);
-}
-
 bool MessageBroadcaster::shouldProcessMessage(
     const std::shared_ptr<WebSocketConnection> &connection,
     const WebSocketMessage &message) const {
@@ -1,13 +1,20 @@
 #include "notification_service.hpp"
+#include "async_http_client.hpp"
 #include "config_manager.hpp"
 #include "etl_exceptions.hpp"
 #include <algorithm>
 #include <chrono>
+#include <future>
 #include <iomanip>
 #include <nlohmann/json.hpp>
 #include <random>
 #include <sstream>
 
+namespace {
+// Deliveries whose queue-to-delivery latency feeds getStats()
+constexpr size_t QUEUE_LATENCY_WINDOW = 1024;
+} // namespace
+
 // Static member definition for RetryQueueManager
 const notification_recovery::RetryConfig
     notification_recovery::RetryQueueManager::defaultConfig_{
@@ -22,11 +29,6 @@ const notification_recovery::RetryConfig
         std::chrono::minutes(10)           // bulkRetryInterval
     };
 
-// Only include curl and json if they are available
-#ifdef CURL_FOUND
-#include <curl/curl.h>
-#endif
-
 // ===== NotificationMessage Implementation =====
 
 std::string NotificationMessage::generateId() {
@@ -192,6 +194,8 @@ NotificationConfig NotificationConfig::fromConfig(const ConfigManager &config) {
       config.getInt("monitoring.notifications.retry_attempts", 3);
   notifConfig.baseRetryDelayMs =
       config.getInt("monitoring.notifications.retry_delay", 5000);
+  notifConfig.deliveryWorkers =
+      config.getInt("monitoring.notifications.delivery_workers", 2);
   notifConfig.timeoutWarningThresholdMinutes =
       config.getInt("monitoring.job_tracking.timeout_warning_threshold", 25);
 
@@ -347,24 +351,29 @@ bool EmailNotificationDelivery::sendEmail(const std::string &to,
 
 WebhookNotificationDelivery::WebhookNotificationDelivery(
     const NotificationConfig &config)
-    : config_(config) {}
+    : WebhookNotificationDelivery(config, AsyncHttpClient::shared()) {}
+
+WebhookNotificationDelivery::WebhookNotificationDelivery(
+    const NotificationConfig &config, std::shared_ptr<AsyncHttpClient> client)
+    : config_(config), client_(std::move(client)) {}
 
 bool WebhookNotificationDelivery::isConfigured() const {
   return !config_.webhookUrl.empty();
 }
 
-#ifdef CURL_FOUND
-// Callback function for libcurl to capture response data
-static size_t WriteCallback(void *contents, size_t size, size_t nmemb,
-                            void *userp) {
-  ((std::string *)userp)->append((char *)contents, size * nmemb);
-  return size * nmemb;
+bool WebhookNotificationDelivery::deliver(const NotificationMessage &message) {
+  auto result = std::make_shared<std::promise<bool>>();
+  auto delivered = result->get_future();
+  deliverAsync(message, [result](bool success) { result->set_value(success); });
+  return delivered.get();
 }
-#endif
 
-bool WebhookNotificationDelivery::deliver(const NotificationMessage &message) {
-  if (!isConfigured())
-    return false;
+void WebhookNotificationDelivery::deliverAsync(
+    const NotificationMessage &message, std::function<void(bool)> done) {
+  if (!isConfigured()) {
+    done(false);
+    return;
+  }
 
   // Create JSON payload using nlohmann/json
   nlohmann::json payload = {
@@ -378,55 +387,26 @@ bool WebhookNotificationDelivery::deliver(const NotificationMessage &message) {
   };
   std::string jsonPayload = payload.dump();
 
-  return sendWebhook(jsonPayload);
+  sendWebhook(jsonPayload, std::move(done));
 }
 
-bool WebhookNotificationDelivery::sendWebhook(const std::string &payload) {
-#ifdef CURL_FOUND
-  CURL *curl;
-  CURLcode res;
-  std::string response;
-
-  curl = curl_easy_init();
-  if (!curl)
-    return false;
-
-  // Set up headers
-  struct curl_slist *headers = nullptr;
-  headers = curl_slist_append(headers, "Content-Type: application/json");
-
+void WebhookNotificationDelivery::sendWebhook(const std::string &payload,
+                                              std::function<void(bool)> done) {
+  HttpRequest request;
+  request.url = config_.webhookUrl;
+  request.body = payload;
+  request.headers["Content-Type"] = "application/json";
+  request.headers["User-Agent"] = "ETLPlus-NotificationService/1.0";
   if (!config_.webhookSecret.empty()) {
-    std::string authHeader = "Authorization: Bearer " + config_.webhookSecret;
-    headers = curl_slist_append(headers, authHeader.c_str());
+    request.headers["Authorization"] = "Bearer " + config_.webhookSecret;
   }
-
-  // Configure curl
-  curl_easy_setopt(curl, CURLOPT_URL, config_.webhookUrl.c_str());
-  curl_easy_setopt(curl, CURLOPT_POSTFIELDS, payload.c_str());
-  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-  curl_easy_setopt(curl, CURLOPT_TIMEOUT, config_.webhookTimeoutMs / 1000);
-  curl_easy_setopt(curl, CURLOPT_USERAGENT, "ETLPlus-NotificationService/1.0");
-
-  // Perform the request
-  res = curl_easy_perform(curl);
-
-  long httpCode = 0;
-  curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-
-  // Cleanup
-  curl_slist_free_all(headers);
-  curl_easy_cleanup(curl);
+  request.timeout = std::chrono::milliseconds(config_.webhookTimeoutMs);
 
   // Consider 2xx status codes as success
-  return (res == CURLE_OK && httpCode >= 200 && httpCode < 300);
-#else
-  // Mock webhook delivery when curl is not available
-  std::cout << "[WEBHOOK MOCK] Would send to " << config_.webhookUrl << ": "
-            << payload << std::endl;
-  return true;
-#endif
+  client_->send(std::move(request),
+                [done = std::move(done)](HttpResponse response) {
+                  done(response.succeeded());
+                });
 }
 
 // ===== NotificationServiceImpl Implementation =====
@@ -462,8 +442,12 @@ void NotificationServiceImpl::start() {
     return;
 
   running_.store(true);
-  processingThread_ =
-      std::thread(&NotificationServiceImpl::processNotifications, this);
+  const int workers = std::max(1, config_.deliveryWorkers);
+  for (int i = 0; i < workers; ++i) {
+    deliveryWorkers_.emplace_back(
+        &NotificationServiceImpl::processNotifications, this);
+  }
+  retryThread_ = std::thread(&NotificationServiceImpl::processRetries, this);
 
   if (logger_) {
     logger_->info("NotificationService", "Notification service started");
@@ -474,11 +458,26 @@ void NotificationServiceImpl::stop() {
   if (!running_.load())
     return;
 
-  running_.store(false);
+  {
+    // Under the lock, so no worker misses the wakeup between its check and
+    // its wait
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    running_.store(false);
+  }
   queueCondition_.notify_all();
+  retryCondition_.notify_all();
 
-  if (processingThread_.joinable()) {
-    processingThread_.join();
+  for (auto &worker : deliveryWorkers_) {
+    worker.join();
+  }
+  deliveryWorkers_.clear();
+  if (retryThread_.joinable()) {
+    retryThread_.join();
+  }
+  // Outcomes still on their way reference this service
+  {
+    std::unique_lock<std::mutex> lock(deliveryMutex_);
+    deliveriesDone_.wait(lock, [this] { return deliveriesInFlight_ == 0; });
   }
 
   if (logger_) {
@@ -550,7 +549,7 @@ void NotificationServiceImpl::queueNotification(
     return;
   }
 
-  notificationQueue_.push(message);
+  enqueueLocked(message);
   queueCondition_.notify_one();
 
   if (logger_) {
@@ -562,7 +561,7 @@ void NotificationServiceImpl::queueNotification(
 
 size_t NotificationServiceImpl::getQueueSize() const {
   std::scoped_lock lock(queueMutex_);
-  return notificationQueue_.size() + retryManager_.getQueueSize();
+  return notificationQueue_.size() + retryWheel_.size();
 }
 
 size_t NotificationServiceImpl::getProcessedCount() const {
@@ -573,6 +572,51 @@ size_t NotificationServiceImpl::getFailedCount() const {
   return failedCount_.load();
 }
 
+std::chrono::microseconds
+NotificationServiceImpl::getAverageDeliveryLatency() const {
+  const uint64_t samples = latencySamples_.load();
+  return std::chrono::microseconds(
+      samples == 0 ? 0 : totalLatencyUs_.load() / samples);
+}
+
+std::chrono::microseconds
+NotificationServiceImpl::getMaxDeliveryLatency() const {
+  return std::chrono::microseconds(maxLatencyUs_.load());
+}
+
+NotificationStats NotificationServiceImpl::getStats() const {
+  NotificationStats stats;
+  stats.processed = processedCount_.load();
+  stats.failed = failedCount_.load();
+  {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    stats.queued = notificationQueue_.size();
+    stats.retriesPending = retryWheel_.size();
+  }
+  {
+    std::lock_guard<std::mutex> lock(deliveryMutex_);
+    stats.inFlight = deliveriesInFlight_;
+  }
+  stats.averageDeliveryLatency = getAverageDeliveryLatency();
+  stats.maxDeliveryLatency = getMaxDeliveryLatency();
+
+  std::vector<uint32_t> sorted;
+  {
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    sorted = queueLatencyUs_;
+  }
+  if (!sorted.empty()) {
+    std::sort(sorted.begin(), sorted.end());
+    const auto at = [&sorted](double percentile) {
+      return std::chrono::microseconds(
+          sorted[static_cast<size_t>(percentile * (sorted.size() - 1))]);
+    };
+    stats.queueToDeliveryP50 = at(0.50);
+    stats.queueToDeliveryP99 = at(0.99);
+  }
+  return stats;
+}
+
 void NotificationServiceImpl::checkMemoryUsage(double currentUsage) {
   if (currentUsage > config_.memoryUsageThreshold) {
     ResourceAlert alert;
@@ -647,10 +691,8 @@ NotificationServiceImpl::getRecentNotifications(size_t limit) const {
 
 void NotificationServiceImpl::clearQueue() {
   std::lock_guard<std::mutex> lock(queueMutex_);
-  while (!notificationQueue_.empty()) {
-    notificationQueue_.pop();
-  }
-  retryManager_.clearQueue();
+  notificationQueue_ = {};
+  retryWheel_.clear();
 }
 
 void NotificationServiceImpl::setTestMode(bool enabled) {
@@ -663,111 +705,175 @@ void NotificationServiceImpl::setTestMode(bool enabled) {
 
 // Private implementation methods
 
+// One delivery worker: takes the highest-priority notification as soon as
+// one is queued
 void NotificationServiceImpl::processNotifications() {
-  while (running_.load()) {
-    std::unique_lock<std::mutex> lock(queueMutex_);
-
-    // Wait for notifications or stop signal
-    queueCondition_.wait(lock, [this] {
-      return !running_.load() || !notificationQueue_.empty() ||
-             (retryManager_.getQueueSize() > 0);
-    });
-
-    if (!running_.load())
-      break;
-
-    // Process regular queue
-    std::queue<NotificationMessage> currentQueue;
-    currentQueue.swap(notificationQueue_);
-
-    // Process retry queue
-    auto readyForRetry = retryManager_.getReadyForRetry();
-    lock.unlock();
-
-    // Process notifications outside of lock
-    while (!currentQueue.empty()) {
-      auto message = currentQueue.front();
-      currentQueue.pop();
-
-      if (deliverNotification(message)) {
-        processedCount_++;
-        addToRecentNotifications(message);
-      } else {
-        failedCount_++;
-        scheduleRetry(message, "delivery_failed", NotificationMethod::LOG_ONLY);
+  for (;;) {
+    QueuedNotification next;
+    {
+      std::unique_lock<std::mutex> lock(queueMutex_);
+      queueCondition_.wait(lock, [this] {
+        return !running_.load() || !notificationQueue_.empty();
+      });
+      if (!running_.load()) {
+        return;
       }
+      // top() is const only to protect the heap order; it is popped next
+      next = std::move(
+          const_cast<QueuedNotification &>(notificationQueue_.top()));
+      notificationQueue_.pop();
     }
+    dispatchNotification(std::move(next));
+  }
+}
 
-    // Process failed notifications ready for retry
-    for (const auto &failedNotif : readyForRetry) {
-      // Convert FailedNotification back to NotificationMessage for delivery
-      NotificationMessage retryMessage;
-      retryMessage.id = failedNotif.notificationId;
-      retryMessage.message = failedNotif.content;
-      retryMessage.retryCount = failedNotif.retryCount;
-
-      if (deliverNotification(retryMessage)) {
-        processedCount_++;
-        addToRecentNotifications(retryMessage);
-      } else {
-        failedCount_++;
-        scheduleRetry(
-            retryMessage, failedNotif.failureReason,
-            static_cast<NotificationMethod>(failedNotif.failedMethodIndex));
-      }
+// Sleeps until the earliest retry's backoff expires, then queues every
+// retry that is due
+void NotificationServiceImpl::processRetries() {
+  std::unique_lock<std::mutex> lock(queueMutex_);
+  std::vector<NotificationMessage> due;
+  while (running_.load()) {
+    if (retryWheel_.empty()) {
+      retryCondition_.wait(lock);
+    } else {
+      retryCondition_.wait_until(lock, retryWheel_.nextDue());
     }
 
-    // Small delay to prevent busy waiting
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    retryWheel_.advance(std::chrono::steady_clock::now(), due);
+    for (auto &message : due) {
+      enqueueLocked(std::move(message));
+      queueCondition_.notify_one();
+    }
+    due.clear();
   }
 }
 
-bool NotificationServiceImpl::deliverNotification(
-    const NotificationMessage &message) {
+void NotificationServiceImpl::enqueueLocked(NotificationMessage message) {
+  QueuedNotification queued;
+  queued.message = std::move(message);
+  queued.sequence = nextSequence_++;
+  queued.enqueued = std::chrono::steady_clock::now();
+  notificationQueue_.push(std::move(queued));
+}
+
+// Starts delivery and returns; the notification is counted, and retried
+// on failure, when its last delivery method reports back
+void NotificationServiceImpl::dispatchNotification(QueuedNotification queued) {
+  {
+    std::lock_guard<std::mutex> lock(deliveryMutex_);
+    deliveriesInFlight_++;
+  }
+  const auto started = std::chrono::steady_clock::now();
+  auto pending = std::make_shared<QueuedNotification>(std::move(queued));
+  deliverNotification(pending->message, [this, pending,
+                                         started](bool success) {
+    const auto now = std::chrono::steady_clock::now();
+    recordDeliveryLatency(
+        std::chrono::duration_cast<std::chrono::microseconds>(now - started),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            now - pending->enqueued));
+    if (success) {
+      processedCount_++;
+      addToRecentNotifications(pending->message);
+    } else {
+      failedCount_++;
+      scheduleRetry(std::move(pending->message));
+    }
+
+    std::lock_guard<std::mutex> lock(deliveryMutex_);
+    if (--deliveriesInFlight_ == 0) {
+      deliveriesDone_.notify_all();
+    }
+  });
+}
+
+void NotificationServiceImpl::deliverNotification(
+    const NotificationMessage &message, std::function<void(bool)> done) {
   if (testMode_.load()) {
     // In test mode, just log and return success
     if (logger_) {
       logger_->info("NotificationService",
                     "[TEST MODE] Would deliver: " + message.subject);
     }
-    return true;
+    done(true);
+    return;
   }
 
-  auto methods = getMethodsForPriority(message.priority);
-  bool anySuccess = false;
-
-  for (auto method : methods) {
+  std::vector<NotificationDelivery *> deliveries;
+  for (auto method : getMethodsForPriority(message.priority)) {
     for (const auto &delivery : deliveryMethods_) {
       if (delivery->getMethod() == method && delivery->isConfigured()) {
-        try {
-          if (delivery->deliver(message)) {
-            anySuccess = true;
-            if (logger_) {
-              logger_->debug("NotificationService",
-                             "Successfully delivered notification " +
-                                 message.id + " via " +
-                                 std::to_string(static_cast<int>(method)));
-            }
-          }
-        } catch (const std::exception &e) {
-          if (logger_) {
-            logger_->error(
-                "NotificationService",
-                "Failed to deliver notification " + message.id + " via " +
-                    std::to_string(static_cast<int>(method)) + ": " + e.what());
-          }
-        }
+        deliveries.push_back(delivery.get());
         break;
       }
     }
   }
+  if (deliveries.empty()) {
+    done(false);
+    return;
+  }
+
+  // Succeeds if any method does, once every method has reported
+  struct Outcome {
+    std::atomic<size_t> remaining;
+    std::atomic<bool> anySuccess{false};
+    std::function<void(bool)> done;
+  };
+  auto outcome = std::make_shared<Outcome>();
+  outcome->remaining = deliveries.size();
+  outcome->done = std::move(done);
+
+  for (auto *delivery : deliveries) {
+    const auto method = delivery->getMethod();
+    auto report = [this, outcome, id = message.id, method](bool success) {
+      if (success) {
+        outcome->anySuccess = true;
+        if (logger_) {
+          logger_->debug("NotificationService",
+                         "Successfully delivered notification " + id +
+                             " via " +
+                             std::to_string(static_cast<int>(method)));
+        }
+      }
+      if (--outcome->remaining == 0) {
+        outcome->done(outcome->anySuccess);
+      }
+    };
+    try {
+      delivery->deliverAsync(message, report);
+    } catch (const std::exception &e) {
+      if (logger_) {
+        logger_->error("NotificationService",
+                       "Failed to deliver notification " + message.id +
+                           " via " + std::to_string(static_cast<int>(method)) +
+                           ": " + e.what());
+      }
+      report(false);
+    }
+  }
+}
 
-  return anySuccess;
+void NotificationServiceImpl::recordDeliveryLatency(
+    std::chrono::microseconds latency, std::chrono::microseconds queueLatency) {
+  const auto us = static_cast<uint64_t>(latency.count());
+  latencySamples_++;
+  totalLatencyUs_ += us;
+  uint64_t max = maxLatencyUs_.load();
+  while (us > max && !maxLatencyUs_.compare_exchange_weak(max, us)) {
+  }
+
+  const auto sample = static_cast<uint32_t>(
+      std::min<int64_t>(queueLatency.count(), UINT32_MAX));
+  std::lock_guard<std::mutex> lock(latencyMutex_);
+  if (queueLatencyUs_.size() < QUEUE_LATENCY_WINDOW) {
+    queueLatencyUs_.push_back(sample);
+  } else {
+    queueLatencyUs_[queueLatencyNext_] = sample;
+  }
+  queueLatencyNext_ = (queueLatencyNext_ + 1) % QUEUE_LATENCY_WINDOW;
 }
 
-void NotificationServiceImpl::scheduleRetry(const NotificationMessage &message,
-                                            const std::string &reason,
-                                            NotificationMethod failedMethod) {
+void NotificationServiceImpl::scheduleRetry(NotificationMessage message) {
   if (!message.shouldRetry()) {
     if (logger_) {
       logger_->warn("NotificationService",
@@ -777,17 +883,34 @@ void NotificationServiceImpl::scheduleRetry(const NotificationMessage &message,
     return;
   }
 
-  retryManager_.addFailedNotification(
-      message.id,
-      "recipient", // Would need to extract from message
-      message.message, reason, static_cast<int>(failedMethod));
-
+  const auto delay = retryDelay(message.retryCount);
+  message.retryCount++;
+  message.scheduledFor = std::chrono::system_clock::now() + delay;
   if (logger_) {
     logger_->info("NotificationService",
-                  "Scheduled retry for notification " + message.id +
-                      " (attempt " + std::to_string(message.retryCount + 1) +
-                      "/" + std::to_string(message.maxRetries) + ")");
+                  "Scheduled retry for notification " + message.id + " in " +
+                      std::to_string(delay.count()) + "ms (attempt " +
+                      std::to_string(message.retryCount) + "/" +
+                      std::to_string(message.maxRetries) + ")");
   }
+
+  {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    retryWheel_.schedule(std::move(message),
+                         std::chrono::steady_clock::now() + delay);
+  }
+  retryCondition_.notify_one();
+}
+
+// Exponential backoff from the configured base delay, capped at the maximum
+std::chrono::milliseconds
+NotificationServiceImpl::retryDelay(int retryCount) const {
+  constexpr int MAX_RETRY_EXPONENT = 16;
+  const int64_t delay =
+      static_cast<int64_t>(config_.baseRetryDelayMs)
+      << std::min(std::max(retryCount, 0), MAX_RETRY_EXPONENT);
+  return std::chrono::milliseconds(
+      std::min<int64_t>(delay, config_.maxRetryDelayMs));
 }
 
 void NotificationServiceImpl::addToRecentNotifications(
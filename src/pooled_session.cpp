@@ -1,11 +1,13 @@
 #include "pooled_session.hpp"
 #include "logger.hpp"
 #include "performance_monitor.hpp"
+#include "request_executor.hpp"
 #include "request_handler.hpp"
 #include "timeout_manager.hpp"
 #include "websocket_manager.hpp"
 #include <algorithm>
 #include <boost/asio/dispatch.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
@@ -27,9 +29,11 @@ PooledSession::PooledSession(
     tcp::socket &&socket, std::shared_ptr<RequestHandler> handler,
     std::shared_ptr<WebSocketManager> wsManager,
     std::shared_ptr<TimeoutManager> timeoutManager,
-    std::shared_ptr<PerformanceMonitor> performanceMonitor)
+    std::shared_ptr<PerformanceMonitor> performanceMonitor,
+    std::shared_ptr<RequestExecutor> executor)
     : stream_(std::move(socket)), handler_(handler), wsManager_(wsManager),
       timeoutManager_(timeoutManager), performanceMonitor_(performanceMonitor),
+      executor_(std::move(executor)),
       lastActivity_(std::chrono::steady_clock::now()),
       requestStartTime_(std::chrono::steady_clock::now()), isIdle_(false),
       processingRequest_(false) {
@@ -124,6 +128,9 @@ void PooledSession::handleTimeout(const std::string &timeoutType) {
     HTTP_LOG_INFO("PooledSession::handleTimeout() - Request timeout, sending "
                   "timeout response");
 
+    // An offloaded handler may still be running; its response is dropped
+    timedOutRequest_.store(requestSequence_.load());
+
     // Send HTTP 408 Request Timeout response
     http::response<http::string_body> timeout_res{http::status::request_timeout,
                                                   req_.version()};
@@ -152,6 +159,7 @@ void PooledSession::doRead() {
   HTTP_LOG_DEBUG("PooledSession::doRead() - Starting read operation");
   updateLastActivity();
   processingRequest_ = true;
+  requestSequence_.fetch_add(1);
 
   // Record request start for performance monitoring
   requestStartTime_ = std::chrono::steady_clock::now();
@@ -245,37 +253,91 @@ void PooledSession::onRead(beast::error_code ec,
     return;
   }
 
+  if (executor_) {
+    dispatchToExecutor();
+    return;
+  }
+
+  sendResponse(runHandler(std::move(req_)));
+}
+
+void PooledSession::dispatchToExecutor() {
+  auto self = shared_from_this();
+  auto request =
+      std::make_shared<http::request<http::string_body>>(std::move(req_));
+  const uint64_t sequence = requestSequence_.load();
+  const auto target = request->target();
+  const std::string route =
+      RequestExecutor::routeKey(std::string_view(target.data(), target.size()));
+
+  bool accepted = executor_->submit(
+      route, [self, request, sequence](std::chrono::microseconds queueWait) {
+        auto handlerStart = std::chrono::steady_clock::now();
+        auto response = self->runHandler(std::move(*request));
+        if (self->performanceMonitor_) {
+          self->performanceMonitor_->recordQueueWait(queueWait);
+          self->performanceMonitor_->recordHandlerTime(
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - handlerStart));
+        }
+
+        // Writes must happen on the session's strand, not the worker
+        net::post(self->stream_.get_executor(),
+                  [self, sequence, response = std::move(response)]() mutable {
+                    if (self->timedOutRequest_.load() == sequence) {
+                      HTTP_LOG_DEBUG("PooledSession - Dropping response for "
+                                     "timed out request");
+                      return;
+                    }
+                    self->sendResponse(std::move(response));
+                  });
+      });
+  if (accepted) {
+    return;
+  }
+
+  HTTP_LOG_WARN("PooledSession::onRead() - Handler queue full for route " +
+                route + ", rejecting request");
+  if (performanceMonitor_) {
+    performanceMonitor_->recordRejectedRequest();
+  }
+  http::response<http::string_body> busy_res{http::status::service_unavailable,
+                                             request->version()};
+  busy_res.set(http::field::server, "ETL Plus Backend");
+  busy_res.set(http::field::content_type, "application/json");
+  busy_res.set(http::field::retry_after, "1");
+  busy_res.keep_alive(false);
+  busy_res.body() = "{\"error\":\"Server busy, retry later\"}";
+  busy_res.prepare_payload();
+  sendResponse(std::move(busy_res));
+}
+
+http::response<http::string_body>
+PooledSession::runHandler(http::request<http::string_body> &&req) {
+  const unsigned version = req.version();
   try {
     HTTP_LOG_DEBUG(
-        "PooledSession::onRead() - Calling handler->handleRequest()");
-    auto response = handler_->handleRequest(std::move(req_));
-    HTTP_LOG_DEBUG(
-        "PooledSession::onRead() - Handler completed, sending response");
-    sendResponse(std::move(response));
+        "PooledSession::runHandler() - Calling handler->handleRequest()");
+    auto response = handler_->handleRequest(std::move(req));
+    HTTP_LOG_DEBUG("PooledSession::runHandler() - Handler completed");
+    return response;
   } catch (const std::exception &e) {
-    HTTP_LOG_ERROR("PooledSession::onRead() - Exception in handler: " +
+    HTTP_LOG_ERROR("PooledSession::runHandler() - Exception in handler: " +
                    std::string(e.what()));
-    // Send proper error response for exceptions
-    http::response<http::string_body> error_res{
-        http::status::internal_server_error, req_.version()};
-    error_res.set(http::field::server, "ETL Plus Backend");
-    error_res.set(http::field::content_type, "application/json");
-    error_res.keep_alive(false);
-    error_res.body() = "{\"error\":\"Internal server error\"}";
-    error_res.prepare_payload();
-    sendResponse(std::move(error_res));
   } catch (...) {
-    HTTP_LOG_ERROR("PooledSession::onRead() - Unknown exception in handler");
-    // Send proper error response for unknown exceptions
-    http::response<http::string_body> error_res{
-        http::status::internal_server_error, req_.version()};
-    error_res.set(http::field::server, "ETL Plus Backend");
-    error_res.set(http::field::content_type, "application/json");
-    error_res.keep_alive(false);
-    error_res.body() = "{\"error\":\"Internal server error\"}";
-    error_res.prepare_payload();
-    sendResponse(std::move(error_res));
+    HTTP_LOG_ERROR(
+        "PooledSession::runHandler() - Unknown exception in handler");
   }
+
+  // Send proper error response for exceptions
+  http::response<http::string_body> error_res{
+      http::status::internal_server_error, version};
+  error_res.set(http::field::server, "ETL Plus Backend");
+  error_res.set(http::field::content_type, "application/json");
+  error_res.keep_alive(false);
+  error_res.body() = "{\"error\":\"Internal server error\"}";
+  error_res.prepare_payload();
+  return error_res;
 }
 
 void PooledSession::sendResponse(http::response<http::string_body> &&msg) {
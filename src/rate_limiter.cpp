@@ -1,215 +1,308 @@
 #include "rate_limiter.hpp"
 #include "component_logger.hpp"
+#include "etl_exceptions.hpp"
 #include "logger.hpp"
 #include <algorithm>
 #include <chrono>
-#include <ctime>
+#include <climits>
+#include <stdexcept>
 
-RateLimiter::RateLimiter() { initializeDefaultRules(); }
+namespace {
+
+constexpr int64_t kMinuteMicros = 60LL * 1000 * 1000;
+constexpr int64_t kHourMicros = 60 * kMinuteMicros;
+
+uint64_t fnv1a(std::string_view text,
+               uint64_t hash = 14695981039346656037ULL) {
+  for (unsigned char c : text) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// splitmix64 finalizer, so the low bits used for the slot index are mixed
+uint64_t mix(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+} // namespace
+
+RateLimiter::RateLimiter() : RateLimiter(RateLimiterConfig{}) {}
+
+RateLimiter::RateLimiter(RateLimiterConfig config) {
+  size_t slotCount = kMaxProbe;
+  while (slotCount < config.slotCount) {
+    slotCount <<= 1;
+  }
+  slots_ = std::make_unique<Slot[]>(slotCount);
+  slotMask_ = slotCount - 1;
+  initializeDefaultRules();
+}
 
 void RateLimiter::initializeDefaultRules() {
-  // Default rate limiting rules
-  rules_ = {
-      {"/api/auth/login", 5, 20},     // 5 per minute, 20 per hour for login
-      {"/api/auth/logout", 10, 50},   // 10 per minute, 50 per hour for logout
-      {"/api/auth/profile", 30, 200}, // 30 per minute, 200 per hour for profile
-      {"/api/logs", 60, 500},         // 60 per minute, 500 per hour for logs
-      {"/api/jobs", 30, 200},         // 30 per minute, 200 per hour for jobs
-      {"/api/monitor", 120,
-       1000}, // 120 per minute, 1000 per hour for monitoring
-      {"/api/health", 300, 2000}
-      // 300 per minute, 2000 per hour for health checks
-  };
-
-  // Sort rules by descending prefix length to ensure more specific rules are
-  // checked first
-  std::sort(rules_.begin(), rules_.end(),
-            [](const RateLimitRule &a, const RateLimitRule &b) {
-              return a.endpoint.length() > b.endpoint.length();
-            });
+  {
+    std::lock_guard<std::mutex> lock(rulesMutex_);
+    publishRules({
+        {"/api/auth/login", 5, 20},     // 5 per minute, 20 per hour for login
+        {"/api/auth/logout", 10, 50},   // 10 per minute, 50 per hour
+        {"/api/auth/profile", 30, 200}, // 30 per minute, 200 per hour
+        {"/api/logs", 60, 500},         // 60 per minute, 500 per hour
+        {"/api/jobs", 30, 200},         // 30 per minute, 200 per hour
+        {"/api/monitor", 120, 1000},    // 120 per minute, 1000 per hour
+        {"/api/health", 300, 2000}      // 300 per minute, 2000 per hour
+    });
+  }
 
   etl::ComponentLogger<RateLimiter>::info(
       "RateLimiter initialized with default rules");
 }
 
 void RateLimiter::addRule(const RateLimitRule &rule) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  rules_.push_back(rule);
-  // Sort rules by descending prefix length to ensure more specific rules are
-  // checked first
-  std::sort(rules_.begin(), rules_.end(),
-            [](const RateLimitRule &a, const RateLimitRule &b) {
-              return a.endpoint.length() > b.endpoint.length();
-            });
+  if (rule.requestsPerMinute <= 0 || rule.requestsPerHour <= 0) {
+    throw etl::ValidationException(etl::ErrorCode::INVALID_RANGE,
+                                   "Rate limits must be positive", "endpoint",
+                                   rule.endpoint);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(rulesMutex_);
+    std::vector<RateLimitRule> rules = rules_.load()->rules;
+    auto it = std::find_if(rules.begin(), rules.end(),
+                           [&rule](const RateLimitRule &existing) {
+                             return existing.endpoint == rule.endpoint;
+                           });
+    if (it != rules.end()) {
+      // Re-adding an unchanged rule would only retire another set
+      if (it->requestsPerMinute == rule.requestsPerMinute &&
+          it->requestsPerHour == rule.requestsPerHour) {
+        return;
+      }
+      *it = rule;
+    } else {
+      rules.push_back(rule);
+    }
+    publishRules(std::move(rules));
+  }
+
   etl::ComponentLogger<RateLimiter>::info(
       "Added rate limit rule for endpoint: " + rule.endpoint);
 }
 
-bool RateLimiter::isAllowed(const std::string &clientId,
-                            const std::string &endpoint) {
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  const RateLimitRule *rule = getRuleForEndpoint(endpoint);
-  if (!rule) {
+bool RateLimiter::isAllowed(std::string_view clientId,
+                            std::string_view endpoint) {
+  const RuleSet &set = *rules_.load(std::memory_order_acquire);
+  auto index = findRule(set, endpoint);
+  if (!index) {
     // No rule found, allow request
     return true;
   }
 
-  auto [currentMinute, currentHour] = getCurrentWindows();
-
-  // Get or create client data
-  auto &clientData = clientData_[clientId];
+  const RateLimitRule &rule = set.rules[*index];
+  const int64_t now = nowMicros();
+  Slot &slot = slotFor(slotKey(clientId, set.ruleHashes[*index]), now);
 
-  // Check minute limit
-  std::string minuteKey = endpoint + "_min_" + std::to_string(currentMinute);
-  if (clientData.minuteCounters[minuteKey] >= rule->requestsPerMinute) {
-    etl::ComponentLogger<RateLimiter>::warn("Rate limit exceeded for client " +
-                                            clientId + " on endpoint " +
-                                            endpoint + " (minute limit)");
+  const Window minute = minuteWindow(rule);
+  if (!tryConsume(slot.minuteTat, now, minute)) {
+    etl::ComponentLogger<RateLimiter>::warn(
+        "Rate limit exceeded for client " + std::string(clientId) +
+        " on endpoint " + std::string(endpoint) + " (minute limit)");
     return false;
   }
 
-  // Check hour limit
-  std::string hourKey = endpoint + "_hour_" + std::to_string(currentHour);
-  if (clientData.hourCounters[hourKey] >= rule->requestsPerHour) {
-    etl::ComponentLogger<RateLimiter>::warn("Rate limit exceeded for client " +
-                                            clientId + " on endpoint " +
-                                            endpoint + " (hour limit)");
+  if (!tryConsume(slot.hourTat, now, hourWindow(rule))) {
+    // Give back the minute token taken above
+    slot.minuteTat.fetch_sub(minute.interval, std::memory_order_relaxed);
+    etl::ComponentLogger<RateLimiter>::warn(
+        "Rate limit exceeded for client " + std::string(clientId) +
+        " on endpoint " + std::string(endpoint) + " (hour limit)");
     return false;
   }
 
-  // Increment counters
-  clientData.minuteCounters[minuteKey]++;
-  clientData.hourCounters[hourKey]++;
-
-  etl::ComponentLogger<RateLimiter>::debug(
-      "Request allowed for client " + clientId + " on endpoint " + endpoint);
   return true;
 }
 
-RateLimitInfo RateLimiter::getRateLimitInfo(const std::string &clientId,
-                                            const std::string &endpoint) {
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  const RateLimitRule *rule = getRuleForEndpoint(endpoint);
-  if (!rule) {
+RateLimitInfo RateLimiter::getRateLimitInfo(std::string_view clientId,
+                                            std::string_view endpoint) const {
+  const RuleSet &set = *rules_.load(std::memory_order_acquire);
+  auto index = findRule(set, endpoint);
+  if (!index) {
     return {INT_MAX, std::chrono::system_clock::time_point::max(), INT_MAX};
   }
 
-  auto [currentMinute, currentHour] = getCurrentWindows();
+  const RateLimitRule &rule = set.rules[*index];
+  const int64_t now = nowMicros();
+  const Slot *slot = findSlot(slotKey(clientId, set.ruleHashes[*index]));
+  const int64_t tat =
+      slot ? slot->minuteTat.load(std::memory_order_relaxed) : 0;
 
-  auto &clientData = clientData_[clientId];
+  // The minute bucket is full again once its arrival time has passed
+  auto resetTime = std::chrono::system_clock::now() +
+                   std::chrono::microseconds(std::max<int64_t>(tat - now, 0));
+  return {remaining(tat, now, minuteWindow(rule), rule.requestsPerMinute),
+          resetTime, rule.requestsPerMinute};
+}
 
-  // Calculate remaining requests for minute window
-  std::string minuteKey = endpoint + "_min_" + std::to_string(currentMinute);
-  int minuteUsed = clientData.minuteCounters[minuteKey];
-  int minuteRemaining = std::max(0, rule->requestsPerMinute - minuteUsed);
+void RateLimiter::resetClient(std::string_view clientId) {
+  const RuleSet &set = *rules_.load(std::memory_order_acquire);
+  for (uint64_t ruleHash : set.ruleHashes) {
+    // findSlot() only returns a slot whose stored key is this client's
+    Slot *slot = findSlot(slotKey(clientId, ruleHash));
+    if (slot && !slot->shared.load(std::memory_order_relaxed)) {
+      slot->minuteTat.store(0, std::memory_order_relaxed);
+      slot->hourTat.store(0, std::memory_order_relaxed);
+    }
+  }
+  etl::ComponentLogger<RateLimiter>::info("Reset rate limits for client: " +
+                                          std::string(clientId));
+}
 
-  // Calculate remaining requests for hour window
-  std::string hourKey = endpoint + "_hour_" + std::to_string(currentHour);
-  int hourUsed = clientData.hourCounters[hourKey];
-  int hourRemaining = std::max(0, rule->requestsPerHour - hourUsed);
+void RateLimiter::cleanupExpiredEntries() {
+  const int64_t now = nowMicros();
+  size_t freed = 0;
+  for (size_t i = 0; i <= slotMask_; ++i) {
+    Slot &slot = slots_[i];
+    uint64_t key = slot.key.load(std::memory_order_acquire);
+    if (key != 0 && slot.minuteTat.load(std::memory_order_relaxed) <= now &&
+        slot.hourTat.load(std::memory_order_relaxed) <= now &&
+        slot.key.compare_exchange_strong(key, 0, std::memory_order_acq_rel)) {
+      slot.shared.store(false, std::memory_order_relaxed);
+      ++freed;
+    }
+  }
 
-  // Use per-minute limit as the primary enforcement
-  int remaining = minuteRemaining;
-  int limit = rule->requestsPerMinute;
+  etl::ComponentLogger<RateLimiter>::debug(
+      "Cleaned up " + std::to_string(freed) + " expired rate limit entries");
+}
+
+void RateLimiter::publishRules(std::vector<RateLimitRule> rules) {
+  auto set = std::make_unique<RuleSet>();
+  for (size_t i = 0; i < rules.size(); ++i) {
+    const std::string &endpoint = rules[i].endpoint;
+    try {
+      set->router.add(endpoint, i);
+      set->router.add(endpoint + (endpoint.ends_with('/') ? "*" : "/*"), i);
+    } catch (const std::invalid_argument &e) {
+      throw etl::ValidationException(etl::ErrorCode::INVALID_INPUT,
+                                     "Invalid rate limit endpoint: " +
+                                         std::string(e.what()),
+                                     "endpoint", endpoint);
+    }
+    set->ruleHashes.push_back(fnv1a(endpoint));
+  }
+  set->rules = std::move(rules);
 
-  // Calculate reset time aligned to next minute boundary
-  auto nextMinuteTime = std::chrono::system_clock::time_point(
-      std::chrono::minutes(currentMinute + 1));
-  auto resetTime = nextMinuteTime;
+  // Readers may still hold the previous set, so it is retired, not freed;
+  // retired sets are only released with the limiter (see addRule())
+  rules_.store(set.get(), std::memory_order_release);
+  ruleSets_.push_back(std::move(set));
+}
 
-  return {remaining, resetTime, limit};
+std::optional<size_t> RateLimiter::findRule(const RuleSet &set,
+                                            std::string_view endpoint) {
+  auto match = set.router.match(splitRequestTarget(endpoint).first);
+  if (!match) {
+    return std::nullopt;
+  }
+  return match->value;
 }
 
-void RateLimiter::resetClient(const std::string &clientId) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  clientData_.erase(clientId);
-  etl::ComponentLogger<RateLimiter>::info("Reset rate limits for client: " +
-                                          clientId);
+uint64_t RateLimiter::slotKey(std::string_view clientId, uint64_t ruleHash) {
+  uint64_t key = mix(fnv1a(clientId, ruleHash));
+  return key != 0 ? key : 1;
 }
 
-void RateLimiter::cleanupExpiredEntries() {
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  auto [currentMinute, currentHour] = getCurrentWindows();
-
-  // Clean up old minute counters (keep only current and previous minute)
-  for (auto &[clientId, clientData] : clientData_) {
-    std::vector<std::string> toRemove;
-    for (const auto &[key, count] : clientData.minuteCounters) {
-      if (key.find("_min_") != std::string::npos) {
-        size_t pos = key.find_last_of('_');
-        if (pos != std::string::npos) {
-          try {
-            int64_t window = std::stoll(key.substr(pos + 1));
-            if (window < currentMinute - 1) {
-              toRemove.push_back(key);
-            }
-          } catch (const std::exception &) {
-            // Invalid key format, remove it
-            toRemove.push_back(key);
-          }
-        }
+RateLimiter::Slot &RateLimiter::slotFor(uint64_t key, int64_t now) {
+  const size_t home = key & slotMask_;
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    Slot *candidate = nullptr;
+    uint64_t candidateKey = 0;
+    for (size_t i = 0; i < kMaxProbe; ++i) {
+      Slot &slot = slots_[(home + i) & slotMask_];
+      uint64_t current = slot.key.load(std::memory_order_acquire);
+      if (current == key) {
+        return slot;
+      }
+      if (!candidate &&
+          (current == 0 ||
+           (slot.minuteTat.load(std::memory_order_relaxed) <= now &&
+            slot.hourTat.load(std::memory_order_relaxed) <= now))) {
+        candidate = &slot;
+        candidateKey = current;
       }
     }
-    for (const auto &key : toRemove) {
-      clientData.minuteCounters.erase(key);
+
+    if (!candidate) {
+      break;
     }
+    // A refilled bucket needs no reset: its arrival times are in the past
+    if (candidate->key.compare_exchange_strong(candidateKey, key,
+                                               std::memory_order_acq_rel)) {
+      candidate->shared.store(false, std::memory_order_relaxed);
+      return *candidate;
+    }
+    // Lost the slot to another client; rescan
   }
 
-  // Clean up old hour counters (keep only current and previous hour)
-  for (auto &[clientId, clientData] : clientData_) {
-    std::vector<std::string> toRemove;
-    for (const auto &[key, count] : clientData.hourCounters) {
-      if (key.find("_hour_") != std::string::npos) {
-        size_t pos = key.find_last_of('_');
-        if (pos != std::string::npos) {
-          try {
-            int64_t window = std::stoll(key.substr(pos + 1));
-            if (window < currentHour - 1) {
-              toRemove.push_back(key);
-            }
-          } catch (const std::exception &) {
-            // Invalid key format, remove it
-            toRemove.push_back(key);
-          }
-        }
-      }
-    }
-    for (const auto &key : toRemove) {
-      clientData.hourCounters.erase(key);
+  // Every nearby slot is in use: share the home bucket
+  slots_[home].shared.store(true, std::memory_order_relaxed);
+  return slots_[home];
+}
+
+RateLimiter::Slot *RateLimiter::findSlot(uint64_t key) const {
+  const size_t home = key & slotMask_;
+  for (size_t i = 0; i < kMaxProbe; ++i) {
+    Slot &slot = slots_[(home + i) & slotMask_];
+    if (slot.key.load(std::memory_order_acquire) == key) {
+      return &slot;
     }
   }
+  return nullptr;
+}
 
-  etl::ComponentLogger<RateLimiter>::debug(
-      "Cleaned up expired rate limit entries");
+RateLimiter::Window RateLimiter::minuteWindow(const RateLimitRule &rule) {
+  int64_t interval =
+      std::max<int64_t>(kMinuteMicros / rule.requestsPerMinute, 1);
+  return {interval, kMinuteMicros - interval};
+}
+
+RateLimiter::Window RateLimiter::hourWindow(const RateLimitRule &rule) {
+  int64_t interval =
+      std::max<int64_t>(kHourMicros / rule.requestsPerHour, 1);
+  return {interval, kHourMicros - interval};
 }
 
-const RateLimitRule *
-RateLimiter::getRuleForEndpoint(const std::string &endpoint) const {
-  for (const auto &rule : rules_) {
-    // Check for exact match
-    if (endpoint == rule.endpoint) {
-      return &rule;
+bool RateLimiter::tryConsume(std::atomic<int64_t> &tat, int64_t now,
+                             Window window) {
+  int64_t current = tat.load(std::memory_order_relaxed);
+  while (true) {
+    int64_t start = std::max(current, now);
+    if (start - now > window.burst) {
+      return false;
     }
-    // Check for prefix match with delimiter
-    if (endpoint.rfind(rule.endpoint, 0) == 0 &&
-        (endpoint.size() == rule.endpoint.size() ||
-         endpoint[rule.endpoint.size()] == '/')) {
-      return &rule;
+    if (tat.compare_exchange_weak(current, start + window.interval,
+                                  std::memory_order_relaxed)) {
+      return true;
     }
   }
-  return nullptr;
 }
 
-std::pair<int64_t, int64_t> RateLimiter::getCurrentWindows() const {
-  auto now = std::chrono::system_clock::now();
-  auto timeSinceEpoch = now.time_since_epoch();
+int RateLimiter::remaining(int64_t tat, int64_t now, Window window,
+                           int limit) {
+  int64_t backlog = std::max<int64_t>(tat - now, 0);
+  if (backlog > window.burst) {
+    return 0;
+  }
+  int64_t left = (window.burst - backlog) / window.interval + 1;
+  return static_cast<int>(std::min<int64_t>(left, limit));
+}
 
-  const int64_t minutesSinceEpoch =
-      std::chrono::duration_cast<std::chrono::minutes>(timeSinceEpoch).count();
-  const int64_t hoursSinceEpoch =
-      std::chrono::duration_cast<std::chrono::hours>(timeSinceEpoch).count();
-  return {minutesSinceEpoch, hoursSinceEpoch};
+int64_t RateLimiter::nowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
 }
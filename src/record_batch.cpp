@@ -0,0 +1,319 @@
+#include "record_batch.hpp"
+#include "data_transformer.hpp"
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+std::string formatNumericValue(double value) {
+  std::ostringstream oss;
+  oss << std::setprecision(15) << value; // not fixed => no forced zeros
+  auto s = oss.str();
+  auto dot = s.find('.');
+  if (dot != std::string::npos) {
+    // trim trailing zeros
+    auto last = s.find_last_not_of('0');
+    if (last != std::string::npos) {
+      if (s[last] == '.')
+        last--;
+      s.erase(last + 1);
+    }
+  }
+  return s;
+}
+
+// BatchSchema
+
+BatchSchema::BatchSchema(std::vector<FieldDescriptor> fields)
+    : fields_(std::move(fields)) {
+  index_.reserve(fields_.size());
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    index_.emplace(fields_[i].name, i);
+  }
+}
+
+std::optional<size_t> BatchSchema::fieldIndex(std::string_view name) const {
+  auto it = index_.find(name);
+  if (it == index_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+std::shared_ptr<const BatchSchema>
+BatchSchema::withField(const FieldDescriptor &field) const {
+  auto fields = fields_;
+  if (auto idx = fieldIndex(field.name)) {
+    fields[*idx].type = field.type;
+  } else {
+    fields.push_back(field);
+  }
+  return std::make_shared<const BatchSchema>(std::move(fields));
+}
+
+// Column
+
+void Column::reserve(size_t rows, size_t stringBytes) {
+  nulls_.reserve((rows + 63) / 64);
+  switch (type_) {
+  case ColumnType::INT64:
+    int64Values_.reserve(rows);
+    break;
+  case ColumnType::DOUBLE:
+    doubleValues_.reserve(rows);
+    break;
+  case ColumnType::STRING:
+    offsets_.reserve(rows + 1);
+    stringData_.reserve(stringBytes);
+    break;
+  }
+}
+
+void Column::pushNullBit(bool isNull) {
+  if ((size_ & 63) == 0) {
+    nulls_.push_back(0);
+  }
+  if (isNull) {
+    nulls_.back() |= uint64_t{1} << (size_ & 63);
+    ++nullCount_;
+  }
+  ++size_;
+}
+
+void Column::appendInt64(int64_t value) {
+  if (type_ != ColumnType::INT64) {
+    throw std::logic_error("appendInt64 on non-INT64 column");
+  }
+  int64Values_.push_back(value);
+  pushNullBit(false);
+}
+
+void Column::appendDouble(double value) {
+  if (type_ != ColumnType::DOUBLE) {
+    throw std::logic_error("appendDouble on non-DOUBLE column");
+  }
+  doubleValues_.push_back(value);
+  pushNullBit(false);
+}
+
+void Column::appendString(std::string_view value) {
+  if (type_ != ColumnType::STRING) {
+    throw std::logic_error("appendString on non-STRING column");
+  }
+  stringData_.append(value.data(), value.size());
+  offsets_.push_back(static_cast<uint32_t>(stringData_.size()));
+  pushNullBit(false);
+}
+
+void Column::appendNull() {
+  switch (type_) {
+  case ColumnType::INT64:
+    int64Values_.push_back(0);
+    break;
+  case ColumnType::DOUBLE:
+    doubleValues_.push_back(0.0);
+    break;
+  case ColumnType::STRING:
+    offsets_.push_back(static_cast<uint32_t>(stringData_.size()));
+    break;
+  }
+  pushNullBit(true);
+}
+
+void Column::appendFrom(const Column &other, size_t row) {
+  if (other.isNull(row)) {
+    appendNull();
+    return;
+  }
+  if (type_ == other.type_) {
+    switch (type_) {
+    case ColumnType::INT64:
+      appendInt64(other.int64At(row));
+      return;
+    case ColumnType::DOUBLE:
+      appendDouble(other.doubleAt(row));
+      return;
+    case ColumnType::STRING:
+      appendString(other.stringAt(row));
+      return;
+    }
+  }
+  if (type_ != ColumnType::STRING) {
+    throw std::logic_error("Cannot append value into a narrower column type");
+  }
+  appendString(other.valueAsString(row));
+}
+
+std::string Column::valueAsString(size_t row) const {
+  if (isNull(row)) {
+    return std::string{};
+  }
+  switch (type_) {
+  case ColumnType::INT64:
+    return std::to_string(int64Values_[row]);
+  case ColumnType::DOUBLE:
+    return formatNumericValue(doubleValues_[row]);
+  case ColumnType::STRING:
+    return std::string(stringAt(row));
+  }
+  return std::string{};
+}
+
+// RecordBatch
+
+RecordBatch::RecordBatch() : schema_(std::make_shared<const BatchSchema>()) {}
+
+RecordBatch::RecordBatch(std::shared_ptr<const BatchSchema> schema,
+                         std::vector<Column> columns)
+    : schema_(std::move(schema)), columns_(std::move(columns)) {
+  if (!schema_ || schema_->fieldCount() != columns_.size()) {
+    throw std::invalid_argument("RecordBatch schema/column count mismatch");
+  }
+  numRows_ = columns_.empty() ? 0 : columns_.front().size();
+  for (const auto &col : columns_) {
+    if (col.size() != numRows_) {
+      throw std::invalid_argument("RecordBatch columns have unequal lengths");
+    }
+  }
+}
+
+RecordBatch RecordBatch::fromRecords(const std::vector<DataRecord> &records) {
+  // Union of all field names in first-seen order. Values stay textual so the
+  // round trip through toRecords() is lossless.
+  std::vector<FieldDescriptor> fields;
+  std::unordered_map<std::string, size_t, TransparentStringHash,
+                     std::equal_to<>>
+      seen;
+  for (const auto &record : records) {
+    for (const auto &[name, value] : record.fields) {
+      if (seen.emplace(name, fields.size()).second) {
+        fields.push_back({name, ColumnType::STRING});
+      }
+    }
+  }
+  return fromRecords(records,
+                     std::make_shared<const BatchSchema>(std::move(fields)));
+}
+
+RecordBatch
+RecordBatch::fromRecords(const std::vector<DataRecord> &records,
+                         std::shared_ptr<const BatchSchema> schema) {
+  std::vector<Column> columns;
+  columns.reserve(schema->fieldCount());
+  for (const auto &field : schema->fields()) {
+    Column col(field.type);
+    col.reserve(records.size());
+    for (const auto &record : records) {
+      auto it = record.fields.find(field.name);
+      if (it == record.fields.end()) {
+        col.appendNull();
+        continue;
+      }
+      switch (field.type) {
+      case ColumnType::STRING:
+        col.appendString(it->second);
+        break;
+      case ColumnType::INT64:
+        try {
+          col.appendInt64(std::stoll(it->second));
+        } catch (const std::exception &) {
+          col.appendNull();
+        }
+        break;
+      case ColumnType::DOUBLE:
+        try {
+          col.appendDouble(std::stod(it->second));
+        } catch (const std::exception &) {
+          col.appendNull();
+        }
+        break;
+      }
+    }
+    columns.push_back(std::move(col));
+  }
+
+  RecordBatch batch(std::move(schema), std::move(columns));
+  batch.numRows_ = records.size();
+  return batch;
+}
+
+std::vector<DataRecord> RecordBatch::toRecords() const {
+  std::vector<DataRecord> records(numRows_);
+  for (size_t c = 0; c < columns_.size(); ++c) {
+    const auto &name = schema_->field(c).name;
+    const auto &col = columns_[c];
+    for (size_t row = 0; row < numRows_; ++row) {
+      if (!col.isNull(row)) {
+        records[row].fields.emplace(name, col.valueAsString(row));
+      }
+    }
+  }
+  return records;
+}
+
+const Column *RecordBatch::column(std::string_view name) const {
+  auto idx = schema_->fieldIndex(name);
+  return idx ? &columns_[*idx] : nullptr;
+}
+
+void RecordBatch::setColumn(const FieldDescriptor &field, Column column) {
+  if (!columns_.empty() && column.size() != numRows_) {
+    throw std::invalid_argument("Column length does not match batch");
+  }
+  if (columns_.empty()) {
+    numRows_ = column.size();
+  }
+  schema_ = schema_->withField(field);
+  auto idx = schema_->fieldIndex(field.name);
+  if (*idx < columns_.size()) {
+    columns_[*idx] = std::move(column);
+  } else {
+    columns_.push_back(std::move(column));
+  }
+}
+
+void appendCopyText(std::string &line, std::string_view value) {
+  for (char c : value) {
+    switch (c) {
+    case '\\':
+      line += "\\\\";
+      break;
+    case '\t':
+      line += "\\t";
+      break;
+    case '\n':
+      line += "\\n";
+      break;
+    case '\r':
+      line += "\\r";
+      break;
+    default:
+      line += c;
+    }
+  }
+}
+
+void formatCopyRow(std::string &line,
+                   const std::vector<const Column *> &sources, size_t row) {
+  line.clear();
+  for (size_t i = 0; i < sources.size(); ++i) {
+    if (i > 0) {
+      line += '\t';
+    }
+    const Column *column = sources[i];
+    if (!column || column->isNull(row)) {
+      line += "\\N";
+      continue;
+    }
+    switch (column->type()) {
+    case ColumnType::INT64:
+      line += std::to_string(column->int64At(row));
+      break;
+    case ColumnType::DOUBLE:
+      line += formatNumericValue(column->doubleAt(row));
+      break;
+    case ColumnType::STRING:
+      appendCopyText(line, column->stringAt(row));
+      break;
+    }
+  }
+}
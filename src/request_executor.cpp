@@ -0,0 +1,141 @@
+#include "request_executor.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <exception>
+
+RequestExecutor::RequestExecutor(RequestExecutorConfig config)
+    : config_(std::move(config)) {
+  size_t workerCount = config_.workerCount;
+  if (workerCount == 0) {
+    workerCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  workers_.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; ++i) {
+    workers_.emplace_back(&RequestExecutor::workerLoop, this);
+  }
+}
+
+RequestExecutor::~RequestExecutor() { shutdown(); }
+
+bool RequestExecutor::submit(std::string_view route, Task task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = queuedByRoute_.find(route);
+    size_t routeQueued = it == queuedByRoute_.end() ? 0 : it->second;
+    if (stopping_ || queue_.size() >= config_.maxQueueSize ||
+        routeQueued >= routeLimit(route)) {
+      ++rejected_;
+      return false;
+    }
+
+    if (it == queuedByRoute_.end()) {
+      it = queuedByRoute_.emplace(std::string(route), 0).first;
+    }
+    ++it->second;
+    queue_.push_back(Entry{std::string(route), std::move(task),
+                           std::chrono::steady_clock::now()});
+  }
+  condition_.notify_one();
+  return true;
+}
+
+void RequestExecutor::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_ && workers_.empty()) {
+      return;
+    }
+    stopping_ = true;
+  }
+  condition_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+}
+
+std::string RequestExecutor::routeKey(std::string_view target) {
+  target = target.substr(0, target.find('?'));
+  size_t end = 0;
+  for (int segment = 0; segment < 2; ++segment) {
+    size_t slash = target.find('/', end + 1);
+    if (slash == std::string_view::npos) {
+      return std::string(target);
+    }
+    end = slash;
+  }
+  return std::string(target.substr(0, end));
+}
+
+size_t RequestExecutor::routeQueueDepth(std::string_view route) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = queuedByRoute_.find(route);
+  return it == queuedByRoute_.end() ? 0 : it->second;
+}
+
+RequestExecutorStats RequestExecutor::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  RequestExecutorStats stats;
+  stats.queued = queue_.size();
+  stats.running = running_;
+  stats.completed = completed_;
+  stats.rejected = rejected_;
+  stats.maxQueueWait = maxQueueWait_;
+  if (completed_ + running_ > 0) {
+    stats.averageQueueWait =
+        totalQueueWait_ / static_cast<int64_t>(completed_ + running_);
+  }
+  return stats;
+}
+
+size_t RequestExecutor::routeLimit(std::string_view route) const {
+  for (const auto &[key, limit] : config_.routeQueueLimits) {
+    if (key == route) {
+      return limit;
+    }
+  }
+  return config_.maxQueuePerRoute;
+}
+
+void RequestExecutor::workerLoop() {
+  while (true) {
+    Entry entry;
+    std::chrono::microseconds queueWait;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return; // Stopping and drained
+      }
+
+      entry = std::move(queue_.front());
+      queue_.pop_front();
+      auto it = queuedByRoute_.find(entry.route);
+      if (it != queuedByRoute_.end() && --it->second == 0) {
+        queuedByRoute_.erase(it);
+      }
+
+      queueWait = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - entry.enqueuedAt);
+      totalQueueWait_ += queueWait;
+      maxQueueWait_ = std::max(maxQueueWait_, queueWait);
+      ++running_;
+    }
+
+    try {
+      entry.task(queueWait);
+    } catch (const std::exception &e) {
+      HTTP_LOG_ERROR("RequestExecutor - Task for " + entry.route +
+                     " threw: " + e.what());
+    } catch (...) {
+      HTTP_LOG_ERROR("RequestExecutor - Task for " + entry.route +
+                     " threw an unknown exception");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    --running_;
+    ++completed_;
+  }
+}
@@ -3,6 +3,7 @@
 #include "database_manager.hpp"
 #include "etl_exceptions.hpp"
 #include "etl_job_manager.hpp"
+#include "etl_job_repository.hpp"
 #include "exception_handler.hpp"
 #include "exception_mapper.hpp"
 #include "input_validator.hpp"
@@ -20,8 +21,29 @@
 #include <sstream>
 #include <stdexcept>
 #include <thread>
+#include <type_traits>
 #include <unistd.h> // for getpid()
 
+namespace {
+std::string_view toStringView(boost::beast::string_view value) {
+  return {value.data(), value.size()};
+}
+
+// Header lookup is case-insensitive and does not copy the value
+std::string_view headerValue(const http::request<http::string_body> &req,
+                             std::string_view name) {
+  return toStringView(req[boost::beast::string_view(name.data(), name.size())]);
+}
+
+std::string_view bearerToken(const http::request<http::string_body> &req) {
+  std::string_view authHeader = headerValue(req, "Authorization");
+  if (authHeader.starts_with("Bearer ")) {
+    return authHeader.substr(7); // Remove "Bearer " prefix
+  }
+  return {};
+}
+} // namespace
+
 RequestHandler::RequestHandler(std::shared_ptr<DatabaseManager> dbManager,
                                std::shared_ptr<AuthManager> authManager,
                                std::shared_ptr<ETLJobManager> etlManager)
@@ -172,6 +194,9 @@ void RequestHandler::initCommon() {
 
   REQ_LOG_INFO(
       "Hana-based exception handlers registered for improved error handling");
+
+  // Build the route table now rather than on the first request
+  routes();
 }
 
 RequestHandler::RequestHandler(std::shared_ptr<DatabaseManager> dbManager,
@@ -202,13 +227,8 @@ RequestHandler::RequestHandler(std::shared_ptr<DatabaseManager> dbManager,
 #if ETL_ENABLE_JWT
 std::optional<std::string> RequestHandler::validateJWTToken(
     const http::request<http::string_body> &req) const {
-  auto headers = extractHeaders(req);
-  if (auto authIt = headers.find("authorization"); authIt != headers.end()) {
-    std::string authHeader = authIt->second;
-    if (authHeader.starts_with("Bearer ")) {
-      std::string token = authHeader.substr(7); // Remove "Bearer " prefix
-      return authManager_->validateJWTToken(token);
-    }
+  if (auto token = bearerToken(req); !token.empty()) {
+    return authManager_->validateJWTToken(std::string(token));
   }
   return std::nullopt;
 }
@@ -230,18 +250,15 @@ bool RequestHandler::isProtectedEndpoint(std::string_view target) const {
 
 std::string
 RequestHandler::getClientId(const http::request<http::string_body> &req) const {
-  auto headers = extractHeaders(req);
-
   // Try to get client IP from X-Forwarded-For header (for proxies/load
   // balancers)
-  if (auto forwardedIt = headers.find("x-forwarded-for");
-      forwardedIt != headers.end()) {
-    std::string forwarded = forwardedIt->second;
+  if (auto forwarded = headerValue(req, "X-Forwarded-For");
+      !forwarded.empty()) {
 
     if (trustProxy_ && numTrustedHops_ > 0) {
       // Parse X-Forwarded-For with trusted hops
       std::vector<std::string> ips;
-      std::stringstream ss(forwarded);
+      std::stringstream ss{std::string(forwarded)};
       std::string ip;
       while (std::getline(ss, ip, ',')) {
         // Trim whitespace
@@ -269,17 +286,13 @@ RequestHandler::getClientId(const http::request<http::string_body> &req) const {
       }
     } else {
       // Simple parsing: take the first IP if there are multiple
-      size_t commaPos = forwarded.find(',');
-      if (commaPos != std::string::npos) {
-        return forwarded.substr(0, commaPos);
-      }
-      return forwarded;
+      return std::string(forwarded.substr(0, forwarded.find(',')));
     }
   }
 
   // Try to get client IP from X-Real-IP header
-  if (auto realIpIt = headers.find("x-real-ip"); realIpIt != headers.end()) {
-    return realIpIt->second;
+  if (auto realIp = headerValue(req, "X-Real-IP"); !realIp.empty()) {
+    return std::string(realIp);
   }
 
   // Fallback: use a default client ID for testing
@@ -290,11 +303,11 @@ RequestHandler::getClientId(const http::request<http::string_body> &req) const {
 bool RequestHandler::checkRateLimit(
     const http::request<http::string_body> &req) const {
   std::string clientId = getClientId(req);
-  std::string endpoint = std::string(req.target());
+  std::string_view endpoint = toStringView(req.target());
 
   if (!rateLimiter_->isAllowed(clientId, endpoint)) {
     REQ_LOG_WARN("Rate limit exceeded for client " + clientId +
-                 " on endpoint " + endpoint);
+                 " on endpoint " + std::string(endpoint));
     return false;
   }
 
@@ -336,14 +349,18 @@ http::response<http::string_body> RequestHandler::handleRequest(
                 std::string(req.method_string()) + " " +
                 std::string(req.target()));
 
-  // Convert to string_body for processing
-  http::request<http::string_body> string_req;
-  string_req.method(req.method());
-  string_req.target(req.target());
-  string_req.version(req.version());
-  string_req.keep_alive(req.keep_alive());
+  // Sessions already read into a string_body; handle it in place
+  if constexpr (std::is_same_v<decltype(req),
+                               http::request<http::string_body>>) {
+    return processRequest(req);
+  } else {
+    // Convert to string_body for processing
+    http::request<http::string_body> string_req;
+    string_req.method(req.method());
+    string_req.target(req.target());
+    string_req.version(req.version());
+    string_req.keep_alive(req.keep_alive());
 
-  try {
     REQ_LOG_DEBUG(
         "RequestHandler::handleRequest() - Converting request headers");
     // Copy headers - check for valid field names to avoid assertion failures
@@ -365,21 +382,19 @@ http::response<http::string_body> RequestHandler::handleRequest(
       }
     }
 
-    REQ_LOG_DEBUG("RequestHandler::handleRequest() - Converting request body");
-    // Copy body if it exists
-    if constexpr (std::is_same_v<Body, http::string_body>) {
-      string_req.body() = req.body();
-    }
-
     string_req.prepare_payload();
+    return processRequest(string_req);
+  }
+}
 
+http::response<http::string_body>
+RequestHandler::processRequest(const http::request<http::string_body> &req) {
+  try {
     // Perform comprehensive validation and handle request
-    auto response = validateAndHandleRequest(string_req);
+    auto response = validateAndHandleRequest(req);
 
     // Add rate limit headers to the response
-    std::string clientId = getClientId(string_req);
-    std::string endpoint = std::string(string_req.target());
-    addRateLimitHeaders(response, clientId, endpoint);
+    addRateLimitHeaders(response, getClientId(req), std::string(req.target()));
 
     return response;
   } catch (const etl::ETLException &ex) {
@@ -387,9 +402,8 @@ http::response<http::string_body> RequestHandler::handleRequest(
     auto errorResponse = hanaExceptionRegistry_.handle(ex, "handleRequest");
 
     // Add rate limit headers to error responses
-    std::string clientId = getClientId(string_req);
-    std::string endpoint = std::string(string_req.target());
-    addRateLimitHeaders(errorResponse, clientId, endpoint);
+    addRateLimitHeaders(errorResponse, getClientId(req),
+                        std::string(req.target()));
 
     return errorResponse;
   } catch (const std::exception &e) {
@@ -397,27 +411,62 @@ http::response<http::string_body> RequestHandler::handleRequest(
     auto errorResponse = exceptionMapper_.mapToResponse(e, "handleRequest");
 
     // Add rate limit headers to error responses
-    std::string clientId = getClientId(string_req);
-    std::string endpoint = std::string(string_req.target());
-    addRateLimitHeaders(errorResponse, clientId, endpoint);
+    addRateLimitHeaders(errorResponse, getClientId(req),
+                        std::string(req.target()));
 
     return errorResponse;
   } catch (...) {
     auto errorResponse = exceptionMapper_.mapToResponse("handleRequest");
 
     // Add rate limit headers to error responses
-    std::string clientId = getClientId(string_req);
-    std::string endpoint = std::string(string_req.target());
-    addRateLimitHeaders(errorResponse, clientId, endpoint);
+    addRateLimitHeaders(errorResponse, getClientId(req),
+                        std::string(req.target()));
 
     return errorResponse;
   }
 }
 
+const RadixRouter<RequestHandler::Endpoint> &RequestHandler::routes() {
+  struct RouteSpec {
+    std::string_view pattern;
+    Endpoint endpoint;
+  };
+  // Family prefixes end in a catch-all so unknown sub-paths still reach the
+  // family handler and get its endpoint-specific error
+  static constexpr RouteSpec kRoutes[] = {
+      {"/api/auth", Endpoint::Auth},
+      {"/api/auth/*", Endpoint::Auth},
+      {"/api/logs", Endpoint::Logs},
+      {"/api/logs/*", Endpoint::Logs},
+      {"/api/jobs", Endpoint::Jobs},
+      {"/api/jobs/*", Endpoint::Jobs},
+      {"/api/jobs/:id", Endpoint::JobById},
+      {"/api/jobs/:id/status", Endpoint::JobStatus},
+      {"/api/jobs/:id/metrics", Endpoint::JobMetrics},
+      {"/api/monitor", Endpoint::Monitor},
+      {"/api/monitor/*", Endpoint::Monitor},
+      {"/api/health", Endpoint::Health},
+      {"/api/health/*", Endpoint::Health},
+      {"/api/status", Endpoint::Health},
+  };
+
+  static const RadixRouter<Endpoint> router = [] {
+    RadixRouter<Endpoint> table;
+    for (const auto &route : kRoutes) {
+      table.add(route.pattern, route.endpoint);
+    }
+    return table;
+  }();
+  return router;
+}
+
 http::response<http::string_body> RequestHandler::validateAndHandleRequest(
     const http::request<http::string_body> &req) const {
+  const std::string_view target = toStringView(req.target());
+  const auto [path, query] = splitRequestTarget(target);
+
   // Step 1: Validate basic request structure
-  if (auto basicValidation = validateRequestBasics(req);
+  if (auto basicValidation = validateRequestBasics(req, path, query);
       !basicValidation.isValid) {
     REQ_LOG_WARN(
         "RequestHandler::validateAndHandleRequest() - Basic validation failed");
@@ -425,12 +474,9 @@ http::response<http::string_body> RequestHandler::validateAndHandleRequest(
                                    "Request validation failed");
   }
 
-  auto target = std::string(req.target());
-  auto method = std::string(req.method_string());
-
   REQ_LOG_INFO("RequestHandler::validateAndHandleRequest() - Processing "
                "validated request: " +
-               method + " " + target);
+               std::string(req.method_string()) + " " + std::string(target));
 
   // Step 2: Validate components before routing
   if (!dbManager_) {
@@ -460,7 +506,7 @@ http::response<http::string_body> RequestHandler::validateAndHandleRequest(
   if (!checkRateLimit(req)) {
     REQ_LOG_WARN("RequestHandler::validateAndHandleRequest() - Rate limit "
                  "exceeded for: " +
-                 target);
+                 std::string(target));
     throw etl::ValidationException(
         etl::ErrorCode::RATE_LIMIT_EXCEEDED,
         "Rate limit exceeded. Please try again later.");
@@ -473,7 +519,7 @@ http::response<http::string_body> RequestHandler::validateAndHandleRequest(
     if (!userId.has_value()) {
       REQ_LOG_WARN("RequestHandler::validateAndHandleRequest() - JWT "
                    "validation failed for protected endpoint: " +
-                   target);
+                   std::string(target));
       throw etl::ValidationException(
           etl::ErrorCode::UNAUTHORIZED,
           "Authentication required for this endpoint");
@@ -485,46 +531,45 @@ http::response<http::string_body> RequestHandler::validateAndHandleRequest(
 #endif
 
   // Step 3: Route requests with endpoint-specific validation
-  if (target.rfind("/api/auth", 0) == 0) {
-    REQ_LOG_DEBUG(
-        "RequestHandler::validateAndHandleRequest() - Routing to auth handler");
-    return handleAuth(req);
-  } else if (target.rfind("/api/logs", 0) == 0) {
-    REQ_LOG_DEBUG("RequestHandler::validateAndHandleRequest() - Routing to "
-                  "logs handler");
-    return handleLogs(req);
-  } else if (target.rfind("/api/jobs", 0) == 0) {
-    REQ_LOG_DEBUG("RequestHandler::validateAndHandleRequest() - Routing to ETL "
-                  "jobs handler");
-    return handleETLJobs(req);
-  } else if (target.rfind("/api/monitor", 0) == 0) {
-    REQ_LOG_DEBUG("RequestHandler::validateAndHandleRequest() - Routing to "
-                  "monitoring handler");
-    return handleMonitoring(req);
-  } else if (target == "/api/health" || target == "/api/status" ||
-             target.rfind("/api/health/", 0) == 0) {
-    REQ_LOG_DEBUG("RequestHandler::validateAndHandleRequest() - Routing to "
-                  "health/status handler");
-    return handleHealth(req);
-  } else {
+  auto match = routes().match(path);
+  if (!match) {
     REQ_LOG_WARN(
         "RequestHandler::validateAndHandleRequest() - Unknown endpoint: " +
-        target);
+        std::string(target));
     throw etl::SystemException(etl::ErrorCode::NETWORK_ERROR,
-                               "Endpoint not found: " + target,
+                               "Endpoint not found: " + std::string(target),
                                "RequestHandler");
   }
+
+  const RequestContext ctx{req, match->value, path, QueryView(query),
+                           match->params};
+  switch (ctx.endpoint) {
+  case Endpoint::Auth:
+    return handleAuth(ctx);
+  case Endpoint::Logs:
+    return handleLogs(ctx);
+  case Endpoint::Jobs:
+  case Endpoint::JobById:
+  case Endpoint::JobStatus:
+  case Endpoint::JobMetrics:
+    return handleETLJobs(ctx);
+  case Endpoint::Monitor:
+    return handleMonitoring(ctx);
+  case Endpoint::Health:
+    return handleHealth(ctx);
+  }
+  throw etl::SystemException(etl::ErrorCode::NETWORK_ERROR,
+                             "Endpoint not found: " + std::string(target),
+                             "RequestHandler");
 }
 
 InputValidator::ValidationResult RequestHandler::validateRequestBasics(
-    const http::request<http::string_body> &req) const {
+    const http::request<http::string_body> &req, std::string_view path,
+    std::string_view query) const {
   InputValidator::ValidationResult result;
 
-  auto target = std::string(req.target());
-  auto method = std::string(req.method_string());
-
-  // Validate request target/path
-  if (auto pathValidation = InputValidator::validateEndpointPath(target);
+  // Validate request path
+  if (auto pathValidation = InputValidator::validateEndpointPath(path);
       !pathValidation.isValid) {
     result.errors.insert(result.errors.end(), pathValidation.errors.begin(),
                          pathValidation.errors.end());
@@ -532,9 +577,8 @@ InputValidator::ValidationResult RequestHandler::validateRequestBasics(
   }
 
   // Validate query parameters if present
-  if (size_t queryPos = target.find('?'); queryPos != std::string::npos) {
-    std::string queryString = target.substr(queryPos + 1);
-    auto queryValidation = InputValidator::validateQueryParameters(queryString);
+  if (!query.empty()) {
+    auto queryValidation = InputValidator::validateQueryParameters(query);
     if (!queryValidation.isValid) {
       result.errors.insert(result.errors.end(), queryValidation.errors.begin(),
                            queryValidation.errors.end());
@@ -543,37 +587,23 @@ InputValidator::ValidationResult RequestHandler::validateRequestBasics(
   }
 
   // Validate HTTP method
-  if (const std::vector<std::string> allowedMethods = {"GET", "POST", "PUT",
-                                                       "DELETE", "OPTIONS",
-                                                       "PATCH"};
-      !InputValidator::isValidHttpMethod(method, allowedMethods)) {
+  switch (req.method()) {
+  case http::verb::get:
+  case http::verb::post:
+  case http::verb::put:
+  case http::verb::delete_:
+  case http::verb::options:
+  case http::verb::patch:
+    break;
+  default:
     result.addError("method", "HTTP method not allowed", "METHOD_NOT_ALLOWED");
   }
 
-  // Validate request headers
-  auto headers = extractHeaders(req);
-
-  // Convert to standard unordered_map for InputValidator
-  std::unordered_map<std::string, std::string, TransparentStringHash,
-                     std::equal_to<>>
-      standardHeaders;
-  for (const auto &[key, value] : headers) {
-    standardHeaders[key] = value;
-  }
-
-  // Convert standardHeaders to the expected type
-  std::unordered_map<std::string, std::string> convertedHeaders;
-  for (const auto &[key, value] : standardHeaders) {
-    convertedHeaders[key] = value;
-  }
-
-  // Pass convertedHeaders to the function
-  if (auto headerValidation =
-          InputValidator::validateRequestHeaders(convertedHeaders);
-      !headerValidation.isValid) {
-    result.errors.insert(result.errors.end(), headerValidation.errors.begin(),
-                         headerValidation.errors.end());
-    result.isValid = false;
+  // Validate request headers in place; the content-type check covers
+  // POST/PUT/PATCH bodies
+  for (const auto &field : req) {
+    InputValidator::validateRequestHeader(toStringView(field.name_string()),
+                                          toStringView(field.value()), result);
   }
 
   // Validate request size
@@ -582,61 +612,12 @@ InputValidator::ValidationResult RequestHandler::validateRequestBasics(
                     "BODY_TOO_LARGE");
   }
 
-  // Validate content type for POST/PUT/PATCH requests
-  if (method == "POST" || method == "PUT" || method == "PATCH") {
-    if (auto it = headers.find("content-type");
-        it != headers.end() &&
-        !InputValidator::isValidContentType(it->second)) {
-      result.addError("content-type", "Unsupported content type",
-                      "INVALID_CONTENT_TYPE");
-    }
-  }
-
-  return result;
-}
-
-std::unordered_map<std::string, std::string, TransparentStringHash,
-                   std::equal_to<>>
-RequestHandler::extractHeaders(
-    const http::request<http::string_body> &req) const {
-  std::unordered_map<std::string, std::string, TransparentStringHash,
-                     std::equal_to<>>
-      headers;
-
-  for (const auto &field : req) {
-    auto name = std::string(field.name_string());
-    auto value = std::string(field.value());
-    headers[name] = value;
-  }
-
-  return headers;
-}
-
-std::unordered_map<std::string, std::string, TransparentStringHash,
-                   std::equal_to<>>
-RequestHandler::extractQueryParams(std::string_view target) const {
-  size_t queryPos = target.find('?');
-  if (queryPos == std::string::npos) {
-    return {};
-  }
-
-  auto queryString = std::string(target.substr(queryPos + 1));
-  auto standardParams = InputValidator::parseQueryString(queryString);
-
-  // Convert to TransparentStringHash map
-  std::unordered_map<std::string, std::string, TransparentStringHash,
-                     std::equal_to<>>
-      result;
-  for (const auto &[key, value] : standardParams) {
-    result[key] = value;
-  }
-
   return result;
 }
 
 http::response<http::string_body>
-RequestHandler::handleAuth(const http::request<http::string_body> &req) const {
-  auto target = std::string(req.target());
+RequestHandler::handleAuth(const RequestContext &ctx) const {
+  const auto &req = ctx.req;
   auto method = std::string(req.method_string());
 
   // Handle CORS preflight
@@ -662,7 +643,7 @@ RequestHandler::handleAuth(const http::request<http::string_body> &req) const {
                                    "method", std::string(req.method_string()));
   }
 
-  if (req.method() == http::verb::post && target == "/api/auth/login") {
+  if (req.method() == http::verb::post && ctx.path == "/api/auth/login") {
 #if ETL_ENABLE_JWT
     // Validate login request body
     if (auto validation = InputValidator::validateLoginRequest(req.body());
@@ -736,7 +717,8 @@ RequestHandler::handleAuth(const http::request<http::string_body> &req) const {
     throw etl::ValidationException(etl::ErrorCode::UNAUTHORIZED,
                                    "Authentication is currently disabled");
 #endif
-  } else if (req.method() == http::verb::post && target == "/api/auth/logout") {
+  } else if (req.method() == http::verb::post &&
+             ctx.path == "/api/auth/logout") {
     // Validate logout request (may be empty or contain token)
     if (!req.body().empty()) {
       if (auto validation = InputValidator::validateLogoutRequest(req.body());
@@ -749,15 +731,7 @@ RequestHandler::handleAuth(const http::request<http::string_body> &req) const {
     }
 
     // Extract token from Authorization header
-    auto headers = extractHeaders(req);
-    std::string token;
-    if (auto authIt = headers.find("authorization"); authIt != headers.end()) {
-      // Extract token from "Bearer <token>" format
-      std::string authHeader = authIt->second;
-      if (authHeader.starts_with("Bearer ")) {
-        token = authHeader.substr(7); // Remove "Bearer " prefix
-      }
-    }
+    std::string token(bearerToken(req));
 
     if (!token.empty()) {
 #if ETL_ENABLE_JWT
@@ -780,7 +754,8 @@ RequestHandler::handleAuth(const http::request<http::string_body> &req) const {
 
     return createSuccessResponse(R"({"message":"Logged out successfully"})",
                                  req.version());
-  } else if (req.method() == http::verb::get && target == "/api/auth/profile") {
+  } else if (req.method() == http::verb::get &&
+             ctx.path == "/api/auth/profile") {
 #if ETL_ENABLE_JWT
     // JWT validation is now handled by middleware, so we can extract user info
     // from token
@@ -826,12 +801,13 @@ RequestHandler::handleAuth(const http::request<http::string_body> &req) const {
   }
 
   throw etl::ValidationException(etl::ErrorCode::INVALID_INPUT,
-                                 "Invalid auth endpoint", "target", target);
+                                 "Invalid auth endpoint", "target",
+                                 std::string(req.target()));
 }
 
 http::response<http::string_body>
-RequestHandler::handleLogs(const http::request<http::string_body> &req) const {
-  auto target = std::string(req.target());
+RequestHandler::handleLogs(const RequestContext &ctx) const {
+  const auto &req = ctx.req;
   auto method = std::string(req.method_string());
 
   // Handle CORS preflight
@@ -858,21 +834,22 @@ RequestHandler::handleLogs(const http::request<http::string_body> &req) const {
   }
 
   // Handle different log endpoints
-  if (req.method() == http::verb::get && target == "/api/logs") {
+  if (req.method() == http::verb::get && ctx.path == "/api/logs") {
     // Return recent logs
     REQ_LOG_INFO("RequestHandler::handleLogs() - Retrieving recent logs");
     return createSuccessResponse(
         R"({"logs":[],"total":0,"message":"Logs endpoint implemented"})",
         req.version());
   } else if (req.method() == http::verb::get &&
-             target.rfind("/api/logs/", 0) == 0) {
+             ctx.path.starts_with("/api/logs/")) {
     // Handle specific log queries with parameters
     REQ_LOG_INFO(
         "RequestHandler::handleLogs() - Processing log query with parameters");
     return createSuccessResponse(
         R"({"logs":[],"total":0,"message":"Log query endpoint implemented"})",
         req.version());
-  } else if (req.method() == http::verb::post && target == "/api/logs/search") {
+  } else if (req.method() == http::verb::post &&
+             ctx.path == "/api/logs/search") {
     // Handle log search requests
     REQ_LOG_INFO(
         "RequestHandler::handleLogs() - Processing log search request");
@@ -882,12 +859,13 @@ RequestHandler::handleLogs(const http::request<http::string_body> &req) const {
   }
 
   throw etl::ValidationException(etl::ErrorCode::INVALID_INPUT,
-                                 "Invalid logs endpoint", "target", target);
+                                 "Invalid logs endpoint", "target",
+                                 std::string(req.target()));
 }
 
-http::response<http::string_body> RequestHandler::handleETLJobs(
-    const http::request<http::string_body> &req) const {
-  auto target = std::string(req.target());
+http::response<http::string_body>
+RequestHandler::handleETLJobs(const RequestContext &ctx) const {
+  const auto &req = ctx.req;
   auto method = std::string(req.method_string());
 
   // Handle CORS preflight
@@ -916,9 +894,8 @@ http::response<http::string_body> RequestHandler::handleETLJobs(
   }
 
   // Handle GET /api/jobs/{id}/status - detailed job status
-  if (req.method() == http::verb::get && target.rfind("/api/jobs/", 0) == 0 &&
-      target.size() > 7 && target.substr(target.size() - 7) == "/status") {
-    auto jobId = extractJobIdFromPath(target, "/api/jobs/", "/status");
+  if (req.method() == http::verb::get && ctx.endpoint == Endpoint::JobStatus) {
+    std::string jobId(ctx.params.get("id"));
     if (!InputValidator::isValidJobId(jobId)) {
       throw etl::ValidationException(etl::ErrorCode::INVALID_INPUT,
                                      "Invalid job ID format", "jobId", jobId);
@@ -966,9 +943,9 @@ http::response<http::string_body> RequestHandler::handleETLJobs(
   }
 
   // Handle GET /api/jobs/{id}/metrics - job execution metrics
-  if (req.method() == http::verb::get && target.rfind("/api/jobs/", 0) == 0 &&
-      target.size() > 8 && target.substr(target.size() - 8) == "/metrics") {
-    auto jobId = extractJobIdFromPath(target, "/api/jobs/", "/metrics");
+  if (req.method() == http::verb::get &&
+      ctx.endpoint == Endpoint::JobMetrics) {
+    std::string jobId(ctx.params.get("id"));
     if (!InputValidator::isValidJobId(jobId)) {
       throw etl::ValidationException(etl::ErrorCode::INVALID_INPUT,
                                      "Invalid job ID format", "jobId", jobId);
@@ -1014,28 +991,10 @@ http::response<http::string_body> RequestHandler::handleETLJobs(
     return createSuccessResponse(json.str(), req.version());
   }
 
-  if (req.method() == http::verb::get && target == "/api/jobs") {
+  if (req.method() == http::verb::get && ctx.path == "/api/jobs") {
     // Validate query parameters
-    auto queryParams =
-        extractQueryParams(std::string_view(target.data(), target.size()));
-
-    // Convert to standard unordered_map for InputValidator
-    std::unordered_map<std::string, std::string, TransparentStringHash,
-                       std::equal_to<>>
-        standardParams;
-    for (const auto &[key, value] : queryParams) {
-      standardParams[key] = value;
-    }
-
-    // Convert standardParams to the expected type
-    std::unordered_map<std::string, std::string> convertedParams;
-    for (const auto &[key, value] : standardParams) {
-      convertedParams[key] = value;
-    }
-
-    // Pass convertedParams to the function
     if (auto queryValidation =
-            InputValidator::validateJobQueryParams(convertedParams);
+            InputValidator::validateJobQueryParams(ctx.query.toMap());
         !queryValidation.isValid) {
       REQ_LOG_WARN("RequestHandler::handleETLJobs() - Query parameter "
                    "validation failed");
@@ -1044,38 +1003,52 @@ http::response<http::string_body> RequestHandler::handleETLJobs(
                                      "query", std::string(req.target()));
     }
 
-    // Return list of jobs
-    auto jobs = etlManager_->getAllJobs();
+    // Keyset pagination: ?limit=N&cursor=<nextCursor>&status=<status>
+    JobPageQuery pageQuery;
+    if (auto limit = ctx.query.get("limit")) {
+      pageQuery.limit = static_cast<size_t>(std::stoi(std::string(*limit)));
+    }
+    if (auto cursor = ctx.query.get("cursor")) {
+      int64_t createdAtMicros = 0;
+      std::string cursorJobId;
+      pageQuery.cursor = std::string(*cursor);
+      if (!ETLJobRepository::decodePageCursor(pageQuery.cursor,
+                                              createdAtMicros, cursorJobId)) {
+        throw etl::ValidationException(etl::ErrorCode::INVALID_INPUT,
+                                       "Invalid page cursor", "cursor",
+                                       pageQuery.cursor);
+      }
+    }
+    if (auto statusParam = ctx.query.get("status")) {
+      std::string status(*statusParam);
+      std::transform(status.begin(), status.end(), status.begin(), ::tolower);
+      pageQuery.status = stringToJobStatus(status);
+    }
+
+    JobPage page = etlManager_->listJobs(pageQuery);
     std::ostringstream json;
     json << R"({"jobs":[)";
-    for (size_t i = 0; i < jobs.size(); ++i) {
+    for (size_t i = 0; i < page.jobs.size(); ++i) {
+      const auto &job = page.jobs[i];
       if (i > 0)
         json << ",";
-      json << R"({"id":")" << jobs[i]->jobId << R"(","status":")";
-      using enum JobStatus;
-      switch (jobs[i]->status) {
-      case PENDING:
-        json << "pending";
-        break;
-      case RUNNING:
-        json << "running";
-        break;
-      case COMPLETED:
-        json << "completed";
-        break;
-      case FAILED:
-        json << "failed";
-        break;
-      case CANCELLED:
-        json << "cancelled";
-        break;
-      }
-      json << R"("})";
+      json << R"({"id":")" << job.jobId << R"(","status":")"
+           << jobStatusToString(job.status) << R"(","type":")"
+           << jobTypeToString(job.type) << R"(","createdAt":")"
+           << formatTimestamp(job.createdAt) << R"(","recordsProcessed":)"
+           << job.recordsProcessed << R"(,"recordsFailed":)"
+           << job.recordsFailed << "}";
+    }
+    json << R"(],"nextCursor":)";
+    if (page.nextCursor.empty()) {
+      json << "null";
+    } else {
+      json << '"' << page.nextCursor << '"';
     }
-    json << R"(]})";
+    json << "}";
 
     return createSuccessResponse(json.str(), req.version());
-  } else if (req.method() == http::verb::post && target == "/api/jobs") {
+  } else if (req.method() == http::verb::post && ctx.path == "/api/jobs") {
     // Validate job creation request
     auto validation = InputValidator::validateJobCreationRequest(req.body());
     if (!validation.isValid) {
@@ -1114,9 +1087,8 @@ http::response<http::string_body> RequestHandler::handleETLJobs(
                                  "Failed to create job", "ETLJobManager");
     }
   } else if (req.method() == http::verb::put &&
-             target.find("/api/jobs/") == 0) {
-    // Extract job ID from path
-    std::string jobId = target.substr(11); // Remove "/api/jobs/"
+             ctx.endpoint == Endpoint::JobById) {
+    std::string jobId(ctx.params.get("id"));
     if (!InputValidator::isValidJobId(jobId)) {
       throw etl::ValidationException(etl::ErrorCode::INVALID_INPUT,
                                      "Invalid job ID format", "jobId", jobId);
@@ -1138,12 +1110,13 @@ http::response<http::string_body> RequestHandler::handleETLJobs(
   }
 
   throw etl::ValidationException(etl::ErrorCode::INVALID_INPUT,
-                                 "Invalid jobs endpoint", "target", target);
+                                 "Invalid jobs endpoint", "target",
+                                 std::string(req.target()));
 }
 
-http::response<http::string_body> RequestHandler::handleMonitoring(
-    const http::request<http::string_body> &req) const {
-  auto target = std::string(req.target());
+http::response<http::string_body>
+RequestHandler::handleMonitoring(const RequestContext &ctx) const {
+  const auto &req = ctx.req;
   auto method = std::string(req.method_string());
 
   // Handle CORS preflight
@@ -1170,19 +1143,11 @@ http::response<http::string_body> RequestHandler::handleMonitoring(
   }
 
   // Handle GET /api/monitor/jobs - filtered job monitoring
-  if (req.method() == http::verb::get &&
-      target.find("/api/monitor/jobs") == 0) {
-    auto queryParams =
-        extractQueryParams(std::string_view(target.data(), target.size()));
-
-    // Convert to standard unordered_map for InputValidator
-    std::unordered_map<std::string, std::string> standardParams;
-    for (const auto &[key, value] : queryParams) {
-      standardParams[key] = value;
-    }
+  if (req.method() == http::verb::get && ctx.path == "/api/monitor/jobs") {
+    auto queryParams = ctx.query.toMap();
 
     if (auto queryValidation =
-            InputValidator::validateMonitoringParams(standardParams);
+            InputValidator::validateMonitoringParams(queryParams);
         !queryValidation.isValid) {
       REQ_LOG_WARN(
           "RequestHandler::handleMonitoring() - Jobs query validation failed");
@@ -1317,7 +1282,7 @@ http::response<http::string_body> RequestHandler::handleMonitoring(
     return createSuccessResponse(json.str(), req.version());
   }
 
-  if (req.method() == http::verb::get && target == "/api/monitor/status") {
+  if (req.method() == http::verb::get && ctx.path == "/api/monitor/status") {
     // Use safe JSON construction to avoid string concatenation issues
     nlohmann::json statusJson = {
         {"server_status", "running"},
@@ -1326,19 +1291,10 @@ http::response<http::string_body> RequestHandler::handleMonitoring(
 
     return createSuccessResponse(statusJson.dump(), req.version());
   } else if (req.method() == http::verb::get &&
-             target == "/api/monitor/metrics") {
+             ctx.path == "/api/monitor/metrics") {
     // Validate query parameters for metrics
-    auto queryParams =
-        extractQueryParams(std::string_view(target.data(), target.size()));
-
-    // Convert to standard unordered_map for InputValidator
-    std::unordered_map<std::string, std::string> standardParams;
-    for (const auto &[key, value] : queryParams) {
-      standardParams[key] = value;
-    }
-
     if (auto queryValidation =
-            InputValidator::validateMetricsParams(standardParams);
+            InputValidator::validateMetricsParams(ctx.query.toMap());
         !queryValidation.isValid) {
       REQ_LOG_WARN("RequestHandler::handleMonitoring() - Metrics query "
                    "validation failed");
@@ -1354,7 +1310,7 @@ http::response<http::string_body> RequestHandler::handleMonitoring(
 
   throw etl::ValidationException(etl::ErrorCode::INVALID_INPUT,
                                  "Invalid monitoring endpoint", "target",
-                                 target);
+                                 std::string(req.target()));
 }
 
 http::response<http::string_body>
@@ -1374,24 +1330,6 @@ RequestHandler::createSuccessResponse(std::string_view data,
   return res;
 }
 
-std::string
-RequestHandler::extractJobIdFromPath(std::string_view target,
-                                     std::string_view prefix,
-                                     std::string_view suffix) const {
-  if (target.length() <= prefix.length() + suffix.length()) {
-    return "";
-  }
-
-  size_t startPos = prefix.length();
-  size_t endPos = target.length() - suffix.length();
-
-  if (startPos >= endPos) {
-    return "";
-  }
-
-  return std::string(target.substr(startPos, endPos - startPos));
-}
-
 std::string RequestHandler::jobStatusToString(JobStatus status) const {
   using enum JobStatus;
   switch (status) {
@@ -1486,11 +1424,12 @@ RequestHandler::parseTimestamp(std::string_view timestampStr) const {
   return std::chrono::system_clock::now();
 }
 
-http::response<http::string_body> RequestHandler::handleHealth(
-    const http::request<http::string_body> &req) const {
+http::response<http::string_body>
+RequestHandler::handleHealth(const RequestContext &ctx) const {
   using namespace std::chrono;
 
-  const auto target = req.target();
+  const auto &req = ctx.req;
+  const std::string_view target = ctx.path;
   const auto now = system_clock::now();
   const auto timestamp = duration_cast<seconds>(now.time_since_epoch()).count();
 
@@ -1548,7 +1487,8 @@ http::response<http::string_body> RequestHandler::handleHealth(
   }
 
   // Basic health check
-  if (target == "/api/health" || target == "/api/status") {
+  if ((target == "/api/health" && ctx.query.empty()) ||
+      target == "/api/status") {
     std::string status = "healthy";
     if (!dbConnected || !dbPoolHealthy || !wsRunning) {
       status = "degraded";
@@ -1701,7 +1641,11 @@ http::response<http::string_body> RequestHandler::handleHealth(
         "connection_timeouts": )"
        << dbMetrics.connectionTimeouts << R"(,
         "average_wait_time_ms": )"
-       << dbMetrics.averageWaitTimeMs << R"(
+       << dbMetrics.averageWaitTimeMs << R"(,
+        "prepared_statement_hits": )"
+       << dbMetrics.preparedStatementHits << R"(,
+        "prepared_statement_misses": )"
+       << dbMetrics.preparedStatementMisses << R"(
       }
     })";
     std::string dbHealthData = ss.str();
@@ -1814,21 +1758,9 @@ http::response<http::string_body> RequestHandler::handleHealth(
   }
 
   // Handle parameterized health endpoint
-  if (target.find("/api/health?") == 0) {
-    auto queryParams =
-        extractQueryParams(std::string_view(target.data(), target.size()));
-    std::string format = "json";
-    bool detailed = false;
-
-    auto formatIt = queryParams.find("format");
-    if (formatIt != queryParams.end()) {
-      format = formatIt->second;
-    }
-
-    auto detailedIt = queryParams.find("detailed");
-    if (detailedIt != queryParams.end()) {
-      detailed = (detailedIt->second == "true");
-    }
+  if (target == "/api/health") {
+    std::string format(ctx.query.get("format").value_or("json"));
+    bool detailed = ctx.query.get("detailed") == "true";
 
     if (format != "json" && format != "text") {
       throw etl::ValidationException(
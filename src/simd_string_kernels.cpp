@@ -0,0 +1,432 @@
+#include "simd_string_kernels.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ETL_STRING_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace etl {
+namespace string_kernels {
+
+namespace {
+
+inline bool isTrimSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Scalar kernels -------------------------------------------------------------
+
+void toUpperScalar(char *data, std::size_t length) {
+  for (std::size_t i = 0; i < length; ++i) {
+    unsigned char c = static_cast<unsigned char>(data[i]);
+    if (static_cast<unsigned>(c - 'a') < 26u) {
+      data[i] = static_cast<char>(c ^ 0x20);
+    }
+  }
+}
+
+void toLowerScalar(char *data, std::size_t length) {
+  for (std::size_t i = 0; i < length; ++i) {
+    unsigned char c = static_cast<unsigned char>(data[i]);
+    if (static_cast<unsigned>(c - 'A') < 26u) {
+      data[i] = static_cast<char>(c ^ 0x20);
+    }
+  }
+}
+
+std::size_t firstNonSpaceScalar(const char *data, std::size_t begin,
+                                std::size_t end) {
+  while (begin < end && isTrimSpace(data[begin])) {
+    ++begin;
+  }
+  return begin;
+}
+
+// Returns one past the last non-space byte in [begin, end)
+std::size_t lastNonSpaceScalar(const char *data, std::size_t begin,
+                               std::size_t end) {
+  while (end > begin && isTrimSpace(data[end - 1])) {
+    --end;
+  }
+  return end;
+}
+
+std::size_t countByteScalar(const char *data, std::size_t length, char byte) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < length; ++i) {
+    count += data[i] == byte;
+  }
+  return count;
+}
+
+// Checks the candidate whose first and last bytes already matched
+inline bool middleMatches(const char *candidate, std::string_view needle) {
+  return needle.size() <= 2 ||
+         std::memcmp(candidate + 1, needle.data() + 1, needle.size() - 2) == 0;
+}
+
+#ifdef ETL_STRING_KERNELS_X86
+
+// SSE2 kernels ---------------------------------------------------------------
+
+// Flips bit 0x20 of every byte in [lo, hi]. Bytes >= 0x80 compare as negative
+// and therefore never fall inside an ASCII letter range.
+__attribute__((target("sse2"))) void flipCaseSse2(char *data,
+                                                  std::size_t length, char lo,
+                                                  char hi) {
+  const __m128i lower = _mm_set1_epi8(static_cast<char>(lo - 1));
+  const __m128i upper = _mm_set1_epi8(static_cast<char>(hi + 1));
+  const __m128i bit = _mm_set1_epi8(0x20);
+  std::size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    __m128i inRange =
+        _mm_and_si128(_mm_cmpgt_epi8(v, lower), _mm_cmplt_epi8(v, upper));
+    v = _mm_xor_si128(v, _mm_and_si128(inRange, bit));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i), v);
+  }
+  if (lo == 'a') {
+    toUpperScalar(data + i, length - i);
+  } else {
+    toLowerScalar(data + i, length - i);
+  }
+}
+
+__attribute__((target("sse2"))) unsigned spaceMaskSse2(const char *p) {
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  __m128i ws = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                   _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                   _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+  return static_cast<unsigned>(_mm_movemask_epi8(ws));
+}
+
+__attribute__((target("sse2"))) std::string_view
+trimSse2(std::string_view value) {
+  const char *data = value.data();
+  std::size_t begin = 0;
+  std::size_t end = value.size();
+
+  // Fast exit for the common case of an already-trimmed value
+  if (end == 0 || (!isTrimSpace(data[0]) && !isTrimSpace(data[end - 1]))) {
+    return value;
+  }
+
+  while (begin + 16 <= end) {
+    unsigned nonSpace = ~spaceMaskSse2(data + begin) & 0xFFFFu;
+    if (nonSpace) {
+      begin += static_cast<std::size_t>(__builtin_ctz(nonSpace));
+      break;
+    }
+    begin += 16;
+  }
+  if (begin + 16 > end) {
+    begin = firstNonSpaceScalar(data, begin, end);
+  }
+
+  while (end >= begin + 16) {
+    unsigned nonSpace = ~spaceMaskSse2(data + end - 16) & 0xFFFFu;
+    if (nonSpace) {
+      end = end - 16 + (32 - static_cast<std::size_t>(__builtin_clz(nonSpace)));
+      return value.substr(begin, end - begin);
+    }
+    end -= 16;
+  }
+  end = lastNonSpaceScalar(data, begin, end);
+  return value.substr(begin, end - begin);
+}
+
+// Compares the needle's first and last bytes against 16 candidate positions
+// at once and only memcmp()s the positions where both match
+__attribute__((target("sse2"))) std::size_t
+findSubstringSse2(std::string_view haystack, std::string_view needle) {
+  const std::size_t n = needle.size();
+  const char *h = haystack.data();
+  const __m128i first = _mm_set1_epi8(needle.front());
+  const __m128i last = _mm_set1_epi8(needle.back());
+  std::size_t i = 0;
+  for (; i + n - 1 + 16 <= haystack.size(); i += 16) {
+    const __m128i blockFirst =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(h + i));
+    const __m128i blockLast =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(h + i + n - 1));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+    while (mask) {
+      const std::size_t bit = static_cast<std::size_t>(__builtin_ctz(mask));
+      if (middleMatches(h + i + bit, needle)) {
+        return i + bit;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return haystack.find(needle, i);
+}
+
+__attribute__((target("sse2"))) std::size_t
+countByteSse2(const char *data, std::size_t length, char byte) {
+  const __m128i target = _mm_set1_epi8(byte);
+  std::size_t count = 0;
+  std::size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    count += static_cast<std::size_t>(__builtin_popcount(
+        static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, target)))));
+  }
+  return count + countByteScalar(data + i, length - i, byte);
+}
+
+// AVX2 kernels ---------------------------------------------------------------
+
+__attribute__((target("avx2"))) void flipCaseAvx2(char *data,
+                                                  std::size_t length, char lo,
+                                                  char hi) {
+  const __m256i lower = _mm256_set1_epi8(static_cast<char>(lo - 1));
+  const __m256i upper = _mm256_set1_epi8(static_cast<char>(hi + 1));
+  const __m256i bit = _mm256_set1_epi8(0x20);
+  std::size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    __m256i inRange = _mm256_and_si256(_mm256_cmpgt_epi8(v, lower),
+                                       _mm256_cmpgt_epi8(upper, v));
+    v = _mm256_xor_si256(v, _mm256_and_si256(inRange, bit));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + i), v);
+  }
+  flipCaseSse2(data + i, length - i, lo, hi);
+}
+
+__attribute__((target("avx2"))) unsigned spaceMaskAvx2(const char *p) {
+  __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  __m256i ws = _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                      _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+      _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')),
+                      _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+  return static_cast<unsigned>(_mm256_movemask_epi8(ws));
+}
+
+__attribute__((target("avx2"))) std::string_view
+trimAvx2(std::string_view value) {
+  const char *data = value.data();
+  std::size_t begin = 0;
+  std::size_t end = value.size();
+
+  // Fast exit for the common case of an already-trimmed value
+  if (end == 0 || (!isTrimSpace(data[0]) && !isTrimSpace(data[end - 1]))) {
+    return value;
+  }
+
+  while (begin + 32 <= end) {
+    unsigned nonSpace = ~spaceMaskAvx2(data + begin);
+    if (nonSpace) {
+      begin += static_cast<std::size_t>(__builtin_ctz(nonSpace));
+      break;
+    }
+    begin += 32;
+  }
+  if (begin + 32 > end) {
+    begin = firstNonSpaceScalar(data, begin, end);
+  }
+
+  while (end >= begin + 32) {
+    unsigned nonSpace = ~spaceMaskAvx2(data + end - 32);
+    if (nonSpace) {
+      end = end - 32 + (32 - static_cast<std::size_t>(__builtin_clz(nonSpace)));
+      return value.substr(begin, end - begin);
+    }
+    end -= 32;
+  }
+  end = lastNonSpaceScalar(data, begin, end);
+  return value.substr(begin, end - begin);
+}
+
+__attribute__((target("avx2"))) std::size_t
+findSubstringAvx2(std::string_view haystack, std::string_view needle) {
+  const std::size_t n = needle.size();
+  const char *h = haystack.data();
+  const __m256i first = _mm256_set1_epi8(needle.front());
+  const __m256i last = _mm256_set1_epi8(needle.back());
+  std::size_t i = 0;
+  for (; i + n - 1 + 32 <= haystack.size(); i += 32) {
+    const __m256i blockFirst =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(h + i));
+    const __m256i blockLast =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(h + i + n - 1));
+    unsigned mask = static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(first, blockFirst),
+            _mm256_cmpeq_epi8(last, blockLast))));
+    while (mask) {
+      const std::size_t bit = static_cast<std::size_t>(__builtin_ctz(mask));
+      if (middleMatches(h + i + bit, needle)) {
+        return i + bit;
+      }
+      mask &= mask - 1;
+    }
+  }
+  const std::size_t rest = findSubstringSse2(haystack.substr(i), needle);
+  return rest == std::string_view::npos ? rest : i + rest;
+}
+
+__attribute__((target("avx2"))) std::size_t
+countByteAvx2(const char *data, std::size_t length, char byte) {
+  const __m256i target = _mm256_set1_epi8(byte);
+  std::size_t count = 0;
+  std::size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    count += static_cast<std::size_t>(__builtin_popcount(static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, target)))));
+  }
+  return count + countByteSse2(data + i, length - i, byte);
+}
+
+#endif // ETL_STRING_KERNELS_X86
+
+SimdLevel detectLevel() noexcept {
+#ifdef ETL_STRING_KERNELS_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return SimdLevel::SSE2;
+  }
+#endif
+  return SimdLevel::SCALAR;
+}
+
+SimdLevel clampLevel(SimdLevel requested) noexcept {
+  SimdLevel supported = detectedSimdLevel();
+  return static_cast<int>(requested) > static_cast<int>(supported) ? supported
+                                                                   : requested;
+}
+
+} // namespace
+
+SimdLevel detectedSimdLevel() noexcept {
+  static const SimdLevel level = detectLevel();
+  return level;
+}
+
+const char *simdLevelName(SimdLevel level) noexcept {
+  switch (level) {
+  case SimdLevel::AVX2:
+    return "AVX2";
+  case SimdLevel::SSE2:
+    return "SSE2";
+  case SimdLevel::SCALAR:
+    break;
+  }
+  return "scalar";
+}
+
+void asciiToUpper(char *data, std::size_t length) noexcept {
+  asciiToUpper(data, length, detectedSimdLevel());
+}
+
+void asciiToLower(char *data, std::size_t length) noexcept {
+  asciiToLower(data, length, detectedSimdLevel());
+}
+
+void asciiToUpper(char *data, std::size_t length, SimdLevel level) noexcept {
+  switch (clampLevel(level)) {
+#ifdef ETL_STRING_KERNELS_X86
+  case SimdLevel::AVX2:
+    flipCaseAvx2(data, length, 'a', 'z');
+    return;
+  case SimdLevel::SSE2:
+    flipCaseSse2(data, length, 'a', 'z');
+    return;
+#endif
+  default:
+    toUpperScalar(data, length);
+  }
+}
+
+void asciiToLower(char *data, std::size_t length, SimdLevel level) noexcept {
+  switch (clampLevel(level)) {
+#ifdef ETL_STRING_KERNELS_X86
+  case SimdLevel::AVX2:
+    flipCaseAvx2(data, length, 'A', 'Z');
+    return;
+  case SimdLevel::SSE2:
+    flipCaseSse2(data, length, 'A', 'Z');
+    return;
+#endif
+  default:
+    toLowerScalar(data, length);
+  }
+}
+
+std::string_view trimAsciiWhitespace(std::string_view value) noexcept {
+  return trimAsciiWhitespace(value, detectedSimdLevel());
+}
+
+std::string_view trimAsciiWhitespace(std::string_view value,
+                                     SimdLevel level) noexcept {
+  switch (clampLevel(level)) {
+#ifdef ETL_STRING_KERNELS_X86
+  case SimdLevel::AVX2:
+    return trimAvx2(value);
+  case SimdLevel::SSE2:
+    return trimSse2(value);
+#endif
+  default:
+    break;
+  }
+  std::size_t begin = firstNonSpaceScalar(value.data(), 0, value.size());
+  std::size_t end = lastNonSpaceScalar(value.data(), begin, value.size());
+  return value.substr(begin, end - begin);
+}
+
+std::size_t findSubstring(std::string_view haystack,
+                          std::string_view needle) noexcept {
+  return findSubstring(haystack, needle, detectedSimdLevel());
+}
+
+std::size_t findSubstring(std::string_view haystack, std::string_view needle,
+                          SimdLevel level) noexcept {
+  if (needle.size() <= 1 || needle.size() > haystack.size()) {
+    // memchr() is already vectorised for a single byte
+    return haystack.find(needle);
+  }
+  switch (clampLevel(level)) {
+#ifdef ETL_STRING_KERNELS_X86
+  case SimdLevel::AVX2:
+    return findSubstringAvx2(haystack, needle);
+  case SimdLevel::SSE2:
+    return findSubstringSse2(haystack, needle);
+#endif
+  default:
+    break;
+  }
+  return haystack.find(needle);
+}
+
+std::size_t countByte(std::string_view data, char byte) noexcept {
+  return countByte(data, byte, detectedSimdLevel());
+}
+
+std::size_t countByte(std::string_view data, char byte,
+                      SimdLevel level) noexcept {
+  switch (clampLevel(level)) {
+#ifdef ETL_STRING_KERNELS_X86
+  case SimdLevel::AVX2:
+    return countByteAvx2(data.data(), data.size(), byte);
+  case SimdLevel::SSE2:
+    return countByteSse2(data.data(), data.size(), byte);
+#endif
+  default:
+    break;
+  }
+  return countByteScalar(data.data(), data.size(), byte);
+}
+
+} // namespace string_kernels
+} // namespace etl
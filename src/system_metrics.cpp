@@ -659,6 +659,49 @@ void JobMetricsCollector::updateLoop() {
   }
 }
 
+void JobMetricsCollector::recordStageBatch(PipelineStage stage, size_t records,
+                                           std::chrono::nanoseconds busyTime) {
+  auto &counters = stages_[static_cast<size_t>(stage)];
+  counters.batches.fetch_add(1, std::memory_order_relaxed);
+  counters.records.fetch_add(records, std::memory_order_relaxed);
+  counters.busyNs.fetch_add(busyTime.count(), std::memory_order_relaxed);
+}
+
+void JobMetricsCollector::recordStageBlocked(
+    PipelineStage stage, std::chrono::nanoseconds blockedTime) {
+  stages_[static_cast<size_t>(stage)].blockedNs.fetch_add(
+      blockedTime.count(), std::memory_order_relaxed);
+}
+
+JobMetricsCollector::StageMetrics
+JobMetricsCollector::getStageMetrics(PipelineStage stage) const {
+  const auto &counters = stages_[static_cast<size_t>(stage)];
+  StageMetrics metrics;
+  metrics.batches = counters.batches.load(std::memory_order_relaxed);
+  metrics.records = counters.records.load(std::memory_order_relaxed);
+  auto busy = std::chrono::nanoseconds(
+      counters.busyNs.load(std::memory_order_relaxed));
+  metrics.busyTime =
+      std::chrono::duration_cast<std::chrono::milliseconds>(busy);
+  metrics.blockedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::nanoseconds(
+          counters.blockedNs.load(std::memory_order_relaxed)));
+  if (busy.count() > 0) {
+    metrics.recordsPerSecond =
+        static_cast<double>(metrics.records) / (busy.count() / 1e9);
+  }
+  return metrics;
+}
+
+void JobMetricsCollector::requestCancellation() {
+  cancellationRequested_.store(true);
+  ETL_LOG_INFO("Cancellation requested for job: " + jobId_);
+}
+
+bool JobMetricsCollector::isCancellationRequested() const {
+  return cancellationRequested_.load();
+}
+
 std::chrono::milliseconds JobMetricsCollector::calculateExecutionTime() const {
   if (!collecting_.load()) {
     return std::chrono::milliseconds(0);
@@ -28,6 +28,7 @@ WebSocketConnection::WebSocketConnection(
   // Initialize heartbeat timer
   auto executor = ws_.get_executor();
   heartbeatTimer_ = std::make_unique<boost::asio::steady_timer>(executor);
+  flushTimer_ = std::make_unique<boost::asio::steady_timer>(executor);
 
   WS_LOG_DEBUG("WebSocket connection created with ID: " + connectionId_);
 }
@@ -50,17 +51,28 @@ void WebSocketConnection::start() {
         res.set(beast::http::field::server, "ETL Plus WebSocket Server");
       }));
 
+  // Offer permessage-deflate; it is used only if the client asks for it
+  if (getWriteBatchingConfig().enableCompression) {
+    websocket::permessage_deflate deflate;
+    deflate.server_enable = true;
+    ws_.set_option(deflate);
+  }
+
   // Accept the websocket handshake
   ws_.async_accept(beast::bind_front_handler(&WebSocketConnection::onAccept,
                                              shared_from_this()));
 }
 
 void WebSocketConnection::send(const std::string &message) {
+  send(makeSharedMessage(message));
+}
+
+void WebSocketConnection::send(SharedMessage message, uint64_t supersedeKey) {
   if (!isOpen_.load()) {
     // Queue message for retry if recovery is enabled
     if (recoveryConfig_.enableAutoReconnect &&
         recoveryState_.isRecovering.load()) {
-      recoveryState_.addPendingMessage(message, recoveryConfig_);
+      recoveryState_.addPendingMessage(*message, recoveryConfig_);
       WS_LOG_DEBUG("Message queued for retry on connection: " + connectionId_);
     } else {
       WS_LOG_WARN("Attempted to send message to closed connection: " +
@@ -76,25 +88,48 @@ void WebSocketConnection::send(const std::string &message) {
     return;
   }
 
-  net::post(ws_.get_executor(), [self = shared_from_this(), message]() {
-    std::scoped_lock lock(self->queueMutex_);
-
-    // Check queue size limit
-    if (self->messageQueue_.size() >=
-        static_cast<size_t>(self->recoveryConfig_.messageQueueMaxSize)) {
-      WS_LOG_WARN("Message queue full for connection " + self->connectionId_ +
-                  ", dropping oldest message");
-      self->messageQueue_.pop();
+  net::post(ws_.get_executor(), [self = shared_from_this(),
+                                  message = std::move(message),
+                                  supersedeKey]() mutable {
+    {
+      std::scoped_lock lock(self->queueMutex_);
+      switch (self->outbox_.push(std::move(message), supersedeKey,
+                                 WriteBatcher::Clock::now())) {
+      case WriteBatcher::PushResult::Squashed:
+        self->writeStats_.messagesSquashed++;
+        break;
+      case WriteBatcher::PushResult::DroppedOldest:
+        self->writeStats_.messagesDropped++;
+        WS_LOG_WARN("Message queue full for connection " +
+                    self->connectionId_ + ", dropping oldest message");
+        break;
+      case WriteBatcher::PushResult::Queued:
+        break;
+      }
     }
 
-    self->messageQueue_.push(message);
-
     if (!self->isWriting_.load()) {
       self->doWrite();
     }
   });
 }
 
+void WebSocketConnection::setWriteBatchingConfig(
+    const WriteBatchingConfig &config) {
+  std::scoped_lock lock(queueMutex_);
+  outbox_.setConfig(config);
+}
+
+WriteBatchingConfig WebSocketConnection::getWriteBatchingConfig() const {
+  std::scoped_lock lock(queueMutex_);
+  return outbox_.getConfig();
+}
+
+WebSocketWriteStats WebSocketConnection::getWriteStats() const {
+  std::scoped_lock lock(queueMutex_);
+  return writeStats_;
+}
+
 void WebSocketConnection::close() {
   if (!isOpen_.load()) {
     return;
@@ -175,37 +210,84 @@ void WebSocketConnection::doWrite() {
     return;
   }
 
-  std::lock_guard<std::mutex> lock(queueMutex_);
-  if (messageQueue_.empty()) {
-    isWriting_.store(false);
-    return;
-  }
+  {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    if (isWriting_.load() || outbox_.empty()) {
+      return;
+    }
 
-  isWriting_.store(true);
-  std::string message = messageQueue_.front();
-  messageQueue_.pop();
+    // With batching on, an idle connection waits briefly for more messages
+    // to share the frame
+    if (!outbox_.readyToFlush(WriteBatcher::Clock::now())) {
+      scheduleFlush(outbox_.flushDeadline());
+      return;
+    }
 
-  // Release the lock before async operation
-  lock.~lock_guard();
+    isWriting_.store(true);
+    outbox_.takeBatch(inFlight_);
+  }
 
-  ws_.async_write(net::buffer(message),
+  startWrite();
+}
+
+void WebSocketConnection::startWrite() {
+  // The shared payloads are written in place; inFlight_ keeps them alive
+  ws_.async_write(inFlight_.buffers(),
                   beast::bind_front_handler(&WebSocketConnection::onWrite,
                                             shared_from_this()));
 }
 
+void WebSocketConnection::scheduleFlush(
+    WriteBatcher::Clock::time_point deadline) {
+  // Called with queueMutex_ held
+  if (flushTimerArmed_) {
+    return;
+  }
+  flushTimerArmed_ = true;
+
+  flushTimer_->expires_at(deadline);
+  flushTimer_->async_wait([self = shared_from_this()](beast::error_code ec) {
+    {
+      std::lock_guard<std::mutex> lock(self->queueMutex_);
+      self->flushTimerArmed_ = false;
+    }
+    if (ec != net::error::operation_aborted) {
+      self->doWrite();
+    }
+  });
+}
+
 void WebSocketConnection::onWrite(beast::error_code ec,
                                   std::size_t bytes_transferred) {
   boost::ignore_unused(bytes_transferred);
 
   if (ec) {
+    {
+      std::lock_guard<std::mutex> lock(queueMutex_);
+      inFlight_.clear();
+    }
     handleError("write", ec);
     return;
   }
 
   circuitBreaker_.onSuccess();
 
-  // Continue writing if there are more messages
-  doWrite();
+  {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    writeStats_.framesSent++;
+    writeStats_.messagesSent += inFlight_.messageCount();
+    writeStats_.bytesSent += inFlight_.bytes();
+    inFlight_.clear();
+
+    // Whatever queued up during the write has already waited; send it now
+    if (outbox_.empty() || !isOpen_.load()) {
+      isWriting_.store(false);
+      return;
+    }
+    outbox_.takeBatch(inFlight_);
+  }
+
+  startWrite();
 }
 
 void WebSocketConnection::doClose() {
@@ -214,6 +296,9 @@ void WebSocketConnection::doClose() {
   }
 
   isOpen_.store(false);
+  if (flushTimer_) {
+    flushTimer_->cancel();
+  }
 
   ws_.async_close(websocket::close_code::normal,
                   [self = shared_from_this()](beast::error_code ec) {
@@ -237,6 +322,11 @@ void WebSocketConnection::setFilters(const ConnectionFilters &filters) {
   WS_LOG_DEBUG("Filters updated for connection: " + connectionId_);
 }
 
+ConnectionFilters WebSocketConnection::copyFilters() const {
+  std::lock_guard<std::mutex> lock(filtersMutex_);
+  return filters_;
+}
+
 bool WebSocketConnection::shouldReceiveMessage(
     MessageType type, const std::string &jobId,
     const std::string &logLevel) const {
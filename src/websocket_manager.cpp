@@ -1,8 +1,38 @@
 #include "websocket_manager.hpp"
+#include "config_manager.hpp"
 #include "lock_utils.hpp"
 #include "logger.hpp"
 #include <algorithm>
 
+WebSocketManagerConfig
+WebSocketManagerConfig::fromConfig(const ConfigManager &config) {
+  const std::string prefix = "monitoring.websocket.write_batching.";
+  WebSocketManagerConfig managerConfig;
+  WriteBatchingConfig &batching = managerConfig.writeBatchingConfig;
+
+  batching.enableBatching = config.getBool(prefix + "enabled", false);
+  batching.framing = config.getString(prefix + "framing", "json_array") ==
+                             "newline_delimited"
+                         ? BatchFraming::NewlineDelimited
+                         : BatchFraming::JsonArray;
+  batching.maxBatchBytes = static_cast<size_t>(
+      config.getInt(prefix + "max_batch_bytes", 64 * 1024));
+  batching.maxBatchMessages =
+      static_cast<size_t>(config.getInt(prefix + "max_batch_messages", 256));
+  batching.maxBatchDelay = std::chrono::milliseconds(
+      config.getInt(prefix + "max_batch_delay_ms", 5));
+  batching.enableCompression = config.getBool(prefix + "compression", false);
+  batching.maxQueuedMessages =
+      static_cast<size_t>(config.getInt(prefix + "max_queued_messages", 1000));
+  batching.slowConsumerPolicy =
+      config.getString(prefix + "slow_consumer_policy", "drop_oldest") ==
+              "squash_superseded"
+          ? SlowConsumerPolicy::SquashSuperseded
+          : SlowConsumerPolicy::DropOldest;
+
+  return managerConfig;
+}
+
 WebSocketManager::WebSocketManager()
     : WebSocketManager(WebSocketManagerConfig{}) {}
 
@@ -93,6 +123,7 @@ void WebSocketManager::handleUpgrade(tcp::socket socket) {
   // Create new WebSocket connection
   auto connection = std::make_shared<WebSocketConnection>(
       std::move(socket), std::weak_ptr<WebSocketManager>(shared_from_this()));
+  connection->setWriteBatchingConfig(config_.writeBatchingConfig);
 
   // Start the connection (this will trigger the handshake)
   connection->start();
@@ -110,8 +141,9 @@ void WebSocketManager::addConnection(
     return;
   }
 
-  // Delegate to connection pool
+  // Delegate to connection pool, then make it routable
   connectionPool_->addConnection(connection);
+  messageBroadcaster_->registerConnection(connection);
 }
 
 void WebSocketManager::removeConnection(const std::string &connectionId) {
@@ -120,6 +152,7 @@ void WebSocketManager::removeConnection(const std::string &connectionId) {
   }
 
   // Delegate to connection pool
+  messageBroadcaster_->unregisterConnection(connectionId);
   connectionPool_->removeConnection(connectionId);
 }
 
@@ -0,0 +1,142 @@
+#include "websocket_write_batcher.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr std::string_view kArrayOpen = "[";
+constexpr std::string_view kArraySeparator = ",";
+constexpr std::string_view kArrayClose = "]";
+constexpr std::string_view kLineSeparator = "\n";
+
+} // namespace
+
+uint64_t supersedeKeyFor(MessageType type, std::string_view jobId) {
+  if (jobId.empty() || (type != MessageType::JOB_PROGRESS_UPDATE &&
+                        type != MessageType::JOB_METRICS_UPDATE)) {
+    return 0;
+  }
+
+  // FNV-1a over the type and job id
+  uint64_t hash = 14695981039346656037ULL;
+  hash = (hash ^ static_cast<uint64_t>(type)) * 1099511628211ULL;
+  for (unsigned char c : jobId) {
+    hash = (hash ^ c) * 1099511628211ULL;
+  }
+  return hash != 0 ? hash : 1;
+}
+
+void WriteBatch::clear() {
+  messages_.clear();
+  buffers_.clear();
+  bytes_ = 0;
+}
+
+void WriteBatch::append(std::string_view bytes) {
+  buffers_.emplace_back(bytes.data(), bytes.size());
+  bytes_ += bytes.size();
+}
+
+WriteBatcher::WriteBatcher(const WriteBatchingConfig &config)
+    : config_(config) {}
+
+WriteBatcher::PushResult WriteBatcher::push(SharedMessage message,
+                                            uint64_t supersedeKey,
+                                            Clock::time_point now) {
+  const bool squash =
+      supersedeKey != 0 &&
+      config_.slowConsumerPolicy == SlowConsumerPolicy::SquashSuperseded;
+
+  if (squash) {
+    auto it = latestByKey_.find(supersedeKey);
+    if (it != latestByKey_.end()) {
+      // Keep the queue position and age of the update being replaced, so
+      // a steady stream of updates cannot starve it
+      Pending &queued = queue_[it->second - frontSequence_];
+      queuedBytes_ += message->size() - queued.message->size();
+      queued.message = std::move(message);
+      return PushResult::Squashed;
+    }
+  }
+
+  PushResult result = PushResult::Queued;
+  if (queue_.size() >= std::max<size_t>(config_.maxQueuedMessages, 1)) {
+    popFront();
+    result = PushResult::DroppedOldest;
+  }
+
+  queuedBytes_ += message->size();
+  queue_.push_back({std::move(message), squash ? supersedeKey : 0, now});
+  if (squash) {
+    latestByKey_[supersedeKey] = frontSequence_ + queue_.size() - 1;
+  }
+  return result;
+}
+
+bool WriteBatcher::readyToFlush(Clock::time_point now) const {
+  if (queue_.empty()) {
+    return false;
+  }
+  return !config_.enableBatching || queue_.size() >= config_.maxBatchMessages ||
+         queuedBytes_ >= config_.maxBatchBytes || now >= flushDeadline();
+}
+
+WriteBatcher::Clock::time_point WriteBatcher::flushDeadline() const {
+  return queue_.empty() ? Clock::time_point::max()
+                        : queue_.front().enqueued + config_.maxBatchDelay;
+}
+
+void WriteBatcher::takeBatch(WriteBatch &batch) {
+  batch.clear();
+  if (queue_.empty()) {
+    return;
+  }
+
+  // Count what fits in the budget; the first message always goes, even if
+  // it is larger than the budget on its own
+  size_t count = 1;
+  if (config_.enableBatching) {
+    const size_t overhead = 1; // separator or closing bracket per message
+    size_t bytes = kArrayOpen.size() + queue_[0].message->size() + overhead;
+    while (count < queue_.size() && count < config_.maxBatchMessages) {
+      size_t next = queue_[count].message->size() + overhead;
+      if (bytes + next > config_.maxBatchBytes) {
+        break;
+      }
+      bytes += next;
+      ++count;
+    }
+  }
+
+  const bool array = count > 1 && config_.framing == BatchFraming::JsonArray;
+  const std::string_view separator =
+      config_.framing == BatchFraming::JsonArray ? kArraySeparator
+                                                 : kLineSeparator;
+  if (array) {
+    batch.append(kArrayOpen);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (i > 0) {
+      batch.append(separator);
+    }
+    const SharedMessage &message = queue_.front().message;
+    batch.append(*message);
+    batch.messages_.push_back(message);
+    popFront();
+  }
+  if (array) {
+    batch.append(kArrayClose);
+  }
+}
+
+void WriteBatcher::popFront() {
+  const Pending &front = queue_.front();
+  if (front.supersedeKey != 0) {
+    auto it = latestByKey_.find(front.supersedeKey);
+    if (it != latestByKey_.end() && it->second == frontSequence_) {
+      latestByKey_.erase(it);
+    }
+  }
+  queuedBytes_ -= front.message->size();
+  queue_.pop_front();
+  ++frontSequence_;
+}
@@ -0,0 +1,168 @@
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace {
+// Identifies the pool and queue owned by the current worker thread, if any
+thread_local const WorkStealingPool *tlsPool = nullptr;
+thread_local size_t tlsQueueIndex = 0;
+} // namespace
+
+WorkStealingPool::WorkStealingPool(size_t workerCount) {
+  if (workerCount == 0) {
+    workerCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+
+  queues_.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+
+  workers_.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; ++i) {
+    workers_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    stopping_ = true;
+  }
+  sleepCondition_.notify_all();
+
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void WorkStealingPool::submit(Task task) {
+  size_t index = tlsPool == this
+                     ? tlsQueueIndex
+                     : nextQueue_.fetch_add(1, std::memory_order_relaxed) %
+                           queues_.size();
+
+  pendingTasks_.fetch_add(1, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+
+  // Taking the sleep mutex orders this wakeup after a worker's predicate
+  // check, so the notification cannot be lost.
+  { std::lock_guard<std::mutex> lock(sleepMutex_); }
+  sleepCondition_.notify_one();
+}
+
+void WorkStealingPool::parallelFor(size_t count,
+                                   const std::function<void(size_t)> &body) {
+  if (count == 0) {
+    return;
+  }
+  if (count == 1) {
+    body(0);
+    return;
+  }
+
+  struct ForState {
+    std::atomic<size_t> remaining;
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+  };
+  auto state = std::make_shared<ForState>();
+  state->remaining.store(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    submit([state, &body, i]() {
+      try {
+        body(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!state->error) {
+          state->error = std::current_exception();
+        }
+      }
+      if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->done.notify_all();
+      }
+    });
+  }
+
+  // Help out instead of idling; once nothing is queued, the remaining tasks
+  // are all running on workers and we only need to wait for them.
+  size_t preferred = tlsPool == this ? tlsQueueIndex : 0;
+  while (state->remaining.load(std::memory_order_acquire) > 0) {
+    if (!tryRunOne(preferred)) {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      state->done.wait(lock, [&state] {
+        return state->remaining.load(std::memory_order_acquire) == 0;
+      });
+    }
+  }
+
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
+
+void WorkStealingPool::workerLoop(size_t index) {
+  tlsPool = this;
+  tlsQueueIndex = index;
+
+  while (true) {
+    if (tryRunOne(index)) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    if (stopping_ && pendingTasks_.load(std::memory_order_acquire) == 0) {
+      break;
+    }
+    sleepCondition_.wait(lock, [this] {
+      return stopping_ || pendingTasks_.load(std::memory_order_acquire) > 0;
+    });
+  }
+
+  tlsPool = nullptr;
+}
+
+bool WorkStealingPool::tryRunOne(size_t preferredQueue) {
+  Task task;
+  if (!popLocal(preferredQueue, task) && !steal(preferredQueue, task)) {
+    return false;
+  }
+  pendingTasks_.fetch_sub(1, std::memory_order_acq_rel);
+  task();
+  return true;
+}
+
+bool WorkStealingPool::popLocal(size_t index, Task &task) {
+  auto &queue = *queues_[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) {
+    return false;
+  }
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool WorkStealingPool::steal(size_t thiefIndex, Task &task) {
+  const size_t n = queues_.size();
+  for (size_t offset = 1; offset < n; ++offset) {
+    auto &victim = *queues_[(thiefIndex + offset) % n];
+    std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+    if (!lock.owns_lock() || victim.tasks.empty()) {
+      continue;
+    }
+    task = std::move(victim.tasks.front());
+    victim.tasks.pop_front();
+    stolenTasks_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,221 @@
+#include "data_transformer.hpp"
+#include "performance_benchmark.hpp"
+#include "record_batch.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+// DataTransformer performance benchmark
+class DataTransformerBenchmark : public BenchmarkBase {
+public:
+  DataTransformerBenchmark() : BenchmarkBase("Data Transformer") {}
+
+  void run() override {
+    buildInput();
+    buildRules();
+    benchmarkInterpretedRules();
+    benchmarkCompiledPlan();
+    benchmarkColumnarBatch();
+    benchmarkParallelScaling();
+  }
+
+private:
+  static constexpr size_t kNumRecords = 200000;
+
+  std::vector<DataRecord> input_;
+  std::vector<TransformationRule> rules_;
+  double interpretedRowsPerSec_ = 0.0;
+  double sequentialRowsPerSec_ = 0.0;
+
+  void buildInput() {
+    input_.clear();
+    input_.reserve(kNumRecords);
+    for (size_t i = 0; i < kNumRecords; ++i) {
+      DataRecord record;
+      record.fields["name"] = "  Customer " + std::to_string(i) + "  ";
+      record.fields["email"] = "User" + std::to_string(i) + "@Example.COM";
+      record.fields["amount"] = std::to_string(i % 1000) + ".25";
+      record.fields["quantity"] = std::to_string(i % 17);
+      input_.push_back(std::move(record));
+    }
+  }
+
+  void buildRules() {
+    rules_.clear();
+    rules_.push_back({"name", "name", "trim", {}});
+    rules_.push_back({"email", "email", "lowercase", {}});
+    rules_.push_back(
+        {"amount", "amount_eur", "multiply", {{"factor", "0.92"}}});
+    rules_.push_back({"quantity", "quantity", "add", {{"addend", "1"}}});
+  }
+
+  // Reference copy of the pre-plan DataTransformer: operator names are
+  // compared and numeric parameters re-parsed for every value.
+  static std::string interpretValue(const std::string &value,
+                                    const TransformationRule &rule) {
+    if (rule.transformationType == "uppercase") {
+      std::string result = value;
+      std::transform(result.begin(), result.end(), result.begin(), ::toupper);
+      return result;
+    } else if (rule.transformationType == "lowercase") {
+      std::string result = value;
+      std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+      return result;
+    } else if (rule.transformationType == "trim") {
+      auto start = value.find_first_not_of(" \t\n\r");
+      if (start == std::string::npos)
+        return std::string{};
+      auto end = value.find_last_not_of(" \t\n\r");
+      return value.substr(start, end - start + 1);
+    } else if (rule.transformationType == "multiply" ||
+               rule.transformationType == "add") {
+      try {
+        double numValue = std::stod(value);
+        bool multiply = rule.transformationType == "multiply";
+        auto it = rule.parameters.find(multiply ? "factor" : "addend");
+        if (it != rule.parameters.end()) {
+          double operand = std::stod(it->second);
+          return formatNumericValue(multiply ? numValue * operand
+                                             : numValue + operand);
+        }
+      } catch (const std::exception &) {
+        return value;
+      }
+    }
+    return value;
+  }
+
+  std::vector<DataRecord> interpretedTransform() const {
+    std::vector<DataRecord> result;
+    result.reserve(input_.size());
+    for (const auto &record : input_) {
+      DataRecord out = record;
+      for (const auto &rule : rules_) {
+        auto it = out.fields.find(rule.sourceField);
+        if (it != out.fields.end()) {
+          out.fields[rule.targetField] = interpretValue(it->second, rule);
+        }
+      }
+      result.push_back(std::move(out));
+    }
+    return result;
+  }
+
+  DataTransformer makeTransformer() const {
+    DataTransformer transformer;
+    for (const auto &rule : rules_) {
+      transformer.addTransformationRule(rule);
+    }
+    return transformer;
+  }
+
+  std::string speedupNote(std::chrono::microseconds elapsed) const {
+    double rowsPerSec =
+        elapsed.count() > 0 ? kNumRecords * 1e6 / elapsed.count() : 0.0;
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(0) << rowsPerSec << " rows/sec";
+    if (interpretedRowsPerSec_ > 0.0) {
+      oss << ", " << std::setprecision(2)
+          << rowsPerSec / interpretedRowsPerSec_ << "x vs interpreted";
+    }
+    return oss.str();
+  }
+
+  void benchmarkInterpretedRules() {
+    std::cout << "Running interpreted rule benchmark (baseline)...\n";
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto output = interpretedTransform();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    interpretedRowsPerSec_ =
+        elapsed.count() > 0 ? kNumRecords * 1e6 / elapsed.count() : 0.0;
+
+    addResult(createResult(
+        "Interpreted Rules", output.size(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed),
+        speedupNote(elapsed)));
+  }
+
+  void benchmarkCompiledPlan() {
+    std::cout << "Running compiled plan benchmark...\n";
+
+    auto transformer = makeTransformer();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto output = transformer.transform(input_);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    sequentialRowsPerSec_ =
+        elapsed.count() > 0 ? kNumRecords * 1e6 / elapsed.count() : 0.0;
+    addResult(createResult(
+        "Compiled Plan", output.size(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed),
+        speedupNote(elapsed)));
+  }
+
+  void benchmarkColumnarBatch() {
+    std::cout << "Running columnar batch benchmark...\n";
+
+    auto transformer = makeTransformer();
+    auto batch = RecordBatch::fromRecords(input_);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto output = transformer.transformBatch(batch);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    addResult(createResult(
+        "Columnar Batch", output.numRows(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed),
+        speedupNote(elapsed)));
+  }
+
+  void benchmarkParallelScaling() {
+    std::cout << "Running parallel transform scaling benchmark...\n";
+
+    const size_t hardwareThreads =
+        std::max<size_t>(1, std::thread::hardware_concurrency());
+    std::vector<size_t> workerCounts;
+    for (size_t workers = 2; workers < hardwareThreads; workers *= 2) {
+      workerCounts.push_back(workers);
+    }
+    workerCounts.push_back(hardwareThreads);
+
+    for (size_t workers : workerCounts) {
+      auto transformer = makeTransformer();
+      ParallelTransformConfig config;
+      config.enabled = true;
+      config.workerCount = workers;
+      transformer.setParallelConfig(config);
+
+      auto start = std::chrono::high_resolution_clock::now();
+      auto output = transformer.transform(input_);
+      auto end = std::chrono::high_resolution_clock::now();
+
+      auto elapsed =
+          std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+      double rowsPerSec =
+          elapsed.count() > 0 ? kNumRecords * 1e6 / elapsed.count() : 0.0;
+      std::ostringstream notes;
+      notes << speedupNote(elapsed);
+      if (sequentialRowsPerSec_ > 0.0) {
+        double speedup = rowsPerSec / sequentialRowsPerSec_;
+        notes << ", " << std::fixed << std::setprecision(2) << speedup
+              << "x vs sequential (" << std::setprecision(0)
+              << speedup / workers * 100.0 << "% efficiency)";
+      }
+
+      addResult(createResult(
+          "Parallel " + std::to_string(workers) + " Workers", output.size(),
+          std::chrono::duration_cast<std::chrono::milliseconds>(elapsed),
+          notes.str()));
+    }
+  }
+};
@@ -0,0 +1,231 @@
+#include "log_search_engine.hpp"
+#include "performance_benchmark.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Scans a synthetic log corpus with the old text-only search loop, with a
+// getline reader using the new matcher, and with LogSearchEngine. The corpus size in MB comes from
+// ETL_LOG_SEARCH_BENCH_MB (default 2048).
+class LogSearchBenchmark : public BenchmarkBase {
+public:
+  LogSearchBenchmark() : BenchmarkBase("Log Search") {}
+
+  void run() override {
+    dir_ = std::filesystem::temp_directory_path() / "etl_log_search_bench";
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+    buildCorpus(corpusBytes());
+
+    const size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    for (const auto &query : queries()) {
+      if (query.params.searchText) {
+        benchmarkOldLoop(query);
+      }
+      benchmarkLineReader(query);
+      benchmarkEngine(query, 1);
+      benchmarkEngine(query, threads);
+    }
+
+    std::filesystem::remove_all(dir_);
+  }
+
+private:
+  static constexpr int kJobs = 16;
+  static constexpr size_t kErrorEvery = 1000;
+  static constexpr size_t kNeedleEvery = 250000;
+  static constexpr size_t kFiles = 4;
+
+  struct Query {
+    std::string name;
+    LogQueryParams params;
+  };
+
+  std::filesystem::path dir_;
+  std::vector<std::string> files_;
+  size_t totalBytes_ = 0;
+  size_t totalLines_ = 0;
+  std::time_t start_ = 0;
+
+  static size_t corpusBytes() {
+    size_t megabytes = 2048;
+    if (const char *env = std::getenv("ETL_LOG_SEARCH_BENCH_MB")) {
+      megabytes = std::max(1L, std::atol(env));
+    }
+    return megabytes * 1024 * 1024;
+  }
+
+  // Logger text layout, ten lines per second spread over kFiles rotated
+  // files; every kErrorEvery-th line is an ERROR and every kNeedleEvery-th
+  // carries a rare phrase
+  void buildCorpus(size_t bytes) {
+    std::tm tm{};
+    tm.tm_year = 2024 - 1900;
+    tm.tm_mon = 5;
+    tm.tm_mday = 1;
+    tm.tm_isdst = -1;
+    start_ = std::mktime(&tm);
+
+    files_.clear();
+    totalBytes_ = 0;
+    totalLines_ = 0;
+    const size_t perFile = bytes / kFiles;
+    std::string buffer;
+    char stamp[32] = {};
+    std::time_t stampFor = -1;
+    char line[256];
+
+    for (size_t f = 0; f < kFiles; ++f) {
+      const std::string path =
+          (dir_ / ("etl." + std::to_string(f) + ".log")).string();
+      std::ofstream out(path, std::ios::binary);
+      size_t written = 0;
+      while (written < perFile) {
+        const size_t i = totalLines_++;
+        const std::time_t second = start_ + static_cast<std::time_t>(i / 10);
+        if (second != stampFor) {
+          std::tm local{};
+          localtime_r(&second, &local);
+          std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+          stampFor = second;
+        }
+        const bool error = i % kErrorEvery == kErrorEvery - 1;
+        const char *message = i % kNeedleEvery == kNeedleEvery - 1
+                                  ? "deadlock detected on staging table"
+                                  : "processed batch";
+        const int length = std::snprintf(
+            line, sizeof(line),
+            "[%s.%03zu] [%s] [%s] [Job: job-%zu] %s %zu rows=%zu\n", stamp,
+            (i % 10) * 100, error ? "ERROR" : "INFO ",
+            error ? "Loader" : "Transformer", i % kJobs, message, i,
+            i % 5000);
+        buffer.append(line, static_cast<size_t>(length));
+        written += static_cast<size_t>(length);
+        if (buffer.size() >= (4u << 20)) {
+          out.write(buffer.data(),
+                    static_cast<std::streamsize>(buffer.size()));
+          buffer.clear();
+        }
+      }
+      out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      buffer.clear();
+      files_.push_back(path);
+      totalBytes_ += written;
+    }
+  }
+
+  std::vector<Query> queries() const {
+    std::vector<Query> result;
+
+    Query text{"Rare Text", {}};
+    text.params.searchText = "deadlock detected";
+    result.push_back(text);
+
+    // One job over the middle tenth of the corpus
+    Query job{"Job + Time Range", {}};
+    const auto seconds = static_cast<std::time_t>(totalLines_ / 10);
+    job.params.jobId = "job-7";
+    job.params.startTime =
+        std::chrono::system_clock::from_time_t(start_ + seconds * 45 / 100);
+    job.params.endTime =
+        std::chrono::system_clock::from_time_t(start_ + seconds * 55 / 100);
+    result.push_back(job);
+
+    Query level{"Errors", {}};
+    level.params.minLevel = LogLevel::ERROR;
+    result.push_back(level);
+    return result;
+  }
+
+  std::string throughput(size_t matches,
+                         std::chrono::milliseconds elapsed) const {
+    const double seconds = elapsed.count() / 1e3;
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2)
+        << (seconds > 0 ? totalBytes_ / seconds / 1e9 : 0.0) << " GB/s over "
+        << totalBytes_ / (1024 * 1024) << " MB, " << matches << " returned";
+    return oss.str();
+  }
+
+  // The old searchLogEntries loop: substring search only, every other
+  // filter ignored, stopping once maxResults lines are kept
+  void benchmarkOldLoop(const Query &query) {
+    const LogQueryParams &params = query.params;
+    std::vector<HistoricalLogEntry> results;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto &path : files_) {
+      std::ifstream in(path);
+      std::string line;
+      size_t lineNumber = 1;
+      while (std::getline(in, line) && results.size() < params.maxResults) {
+        if (line.find(*params.searchText) != std::string::npos) {
+          HistoricalLogEntry entry;
+          entry.timestamp = std::chrono::system_clock::now();
+          entry.level = LogLevel::INFO;
+          entry.message = line;
+          entry.filename = std::filesystem::path(path).filename().string();
+          entry.lineNumber = lineNumber;
+          results.push_back(entry);
+        }
+        lineNumber++;
+      }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+    addResult(createResult(query.name + " (Old Loop)", totalLines_, elapsed,
+                           throughput(results.size(), elapsed)));
+  }
+
+  // getline with the engine's matcher and result window: parse, filter, keep
+  void benchmarkLineReader(const Query &query) {
+    LogQueryMatcher matcher(query.params);
+    LogResultWindow window(query.params);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t rank = 0; rank < files_.size(); ++rank) {
+      std::ifstream in(files_[rank]);
+      std::string line;
+      uint64_t lineNumber = 0;
+      while (std::getline(in, line)) {
+        ++lineNumber;
+        auto parsed = parseLogLine(line);
+        if (!matcher.matches(parsed, line)) {
+          continue;
+        }
+        HistoricalLogEntry entry;
+        entry.message = line;
+        entry.lineNumber = lineNumber;
+        if (parsed) {
+          entry.timestamp = std::chrono::system_clock::time_point(
+              std::chrono::milliseconds(parsed->timestampMs));
+          entry.level = parsed->level;
+        }
+        window.add(std::move(entry), rank, lineNumber);
+      }
+    }
+    const size_t matches = window.takePage().size();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+    addResult(createResult(query.name + " (Getline + Matcher)", totalLines_,
+                           elapsed, throughput(matches, elapsed)));
+  }
+
+  void benchmarkEngine(const Query &query, size_t threads) {
+    LogSearchEngine engine(threads);
+    auto start = std::chrono::high_resolution_clock::now();
+    const size_t matches = engine.search(files_, query.params).size();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+    addResult(createResult(query.name + " (mmap Engine, " +
+                               std::to_string(threads) + " threads)",
+                           totalLines_, elapsed,
+                           throughput(matches, elapsed)));
+  }
+};
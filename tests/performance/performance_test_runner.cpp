@@ -13,6 +13,11 @@ class ConnectionPoolBenchmark;
 class WebSocketBenchmark;
 class MemoryBenchmark;
 class LoadTestBenchmark;
+class DataTransformerBenchmark;
+class StringKernelBenchmark;
+class RouterBenchmark;
+class RateLimiterBenchmark;
+class LogSearchBenchmark;
 
 // Performance test runner
 class PerformanceTestRunner {
@@ -29,6 +34,11 @@ public:
     benchmarks.emplace_back(std::make_unique<WebSocketBenchmark>());
     benchmarks.emplace_back(std::make_unique<MemoryBenchmark>());
     benchmarks.emplace_back(std::make_unique<LoadTestBenchmark>());
+    benchmarks.emplace_back(std::make_unique<DataTransformerBenchmark>());
+    benchmarks.emplace_back(std::make_unique<StringKernelBenchmark>());
+    benchmarks.emplace_back(std::make_unique<RouterBenchmark>());
+    benchmarks.emplace_back(std::make_unique<RateLimiterBenchmark>());
+    benchmarks.emplace_back(std::make_unique<LogSearchBenchmark>());
 
     // Run all benchmarks
     for (auto &benchmark : benchmarks) {
@@ -136,11 +146,12 @@ private:
 
     // Define performance thresholds (these would be configurable)
     const std::map<std::string, double> thresholds = {
-        {"Logger", 10000.0},         // 10k ops/sec minimum
-        {"Connection Pool", 5000.0}, // 5k ops/sec minimum
-        {"WebSocket", 2000.0},       // 2k ops/sec minimum
-        {"Memory", 100000.0},        // 100k ops/sec minimum
-        {"Load Test", 1000.0}        // 1k ops/sec minimum
+        {"Logger", 10000.0},            // 10k ops/sec minimum
+        {"Connection Pool", 5000.0},    // 5k ops/sec minimum
+        {"WebSocket", 2000.0},          // 2k ops/sec minimum
+        {"Memory", 100000.0},           // 100k ops/sec minimum
+        {"Load Test", 1000.0},          // 1k ops/sec minimum
+        {"Data Transformer", 100000.0}, // 100k rows/sec minimum
     };
 
     std::map<std::string, std::vector<double>> categoryThroughputs;
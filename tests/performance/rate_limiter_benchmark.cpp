@@ -0,0 +1,117 @@
+#include "performance_benchmark.hpp"
+#include "rate_limiter.hpp"
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Contention on the request rate limiter: the sharded atomic buckets in
+// RateLimiter against a reference copy of the old single-mutex limiter
+class RateLimiterBenchmark : public BenchmarkBase {
+public:
+  RateLimiterBenchmark() : BenchmarkBase("Rate Limiter") {}
+
+  void run() override {
+    size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+      benchmarkLegacy(threads);
+      benchmarkSharded(threads);
+    }
+  }
+
+private:
+  static constexpr size_t kRequestsPerThread = 200000;
+  static constexpr size_t kClientsPerThread = 256;
+  static constexpr const char *kEndpoint = "/api/bench/items/42";
+
+  // The old implementation: one mutex, per-window string keys in nested
+  // maps that grow until cleanupExpiredEntries() runs
+  class LegacyRateLimiter {
+  public:
+    bool isAllowed(const std::string &clientId, const std::string &endpoint) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto now = std::chrono::system_clock::now().time_since_epoch();
+      auto minute = std::chrono::duration_cast<std::chrono::minutes>(now);
+      auto hour = std::chrono::duration_cast<std::chrono::hours>(now);
+
+      auto &data = clientData_[clientId];
+      std::string minuteKey =
+          endpoint + "_min_" + std::to_string(minute.count());
+      if (data.minuteCounters[minuteKey] >= kLimit) {
+        return false;
+      }
+      std::string hourKey = endpoint + "_hour_" + std::to_string(hour.count());
+      if (data.hourCounters[hourKey] >= kLimit) {
+        return false;
+      }
+      data.minuteCounters[minuteKey]++;
+      data.hourCounters[hourKey]++;
+      return true;
+    }
+
+  private:
+    static constexpr int kLimit = 1000000000;
+
+    struct ClientData {
+      std::unordered_map<std::string, int> minuteCounters;
+      std::unordered_map<std::string, int> hourCounters;
+    };
+    std::unordered_map<std::string, ClientData> clientData_;
+    std::mutex mutex_;
+  };
+
+  static std::vector<std::string> clientIds(size_t thread) {
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < kClientsPerThread; ++i) {
+      ids.push_back("10.0." + std::to_string(thread) + "." +
+                    std::to_string(i));
+    }
+    return ids;
+  }
+
+  template <class Limiter>
+  void measure(const std::string &name, size_t threadCount,
+               Limiter &limiter) {
+    std::cout << "Running " << name << " benchmark with " << threadCount
+              << " threads...\n";
+
+    std::atomic<size_t> allowed{0};
+    std::vector<std::thread> threads;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t t = 0; t < threadCount; ++t) {
+      threads.emplace_back([&, t] {
+        const auto ids = clientIds(t);
+        const std::string endpoint = kEndpoint;
+        size_t local = 0;
+        for (size_t i = 0; i < kRequestsPerThread; ++i) {
+          local += limiter.isAllowed(ids[i % ids.size()], endpoint);
+        }
+        allowed += local;
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    size_t total = threadCount * kRequestsPerThread;
+    addResult(createResult(
+        name + " (" + std::to_string(threadCount) + " threads)", total,
+        std::chrono::duration_cast<std::chrono::milliseconds>(end - start),
+        std::to_string(allowed.load()) + "/" + std::to_string(total) +
+            " allowed"));
+  }
+
+  void benchmarkLegacy(size_t threads) {
+    LegacyRateLimiter limiter;
+    measure("Global Mutex", threads, limiter);
+  }
+
+  void benchmarkSharded(size_t threads) {
+    RateLimiter limiter;
+    limiter.addRule({"/api/bench", 1000000000, 2000000000});
+    measure("Atomic Buckets", threads, limiter);
+  }
+};
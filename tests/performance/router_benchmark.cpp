@@ -0,0 +1,180 @@
+#include "http_router.hpp"
+#include "input_validator.hpp"
+#include "performance_benchmark.hpp"
+#include <boost/beast/http.hpp>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Counts heap allocations made by the current thread. Replacing the global
+// operator new affects the whole benchmark binary, but only costs an
+// increment of a thread-local counter.
+namespace {
+thread_local size_t tlsAllocations = 0;
+}
+
+void *operator new(std::size_t size) {
+  ++tlsAllocations;
+  if (void *p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+// Request dispatch cost: the prefix-compare chain with header and query map
+// copies that RequestHandler used to do, against the radix route table with
+// in-place header and query lookups
+class RouterBenchmark : public BenchmarkBase {
+public:
+  RouterBenchmark() : BenchmarkBase("HTTP Router") {}
+
+  void run() override {
+    buildRequests();
+    buildRouter();
+    benchmarkLegacyDispatch();
+    benchmarkRadixDispatch();
+  }
+
+private:
+  using Request = boost::beast::http::request<boost::beast::http::string_body>;
+
+  enum class Endpoint { Auth, Logs, Jobs, JobStatus, Monitor, Health };
+
+  static constexpr size_t kIterations = 200000;
+
+  std::vector<Request> requests_;
+  RadixRouter<Endpoint> router_;
+
+  void buildRequests() {
+    const char *targets[] = {
+        "/api/jobs?limit=50&status=running",
+        "/api/jobs/job-20240101-42/status",
+        "/api/health",
+        "/api/monitor/jobs?status=failed&limit=10&from=2024-01-01",
+        "/api/auth/profile",
+        "/api/logs/search",
+    };
+    requests_.clear();
+    for (const char *target : targets) {
+      Request req{boost::beast::http::verb::get, target, 11};
+      req.set(boost::beast::http::field::host, "etl.example.com");
+      req.set(boost::beast::http::field::user_agent, "etl-bench/1.0");
+      req.set(boost::beast::http::field::accept, "application/json");
+      req.set(boost::beast::http::field::authorization,
+              "Bearer eyJhbGciOiJIUzI1NiJ9.eyJzdWIiOiJiZW5jaCJ9.c2ln");
+      req.set("X-Forwarded-For", "10.0.0.1, 10.0.0.2");
+      req.set("X-Request-Id", "4f7c0a1e-2b51-4c8e-9a3d-6f1e2d3c4b5a");
+      requests_.push_back(std::move(req));
+    }
+  }
+
+  void buildRouter() {
+    router_ = RadixRouter<Endpoint>();
+    router_.add("/api/auth/*", Endpoint::Auth);
+    router_.add("/api/logs", Endpoint::Logs);
+    router_.add("/api/logs/*", Endpoint::Logs);
+    router_.add("/api/jobs", Endpoint::Jobs);
+    router_.add("/api/jobs/*", Endpoint::Jobs);
+    router_.add("/api/jobs/:id/status", Endpoint::JobStatus);
+    router_.add("/api/monitor/*", Endpoint::Monitor);
+    router_.add("/api/health", Endpoint::Health);
+    router_.add("/api/health/*", Endpoint::Health);
+  }
+
+  static std::string_view toStringView(boost::beast::string_view sv) {
+    return {sv.data(), sv.size()};
+  }
+
+  // Mirrors the old RequestHandler: target copy, prefix chain, header map
+  // and query map copies, job id substr
+  static size_t legacyDispatch(const Request &req) {
+    std::string target(req.target());
+    std::unordered_map<std::string, std::string> headers;
+    for (const auto &field : req) {
+      headers[std::string(field.name_string())] = std::string(field.value());
+    }
+
+    Endpoint endpoint;
+    if (target.rfind("/api/auth", 0) == 0) {
+      endpoint = Endpoint::Auth;
+    } else if (target.rfind("/api/logs", 0) == 0) {
+      endpoint = Endpoint::Logs;
+    } else if (target.rfind("/api/jobs", 0) == 0) {
+      endpoint = Endpoint::Jobs;
+    } else if (target.rfind("/api/monitor", 0) == 0) {
+      endpoint = Endpoint::Monitor;
+    } else {
+      endpoint = Endpoint::Health;
+    }
+
+    size_t work = headers["Authorization"].size();
+    if (endpoint == Endpoint::Jobs && target.size() > 7 &&
+        target.substr(target.size() - 7) == "/status") {
+      std::string jobId = target.substr(10, target.size() - 17);
+      work += jobId.size();
+    }
+    if (size_t pos = target.find('?'); pos != std::string::npos) {
+      auto params =
+          InputValidator::parseQueryString(target.substr(pos + 1));
+      if (auto it = params.find("limit"); it != params.end()) {
+        work += it->second.size();
+      }
+    }
+    return work + static_cast<size_t>(endpoint);
+  }
+
+  size_t radixDispatch(const Request &req) const {
+    auto [path, query] = splitRequestTarget(toStringView(req.target()));
+    auto match = router_.match(path);
+    if (!match) {
+      return 0;
+    }
+
+    size_t work =
+        toStringView(req[boost::beast::http::field::authorization]).size();
+    if (match->value == Endpoint::JobStatus) {
+      work += match->params.get("id").size();
+    }
+    if (auto limit = QueryView(query).get("limit")) {
+      work += limit->size();
+    }
+    return work + static_cast<size_t>(match->value);
+  }
+
+  template <class Fn> void measure(const std::string &name, Fn &&dispatch) {
+    std::cout << "Running " << name << " benchmark...\n";
+
+    size_t checksum = 0;
+    size_t allocationsBefore = tlsAllocations;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < kIterations; ++i) {
+      checksum += dispatch(requests_[i % requests_.size()]);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    size_t allocations = tlsAllocations - allocationsBefore;
+
+    std::ostringstream notes;
+    notes << std::fixed << std::setprecision(1)
+          << static_cast<double>(allocations) / kIterations
+          << " allocs/request, checksum " << checksum;
+    addResult(createResult(
+        name, kIterations,
+        std::chrono::duration_cast<std::chrono::milliseconds>(end - start),
+        notes.str()));
+  }
+
+  void benchmarkLegacyDispatch() {
+    measure("Prefix Chain + Map Copies", legacyDispatch);
+  }
+
+  void benchmarkRadixDispatch() {
+    measure("Radix Router + Views",
+            [this](const Request &req) { return radixDispatch(req); });
+  }
+};
@@ -0,0 +1,104 @@
+#include "performance_benchmark.hpp"
+#include "simd_string_kernels.hpp"
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Throughput of the ASCII string kernels used by DataTransformer, in GB/s
+class StringKernelBenchmark : public BenchmarkBase {
+public:
+  StringKernelBenchmark() : BenchmarkBase("String Kernels") {}
+
+  void run() override {
+    buildBuffer();
+    for (auto level : {etl::string_kernels::SimdLevel::SCALAR,
+                       etl::string_kernels::SimdLevel::SSE2,
+                       etl::string_kernels::SimdLevel::AVX2}) {
+      if (static_cast<int>(level) >
+          static_cast<int>(etl::string_kernels::detectedSimdLevel())) {
+        continue; // Not supported on this CPU
+      }
+      benchmarkCaseMapping(level);
+      benchmarkTrim(level);
+    }
+  }
+
+private:
+  static constexpr size_t kBufferBytes = 64 * 1024 * 1024;
+  static constexpr size_t kPasses = 8;
+
+  std::string buffer_;
+  std::vector<std::string> paddedValues_;
+
+  void buildBuffer() {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> printable(32, 126);
+    buffer_.resize(kBufferBytes);
+    for (auto &c : buffer_) {
+      c = static_cast<char>(printable(rng));
+    }
+
+    paddedValues_.clear();
+    std::uniform_int_distribution<int> pad(0, 24);
+    for (size_t i = 0; i < 200000; ++i) {
+      paddedValues_.push_back(std::string(pad(rng), ' ') + "value " +
+                              std::to_string(i) + std::string(pad(rng), '\t'));
+    }
+  }
+
+  static std::string gbPerSec(size_t bytes, std::chrono::nanoseconds elapsed) {
+    double seconds = elapsed.count() / 1e9;
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2)
+        << (seconds > 0 ? bytes / seconds / 1e9 : 0.0) << " GB/s";
+    return oss.str();
+  }
+
+  void benchmarkCaseMapping(etl::string_kernels::SimdLevel level) {
+    const std::string levelName = etl::string_kernels::simdLevelName(level);
+    std::cout << "Running " << levelName << " case mapping benchmark...\n";
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t pass = 0; pass < kPasses; ++pass) {
+      if (pass % 2 == 0) {
+        etl::string_kernels::asciiToUpper(buffer_.data(), buffer_.size(),
+                                          level);
+      } else {
+        etl::string_kernels::asciiToLower(buffer_.data(), buffer_.size(),
+                                          level);
+      }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    size_t bytes = kBufferBytes * kPasses;
+    addResult(createResult(
+        "Case Mapping (" + levelName + ")", bytes,
+        std::chrono::duration_cast<std::chrono::milliseconds>(end - start),
+        gbPerSec(bytes, end - start)));
+  }
+
+  void benchmarkTrim(etl::string_kernels::SimdLevel level) {
+    const std::string levelName = etl::string_kernels::simdLevelName(level);
+    std::cout << "Running " << levelName << " trim benchmark...\n";
+
+    size_t bytes = 0;
+    size_t kept = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t pass = 0; pass < kPasses; ++pass) {
+      for (const auto &value : paddedValues_) {
+        kept +=
+            etl::string_kernels::trimAsciiWhitespace(value, level).size();
+        bytes += value.size();
+      }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    addResult(createResult(
+        "Trim (" + levelName + ")", paddedValues_.size() * kPasses,
+        std::chrono::duration_cast<std::chrono::milliseconds>(end - start),
+        gbPerSec(bytes, end - start) + ", kept " + std::to_string(kept) +
+            " bytes"));
+  }
+};
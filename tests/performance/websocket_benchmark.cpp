@@ -1,179 +1,248 @@
 #include "performance_benchmark.hpp"
-#include "websocket_manager_enhanced.hpp"
+#include "websocket_manager.hpp"
 #include <atomic>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket.hpp>
+#include <charconv>
+#include <functional>
 #include <memory>
-#include <mutex>
-#include <queue>
+#include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
-// WebSocket performance benchmark
+// Outbound cost of a log burst to real loopback clients: one frame per
+// message against write batching, with and without permessage-deflate.
+// Reports frames and bytes on the wire per message, and the latency from
+// broadcast to the client's read.
 class WebSocketBenchmark : public BenchmarkBase {
 public:
   WebSocketBenchmark() : BenchmarkBase("WebSocket") {}
 
   void run() override {
-    benchmarkMessageThroughput();
-    benchmarkConcurrentClients();
-    benchmarkMessageLatency();
-    benchmarkConnectionHandling();
-  }
-
-private:
-  void benchmarkMessageThroughput() {
-    std::cout << "Running WebSocket message throughput benchmark...\n";
-
-    etl_plus::WebSocketManagerEnhanced wsManager;
-    wsManager.initialize(8080);
+    WriteBatchingConfig perMessage;
+    measure("Frame per Message", perMessage);
 
-    const size_t numMessages = 10000;
-    const std::string testMessage =
-        R"({"type":"status","data":{"progress":50}})";
+    WriteBatchingConfig batched;
+    batched.enableBatching = true;
+    batched.maxBatchDelay = std::chrono::milliseconds(2);
+    measure("Batched JSON Array", batched);
 
-    auto start = std::chrono::high_resolution_clock::now();
-
-    // Simulate sending messages to connected clients
-    for (size_t i = 0; i < numMessages; ++i) {
-      wsManager.broadcastMessage(testMessage);
-      // Small delay to simulate realistic message spacing
-      std::this_thread::sleep_for(std::chrono::microseconds(10));
-    }
-
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration =
-        std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-
-    addResult(createResult("Message Throughput", numMessages, duration,
-                           "Broadcasting messages to connected clients"));
+    WriteBatchingConfig compressed = batched;
+    compressed.enableCompression = true;
+    measure("Batched + Deflate", compressed);
   }
 
-  void benchmarkConcurrentClients() {
-    std::cout << "Running concurrent WebSocket clients benchmark...\n";
-
-    etl_plus::WebSocketManagerEnhanced wsManager;
-    wsManager.initialize(8080);
-
-    const size_t numClients = 100;
-    const size_t messagesPerClient = 50;
-    const size_t totalMessages = numClients * messagesPerClient;
-
-    auto start = std::chrono::high_resolution_clock::now();
-
-    std::vector<std::thread> clientThreads;
-    std::atomic<size_t> activeClients{0};
-
-    for (size_t i = 0; i < numClients; ++i) {
-      clientThreads.emplace_back([&, i]() {
-        activeClients++;
-
-        // Simulate client connection and message handling
-        for (size_t j = 0; j < messagesPerClient; ++j) {
-          std::string clientMessage = R"({"client":)" + std::to_string(i) +
-                                      R"(,"message":)" + std::to_string(j) +
-                                      "}";
-          wsManager.handleIncomingMessage(i, clientMessage);
-          std::this_thread::sleep_for(std::chrono::microseconds(100));
-        }
-
-        activeClients--;
-      });
+private:
+  static constexpr size_t kClients = 4;
+  static constexpr size_t kMessages = 5000;
+  static constexpr size_t kIoThreads = 2;
+  static constexpr std::string_view kSentField = "\"sent\":";
+  static constexpr std::string_view kDoneMarker = "\"bench-done\"";
+
+  // Blocking TCP stream that counts what the client reads: frame headers
+  // and (possibly compressed) payloads as they crossed the wire
+  class CountingSocket {
+  public:
+    using executor_type = tcp::socket::executor_type;
+
+    explicit CountingSocket(net::io_context &ioc) : socket_(ioc) {}
+
+    executor_type get_executor() { return socket_.get_executor(); }
+    tcp::socket &socket() { return socket_; }
+    size_t bytesRead() const { return bytesRead_; }
+
+    template <class Buffers> size_t read_some(const Buffers &buffers) {
+      size_t n = socket_.read_some(buffers);
+      bytesRead_ += n;
+      return n;
     }
-
-    for (auto &thread : clientThreads) {
-      thread.join();
+    template <class Buffers>
+    size_t read_some(const Buffers &buffers, beast::error_code &ec) {
+      size_t n = socket_.read_some(buffers, ec);
+      bytesRead_ += n;
+      return n;
+    }
+    template <class Buffers> size_t write_some(const Buffers &buffers) {
+      return socket_.write_some(buffers);
+    }
+    template <class Buffers>
+    size_t write_some(const Buffers &buffers, beast::error_code &ec) {
+      return socket_.write_some(buffers, ec);
     }
 
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration =
-        std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    friend void teardown(beast::role_type role, CountingSocket &stream,
+                         beast::error_code &ec) {
+      websocket::teardown(role, stream.socket_, ec);
+    }
+    template <class Handler>
+    friend void async_teardown(beast::role_type role, CountingSocket &stream,
+                               Handler &&handler) {
+      websocket::async_teardown(role, stream.socket_,
+                                std::forward<Handler>(handler));
+    }
 
-    addResult(
-        createResult("Concurrent Clients", totalMessages, duration,
-                     std::to_string(numClients) + " simultaneous clients"));
+  private:
+    tcp::socket socket_;
+    size_t bytesRead_ = 0;
+  };
+
+  struct ClientResult {
+    size_t frames = 0;
+    size_t messages = 0;
+    size_t wireBytes = 0;
+    std::vector<int64_t> latenciesMicros;
+  };
+
+  static int64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
   }
 
-  void benchmarkMessageLatency() {
-    std::cout << "Running WebSocket message latency benchmark...\n";
-
-    etl_plus::WebSocketManagerEnhanced wsManager;
-    wsManager.initialize(8080);
-
-    const size_t numLatencyTests = 1000;
-    std::vector<long long> latencies;
-
-    for (size_t i = 0; i < numLatencyTests; ++i) {
-      auto sendTime = std::chrono::high_resolution_clock::now();
-
-      std::string pingMessage =
-          R"({"type":"ping","timestamp":)" +
-          std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
-                             sendTime.time_since_epoch())
-                             .count()) +
-          "}";
-
-      wsManager.broadcastMessage(pingMessage);
-
-      // Simulate round-trip delay
-      std::this_thread::sleep_for(std::chrono::microseconds(500));
-
-      auto receiveTime = std::chrono::high_resolution_clock::now();
-      auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
-                         receiveTime - sendTime)
-                         .count();
+  // Shaped like a JobMonitorService log message, stamped with the send time
+  static std::string logPayload(size_t sequence) {
+    return R"({"type":"job_log_message","timestamp":"2024-01-01T12:00:00Z",)"
+           R"("data":{"jobId":"job-bench","level":"INFO","component":)"
+           R"("DataTransformer","message":"Processed batch )" +
+           std::to_string(sequence) +
+           R"( of customer records","context":{"rows":"500"}},)"
+           R"("sent":)" +
+           std::to_string(nowMicros()) + "}";
+  }
 
-      latencies.push_back(latency);
+  static void runClient(unsigned short port, bool deflate,
+                        ClientResult &result) {
+    net::io_context ioc;
+    websocket::stream<CountingSocket> ws(ioc);
+    ws.next_layer().socket().connect(
+        {net::ip::make_address("127.0.0.1"), port});
+    if (deflate) {
+      websocket::permessage_deflate options;
+      options.client_enable = true;
+      ws.set_option(options);
+    }
+    ws.handshake("127.0.0.1", "/");
+    const size_t handshakeBytes = ws.next_layer().bytesRead();
+
+    beast::flat_buffer buffer;
+    bool done = false;
+    while (!done) {
+      ws.read(buffer);
+      const int64_t receivedAt = nowMicros();
+      result.frames++;
+
+      // A frame holds one message or a JSON array of them
+      std::string_view frame(static_cast<const char *>(buffer.data().data()),
+                             buffer.size());
+      for (size_t pos = frame.find(kSentField); pos != std::string_view::npos;
+           pos = frame.find(kSentField, pos)) {
+        pos += kSentField.size();
+        int64_t sentAt = 0;
+        std::from_chars(frame.data() + pos, frame.data() + frame.size(),
+                        sentAt);
+        result.latenciesMicros.push_back(receivedAt - sentAt);
+        result.messages++;
+      }
+      done = frame.find(kDoneMarker) != std::string_view::npos;
+      buffer.consume(buffer.size());
     }
 
-    // Calculate average latency
-    double avgLatency =
-        std::accumulate(latencies.begin(), latencies.end(), 0.0) /
-        latencies.size();
-
-    auto totalDuration =
-        std::chrono::microseconds(static_cast<long long>(avgLatency));
-    addResult(
-        createResult("Message Latency", numLatencyTests, totalDuration,
-                     "Average latency: " +
-                         std::to_string(static_cast<long long>(avgLatency)) +
-                         " microseconds"));
+    result.wireBytes = ws.next_layer().bytesRead() - handshakeBytes;
+    beast::error_code ec;
+    ws.next_layer().socket().shutdown(tcp::socket::shutdown_both, ec);
   }
 
-  void benchmarkConnectionHandling() {
-    std::cout << "Running WebSocket connection handling benchmark...\n";
+  void measure(const std::string &name, const WriteBatchingConfig &batching) {
+    std::cout << "Running " << name << " benchmark...\n";
+
+    net::io_context ioc;
+    auto work = net::make_work_guard(ioc);
+    tcp::acceptor acceptor(ioc, {net::ip::make_address("127.0.0.1"), 0});
+
+    WebSocketManagerConfig config;
+    config.messageBroadcasterConfig.enableAsyncProcessing = false;
+    config.writeBatchingConfig = batching;
+    // Measure framing, not the slow-consumer policy
+    config.writeBatchingConfig.maxQueuedMessages = kMessages + 1;
+    auto manager = std::make_shared<WebSocketManager>(config);
+    manager->start();
+
+    std::function<void()> accept = [&] {
+      acceptor.async_accept([&](beast::error_code ec, tcp::socket socket) {
+        if (!ec) {
+          manager->handleUpgrade(std::move(socket));
+          accept();
+        }
+      });
+    };
+    accept();
 
-    etl_plus::WebSocketManagerEnhanced wsManager;
-    wsManager.initialize(8080);
+    std::vector<std::thread> ioThreads;
+    for (size_t i = 0; i < kIoThreads; ++i) {
+      ioThreads.emplace_back([&ioc] { ioc.run(); });
+    }
 
-    const size_t numConnections = 500;
-    const size_t connectionDurationMs = 100;
+    const unsigned short port = acceptor.local_endpoint().port();
+    std::vector<ClientResult> results(kClients);
+    std::vector<std::thread> clients;
+    for (size_t i = 0; i < kClients; ++i) {
+      clients.emplace_back(runClient, port, batching.enableCompression,
+                           std::ref(results[i]));
+    }
+    while (manager->getConnectionCount() < kClients) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
 
     auto start = std::chrono::high_resolution_clock::now();
-
-    std::vector<std::thread> connectionThreads;
-
-    for (size_t i = 0; i < numConnections; ++i) {
-      connectionThreads.emplace_back([&, i]() {
-        // Simulate connection establishment
-        wsManager.handleNewConnection(i);
-
-        // Simulate connection activity
-        std::this_thread::sleep_for(
-            std::chrono::milliseconds(connectionDurationMs));
-
-        // Simulate connection closure
-        wsManager.handleConnectionClose(i);
-      });
+    for (size_t i = 0; i < kMessages; ++i) {
+      manager->broadcastLogMessage(logPayload(i), "job-bench", "INFO");
+    }
+    manager->broadcastLogMessage(R"({"type":"bench-done"})", "job-bench",
+                                 "INFO");
+    for (auto &client : clients) {
+      client.join();
     }
+    auto end = std::chrono::high_resolution_clock::now();
 
-    for (auto &thread : connectionThreads) {
+    manager->stop();
+    acceptor.close();
+    work.reset();
+    ioc.stop();
+    for (auto &thread : ioThreads) {
       thread.join();
     }
 
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration =
-        std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-
-    addResult(createResult("Connection Handling", numConnections, duration,
-                           "Connection establishment and cleanup"));
+    size_t frames = 0;
+    size_t messages = 0;
+    size_t wireBytes = 0;
+    std::vector<int64_t> latencies;
+    for (const auto &result : results) {
+      frames += result.frames;
+      messages += result.messages;
+      wireBytes += result.wireBytes;
+      latencies.insert(latencies.end(), result.latenciesMicros.begin(),
+                       result.latenciesMicros.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) -> int64_t {
+      return latencies.empty()
+                 ? 0
+                 : latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+    };
+
+    std::ostringstream notes;
+    notes << std::fixed << std::setprecision(1)
+          << static_cast<double>(frames) / kClients << " frames/client, "
+          << static_cast<double>(wireBytes) / std::max<size_t>(messages, 1)
+          << " wire bytes/msg, p50 " << percentile(0.50) << " us, p99 "
+          << percentile(0.99) << " us";
+    addResult(createResult(
+        name, messages,
+        std::chrono::duration_cast<std::chrono::milliseconds>(end - start),
+        notes.str()));
   }
 };
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A local HTTP/1.1 server for tests of outgoing HTTP. It listens on an
+ * ephemeral loopback port, keeps connections alive, records every request
+ * and answers each with status after delay.
+ */
+class HttpStubServer {
+public:
+  struct Request {
+    std::string method;
+    std::string path;
+    std::unordered_map<std::string, std::string> headers; // lower-case keys
+    std::string body;
+    int connection = 0; // which accepted connection carried it
+  };
+
+  HttpStubServer() {
+    listenFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ::bind(listenFd_, reinterpret_cast<sockaddr *>(&address),
+           sizeof(address));
+    socklen_t length = sizeof(address);
+    ::getsockname(listenFd_, reinterpret_cast<sockaddr *>(&address),
+                  &length);
+    port_ = ntohs(address.sin_port);
+    ::listen(listenFd_, 64);
+    acceptor_ = std::thread([this] { acceptLoop(); });
+  }
+
+  ~HttpStubServer() {
+    stopping_ = true;
+    ::shutdown(listenFd_, SHUT_RDWR);
+    ::close(listenFd_);
+    acceptor_.join();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (int fd : connections_) {
+        ::shutdown(fd, SHUT_RDWR);
+      }
+    }
+    for (auto &handler : handlers_) {
+      handler.join();
+    }
+  }
+
+  std::string url(const std::string &path = "/") const {
+    return "http://127.0.0.1:" + std::to_string(port_) + path;
+  }
+
+  void respondWith(int status, std::chrono::milliseconds delay = {}) {
+    status_ = status;
+    delayMs_ = static_cast<int>(delay.count());
+  }
+
+  std::vector<Request> requests() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requests_;
+  }
+
+  // Waits until count requests have arrived
+  bool waitForRequests(size_t count, std::chrono::milliseconds timeout =
+                                         std::chrono::seconds(5)) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return arrived_.wait_for(lock, timeout,
+                             [&] { return requests_.size() >= count; });
+  }
+
+  int connectionsAccepted() const { return accepted_; }
+  // Most requests being answered at the same moment
+  int maxConcurrent() const { return maxConcurrent_; }
+
+private:
+  void acceptLoop() {
+    while (!stopping_) {
+      const int fd = ::accept(listenFd_, nullptr, nullptr);
+      if (fd < 0) {
+        continue;
+      }
+      const int connection = ++accepted_;
+      std::lock_guard<std::mutex> lock(mutex_);
+      connections_.push_back(fd);
+      handlers_.emplace_back([this, fd, connection] {
+        serve(fd, connection);
+        std::lock_guard<std::mutex> lock(mutex_);
+        connections_.erase(
+            std::find(connections_.begin(), connections_.end(), fd));
+        ::close(fd);
+      });
+    }
+  }
+
+  void serve(int fd, int connection) {
+    std::string buffer;
+    char chunk[4096];
+    for (;;) {
+      // Headers, then a Content-Length body
+      size_t headerEnd;
+      while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+        const ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+          return;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+      }
+      Request request = parseHead(buffer.substr(0, headerEnd));
+      request.connection = connection;
+      const auto length = request.headers.find("content-length");
+      const size_t bodyBytes =
+          length == request.headers.end() ? 0 : std::stoul(length->second);
+      buffer.erase(0, headerEnd + 4);
+      while (buffer.size() < bodyBytes) {
+        const ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+          return;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+      }
+      request.body = buffer.substr(0, bodyBytes);
+      buffer.erase(0, bodyBytes);
+
+      const int concurrent = ++concurrent_;
+      int seen = maxConcurrent_;
+      while (concurrent > seen &&
+             !maxConcurrent_.compare_exchange_weak(seen, concurrent)) {
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests_.push_back(std::move(request));
+      }
+      arrived_.notify_all();
+      std::this_thread::sleep_for(std::chrono::milliseconds(delayMs_));
+      --concurrent_;
+
+      const std::string reply = "HTTP/1.1 " + std::to_string(status_) +
+                                " Stub\r\nContent-Length: 2\r\n\r\nok";
+      if (::send(fd, reply.data(), reply.size(), MSG_NOSIGNAL) < 0) {
+        return;
+      }
+    }
+  }
+
+  static Request parseHead(const std::string &head) {
+    Request request;
+    size_t lineEnd = head.find("\r\n");
+    const std::string first = head.substr(0, lineEnd);
+    request.method = first.substr(0, first.find(' '));
+    request.path = first.substr(first.find(' ') + 1);
+    request.path = request.path.substr(0, request.path.find(' '));
+    while (lineEnd != std::string::npos) {
+      const size_t start = lineEnd + 2;
+      lineEnd = head.find("\r\n", start);
+      const std::string line = head.substr(start, lineEnd - start);
+      const size_t colon = line.find(':');
+      if (colon == std::string::npos) {
+        continue;
+      }
+      std::string key = line.substr(0, colon);
+      for (char &c : key) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+      }
+      const size_t value = line.find_first_not_of(' ', colon + 1);
+      request.headers[key] =
+          value == std::string::npos ? "" : line.substr(value);
+    }
+    return request;
+  }
+
+  int listenFd_ = -1;
+  int port_ = 0;
+  std::atomic<bool> stopping_{false};
+  std::atomic<int> status_{200};
+  std::atomic<int> delayMs_{0};
+  std::atomic<int> accepted_{0};
+  std::atomic<int> concurrent_{0};
+  std::atomic<int> maxConcurrent_{0};
+  std::thread acceptor_;
+  std::vector<std::thread> handlers_;
+  std::vector<int> connections_;
+  std::vector<Request> requests_;
+  mutable std::mutex mutex_;
+  mutable std::condition_variable arrived_;
+};
@@ -0,0 +1,217 @@
+#include "async_http_client.hpp"
+#include "http_stub_server.hpp"
+#include "log_aggregator.hpp"
+#include "log_compression.hpp"
+#include "notification_service.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+
+HttpRequest post(const std::string &url, std::string body) {
+  HttpRequest request;
+  request.url = url;
+  request.body = std::move(body);
+  request.headers["Content-Type"] = "text/plain";
+  return request;
+}
+
+std::vector<HttpResponse>
+waitAll(std::vector<std::future<HttpResponse>> &futures) {
+  std::vector<HttpResponse> responses;
+  for (auto &future : futures) {
+    responses.push_back(future.get());
+  }
+  return responses;
+}
+
+} // namespace
+
+TEST(AsyncHttpClientTest, ReusesOneConnectionForSequentialRequests) {
+  HttpStubServer server;
+  AsyncHttpClient client;
+  for (int i = 0; i < 20; ++i) {
+    HttpResponse response =
+        client.send(post(server.url("/hook"), "event " + std::to_string(i)))
+            .get();
+    ASSERT_TRUE(response.succeeded()) << response.error;
+    EXPECT_EQ(response.body, "ok");
+  }
+
+  const auto requests = server.requests();
+  ASSERT_EQ(requests.size(), 20u);
+  EXPECT_EQ(requests[7].method, "POST");
+  EXPECT_EQ(requests[7].path, "/hook");
+  EXPECT_EQ(requests[7].body, "event 7");
+  EXPECT_EQ(server.connectionsAccepted(), 1);
+  EXPECT_EQ(client.getStats().connectionsOpened, 1u);
+  EXPECT_EQ(client.getStats().succeeded, 20u);
+}
+
+TEST(AsyncHttpClientTest, LimitsRequestsInFlightPerDestination) {
+  HttpStubServer server;
+  server.respondWith(200, std::chrono::milliseconds(100));
+  AsyncHttpClient::Config config;
+  config.maxConnectionsPerHost = 2;
+  config.maxQueuedPerHost = 3;
+  AsyncHttpClient client(config);
+
+  std::vector<std::future<HttpResponse>> futures;
+  for (int i = 0; i < 6; ++i) {
+    futures.push_back(client.send(post(server.url(), std::to_string(i))));
+  }
+  const auto responses = waitAll(futures);
+
+  // Two run, three wait and the sixth is turned away at once
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(responses[i].succeeded()) << responses[i].error;
+  }
+  EXPECT_FALSE(responses[5].succeeded());
+  EXPECT_EQ(responses[5].status, 0);
+  EXPECT_EQ(server.maxConcurrent(), 2);
+  EXPECT_EQ(server.requests().size(), 5u);
+  EXPECT_EQ(client.getStats().rejected, 1u);
+  EXPECT_EQ(client.pending(), 0u);
+}
+
+TEST(AsyncHttpClientTest, SlowDestinationDoesNotDelayOthers) {
+  HttpStubServer slow;
+  HttpStubServer fast;
+  slow.respondWith(200, std::chrono::milliseconds(1500));
+  AsyncHttpClient client;
+
+  auto slowResponse = client.send(post(slow.url(), "slow"));
+  ASSERT_TRUE(slow.waitForRequests(1));
+  HttpResponse fastResponse = client.send(post(fast.url(), "fast")).get();
+  EXPECT_TRUE(fastResponse.succeeded());
+  EXPECT_LT(fastResponse.latency, std::chrono::milliseconds(500));
+  EXPECT_EQ(slowResponse.wait_for(std::chrono::seconds(0)),
+            std::future_status::timeout);
+  EXPECT_TRUE(slowResponse.get().succeeded());
+}
+
+TEST(AsyncHttpClientTest, GzipsBodiesThatShrink) {
+  HttpStubServer server;
+  AsyncHttpClient client;
+  std::string body;
+  for (int i = 0; i < 200; ++i) {
+    body += "{\"level\":\"INFO\",\"message\":\"row " + std::to_string(i) +
+            " loaded\"}\n";
+  }
+  HttpRequest request = post(server.url(), body);
+  request.gzipBody = true;
+  HttpResponse response = client.send(std::move(request)).get();
+  ASSERT_TRUE(response.succeeded()) << response.error;
+  EXPECT_LT(response.bytesSent, body.size());
+
+  const auto received = server.requests().at(0);
+  EXPECT_EQ(received.headers.at("content-encoding"), "gzip");
+  std::string restored;
+  ASSERT_TRUE(
+      decompressLogBuffer(CompressionType::GZIP, received.body, restored));
+  EXPECT_EQ(restored, body);
+  EXPECT_EQ(client.getStats().bytesBeforeGzip, body.size());
+  EXPECT_EQ(client.getStats().bytesSent, received.body.size());
+}
+
+TEST(AsyncHttpClientTest, ReportsErrorStatusesAndRefusedConnections) {
+  HttpStubServer server;
+  server.respondWith(503);
+  AsyncHttpClient client;
+  HttpResponse response = client.send(post(server.url(), "x")).get();
+  EXPECT_FALSE(response.succeeded());
+  EXPECT_EQ(response.status, 503);
+  EXPECT_TRUE(response.error.empty());
+
+  std::string closedUrl;
+  {
+    HttpStubServer gone;
+    closedUrl = gone.url();
+  }
+  response = client.send(post(closedUrl, "x")).get();
+  EXPECT_FALSE(response.succeeded());
+  EXPECT_FALSE(response.error.empty());
+  EXPECT_EQ(client.getStats().failed, 2u);
+}
+
+TEST(AsyncHttpClientTest, DeliversWebhookNotifications) {
+  HttpStubServer server;
+  NotificationConfig config;
+  config.webhookUrl = server.url("/notify");
+  config.webhookSecret = "s3cret";
+  auto client = std::make_shared<AsyncHttpClient>();
+  WebhookNotificationDelivery delivery(config, client);
+
+  NotificationMessage message;
+  message.id = "notif_1";
+  message.type = NotificationType::JOB_FAILURE;
+  message.priority = NotificationPriority::HIGH;
+  message.subject = "ETL Job Failed: job-7";
+  message.timestamp = std::chrono::system_clock::now();
+  message.retryCount = 0;
+  message.maxRetries = 3;
+  EXPECT_TRUE(delivery.deliver(message));
+
+  std::promise<bool> delivered;
+  delivery.deliverAsync(message,
+                        [&delivered](bool ok) { delivered.set_value(ok); });
+  EXPECT_TRUE(delivered.get_future().get());
+
+  const auto requests = server.requests();
+  ASSERT_EQ(requests.size(), 2u);
+  EXPECT_EQ(requests[0].path, "/notify");
+  EXPECT_EQ(requests[0].headers.at("authorization"), "Bearer s3cret");
+  EXPECT_EQ(nlohmann::json::parse(requests[0].body)["subject"],
+            "ETL Job Failed: job-7");
+  EXPECT_EQ(server.connectionsAccepted(), 1);
+
+  server.respondWith(500);
+  EXPECT_FALSE(delivery.deliver(message));
+}
+
+TEST(AsyncHttpClientTest, ShipsLogBatchesAndCountsBytes) {
+  HttpStubServer server;
+  LogDestinationConfig destination;
+  destination.type = LogDestinationType::HTTP_ENDPOINT;
+  destination.name = "stub";
+  destination.endpoint = server.url("/logs");
+  destination.compress_payload = true;
+  destination.batch_timeout = std::chrono::seconds(0);
+
+  LogAggregator aggregator({destination}, std::make_shared<AsyncHttpClient>());
+  aggregator.initialize();
+  for (int i = 0; i < 50; ++i) {
+    StructuredLogEntry entry;
+    entry.timestamp = "2024-06-01T12:00:00.000Z";
+    entry.level = LogLevel::INFO;
+    entry.component = "Loader";
+    entry.message = "loaded batch " + std::to_string(i);
+    aggregator.addLogEntry(entry);
+  }
+  // Waits for the shipments still in flight
+  aggregator.shutdown();
+
+  const auto &stats = aggregator.getStats();
+  EXPECT_EQ(stats.entries_shipped, 50u);
+  EXPECT_EQ(stats.entries_failed, 0u);
+  EXPECT_GT(stats.bytes_shipped, 0u);
+  EXPECT_LE(stats.bytes_shipped, stats.bytes_uncompressed);
+
+  // Batches too small to shrink go out uncompressed
+  size_t entries = 0;
+  uint64_t received = 0;
+  for (const auto &request : server.requests()) {
+    std::string json = request.body;
+    if (request.headers.count("content-encoding")) {
+      json.clear();
+      ASSERT_TRUE(
+          decompressLogBuffer(CompressionType::GZIP, request.body, json));
+    }
+    entries += nlohmann::json::parse(json).size();
+    received += request.body.size();
+  }
+  EXPECT_EQ(entries, 50u);
+  EXPECT_EQ(received, stats.bytes_shipped);
+}
@@ -0,0 +1,70 @@
+#include "bounded_queue.hpp"
+#include <future>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(BoundedQueueTest, PreservesFifoOrderAcrossThreads) {
+  BoundedQueue<int> queue(2);
+  std::thread producer([&queue] {
+    for (int i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(queue.push(i));
+    }
+    queue.close();
+  });
+
+  std::vector<int> received;
+  while (auto item = queue.pop()) {
+    received.push_back(*item);
+  }
+  producer.join();
+
+  ASSERT_EQ(received.size(), 1000u);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(received[i], i);
+  }
+}
+
+TEST(BoundedQueueTest, PushBlocksWhenFullAndRecordsBackpressure) {
+  BoundedQueue<int> queue(1);
+  ASSERT_TRUE(queue.push(1));
+
+  auto blocked =
+      std::async(std::launch::async, [&queue] { return queue.push(2); });
+  EXPECT_EQ(blocked.wait_for(std::chrono::milliseconds(30)),
+            std::future_status::timeout);
+
+  EXPECT_EQ(queue.pop().value(), 1);
+  ASSERT_EQ(blocked.wait_for(std::chrono::seconds(2)),
+            std::future_status::ready);
+  EXPECT_TRUE(blocked.get());
+  EXPECT_GE(queue.producerWaitTime(), std::chrono::milliseconds(30));
+  EXPECT_EQ(queue.pop().value(), 2);
+}
+
+TEST(BoundedQueueTest, CloseDrainsRemainingItems) {
+  BoundedQueue<int> queue(4);
+  queue.push(1);
+  queue.push(2);
+  queue.close();
+
+  EXPECT_FALSE(queue.push(3));
+  EXPECT_EQ(queue.pop().value(), 1);
+  EXPECT_EQ(queue.pop().value(), 2);
+  EXPECT_FALSE(queue.pop().has_value());
+}
+
+TEST(BoundedQueueTest, CancelUnblocksProducerAndDropsItems) {
+  BoundedQueue<int> queue(1);
+  queue.push(1);
+
+  auto blocked =
+      std::async(std::launch::async, [&queue] { return queue.push(2); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  queue.cancel();
+
+  ASSERT_EQ(blocked.wait_for(std::chrono::seconds(2)),
+            std::future_status::ready);
+  EXPECT_FALSE(blocked.get());
+  EXPECT_FALSE(queue.pop().has_value());
+}
@@ -0,0 +1,268 @@
+#include "data_transformer.hpp"
+#include "record_batch.hpp"
+#include "work_stealing_pool.hpp"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class DataTransformerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    DataRecord r1;
+    r1.fields["name"] = "  John Doe ";
+    r1.fields["age"] = "30";
+    r1.fields["salary"] = "1000.5";
+
+    DataRecord r2;
+    r2.fields["name"] = "jane";
+    r2.fields["salary"] = "not-a-number";
+
+    DataRecord r3;
+    r3.fields["age"] = "41";
+    r3.fields["salary"] = "250";
+
+    records = {r1, r2, r3};
+  }
+
+  static TransformationRule makeRule(const std::string &source,
+                                     const std::string &target,
+                                     const std::string &type) {
+    TransformationRule rule;
+    rule.sourceField = source;
+    rule.targetField = target;
+    rule.transformationType = type;
+    return rule;
+  }
+
+  void expectSameRecords(const std::vector<DataRecord> &expected,
+                         const std::vector<DataRecord> &actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(expected[i].fields.size(), actual[i].fields.size())
+          << "record " << i;
+      for (const auto &[key, value] : expected[i].fields) {
+        auto it = actual[i].fields.find(key);
+        ASSERT_NE(it, actual[i].fields.end())
+            << "record " << i << " missing field " << key;
+        EXPECT_EQ(value, it->second) << "record " << i << " field " << key;
+      }
+    }
+  }
+
+  std::vector<DataRecord> records;
+};
+
+TEST_F(DataTransformerTest, RecordBatchRoundTrip) {
+  auto batch = RecordBatch::fromRecords(records);
+
+  EXPECT_EQ(batch.numRows(), 3u);
+  EXPECT_EQ(batch.numColumns(), 3u);
+
+  const Column *age = batch.column("age");
+  ASSERT_NE(age, nullptr);
+  EXPECT_EQ(age->nullCount(), 1u);
+  EXPECT_TRUE(age->isNull(1));
+  EXPECT_EQ(age->stringAt(2), "41");
+
+  expectSameRecords(records, batch.toRecords());
+}
+
+TEST_F(DataTransformerTest, TypedSchemaParsesNumericColumns) {
+  auto schema =
+      std::make_shared<const BatchSchema>(std::vector<FieldDescriptor>{
+          {"age", ColumnType::INT64}, {"salary", ColumnType::DOUBLE}});
+  auto batch = RecordBatch::fromRecords(records, schema);
+
+  const Column *age = batch.column("age");
+  ASSERT_NE(age, nullptr);
+  EXPECT_EQ(age->type(), ColumnType::INT64);
+  EXPECT_EQ(age->int64At(0), 30);
+  EXPECT_TRUE(age->isNull(1));
+
+  const Column *salary = batch.column("salary");
+  ASSERT_NE(salary, nullptr);
+  EXPECT_DOUBLE_EQ(salary->doubleAt(0), 1000.5);
+  EXPECT_TRUE(salary->isNull(1)); // unparseable values become null
+  EXPECT_EQ(salary->valueAsString(2), "250");
+}
+
+TEST(CopyFormatTest, EscapesTextSpecialCharacters) {
+  std::string line;
+  appendCopyText(line, "a\tb\nc\rd\\e");
+  EXPECT_EQ(line, "a\\tb\\nc\\rd\\\\e");
+
+  // A literal backslash-N must not read back as NULL
+  line.clear();
+  appendCopyText(line, "\\N");
+  EXPECT_EQ(line, "\\\\N");
+}
+
+TEST(CopyFormatTest, FormatsRowsWithNulls) {
+  Column ids(ColumnType::INT64);
+  ids.appendInt64(-7);
+  ids.appendNull();
+  Column prices(ColumnType::DOUBLE);
+  prices.appendDouble(2.5);
+  prices.appendDouble(3);
+  Column notes(ColumnType::STRING);
+  notes.appendString("two\twords");
+  notes.appendNull();
+
+  std::vector<const Column *> sources = {&ids, &prices, &notes, nullptr};
+  std::string line = "stale";
+  formatCopyRow(line, sources, 0);
+  EXPECT_EQ(line, "-7\t2.5\ttwo\\twords\t\\N");
+  formatCopyRow(line, sources, 1);
+  EXPECT_EQ(line, "\\N\t3\t\\N\t\\N");
+}
+
+TEST_F(DataTransformerTest, TransformBatchMatchesRowTransform) {
+  DataTransformer transformer;
+  transformer.addTransformationRule(makeRule("name", "name", "trim"));
+  transformer.addTransformationRule(
+      makeRule("name", "name_upper", "uppercase"));
+
+  auto raise = makeRule("salary", "salary", "multiply");
+  raise.parameters["factor"] = "1.1";
+  transformer.addTransformationRule(raise);
+
+  auto older = makeRule("age", "age_next", "add");
+  older.parameters["addend"] = "1";
+  transformer.addTransformationRule(older);
+
+  auto expected = transformer.transform(records);
+  auto actual =
+      transformer.transformBatch(RecordBatch::fromRecords(records)).toRecords();
+
+  expectSameRecords(expected, actual);
+}
+
+TEST_F(DataTransformerTest, TransformBatchKeepsTargetWhenSourceMissing) {
+  for (auto &record : records) {
+    record.fields["label"] = "original";
+  }
+
+  DataTransformer transformer;
+  transformer.addTransformationRule(makeRule("age", "label", "lowercase"));
+
+  auto expected = transformer.transform(records);
+  auto actual =
+      transformer.transformBatch(RecordBatch::fromRecords(records)).toRecords();
+
+  expectSameRecords(expected, actual);
+  EXPECT_EQ(actual[1].fields.at("label"), "original");
+}
+
+TEST_F(DataTransformerTest, NumericTransformProducesDoubleColumn) {
+  DataTransformer transformer;
+  auto rule = makeRule("age", "age", "multiply");
+  rule.parameters["factor"] = "2";
+  transformer.addTransformationRule(rule);
+
+  auto batch = transformer.transformBatch(RecordBatch::fromRecords(records));
+  const Column *age = batch.column("age");
+  ASSERT_NE(age, nullptr);
+  EXPECT_EQ(age->type(), ColumnType::DOUBLE);
+  EXPECT_DOUBLE_EQ(age->doubleAt(0), 60.0);
+  EXPECT_EQ(age->valueAsString(2), "82");
+}
+
+TEST_F(DataTransformerTest, PlanResolvesOperatorsAndParameters) {
+  DataTransformer transformer;
+  transformer.addTransformationRule(makeRule("name", "name", "uppercase"));
+
+  auto scale = makeRule("salary", "salary_k", "multiply");
+  scale.parameters["factor"] = "0.001";
+  transformer.addTransformationRule(scale);
+
+  auto broken = makeRule("age", "age", "add");
+  broken.parameters["addend"] = "abc";
+  transformer.addTransformationRule(broken);
+
+  auto plan = transformer.getPlan();
+  ASSERT_EQ(plan->steps().size(), 3u);
+  EXPECT_EQ(plan->steps()[0].op, TransformOp::UPPERCASE);
+  EXPECT_EQ(plan->steps()[1].op, TransformOp::MULTIPLY);
+  EXPECT_DOUBLE_EQ(plan->steps()[1].operand, 0.001);
+  EXPECT_EQ(plan->fieldName(plan->steps()[1].targetIndex), "salary_k");
+  // An unparseable parameter compiles to a pass-through step
+  EXPECT_EQ(plan->steps()[2].op, TransformOp::NONE);
+
+  auto result = transformer.transformRecord(records[0]);
+  EXPECT_EQ(result.fields.at("age"), "30");
+  EXPECT_EQ(result.fields.at("salary_k"), "1.0005");
+
+  transformer.removeTransformationRule("salary");
+  EXPECT_EQ(transformer.getPlan()->steps().size(), 2u);
+}
+
+TEST_F(DataTransformerTest, RequiredFieldsValidatedFromPlan) {
+  DataTransformer transformer;
+  auto rule = makeRule("age", "age", "trim");
+  rule.parameters["required"] = "true";
+  transformer.addTransformationRule(rule);
+
+  EXPECT_TRUE(transformer.getValidationErrors(records[0]).empty());
+  auto errors = transformer.getValidationErrors(records[1]);
+  ASSERT_EQ(errors.size(), 1u);
+  EXPECT_EQ(errors[0], "Required field 'age' is missing or empty");
+  EXPECT_FALSE(transformer.validateData(records));
+}
+
+TEST_F(DataTransformerTest, ParallelTransformPreservesOrder) {
+  std::vector<DataRecord> input;
+  for (int i = 0; i < 10000; ++i) {
+    DataRecord record;
+    record.fields["id"] = std::to_string(i);
+    record.fields["name"] = " row " + std::to_string(i) + " ";
+    input.push_back(record);
+  }
+
+  DataTransformer transformer;
+  transformer.addTransformationRule(makeRule("name", "name", "trim"));
+  auto bump = makeRule("id", "next_id", "add");
+  bump.parameters["addend"] = "1";
+  transformer.addTransformationRule(bump);
+
+  auto expected = transformer.transform(input);
+
+  ParallelTransformConfig config;
+  config.enabled = true;
+  config.workerCount = 4;
+  config.chunkSize = 97; // deliberately not a divisor of the input size
+  config.minParallelRecords = 1;
+  transformer.setParallelConfig(config);
+
+  auto actual = transformer.transform(input);
+  expectSameRecords(expected, actual);
+  EXPECT_EQ(actual[9999].fields.at("next_id"), "10000");
+}
+
+TEST(WorkStealingPoolTest, ParallelForRunsEveryIndexOnce) {
+  WorkStealingPool pool(3);
+  std::vector<std::atomic<int>> hits(5000);
+
+  pool.parallelFor(hits.size(), [&](size_t i) {
+    hits[i].fetch_add(1);
+    if (i % 1000 == 0) {
+      // Nested parallelism from inside a worker must not deadlock
+      pool.parallelFor(4, [](size_t) {});
+    }
+  });
+
+  for (const auto &hit : hits) {
+    EXPECT_EQ(hit.load(), 1);
+  }
+}
+
+TEST(WorkStealingPoolTest, ParallelForPropagatesExceptions) {
+  WorkStealingPool pool(2);
+  EXPECT_THROW(pool.parallelFor(10,
+                                [](size_t i) {
+                                  if (i == 7)
+                                    throw std::runtime_error("boom");
+                                }),
+               std::runtime_error);
+}
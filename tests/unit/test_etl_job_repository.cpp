@@ -0,0 +1,52 @@
+#include "etl_job_repository.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+
+bool decode(const std::string &cursor, int64_t &micros, std::string &jobId) {
+  return ETLJobRepository::decodePageCursor(cursor, micros, jobId);
+}
+
+} // namespace
+
+TEST(PageCursorTest, RoundTripsCreationTimeAndJobId) {
+  for (const std::string jobId : {"job-1", "a:b:c", "x"}) {
+    for (int64_t micros : {int64_t{0}, int64_t{1718000000123456},
+                           int64_t{-5}}) {
+      const std::string cursor =
+          ETLJobRepository::encodePageCursor(micros, jobId);
+      EXPECT_EQ(cursor.find_first_not_of("0123456789abcdef"),
+                std::string::npos);
+
+      int64_t decodedMicros = 1;
+      std::string decodedJobId;
+      ASSERT_TRUE(decode(cursor, decodedMicros, decodedJobId)) << cursor;
+      EXPECT_EQ(decodedMicros, micros);
+      EXPECT_EQ(decodedJobId, jobId);
+    }
+  }
+}
+
+TEST(PageCursorTest, RejectsTamperedAndGarbageCursors) {
+  const std::string cursor =
+      ETLJobRepository::encodePageCursor(1718000000123456, "job-1");
+  int64_t micros = 0;
+  std::string jobId;
+
+  EXPECT_FALSE(decode("", micros, jobId));
+  // Odd length, or not hex
+  EXPECT_FALSE(decode(cursor.substr(1), micros, jobId));
+  EXPECT_FALSE(decode("zz" + cursor, micros, jobId));
+  EXPECT_FALSE(decode("not a cursor", micros, jobId));
+
+  // A digit of the timestamp changed into a letter
+  std::string tampered = cursor;
+  tampered[0] = '6';
+  EXPECT_FALSE(decode(tampered, micros, jobId));
+
+  // Hex of "123456" (no job id), ":job-1" (no time) and "12:" (empty id)
+  EXPECT_FALSE(decode("313233343536", micros, jobId));
+  EXPECT_FALSE(decode("3a6a6f622d31", micros, jobId));
+  EXPECT_FALSE(decode("31323a", micros, jobId));
+}
@@ -0,0 +1,138 @@
+#include "http_router.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+RadixRouter<int> makeRouter() {
+  RadixRouter<int> router;
+  router.add("/api/jobs", 1);
+  router.add("/api/jobs/*", 2);
+  router.add("/api/jobs/:id", 3);
+  router.add("/api/jobs/:id/status", 4);
+  router.add("/api/jobs/active", 5);
+  router.add("/api/job-types", 6);
+  router.add("/api/health", 7);
+  return router;
+}
+
+} // namespace
+
+TEST(HttpRouterTest, MatchesLiteralRoutes) {
+  auto router = makeRouter();
+  EXPECT_EQ(router.size(), 7u);
+
+  auto match = router.match("/api/jobs");
+  ASSERT_TRUE(match.has_value());
+  EXPECT_EQ(match->value, 1);
+  EXPECT_TRUE(match->params.empty());
+
+  match = router.match("/api/job-types");
+  ASSERT_TRUE(match.has_value());
+  EXPECT_EQ(match->value, 6);
+
+  EXPECT_FALSE(router.match("/api/job").has_value());
+  EXPECT_FALSE(router.match("/api/healthz").has_value());
+  EXPECT_FALSE(router.match("/").has_value());
+}
+
+TEST(HttpRouterTest, LiteralBeatsParamBeatsCatchAll) {
+  auto router = makeRouter();
+
+  auto match = router.match("/api/jobs/active");
+  ASSERT_TRUE(match.has_value());
+  EXPECT_EQ(match->value, 5);
+
+  match = router.match("/api/jobs/job-42");
+  ASSERT_TRUE(match.has_value());
+  EXPECT_EQ(match->value, 3);
+  EXPECT_EQ(match->params.get("id"), "job-42");
+
+  match = router.match("/api/jobs/job-42/logs/tail");
+  ASSERT_TRUE(match.has_value());
+  EXPECT_EQ(match->value, 2);
+  EXPECT_EQ(match->params.get("*"), "job-42/logs/tail");
+  EXPECT_TRUE(match->params.get("id").empty());
+}
+
+TEST(HttpRouterTest, BacktracksOutOfPartialLiteralMatch) {
+  auto router = makeRouter();
+
+  // "active" is a literal child but "/status" only exists under ":id"
+  auto match = router.match("/api/jobs/active/status");
+  ASSERT_TRUE(match.has_value());
+  EXPECT_EQ(match->value, 4);
+  EXPECT_EQ(match->params.get("id"), "active");
+  EXPECT_EQ(match->params.size(), 1u);
+}
+
+TEST(HttpRouterTest, ParamsAreViewsIntoThePath) {
+  auto router = makeRouter();
+  const std::string path = "/api/jobs/abc/status";
+
+  auto match = router.match(path);
+  ASSERT_TRUE(match.has_value());
+  std::string_view id = match->params.get("id");
+  EXPECT_EQ(id, "abc");
+  EXPECT_GE(id.data(), path.data());
+  EXPECT_LT(id.data(), path.data() + path.size());
+}
+
+TEST(HttpRouterTest, EmptyParamSegmentFallsBackToCatchAll) {
+  auto router = makeRouter();
+
+  auto match = router.match("/api/jobs/");
+  ASSERT_TRUE(match.has_value());
+  EXPECT_EQ(match->value, 2);
+  EXPECT_EQ(match->params.get("*"), "");
+}
+
+TEST(HttpRouterTest, RejectsInvalidAndConflictingRoutes) {
+  RadixRouter<int> router;
+  router.add("/a/:id", 1);
+  router.add("/a/*", 2);
+
+  EXPECT_THROW(router.add("a/b", 3), std::invalid_argument);
+  EXPECT_THROW(router.add("/a/:id", 3), std::invalid_argument);
+  EXPECT_THROW(router.add("/a/*", 3), std::invalid_argument);
+  EXPECT_THROW(router.add("/a/:name/x", 3), std::invalid_argument);
+  EXPECT_THROW(router.add("/a/x*", 3), std::invalid_argument);
+  EXPECT_THROW(router.add("/a/*/x", 3), std::invalid_argument);
+  EXPECT_THROW(router.add("/a/x:id", 3), std::invalid_argument);
+  EXPECT_THROW(router.add("/a/:/x", 3), std::invalid_argument);
+  EXPECT_EQ(router.size(), 2u);
+}
+
+TEST(HttpRouterTest, SplitsRequestTarget) {
+  auto [path, query] = splitRequestTarget("/api/jobs?limit=10&status=running");
+  EXPECT_EQ(path, "/api/jobs");
+  EXPECT_EQ(query, "limit=10&status=running");
+
+  auto [bare, none] = splitRequestTarget("/api/health");
+  EXPECT_EQ(bare, "/api/health");
+  EXPECT_TRUE(none.empty());
+}
+
+TEST(QueryViewTest, LooksUpPairsInPlace) {
+  QueryView query("limit=10&cursor=abc&flag&status=running&limit=20");
+
+  EXPECT_EQ(query.get("limit"), "20"); // last occurrence wins
+  EXPECT_EQ(query.get("cursor"), "abc");
+  EXPECT_FALSE(query.get("flag").has_value());
+  EXPECT_FALSE(query.contains("missing"));
+  EXPECT_TRUE(query.contains("status"));
+
+  std::vector<std::string> keys;
+  query.forEach([&keys](std::string_view k, std::string_view) {
+    keys.emplace_back(k);
+  });
+  EXPECT_EQ(keys, (std::vector<std::string>{"limit", "cursor", "status",
+                                            "limit"}));
+
+  auto map = query.toMap();
+  EXPECT_EQ(map.size(), 3u);
+  EXPECT_EQ(map["limit"], "20");
+  EXPECT_TRUE(QueryView().toMap().empty());
+}
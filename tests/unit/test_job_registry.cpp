@@ -0,0 +1,129 @@
+#include "job_registry.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+class JobRegistryTest : public ::testing::Test {
+protected:
+  static std::shared_ptr<ETLJob>
+  makeJob(const std::string &id, JobType type = JobType::EXTRACT,
+          JobStatus status = JobStatus::PENDING) {
+    auto job = std::make_shared<ETLJob>();
+    job->jobId = id;
+    job->type = type;
+    job->status = status;
+    return job;
+  }
+
+  static std::vector<std::string>
+  ids(const std::vector<JobRegistry::JobPtr> &jobs) {
+    std::vector<std::string> result;
+    for (const auto &job : jobs) {
+      result.push_back(job->jobId);
+    }
+    return result;
+  }
+};
+
+TEST_F(JobRegistryTest, FindsJobsByIdAndRejectsDuplicates) {
+  JobRegistry registry;
+  auto job = makeJob("a");
+  EXPECT_TRUE(registry.insert(job));
+  EXPECT_FALSE(registry.insert(makeJob("a")));
+
+  EXPECT_EQ(registry.find("a"), job);
+  EXPECT_EQ(registry.find("missing"), nullptr);
+  EXPECT_EQ(registry.size(), 1u);
+}
+
+TEST_F(JobRegistryTest, SecondaryIndexesFollowStatusChanges) {
+  JobRegistry registry;
+  auto a = makeJob("a", JobType::LOAD);
+  auto b = makeJob("b", JobType::EXTRACT);
+  auto c = makeJob("c", JobType::LOAD);
+  registry.insert(a);
+  registry.insert(b);
+  registry.insert(c);
+
+  EXPECT_EQ(ids(registry.byStatus(JobStatus::PENDING)),
+            (std::vector<std::string>{"a", "b", "c"}));
+  EXPECT_EQ(ids(registry.byType(JobType::LOAD)),
+            (std::vector<std::string>{"a", "c"}));
+
+  EXPECT_EQ(registry.setStatus(b, JobStatus::RUNNING), JobStatus::PENDING);
+  EXPECT_EQ(b->status, JobStatus::RUNNING);
+  EXPECT_EQ(ids(registry.byStatus(JobStatus::PENDING)),
+            (std::vector<std::string>{"a", "c"}));
+  EXPECT_EQ(ids(registry.byStatus(JobStatus::RUNNING)),
+            (std::vector<std::string>{"b"}));
+}
+
+TEST_F(JobRegistryTest, TransitionStatusOnlyFromExpectedState) {
+  JobRegistry registry;
+  auto job = makeJob("a");
+  registry.insert(job);
+
+  EXPECT_TRUE(registry.transitionStatus(job, JobStatus::PENDING,
+                                        JobStatus::CANCELLED));
+  EXPECT_FALSE(
+      registry.transitionStatus(job, JobStatus::PENDING, JobStatus::RUNNING));
+  EXPECT_EQ(job->status, JobStatus::CANCELLED);
+  EXPECT_EQ(ids(registry.byStatus(JobStatus::CANCELLED)),
+            (std::vector<std::string>{"a"}));
+}
+
+TEST_F(JobRegistryTest, EvictsLeastRecentlyUsedFinishedJobs) {
+  JobRegistry registry(2);
+  std::vector<std::string> evicted;
+  registry.setEvictionHandler([&evicted](const JobRegistry::JobPtr &job) {
+    evicted.push_back(job->jobId);
+  });
+
+  auto active = makeJob("active");
+  registry.insert(active);
+  registry.insert(makeJob("done1", JobType::LOAD, JobStatus::COMPLETED));
+  registry.insert(makeJob("done2", JobType::LOAD, JobStatus::FAILED));
+
+  // Touch done1 so done2 becomes the eviction candidate
+  ASSERT_NE(registry.find("done1"), nullptr);
+  registry.insert(makeJob("done3", JobType::LOAD, JobStatus::COMPLETED));
+
+  EXPECT_EQ(evicted, (std::vector<std::string>{"done2"}));
+  EXPECT_EQ(registry.find("done2"), nullptr);
+  EXPECT_EQ(registry.evictedCount(), 1u);
+  EXPECT_TRUE(registry.byStatus(JobStatus::FAILED).empty());
+
+  // The active job was never a candidate; once it finishes it is the most
+  // recently used, so the oldest finished job goes instead
+  EXPECT_EQ(registry.find("active"), active);
+  registry.setStatus(active, JobStatus::COMPLETED);
+  EXPECT_EQ(evicted, (std::vector<std::string>{"done2", "done1"}));
+  EXPECT_EQ(registry.find("active"), active);
+  EXPECT_EQ(registry.size(), 2u);
+}
+
+TEST_F(JobRegistryTest, ConcurrentReadersAndWriters) {
+  JobRegistry registry(64);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&registry, t] {
+      for (int i = 0; i < 500; ++i) {
+        auto job = makeJob("job-" + std::to_string(t) + "-" +
+                           std::to_string(i));
+        registry.insert(job);
+        registry.setStatus(job, JobStatus::RUNNING);
+        registry.setStatus(job, JobStatus::COMPLETED);
+        registry.find(job->jobId);
+        registry.byStatus(JobStatus::COMPLETED);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(registry.size(), 64u);
+  EXPECT_EQ(registry.byStatus(JobStatus::COMPLETED).size(), 64u);
+  EXPECT_EQ(registry.evictedCount(), 2000u - 64u);
+}
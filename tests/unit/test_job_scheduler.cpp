@@ -0,0 +1,122 @@
+#include "job_scheduler.hpp"
+#include <future>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+class JobSchedulerTest : public ::testing::Test {
+protected:
+  static std::shared_ptr<ETLJob> makeJob(const std::string &id, JobType type,
+                                         JobPriority priority) {
+    auto job = std::make_shared<ETLJob>();
+    job->jobId = id;
+    job->type = type;
+    job->priority = priority;
+    return job;
+  }
+
+  static JobSchedulerConfig noAging() {
+    JobSchedulerConfig config;
+    config.agingInterval = std::chrono::milliseconds(0);
+    return config;
+  }
+};
+
+TEST_F(JobSchedulerTest, DispatchesByPriorityThenFifo) {
+  JobScheduler scheduler(noAging());
+  scheduler.enqueue(makeJob("low", JobType::EXTRACT, JobPriority::LOW));
+  scheduler.enqueue(makeJob("n1", JobType::LOAD, JobPriority::NORMAL));
+  scheduler.enqueue(makeJob("crit", JobType::FULL_ETL, JobPriority::CRITICAL));
+  scheduler.enqueue(makeJob("n2", JobType::EXTRACT, JobPriority::NORMAL));
+  EXPECT_EQ(scheduler.queueDepth(), 4u);
+
+  EXPECT_EQ(scheduler.acquireNext()->jobId, "crit");
+  EXPECT_EQ(scheduler.acquireNext()->jobId, "n1");
+  EXPECT_EQ(scheduler.acquireNext()->jobId, "n2");
+  EXPECT_EQ(scheduler.acquireNext()->jobId, "low");
+  EXPECT_EQ(scheduler.queueDepth(), 0u);
+}
+
+TEST_F(JobSchedulerTest, PerTypeLimitSkipsSaturatedType) {
+  auto config = noAging();
+  config.maxConcurrentByType[static_cast<size_t>(JobType::FULL_ETL)] = 1;
+  JobScheduler scheduler(config);
+
+  scheduler.enqueue(makeJob("etl1", JobType::FULL_ETL, JobPriority::HIGH));
+  scheduler.enqueue(makeJob("etl2", JobType::FULL_ETL, JobPriority::HIGH));
+  scheduler.enqueue(makeJob("extract", JobType::EXTRACT, JobPriority::LOW));
+
+  auto first = scheduler.acquireNext();
+  EXPECT_EQ(first->jobId, "etl1");
+  // etl2 has higher priority but FULL_ETL is at its limit
+  EXPECT_EQ(scheduler.acquireNext()->jobId, "extract");
+
+  auto pending = std::async(std::launch::async,
+                            [&scheduler] { return scheduler.acquireNext(); });
+  EXPECT_EQ(pending.wait_for(std::chrono::milliseconds(50)),
+            std::future_status::timeout);
+
+  scheduler.release(*first);
+  ASSERT_EQ(pending.wait_for(std::chrono::seconds(2)),
+            std::future_status::ready);
+  EXPECT_EQ(pending.get()->jobId, "etl2");
+}
+
+TEST_F(JobSchedulerTest, AgingPromotesLongWaitingJobs) {
+  JobSchedulerConfig config;
+  config.agingInterval = std::chrono::milliseconds(10);
+  JobScheduler scheduler(config);
+
+  scheduler.enqueue(makeJob("old-low", JobType::EXTRACT, JobPriority::LOW));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  scheduler.enqueue(makeJob("new-high", JobType::EXTRACT, JobPriority::HIGH));
+
+  EXPECT_EQ(scheduler.acquireNext()->jobId, "old-low");
+  EXPECT_EQ(scheduler.acquireNext()->jobId, "new-high");
+}
+
+TEST_F(JobSchedulerTest, RemoveDropsQueuedJob) {
+  JobScheduler scheduler(noAging());
+  scheduler.enqueue(makeJob("a", JobType::LOAD, JobPriority::NORMAL));
+  scheduler.enqueue(makeJob("b", JobType::LOAD, JobPriority::NORMAL));
+
+  EXPECT_TRUE(scheduler.remove("a"));
+  EXPECT_FALSE(scheduler.remove("a"));
+  EXPECT_EQ(scheduler.queueDepth(), 1u);
+  EXPECT_EQ(scheduler.acquireNext()->jobId, "b");
+}
+
+TEST_F(JobSchedulerTest, ShutdownWakesWaitingWorkers) {
+  JobScheduler scheduler;
+  auto waiting = std::async(std::launch::async,
+                            [&scheduler] { return scheduler.acquireNext(); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  scheduler.shutdown();
+  ASSERT_EQ(waiting.wait_for(std::chrono::seconds(2)),
+            std::future_status::ready);
+  EXPECT_EQ(waiting.get(), nullptr);
+}
+
+TEST_F(JobSchedulerTest, MetricsTrackDepthRunningAndWaitTime) {
+  JobScheduler scheduler(noAging());
+  scheduler.enqueue(makeJob("a", JobType::TRANSFORM, JobPriority::HIGH));
+  scheduler.enqueue(makeJob("b", JobType::LOAD, JobPriority::LOW));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  auto job = scheduler.acquireNext();
+  EXPECT_GE(job->metrics.queueWaitTime.count(), 20);
+
+  auto metrics = scheduler.getMetrics();
+  EXPECT_EQ(metrics.queueDepth, 1u);
+  EXPECT_EQ(metrics.queuedByPriority[static_cast<size_t>(JobPriority::LOW)],
+            1u);
+  EXPECT_EQ(metrics.runningJobs, 1u);
+  EXPECT_EQ(metrics.runningByType[static_cast<size_t>(JobType::TRANSFORM)],
+            1u);
+  EXPECT_EQ(metrics.dispatchedJobs, 1u);
+  EXPECT_GE(metrics.maxWaitTime.count(), 20);
+
+  scheduler.release(*job);
+  EXPECT_EQ(scheduler.getMetrics().runningJobs, 0u);
+}
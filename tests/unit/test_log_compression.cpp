@@ -0,0 +1,401 @@
+#include "log_compression.hpp"
+#include "log_file_manager.hpp"
+#include "logger.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+const std::time_t kStart = [] {
+  std::tm tm{};
+  tm.tm_year = 2024 - 1900;
+  tm.tm_mon = 3;
+  tm.tm_mday = 10;
+  tm.tm_hour = 6;
+  tm.tm_isdst = -1;
+  return std::mktime(&tm);
+}();
+
+// Line i is logged i seconds after kStart, in Logger's text layout; every
+// 100th line is an ERROR
+std::string textLine(int i) {
+  const std::time_t time = kStart + i;
+  std::tm tm{};
+  localtime_r(&time, &tm);
+  std::ostringstream line;
+  line << "[" << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << ".000] ["
+       << (i % 100 == 99 ? "ERROR" : "INFO ") << "] [Loader] [Job: job-"
+       << i % 4 << "] loaded batch " << i << "\n";
+  return line.str();
+}
+
+std::string textLog(int lines) {
+  std::string log;
+  for (int i = 0; i < lines; ++i) {
+    log += textLine(i);
+  }
+  return log;
+}
+
+std::vector<CompressionType> supportedTypes() {
+  std::vector<CompressionType> types;
+  for (auto type : {CompressionType::GZIP, CompressionType::ZSTD,
+                    CompressionType::LZ4}) {
+    if (isCompressionSupported(type)) {
+      types.push_back(type);
+    }
+  }
+  return types;
+}
+
+std::string readFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream data;
+  data << in.rdbuf();
+  return data.str();
+}
+
+class LogCompressionTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    dir_ = std::filesystem::temp_directory_path() /
+           (std::string("log_compression_") +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir_); }
+
+  // Writes log through a SeekableLogWriter with small frames
+  std::string writeSeekable(const std::string &name, CompressionType type,
+                            const std::string &log) {
+    const std::string path = (dir_ / name).string();
+    std::ofstream out(path, std::ios::binary);
+    SeekableLogWriter writer(out, type, 3, 4096);
+    // Uneven pieces, so frames do not line up with writes
+    for (size_t offset = 0; offset < log.size(); offset += 1000) {
+      EXPECT_TRUE(writer.write(std::string_view(log).substr(offset, 1000)));
+    }
+    EXPECT_TRUE(writer.finish());
+    return path;
+  }
+
+  // Rotated files still waiting to be compressed
+  size_t pendingFiles() const {
+    size_t pending = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(dir_)) {
+      pending += entry.path().extension() == ".pending";
+    }
+    return pending;
+  }
+
+  std::filesystem::path dir_;
+};
+
+std::string decompressed(const std::string &path) {
+  std::string text;
+  SeekableLogReader(path).readAll([&text](std::string_view piece) {
+    text.append(piece);
+    return true;
+  });
+  return text;
+}
+
+} // namespace
+
+TEST(LogCompressionBufferTest, RoundTripsEverySupportedFormat) {
+  EXPECT_TRUE(isCompressionSupported(CompressionType::GZIP));
+  EXPECT_FALSE(isCompressionSupported(CompressionType::BZIP2));
+
+  const std::string log = textLog(500);
+  for (auto type : supportedTypes()) {
+    std::string compressed;
+    ASSERT_TRUE(compressLogBuffer(type, 3, log, compressed));
+    EXPECT_LT(compressed.size(), log.size() / 4);
+
+    // Two streams back to back decode as their concatenation
+    std::string twice = compressed + compressed;
+    std::string restored;
+    ASSERT_TRUE(decompressLogBuffer(type, twice, restored));
+    EXPECT_EQ(restored, log + log);
+
+    restored.clear();
+    EXPECT_FALSE(decompressLogBuffer(
+        type, std::string_view(compressed).substr(0, compressed.size() / 2),
+        restored));
+  }
+
+  LogFileCompressor compressor;
+  std::string compressed;
+  std::string restored;
+  ASSERT_TRUE(compressor.compressInMemory(log, compressed,
+                                          CompressionType::GZIP));
+  ASSERT_TRUE(compressor.decompressInMemory(compressed, restored,
+                                            CompressionType::GZIP));
+  EXPECT_EQ(restored, log);
+}
+
+TEST_F(LogCompressionTest, SeekTableFramesTileTheLog) {
+  const std::string log = textLog(2000);
+  for (auto type : supportedTypes()) {
+    const std::string path = writeSeekable("log.z", type, log);
+    SeekableLogReader reader(path);
+    ASSERT_EQ(reader.type(), type);
+    const auto &frames = reader.frames();
+    ASSERT_GT(frames.size(), 10u);
+
+    uint64_t raw = 0;
+    uint64_t lines = 0;
+    std::string frame;
+    for (size_t i = 0; i < frames.size(); ++i) {
+      EXPECT_EQ(frames[i].rawOffset, raw);
+      ASSERT_TRUE(reader.readFrame(i, frame));
+      ASSERT_EQ(frame.size(), frames[i].rawBytes);
+      EXPECT_EQ(frame, log.substr(raw, frame.size()));
+      // Cut at line ends, with the times and levels of those lines
+      EXPECT_EQ(frame.back(), '\n');
+      EXPECT_LE(frames[i].minTimeMs, frames[i].maxTimeMs);
+      raw += frame.size();
+      lines += frames[i].lines;
+    }
+    EXPECT_EQ(raw, log.size());
+    EXPECT_EQ(lines, 2000u);
+    EXPECT_EQ(frames.front().minTimeMs,
+              static_cast<int64_t>(kStart) * 1000);
+    EXPECT_EQ(frames.back().maxTimeMs,
+              static_cast<int64_t>(kStart + 1999) * 1000);
+
+    // The seek table does not get in the way of a whole-file decode
+    std::string whole;
+    ASSERT_TRUE(decompressLogBuffer(type, readFile(path), whole));
+    EXPECT_EQ(whole, log);
+    whole.clear();
+    ASSERT_TRUE(reader.readAll([&](std::string_view piece) {
+      whole.append(piece);
+      return true;
+    }));
+    EXPECT_EQ(whole, log);
+  }
+}
+
+TEST_F(LogCompressionTest, StandardToolsReadSeekableGzip) {
+  if (std::system("gzip --version > /dev/null 2>&1") != 0) {
+    GTEST_SKIP() << "gzip is not installed";
+  }
+  const std::string log = textLog(1000);
+  const std::string path = writeSeekable("log.gz", CompressionType::GZIP, log);
+  const std::string plain = (dir_ / "plain.log").string();
+  ASSERT_EQ(std::system(("gzip -dc " + path + " > " + plain).c_str()), 0);
+  EXPECT_EQ(readFile(plain), log);
+
+  // A file gzip wrote has no seek table and is read whole
+  ASSERT_EQ(std::system(("gzip -kf " + plain).c_str()), 0);
+  SeekableLogReader reader(plain + ".gz");
+  EXPECT_EQ(reader.type(), CompressionType::GZIP);
+  EXPECT_TRUE(reader.frames().empty());
+  std::string whole;
+  ASSERT_TRUE(reader.readAll([&](std::string_view piece) {
+    whole.append(piece);
+    return true;
+  }));
+  EXPECT_EQ(whole, log);
+}
+
+TEST_F(LogCompressionTest, CompressesRotatedFilesInTheBackground) {
+  LogFileManagerConfig config;
+  config.logDirectory = dir_.string();
+  config.archive.archiveDirectory = (dir_ / "archive").string();
+  config.enableFileMonitoring = false;
+  config.indexing.indexDirectory = (dir_ / "index").string();
+  config.rotation.compressRotatedFiles = true;
+  config.rotation.compressionType = CompressionType::GZIP;
+  config.performance.compressionFrameSize = 4096;
+
+  LogFileManager manager(config);
+  ASSERT_TRUE(manager.initializeLogFile("etl.log"));
+  for (int i = 0; i < 1000; ++i) {
+    manager.writeToFile("etl.log", textLine(i));
+  }
+  manager.flush();
+  ASSERT_TRUE(manager.rotateLogFile("etl.log"));
+  for (int i = 1000; i < 1100; ++i) {
+    manager.writeToFile("etl.log", textLine(i));
+  }
+  manager.flush();
+  ASSERT_TRUE(manager.waitForPendingCompression());
+
+  EXPECT_FALSE(std::filesystem::exists(dir_ / "etl.1.log"));
+  const std::string backup = (dir_ / "etl.1.log.gz").string();
+  ASSERT_TRUE(std::filesystem::exists(backup));
+  EXPECT_GT(SeekableLogReader(backup).frames().size(), 1u);
+
+  auto metrics = manager.getMetrics();
+  EXPECT_EQ(metrics.totalFilesCompressed, 1u);
+  EXPECT_EQ(metrics.totalBytesCompressed, textLog(1000).size());
+  EXPECT_GT(metrics.getCompressionRatio(), 0.0);
+  EXPECT_LT(metrics.getCompressionRatio(), 0.5);
+
+  // Search reaches into the compressed backup, alongside the live file
+  LogQueryParams params;
+  params.minLevel = LogLevel::ERROR;
+  auto entries = manager.searchLogEntries(params);
+  ASSERT_EQ(entries.size(), 11u);
+  EXPECT_EQ(entries.front().filename, "etl.1.log.gz");
+  EXPECT_EQ(entries.front().message, "loaded batch 99");
+  EXPECT_EQ(entries.front().lineNumber, 100u);
+  EXPECT_EQ(entries.back().filename, "etl.log");
+
+  params = LogQueryParams();
+  params.jobId = "job-2";
+  params.startTime = Clock::from_time_t(kStart + 500);
+  params.endTime = Clock::from_time_t(kStart + 519);
+  entries = manager.searchLogEntries(params);
+  ASSERT_EQ(entries.size(), 5u);
+  EXPECT_EQ(entries.front().message, "loaded batch 502");
+}
+
+TEST_F(LogCompressionTest, RotatesAgainWhileTheLastBackupIsCompressing) {
+  LogFileManagerConfig config;
+  config.logDirectory = dir_.string();
+  config.archive.archiveDirectory = (dir_ / "archive").string();
+  config.enableFileMonitoring = false;
+  config.indexing.indexDirectory = (dir_ / "index").string();
+  config.rotation.compressRotatedFiles = true;
+  config.rotation.compressionType = CompressionType::GZIP;
+
+  LogFileManager manager(config);
+  ASSERT_TRUE(manager.initializeLogFile("etl.log"));
+  for (int i = 0; i < 5000; ++i) {
+    manager.writeToFile("etl.log", textLine(i));
+  }
+  manager.flush();
+  // Neither rotation waits for the compression the other queued
+  ASSERT_TRUE(manager.rotateLogFile("etl.log"));
+  for (int i = 5000; i < 5100; ++i) {
+    manager.writeToFile("etl.log", textLine(i));
+  }
+  manager.flush();
+  ASSERT_TRUE(manager.rotateLogFile("etl.log"));
+  ASSERT_TRUE(manager.waitForPendingCompression());
+
+  EXPECT_EQ(pendingFiles(), 0u);
+  EXPECT_FALSE(std::filesystem::exists(dir_ / "etl.1.log"));
+  // The newest backup wins, whole
+  std::string expected;
+  for (int i = 5000; i < 5100; ++i) {
+    expected += textLine(i);
+  }
+  EXPECT_EQ(decompressed((dir_ / "etl.1.log.gz").string()), expected);
+  EXPECT_EQ(manager.getMetrics().totalFilesCompressed, 2u);
+}
+
+TEST_F(LogCompressionTest, ScansRotatedFilesWaitingForCompression) {
+  LogFileManagerConfig config;
+  config.logDirectory = dir_.string();
+  config.archive.archiveDirectory = (dir_ / "archive").string();
+  config.enableFileMonitoring = false;
+  config.indexing.indexDirectory = (dir_ / "index").string();
+
+  {
+    LogFileManager manager(config);
+    ASSERT_TRUE(manager.initializeLogFile("etl.log"));
+    for (int i = 1000; i < 1100; ++i) {
+      manager.writeToFile("etl.log", textLine(i));
+    }
+    manager.flush();
+    // A rotated backup the compression queue has not reached yet
+    std::ofstream(dir_ / "etl.1.log.3.pending") << textLog(1000);
+
+    for (const auto &file : manager.listLogFiles(false, true)) {
+      EXPECT_NE(file.filename, "etl.1.log.3.pending");
+    }
+    LogQueryParams params;
+    params.minLevel = LogLevel::ERROR;
+    auto entries = manager.searchLogEntries(params);
+    ASSERT_EQ(entries.size(), 11u);
+    EXPECT_EQ(entries.front().filename, "etl.1.log.3.pending");
+    EXPECT_EQ(entries.front().message, "loaded batch 99");
+    EXPECT_EQ(entries.back().filename, "etl.log");
+    EXPECT_EQ(manager.rebuildAllIndexes(), 1u);
+  }
+
+  // No index outlives the pending file
+  for (const auto &entry :
+       std::filesystem::directory_iterator(dir_ / "index")) {
+    EXPECT_EQ(entry.path().filename().string().find(".pending"),
+              std::string::npos)
+        << entry.path();
+  }
+}
+
+TEST_F(LogCompressionTest, LoggerKeepsBackupOrderWhileCompressing) {
+  LogConfig config;
+  config.consoleOutput = false;
+  config.fileOutput = true;
+  config.logFile = (dir_ / "etl.log").string();
+  config.enableHistoricalAccess = false;
+  config.enableLogIndexing = false;
+  config.enableRotation = true;
+  config.maxFileSize = 8 * 1024;
+  config.maxBackupFiles = 100;
+  config.rotation.compressOldLogs = true;
+  config.rotation.compressionFormat = "gzip";
+  Logger::getInstance().configure(config);
+
+  // Many rotations in a row, none of which waits for compression
+  for (int i = 0; i < 2000; ++i) {
+    Logger::getInstance().info("Rotation", "line " + std::to_string(i));
+  }
+  Logger::getInstance().flush();
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (pendingFiles() > 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  LogConfig off;
+  off.consoleOutput = false;
+  off.fileOutput = false;
+  Logger::getInstance().configure(off);
+  ASSERT_EQ(pendingFiles(), 0u);
+
+  // Oldest backup first, then the live file: every line, in order
+  std::string text;
+  int backups = 0;
+  while (std::filesystem::exists(
+      dir_ / ("etl.log." + std::to_string(backups + 1) + ".gz"))) {
+    ++backups;
+  }
+  ASSERT_GT(backups, 5);
+  for (int i = backups; i > 0; --i) {
+    EXPECT_FALSE(
+        std::filesystem::exists(dir_ / ("etl.log." + std::to_string(i))));
+    text += decompressed(
+        (dir_ / ("etl.log." + std::to_string(i) + ".gz")).string());
+  }
+  text += readFile((dir_ / "etl.log").string());
+
+  std::istringstream lines(text);
+  std::string line;
+  int next = 0;
+  while (std::getline(lines, line)) {
+    // The logger's own lines are interleaved
+    const size_t pos = line.find("[Rotation] line ");
+    if (pos == std::string::npos) {
+      continue;
+    }
+    EXPECT_EQ(std::stoi(line.substr(pos + 16)), next++);
+  }
+  EXPECT_EQ(next, 2000);
+}
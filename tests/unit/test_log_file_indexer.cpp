@@ -0,0 +1,261 @@
+#include "log_file_manager.hpp"
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+// A day-aligned local start time, so tests do not straddle a DST change
+const std::time_t kStart = [] {
+  std::tm tm{};
+  tm.tm_year = 2024 - 1900;
+  tm.tm_mon = 0;
+  tm.tm_mday = 15;
+  tm.tm_hour = 8;
+  tm.tm_isdst = -1;
+  return std::mktime(&tm);
+}();
+
+// Line i is logged i minutes after kStart, in FileLogHandler's text layout
+std::string textLine(int i, const std::string &level, const std::string &job,
+                     const std::string &message) {
+  const std::time_t time = kStart + i * 60;
+  std::tm tm{};
+  localtime_r(&time, &tm);
+  std::ostringstream line;
+  line << "[" << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << ".250] [" << level
+       << "] [Transformer] ";
+  if (!job.empty()) {
+    line << "[Job: " << job << "] ";
+  }
+  line << message << "\n";
+  return line.str();
+}
+
+Clock::time_point minute(int i) {
+  return Clock::from_time_t(kStart + i * 60);
+}
+
+class LogFileIndexerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    dir_ = std::filesystem::temp_directory_path() /
+           (std::string("log_indexer_") +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+
+    config_.logDirectory = dir_.string();
+    config_.archive.archiveDirectory = (dir_ / "archive").string();
+    config_.rotation.enabled = false;
+    config_.enableFileMonitoring = false;
+    config_.indexing.indexDirectory = (dir_ / "index").string();
+    config_.indexing.indexBlockLines = 4;
+    config_.indexing.indexFlushInterval = 8;
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir_); }
+
+  // 40 lines: job-a for the first 20 minutes, then job-b; every tenth line
+  // is an ERROR
+  void writeJobLog(LogFileManager &manager) {
+    ASSERT_TRUE(manager.initializeLogFile("etl.log"));
+    for (int i = 0; i < 40; ++i) {
+      manager.writeToFile("etl.log",
+                          textLine(i, i % 10 == 9 ? "ERROR" : "INFO ",
+                                   i < 20 ? "job-a" : "job-b",
+                                   "step " + std::to_string(i)));
+    }
+    manager.flush();
+  }
+
+  std::string logPath() const { return (dir_ / "etl.log").string(); }
+  std::string indexPath() const {
+    return (dir_ / "index" / "etl.log.idx").string();
+  }
+
+  std::filesystem::path dir_;
+  LogFileManagerConfig config_;
+};
+
+} // namespace
+
+TEST(ParseLogLineTest, ReadsTextAndJsonLayouts) {
+  std::string line = textLine(3, "WARN ", "job-7", "slow batch");
+  line.pop_back(); // the indexer hands over lines without the newline
+  auto text = parseLogLine(line);
+  ASSERT_TRUE(text.has_value());
+  EXPECT_EQ(text->timestampMs,
+            static_cast<int64_t>(kStart + 180) * 1000 + 250);
+  EXPECT_EQ(text->level, LogLevel::WARN);
+  EXPECT_EQ(text->component, "Transformer");
+  EXPECT_EQ(text->jobId, "job-7");
+  EXPECT_EQ(text->message, "slow batch");
+
+  auto json = parseLogLine(
+      R"({"timestamp":"2024-01-15 08:00:00.000","level":"ERROR",)"
+      R"("component":"Loader","message":"said \"no\"","jobId":"job-9"})");
+  ASSERT_TRUE(json.has_value());
+  EXPECT_EQ(json->level, LogLevel::ERROR);
+  EXPECT_EQ(json->component, "Loader");
+  EXPECT_EQ(json->jobId, "job-9");
+  EXPECT_EQ(json->message, R"(said \"no\")");
+
+  EXPECT_FALSE(parseLogLine("    at frame #3").has_value());
+  EXPECT_FALSE(parseLogLine("[not a time] [INFO] [X] hi").has_value());
+}
+
+TEST_F(LogFileIndexerTest, AnswersJobAndTimeQueriesFromTheIndex) {
+  LogFileManager manager(config_);
+  writeJobLog(manager);
+
+  LogQueryParams params;
+  params.jobId = "job-b";
+  params.startTime = minute(30);
+  auto entries = manager.searchLogEntries(params);
+  ASSERT_EQ(entries.size(), 10u);
+  EXPECT_EQ(entries.front().lineNumber, 31u);
+  EXPECT_EQ(entries.front().message, "step 30");
+  EXPECT_EQ(entries.front().jobId, "job-b");
+  EXPECT_EQ(entries.front().filename, "etl.log");
+  EXPECT_EQ(entries.back().lineNumber, 40u);
+
+  params = LogQueryParams();
+  params.minLevel = LogLevel::ERROR;
+  params.ascending = false;
+  entries = manager.searchLogEntries(params);
+  ASSERT_EQ(entries.size(), 4u);
+  EXPECT_EQ(entries.front().message, "step 39");
+
+  params = LogQueryParams();
+  params.searchText = "step 1";
+  params.offset = 2;
+  params.maxResults = 3;
+  entries = manager.searchLogEntries(params);
+  ASSERT_EQ(entries.size(), 3u); // step 1, 10..19 match; skip two
+  EXPECT_EQ(entries.front().message, "step 11");
+
+  auto stats = manager.getIndexStatistics();
+  EXPECT_EQ(stats["index"]["totalEntries"], 40u);
+  EXPECT_EQ(stats["index"]["totalBlocks"], 10u);
+}
+
+TEST_F(LogFileIndexerTest, PersistsAndVerifiesTheSidecar) {
+  {
+    LogFileManager manager(config_);
+    writeJobLog(manager);
+  }
+
+  LogFileIndexer indexer(config_.indexing);
+  EXPECT_TRUE(indexer.verifyIndexIntegrity(indexPath()));
+  ASSERT_TRUE(indexer.indexFile(logPath()));
+  EXPECT_EQ(indexer.getIndexStatistics()["totalEntries"], 40u);
+
+  // A damaged sidecar fails verification and is rebuilt from the log
+  {
+    std::fstream sidecar(indexPath(),
+                         std::ios::in | std::ios::out | std::ios::binary);
+    sidecar.seekp(20);
+    sidecar.put('\x7f');
+  }
+  EXPECT_FALSE(indexer.verifyIndexIntegrity(indexPath()));
+
+  LogFileIndexer reloaded(config_.indexing);
+  ASSERT_TRUE(reloaded.indexFile(logPath()));
+  LogQueryParams params;
+  params.jobId = "job-a";
+  EXPECT_EQ(reloaded.searchIndex(params).size(), 20u);
+}
+
+TEST_F(LogFileIndexerTest, IndexesAppendsIncrementally) {
+  LogFileIndexer indexer(config_.indexing);
+  std::ofstream log(logPath(), std::ios::binary);
+  uint64_t offset = 0;
+  auto append = [&](const std::string &data) {
+    log << data << std::flush;
+    indexer.appendToIndex(logPath(), data, offset);
+    offset += data.size();
+  };
+
+  // A line split across writes is indexed once it is complete
+  const std::string line = textLine(0, "INFO ", "job-a", "first");
+  append(line.substr(0, 10));
+  EXPECT_EQ(indexer.getIndexStatistics()["totalEntries"], 0u);
+  append(line.substr(10));
+  append(textLine(1, "INFO ", "job-a", "second"));
+  EXPECT_EQ(indexer.getIndexStatistics()["totalEntries"], 2u);
+
+  // A write the indexer was not told about leaves a gap; the index goes
+  // stale until indexFile() catches up from the file
+  const std::string missed = textLine(2, "INFO ", "job-a", "missed");
+  log << missed << std::flush;
+  offset += missed.size();
+  append(textLine(3, "INFO ", "job-a", "after"));
+  EXPECT_EQ(indexer.getIndexStatistics()["staleFiles"], 1u);
+
+  ASSERT_TRUE(indexer.indexFile(logPath()));
+  auto stats = indexer.getIndexStatistics();
+  EXPECT_EQ(stats["staleFiles"], 0u);
+  EXPECT_EQ(stats["totalEntries"], 4u);
+
+  LogQueryParams params;
+  params.searchText = "missed";
+  auto entries = indexer.searchIndex(params);
+  ASSERT_EQ(entries.size(), 1u);
+  EXPECT_EQ(entries.front().lineNumber, 3u);
+}
+
+TEST_F(LogFileIndexerTest, SearchesWhileLinesAreAppended) {
+  LogFileIndexer indexer(config_.indexing);
+  std::ofstream log(logPath(), std::ios::binary);
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    uint64_t offset = 0;
+    for (int i = 0; i < 200; ++i) {
+      const std::string line = textLine(i, "INFO ", "job-a", "row");
+      log << line << std::flush;
+      indexer.appendToIndex(logPath(), line, offset);
+      offset += line.size();
+    }
+    done = true;
+  });
+
+  LogQueryParams params;
+  params.jobId = "job-a";
+  params.maxResults = 1000;
+  size_t seen = 0;
+  while (!done) {
+    const size_t found = indexer.searchIndex(params).size();
+    EXPECT_GE(found, seen);
+    seen = found;
+  }
+  writer.join();
+  EXPECT_EQ(indexer.searchIndex(params).size(), 200u);
+}
+
+TEST_F(LogFileIndexerTest, SearchesAppendsThatAreNotFlushedYet) {
+  LogFileManager manager(config_);
+  ASSERT_TRUE(manager.initializeLogFile("etl.log"));
+  for (int i = 0; i < 1000; ++i) {
+    manager.writeToFile("etl.log", textLine(i % 600, "INFO ", "job-a",
+                                            "row " + std::to_string(i)));
+  }
+  EXPECT_EQ(manager.getIndexStatistics()["index"]["totalEntries"], 1000u);
+
+  // Nothing was flushed: the search must not take the short file for a
+  // truncated one and rebuild the index from it
+  LogQueryParams params;
+  params.jobId = "job-a";
+  params.maxResults = 2000;
+  EXPECT_EQ(manager.searchLogEntries(params).size(), 1000u);
+  EXPECT_EQ(manager.getIndexStatistics()["index"]["totalEntries"], 1000u);
+}
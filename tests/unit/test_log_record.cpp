@@ -0,0 +1,280 @@
+#include "component_logger.hpp"
+#include "log_record.hpp"
+#include "logger.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// A record as ComponentLogger::record() builds one
+template <typename... Args>
+std::string encode(LogLevel level, const char *format, const Args &...args) {
+  std::string out;
+  LogRecordWriter record(out);
+  record.begin(level, sizeof...(Args), 0);
+  record.literal("Loader", 6);
+  record.literal(format, std::char_traits<char>::length(format));
+  (record.arg(args), ...);
+  return out;
+}
+
+std::string render(const std::string &record, LogFormat format) {
+  std::string line;
+  renderLogRecord(record, format, line);
+  return line;
+}
+
+// The line without its "[timestamp] " prefix
+std::string afterTimestamp(const std::string &line) {
+  return line.substr(line.find("] ") + 2);
+}
+
+class FastLoggingTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    dir_ = std::filesystem::temp_directory_path() /
+           (std::string("fast_logging_") +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+
+    config_.consoleOutput = false;
+    config_.fileOutput = true;
+    config_.logFile = (dir_ / "etl.log").string();
+    config_.enableHistoricalAccess = false;
+    config_.enableLogIndexing = false;
+    config_.enableRotation = false;
+    config_.asyncQueueSize = 64;
+  }
+
+  void TearDown() override {
+    LogConfig off;
+    off.consoleOutput = false;
+    off.fileOutput = false;
+    Logger::getInstance().configure(off);
+    std::filesystem::remove_all(dir_);
+  }
+
+  // Lines after the logger's startup line
+  std::vector<std::string> loggedLines() const {
+    Logger::getInstance().flush();
+    std::ifstream in(dir_ / "etl.log");
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.find("[Logger]") == std::string::npos) {
+        lines.push_back(line);
+      }
+    }
+    return lines;
+  }
+
+  std::filesystem::path dir_;
+  LogConfig config_;
+};
+
+// Counts how often it is turned into a string
+struct Probe {
+  static int conversions;
+  operator std::string() const {
+    ++conversions;
+    return "probe";
+  }
+};
+int Probe::conversions = 0;
+
+} // namespace
+
+TEST(LogRecordTest, RendersArgumentsAsAStreamWould) {
+  const std::string record =
+      encode(LogLevel::WARN, "batch {} of {}: {} rows, {} ok={} [{}] {}", 3,
+             7u, 2.5, -41L, true, 'x', std::string("done"));
+  EXPECT_EQ(afterTimestamp(render(record, LogFormat::TEXT)),
+            "[WARN ] [Loader] batch 3 of 7: 2.5 rows, -41 ok=1 [x] done\n");
+  EXPECT_EQ(renderLogMessage(record),
+            "batch 3 of 7: 2.5 rows, -41 ok=1 [x] done");
+
+  // Placeholders without arguments stay; arguments without one are dropped
+  EXPECT_EQ(renderLogMessage(encode(LogLevel::INFO, "{} and {}", 1)),
+            "1 and {}");
+  EXPECT_EQ(renderLogMessage(encode(LogLevel::INFO, "only {}", 1, 2, 3)),
+            "only 1");
+  EXPECT_EQ(renderLogMessage(encode(LogLevel::INFO, "verbatim {}")),
+            "verbatim {}");
+
+  std::unordered_map<std::string, std::string> one = {{"rows", "12"}};
+  EXPECT_EQ(renderLogMessage(encode(LogLevel::INFO, "{} {} {}", one,
+                                    std::vector<int>{}, 1e20)),
+            "{rows: 12} [object] 1e+20");
+}
+
+TEST(LogRecordTest, RendersJsonWithContext) {
+  std::string record;
+  LogRecordWriter writer(record);
+  writer.begin(LogLevel::ERROR, 1, 1);
+  writer.string("Http\"Server");
+  writer.literal("failed: {}", 10);
+  writer.arg("line\nbreak");
+  writer.string("code");
+  writer.string("5\t03");
+
+  const std::string line = render(record, LogFormat::JSON);
+  ASSERT_EQ(line.back(), '\n');
+  EXPECT_EQ(line.substr(line.find("\",\"level\"")),
+            "\",\"level\":\"ERROR\",\"component\":\"Http\\\"Server\","
+            "\"message\":\"failed: line\\nbreak\","
+            "\"context\":{\"code\":\"5\\t03\"}}\n");
+  EXPECT_EQ(afterTimestamp(render(record, LogFormat::TEXT)),
+            "[ERROR] [Http\"Server] failed: line\nbreak | code=5\t03\n");
+}
+
+TEST(LogRecordTest, KeepsOnlyStringLiteralsByAddress) {
+  char buffer[] = "rows {}";
+  const LogFormatText copied = ETL_LOG_FORMAT_TEXT(buffer);
+  const LogFormatText literal = ETL_LOG_FORMAT_TEXT("rows {}");
+  EXPECT_FALSE(copied.literal);
+  EXPECT_TRUE(literal.literal);
+  EXPECT_FALSE(ETL_LOG_FORMAT_TEXT(std::string("rows {}")).literal);
+
+  std::string record;
+  LogRecordWriter writer(record);
+  writer.begin(LogLevel::INFO, 1, 0);
+  writer.literal("Loader", 6);
+  writer.format(copied);
+  writer.arg(5);
+  std::memcpy(buffer, "gone {}", sizeof(buffer));
+  EXPECT_EQ(renderLogMessage(record), "rows 5");
+}
+
+TEST_F(FastLoggingTest, LogsFormatsFromBuffersThatAreReused) {
+  config_.level = LogLevel::INFO;
+  config_.asyncLogging = true;
+  config_.asyncOverflowPolicy = LogOverflowPolicy::BLOCK;
+  Logger::getInstance().configure(config_);
+
+  char format[32];
+  for (int i = 0; i < 3; ++i) {
+    std::snprintf(format, sizeof(format), "pass %d of {}", i);
+    HTTP_LOG_INFO(format, 3);
+  }
+  std::memset(format, 0, sizeof(format));
+
+  const auto lines = loggedLines();
+  ASSERT_EQ(lines.size(), 3u);
+  EXPECT_EQ(afterTimestamp(lines[0]), "[INFO ] [HttpServer] pass 0 of 3");
+  EXPECT_EQ(afterTimestamp(lines[2]), "[INFO ] [HttpServer] pass 2 of 3");
+}
+
+TEST_F(FastLoggingTest, SkipsDisabledLevelsWithoutEvaluatingArguments) {
+  config_.level = LogLevel::INFO;
+  Logger::getInstance().configure(config_);
+
+  int evaluated = 0;
+  auto message = [&evaluated] {
+    ++evaluated;
+    return std::string("expensive");
+  };
+  HTTP_LOG_DEBUG(message());
+  HTTP_LOG_DEBUG("read {} bytes", Probe{});
+  EXPECT_EQ(evaluated, 0);
+  EXPECT_EQ(Probe::conversions, 0);
+  EXPECT_FALSE(etl::HttpLogger::enabled(LogLevel::DEBUG));
+  EXPECT_TRUE(etl::HttpLogger::enabled(LogLevel::INFO));
+
+  HTTP_LOG_INFO(message());
+  HTTP_LOG_INFO("read {} bytes from {}", 512, Probe{});
+  EXPECT_EQ(evaluated, 1);
+  EXPECT_EQ(Probe::conversions, 1);
+
+  // The component filter is honoured too
+  config_.componentFilter = {"DatabaseManager"};
+  Logger::getInstance().configure(config_);
+  EXPECT_FALSE(etl::HttpLogger::enabled(LogLevel::ERROR));
+  EXPECT_TRUE(etl::DatabaseLogger::enabled(LogLevel::ERROR));
+  HTTP_LOG_ERROR(message());
+  EXPECT_EQ(evaluated, 1);
+
+  const auto lines = loggedLines();
+  ASSERT_EQ(lines.size(), 2u);
+  EXPECT_EQ(afterTimestamp(lines[0]), "[INFO ] [HttpServer] expensive");
+  EXPECT_EQ(afterTimestamp(lines[1]),
+            "[INFO ] [HttpServer] read 512 bytes from probe");
+}
+
+TEST_F(FastLoggingTest, AsyncWriterRendersTheSameLines) {
+  config_.level = LogLevel::DEBUG;
+  Logger::getInstance().configure(config_);
+  ETL_LOG_INFO("loaded {} rows in {} ms", 1200, 3.75);
+  Logger::getInstance().info("ETLJobManager", "plain {} text", {{"k", "v"}});
+  const auto sync = loggedLines();
+
+  std::filesystem::remove(dir_ / "etl.log");
+  config_.asyncLogging = true;
+  config_.asyncOverflowPolicy = LogOverflowPolicy::BLOCK;
+  Logger::getInstance().configure(config_);
+  ETL_LOG_INFO("loaded {} rows in {} ms", 1200, 3.75);
+  Logger::getInstance().info("ETLJobManager", "plain {} text", {{"k", "v"}});
+  const auto async = loggedLines();
+
+  ASSERT_EQ(sync.size(), 2u);
+  ASSERT_EQ(async.size(), 2u);
+  for (size_t i = 0; i < sync.size(); ++i) {
+    EXPECT_EQ(afterTimestamp(async[i]), afterTimestamp(sync[i]));
+  }
+  EXPECT_EQ(afterTimestamp(sync[0]),
+            "[INFO ] [ETLJobManager] loaded 1200 rows in 3.75 ms");
+  EXPECT_EQ(afterTimestamp(sync[1]),
+            "[INFO ] [ETLJobManager] plain {} text | k=v");
+}
+
+TEST_F(FastLoggingTest, ComponentThresholdsFollowLevelAndFilterChanges) {
+  config_.level = LogLevel::WARN;
+  Logger::getInstance().configure(config_);
+  EXPECT_FALSE(etl::ConfigLogger::enabled(LogLevel::INFO));
+  EXPECT_TRUE(etl::ConfigLogger::enabled(LogLevel::WARN));
+
+  Logger::getInstance().setLogLevel(LogLevel::DEBUG);
+  EXPECT_TRUE(etl::ConfigLogger::enabled(LogLevel::DEBUG));
+
+  Logger::getInstance().setComponentFilter({"HttpServer"});
+  EXPECT_FALSE(etl::ConfigLogger::enabled(LogLevel::FATAL));
+  EXPECT_TRUE(etl::HttpLogger::enabled(LogLevel::DEBUG));
+  EXPECT_FALSE(Logger::getInstance().isEnabled(LogLevel::FATAL, "Other"));
+
+  Logger::getInstance().setComponentFilter({});
+  EXPECT_TRUE(etl::ConfigLogger::enabled(LogLevel::DEBUG));
+  EXPECT_TRUE(Logger::getInstance().isEnabled(LogLevel::DEBUG, "Other"));
+}
+
+TEST_F(FastLoggingTest, KeepsRecordsLoggedWhileTheWriterStops) {
+  config_.level = LogLevel::INFO;
+  config_.asyncLogging = true;
+  config_.asyncOverflowPolicy = LogOverflowPolicy::BLOCK;
+  Logger::getInstance().configure(config_);
+
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 2000;
+  std::vector<std::thread> producers;
+  for (int t = 0; t < kThreads; ++t) {
+    producers.emplace_back([t] {
+      for (int i = 0; i < kPerThread; ++i) {
+        HTTP_LOG_INFO("thread {} line {}", t, i);
+      }
+    });
+  }
+  // Switch to synchronous writes while the producers are still logging
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  config_.asyncLogging = false;
+  Logger::getInstance().configure(config_);
+  for (auto &producer : producers) {
+    producer.join();
+  }
+
+  EXPECT_EQ(loggedLines().size(), size_t{kThreads * kPerThread});
+}
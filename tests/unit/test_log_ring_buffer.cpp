@@ -0,0 +1,213 @@
+#include "log_ring_buffer.hpp"
+#include "logger.hpp"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> drain(LogRingBuffer &ring) {
+  std::vector<std::string> lines;
+  ring.peek(ring.capacity(), [&lines](std::string_view line) {
+    lines.emplace_back(line);
+  });
+  ring.release();
+  return lines;
+}
+
+class AsyncLoggerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    dir_ = std::filesystem::temp_directory_path() /
+           (std::string("async_logger_") +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+
+    config_.consoleOutput = false;
+    config_.fileOutput = true;
+    config_.asyncLogging = true;
+    config_.logFile = (dir_ / "etl.log").string();
+    config_.enableHistoricalAccess = false;
+    config_.enableLogIndexing = false;
+    config_.enableRotation = false;
+    // Each producer thread gets a ring of this many slots
+    config_.asyncQueueSize = 64;
+  }
+
+  void TearDown() override {
+    LogConfig off;
+    off.consoleOutput = false;
+    off.fileOutput = false;
+    Logger::getInstance().configure(off);
+    std::filesystem::remove_all(dir_);
+  }
+
+  // Logs perThread numbered lines from each of threads threads
+  void logFromThreads(int threads, int perThread) {
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t) {
+      producers.emplace_back([t, perThread] {
+        for (int i = 0; i < perThread; ++i) {
+          Logger::getInstance().info("RingTest", "thread " +
+                                                     std::to_string(t) +
+                                                     " line " +
+                                                     std::to_string(i));
+        }
+      });
+    }
+    for (auto &producer : producers) {
+      producer.join();
+    }
+    Logger::getInstance().flush();
+  }
+
+  // RingTest lines in every file of the directory
+  size_t loggedLines() const {
+    size_t lines = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(dir_)) {
+      std::ifstream in(entry.path());
+      std::string line;
+      while (std::getline(in, line)) {
+        lines += line.find("[RingTest]") != std::string::npos;
+      }
+    }
+    return lines;
+  }
+
+  std::filesystem::path dir_;
+  LogConfig config_;
+};
+
+} // namespace
+
+TEST(LogRingBufferTest, RejectsPushesWhenFullUntilReleased) {
+  LogRingBuffer ring(3, 16);
+  ASSERT_EQ(ring.capacity(), 4u);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(ring.tryPush("line " + std::to_string(i)));
+  }
+  EXPECT_FALSE(ring.tryPush("overflow"));
+  EXPECT_EQ(ring.size(), 4u);
+
+  // Peeked slots stay taken until release()
+  size_t seen = ring.peek(2, [](std::string_view) {});
+  EXPECT_EQ(seen, 2u);
+  EXPECT_FALSE(ring.tryPush("still full"));
+  ring.release();
+  EXPECT_EQ(ring.released(), 2u);
+
+  // Records longer than a slot's preallocation still fit
+  EXPECT_TRUE(ring.tryPush(std::string(100, 'x')));
+  EXPECT_TRUE(ring.tryPush("last"));
+  auto lines = drain(ring);
+  ASSERT_EQ(lines.size(), 4u);
+  EXPECT_EQ(lines[0], "line 2");
+  EXPECT_EQ(lines[2], std::string(100, 'x'));
+  EXPECT_EQ(lines[3], "last");
+  EXPECT_EQ(ring.pushed(), ring.released());
+}
+
+TEST(LogRingBufferTest, KeepsEachProducersOrder) {
+  LogRingBuffer ring(256);
+  constexpr int kProducers = 4;
+  constexpr int kLines = 20000;
+  std::atomic<int> running{kProducers};
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&ring, &running, p] {
+      for (int i = 0; i < kLines; ++i) {
+        const std::string line = std::to_string(p) + ":" + std::to_string(i);
+        while (!ring.tryPush(line)) {
+          std::this_thread::yield();
+        }
+      }
+      running--;
+    });
+  }
+
+  std::vector<int> next(kProducers, 0);
+  size_t received = 0;
+  bool ordered = true;
+  while (running > 0 || ring.size() > 0) {
+    for (const auto &line : drain(ring)) {
+      const int producer = std::stoi(line);
+      const int index = std::stoi(line.substr(line.find(':') + 1));
+      ordered = ordered && index == next[producer];
+      next[producer] = index + 1;
+      ++received;
+    }
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(received, static_cast<size_t>(kProducers * kLines));
+}
+
+TEST_F(AsyncLoggerTest, GroupCommitsEveryLineAcrossRotations) {
+  config_.enableRotation = true;
+  config_.maxFileSize = 16 * 1024;
+  config_.maxBackupFiles = 100;
+  config_.asyncOverflowPolicy = LogOverflowPolicy::BLOCK;
+  Logger::getInstance().configure(config_);
+
+  const uint64_t dropped = Logger::getInstance().getMetrics().droppedMessages;
+  logFromThreads(4, 1000);
+  EXPECT_EQ(Logger::getInstance().getMetrics().droppedMessages, dropped);
+  EXPECT_EQ(loggedLines(), 4000u);
+
+  // Rotation happens between lines, as in synchronous mode
+  EXPECT_TRUE(std::filesystem::exists(dir_ / "etl.log.1"));
+  for (const auto &entry : std::filesystem::directory_iterator(dir_)) {
+    EXPECT_LE(std::filesystem::file_size(entry.path()), config_.maxFileSize);
+  }
+}
+
+TEST_F(AsyncLoggerTest, CountsEveryDroppedLine) {
+  config_.asyncOverflowPolicy = LogOverflowPolicy::DROP;
+  config_.flushInterval = 50;
+  Logger::getInstance().configure(config_);
+
+  const auto before = Logger::getInstance().getMetrics();
+  logFromThreads(4, 5000);
+  const auto after = Logger::getInstance().getMetrics();
+  // Whatever the writer could not keep up with is dropped and counted
+  EXPECT_EQ(loggedLines() + (after.droppedMessages - before.droppedMessages),
+            20000u);
+}
+
+TEST_F(AsyncLoggerTest, KeepsEachThreadsOrderAndCountsAfterItExits) {
+  config_.asyncOverflowPolicy = LogOverflowPolicy::BLOCK;
+  config_.flushInterval = 50;
+  Logger::getInstance().configure(config_);
+
+  const uint64_t total = Logger::getInstance().getMetrics().totalMessages;
+  logFromThreads(4, 500);
+  // A few writer rounds, so the exited threads' rings are retired
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(Logger::getInstance().getMetrics().totalMessages, total + 2000);
+
+  std::vector<int> next(4, 0);
+  std::ifstream in(dir_ / "etl.log");
+  std::string line;
+  while (std::getline(in, line)) {
+    const size_t pos = line.find("[RingTest] thread ");
+    if (pos == std::string::npos) {
+      continue;
+    }
+    std::istringstream fields(line.substr(pos + 18));
+    int thread = 0;
+    int index = 0;
+    std::string word;
+    fields >> thread >> word >> index;
+    EXPECT_EQ(index, next[thread]) << line;
+    next[thread] = index + 1;
+  }
+  EXPECT_EQ(next, std::vector<int>(4, 500));
+}
@@ -0,0 +1,213 @@
+#include "log_search_engine.hpp"
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+const std::time_t kStart = [] {
+  std::tm tm{};
+  tm.tm_year = 2024 - 1900;
+  tm.tm_mon = 2;
+  tm.tm_mday = 1;
+  tm.tm_hour = 9;
+  tm.tm_isdst = -1;
+  return std::mktime(&tm);
+}();
+
+// Line i is logged i seconds after kStart, in Logger's text layout
+std::string textLine(int i, const std::string &level,
+                     const std::string &component, const std::string &job,
+                     const std::string &message) {
+  const std::time_t time = kStart + i;
+  std::tm tm{};
+  localtime_r(&time, &tm);
+  std::ostringstream line;
+  line << "[" << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << ".000] [" << level
+       << "] [" << component << "] ";
+  if (!job.empty()) {
+    line << "[Job: " << job << "] ";
+  }
+  line << message << "\n";
+  return line.str();
+}
+
+class LogSearchEngineTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    dir_ = std::filesystem::temp_directory_path() /
+           (std::string("log_search_") +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir_); }
+
+  // 600 lines (about 40KB, many 4KB chunks): job-0..job-5 round robin,
+  // every 50th line an ERROR from Loader followed by a stack frame line
+  std::string writeCorpus(const std::string &name) {
+    const std::string path = (dir_ / name).string();
+    std::ofstream out(path, std::ios::binary);
+    for (int i = 0; i < 600; ++i) {
+      if (i % 50 == 49) {
+        out << textLine(i, "ERROR", "Loader", "job-" + std::to_string(i % 6),
+                        "insert failed for row " + std::to_string(i));
+        out << "    at Loader::insert(batch.cpp:42)\n";
+      } else {
+        out << textLine(i, "INFO ", "Transformer",
+                        "job-" + std::to_string(i % 6),
+                        "transformed row " + std::to_string(i));
+      }
+    }
+    return path;
+  }
+
+  std::filesystem::path dir_;
+  LogSearchEngine engine_{4, 4096};
+};
+
+} // namespace
+
+TEST_F(LogSearchEngineTest, HonoursEveryFilterAcrossChunks) {
+  const std::string path = writeCorpus("a.log");
+
+  LogQueryParams params;
+  params.jobId = "job-3";
+  params.component = "Transformer";
+  params.startTime = Clock::from_time_t(kStart + 100);
+  params.endTime = Clock::from_time_t(kStart + 200);
+  auto entries = engine_.search({path}, params);
+  // i in [100, 200] with i % 6 == 3
+  ASSERT_EQ(entries.size(), 16u);
+  EXPECT_EQ(entries.front().message, "transformed row 105");
+  EXPECT_EQ(entries.front().timestamp, Clock::from_time_t(kStart + 105));
+  EXPECT_EQ(entries.front().jobId, "job-3");
+  EXPECT_EQ(entries.front().filename, "a.log");
+  // Rows 49 and 99 each add a stack frame line before row 105
+  EXPECT_EQ(entries.front().lineNumber, 108u);
+
+  params = LogQueryParams();
+  params.minLevel = LogLevel::ERROR;
+  entries = engine_.search({path}, params);
+  ASSERT_EQ(entries.size(), 12u);
+  EXPECT_EQ(entries.back().message, "insert failed for row 599");
+  EXPECT_EQ(entries.back().level, LogLevel::ERROR);
+  EXPECT_EQ(entries.back().lineNumber, 611u);
+
+  params = LogQueryParams();
+  params.searchText = R"(row 5\d9$)";
+  params.useRegex = true;
+  EXPECT_EQ(engine_.search({path}, params).size(), 10u);
+
+  params.searchText = "(unclosed";
+  EXPECT_TRUE(engine_.search({path}, params).empty());
+}
+
+TEST_F(LogSearchEngineTest, TextSearchFindsContinuationLines) {
+  const std::string path = writeCorpus("a.log");
+
+  LogQueryParams params;
+  params.searchText = "batch.cpp:42";
+  auto entries = engine_.search({path}, params);
+  ASSERT_EQ(entries.size(), 12u);
+  // Reported with the time of the line they continue
+  EXPECT_EQ(entries.front().timestamp, Clock::from_time_t(kStart + 49));
+  EXPECT_EQ(entries.front().lineNumber, 51u);
+  EXPECT_EQ(entries.front().message, "    at Loader::insert(batch.cpp:42)");
+
+  // A structured filter excludes lines that carry no fields
+  params.jobId = "job-1";
+  EXPECT_TRUE(engine_.search({path}, params).empty());
+}
+
+TEST_F(LogSearchEngineTest, PagesAndSortsAcrossFiles) {
+  const std::string a = writeCorpus("a.log");
+  const std::string b = writeCorpus("b.log");
+
+  LogQueryParams params;
+  params.minLevel = LogLevel::ERROR;
+  params.ascending = false;
+  params.offset = 1;
+  params.maxResults = 3;
+  auto entries = engine_.search({a, b}, params);
+  // Newest first; equal timestamps fall back to file order (reversed)
+  ASSERT_EQ(entries.size(), 3u);
+  EXPECT_EQ(entries[0].message, "insert failed for row 599");
+  EXPECT_EQ(entries[0].filename, "a.log");
+  EXPECT_EQ(entries[1].message, "insert failed for row 549");
+  EXPECT_EQ(entries[1].filename, "b.log");
+  EXPECT_EQ(entries[2].filename, "a.log");
+
+  params = LogQueryParams();
+  params.jobId = "job-1";
+  params.sortBy = "level";
+  params.maxResults = 1;
+  params.ascending = false;
+  entries = engine_.search({a, b}, params);
+  ASSERT_EQ(entries.size(), 1u);
+  EXPECT_EQ(entries[0].level, LogLevel::ERROR);
+}
+
+TEST_F(LogSearchEngineTest, MatchesTheIndexedSearch) {
+  LogFileManagerConfig config;
+  config.logDirectory = dir_.string();
+  config.archive.archiveDirectory = (dir_ / "archive").string();
+  config.enableFileMonitoring = false;
+  config.indexing.indexDirectory = (dir_ / "index").string();
+  config.performance.searchChunkSize = 4096;
+  writeCorpus("a.log");
+  writeCorpus("b.log");
+
+  LogQueryParams params;
+  params.jobId = "job-4";
+  params.startTime = Clock::from_time_t(kStart + 300);
+  params.searchText = "row";
+  params.maxResults = 25;
+  params.offset = 5;
+
+  config.indexing.enabled = true;
+  LogFileManager indexed(config);
+  config.indexing.enabled = false;
+  LogFileManager scanned(config);
+
+  auto fromIndex = indexed.searchLogEntries(params);
+  auto fromScan = scanned.searchLogEntries(params);
+  ASSERT_EQ(fromIndex.size(), 25u);
+  ASSERT_EQ(fromScan.size(), fromIndex.size());
+  for (size_t i = 0; i < fromScan.size(); ++i) {
+    EXPECT_EQ(fromScan[i].filename, fromIndex[i].filename);
+    EXPECT_EQ(fromScan[i].lineNumber, fromIndex[i].lineNumber);
+    EXPECT_EQ(fromScan[i].message, fromIndex[i].message);
+  }
+}
+
+TEST_F(LogSearchEngineTest, ScansQueriesTheIndexCannotNarrow) {
+  LogFileManagerConfig config;
+  config.logDirectory = dir_.string();
+  config.archive.archiveDirectory = (dir_ / "archive").string();
+  config.enableFileMonitoring = false;
+  config.indexing.indexDirectory = (dir_ / "index").string();
+  writeCorpus("a.log");
+  LogFileManager manager(config);
+
+  // Plain text without a full-text index: every block would be read, so
+  // the engine scans the file and no index is built
+  LogQueryParams params;
+  params.searchText = "row 599";
+  auto entries = manager.searchLogEntries(params);
+  ASSERT_EQ(entries.size(), 1u);
+  EXPECT_EQ(entries[0].message, "insert failed for row 599");
+  EXPECT_EQ(manager.getIndexStatistics()["index"]["totalEntries"], 0u);
+
+  params.jobId = "job-4";
+  EXPECT_EQ(manager.searchLogEntries(params).size(), 0u);
+  EXPECT_GT(manager.getIndexStatistics()["index"]["totalEntries"], 0u);
+}
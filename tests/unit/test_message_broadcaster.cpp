@@ -0,0 +1,229 @@
+#include "connection_pool.hpp"
+#include "message_broadcaster.hpp"
+#include "websocket_connection.hpp"
+#include <algorithm>
+#include <atomic>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <cstdlib>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// A message this large is only ever allocated when it is copied
+constexpr size_t kLargeBytes = 256 * 1024;
+std::atomic<size_t> largeAllocations{0};
+
+} // namespace
+
+// Every non-aligned form is replaced, so each pair stays malloc/free
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  if (size >= kLargeBytes) {
+    largeAllocations++;
+  }
+  return std::malloc(size ? size : 1);
+}
+void *operator new(size_t size) {
+  if (void *memory = operator new(size, std::nothrow)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+void *operator new[](size_t size) { return operator new(size); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return operator new(size, std::nothrow);
+}
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete[](void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void *memory, size_t) noexcept { std::free(memory); }
+void operator delete(void *memory, const std::nothrow_t &) noexcept {
+  std::free(memory);
+}
+void operator delete[](void *memory, const std::nothrow_t &) noexcept {
+  std::free(memory);
+}
+
+namespace {
+
+using ClientStream = websocket::stream<tcp::socket>;
+
+template <typename Predicate> bool waitFor(Predicate done) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!done()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+std::string readFrame(ClientStream &client) {
+  beast::flat_buffer buffer;
+  client.read(buffer);
+  return beast::buffers_to_string(buffer.data());
+}
+
+class MessageBroadcasterTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    ConnectionPoolConfig config;
+    config.enableHealthMonitoring = false;
+    pool_ = std::make_shared<ConnectionPool>(config);
+    pool_->start();
+    ioThread_ = std::thread([this] { ioc_.run(); });
+  }
+
+  void TearDown() override {
+    if (broadcaster_) {
+      broadcaster_->stop();
+    }
+    for (auto &client : clients_) {
+      beast::error_code ec;
+      client->next_layer().shutdown(tcp::socket::shutdown_both, ec);
+    }
+    pool_->stop();
+    work_.reset();
+    ioc_.stop();
+    ioThread_.join();
+  }
+
+  // Opens count server connections through real handshakes, in the pool
+  // and in the broadcaster's subscription index
+  void connect(size_t count) {
+    tcp::acceptor acceptor(ioc_, {net::ip::make_address("127.0.0.1"), 0});
+    for (size_t i = 0; i < count; ++i) {
+      auto client = std::make_unique<ClientStream>(clientIoc_);
+      client->next_layer().connect(acceptor.local_endpoint());
+      auto connection = std::make_shared<WebSocketConnection>(
+          acceptor.accept(), std::weak_ptr<WebSocketManager>());
+      connection->start();
+      client->handshake("127.0.0.1", "/");
+      ASSERT_TRUE(waitFor([&] { return connection->isOpen(); }));
+      pool_->addConnection(connection);
+      broadcaster_->registerConnection(connection);
+      clients_.push_back(std::move(client));
+    }
+  }
+
+  void startBroadcaster(const MessageBroadcasterConfig &config) {
+    broadcaster_ = std::make_shared<MessageBroadcaster>(pool_, config);
+    broadcaster_->start();
+  }
+
+  net::io_context ioc_;
+  net::executor_work_guard<net::io_context::executor_type> work_ =
+      net::make_work_guard(ioc_);
+  std::thread ioThread_;
+  net::io_context clientIoc_;
+  std::vector<std::unique_ptr<ClientStream>> clients_;
+  std::shared_ptr<ConnectionPool> pool_;
+  std::shared_ptr<MessageBroadcaster> broadcaster_;
+};
+
+} // namespace
+
+TEST_F(MessageBroadcasterTest, SharesOneSerialisationAcrossConnections) {
+  MessageBroadcasterConfig config;
+  config.enableAsyncProcessing = false;
+  startBroadcaster(config);
+  connect(4);
+
+  const std::string message = "\"" + std::string(kLargeBytes, 'x') + "\"";
+  // Holds the io thread so every connection still has the frame queued
+  std::promise<void> release;
+  std::shared_future<void> held = release.get_future().share();
+  net::post(ioc_, [held] { held.wait(); });
+
+  const size_t before = largeAllocations.load();
+  broadcaster_->broadcastMessage(message);
+  EXPECT_EQ(largeAllocations.load() - before, 1u);
+  release.set_value();
+
+  for (auto &client : clients_) {
+    EXPECT_EQ(readFrame(*client), message);
+  }
+  EXPECT_EQ(broadcaster_->getStats().totalMessagesSent, 4u);
+}
+
+TEST_F(MessageBroadcasterTest, DeliversQueuedMessagesOnce) {
+  MessageBroadcasterConfig config;
+  config.processingInterval = std::chrono::milliseconds(1);
+  startBroadcaster(config);
+  connect(2);
+
+  broadcaster_->broadcastMessage("1");
+  broadcaster_->broadcastMessage("2");
+  broadcaster_->broadcastLogMessage("3", "job-1", "INFO");
+  for (auto &client : clients_) {
+    std::vector<std::string> frames;
+    for (int i = 0; i < 3; ++i) {
+      frames.push_back(readFrame(*client));
+    }
+    std::sort(frames.begin(), frames.end());
+    EXPECT_EQ(frames, std::vector<std::string>({"1", "2", "3"}));
+  }
+
+  // Processing a queued message must not queue it again
+  ASSERT_TRUE(waitFor([&] { return broadcaster_->getQueueSize() == 0; }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const MessageBroadcasterStats stats = broadcaster_->getStats();
+  EXPECT_EQ(stats.totalMessagesQueued, 3u);
+  EXPECT_EQ(stats.totalMessagesSent, 6u);
+  EXPECT_EQ(stats.currentQueueSize, 0u);
+}
+
+TEST_F(MessageBroadcasterTest, ForgetsConnectionsThePoolCleansUp) {
+  MessageBroadcasterConfig config;
+  config.enableAsyncProcessing = false;
+  startBroadcaster(config);
+  connect(2);
+  auto subscribers = [this] {
+    return broadcaster_
+        ->getConnectionsForMessageType(MessageType::JOB_STATUS_UPDATE)
+        .size();
+  };
+  ASSERT_EQ(subscribers(), 2u);
+
+  // Closed, but never removed through removeConnection()
+  auto closeOne = [this](size_t remaining) {
+    pool_->getConnection(pool_->getConnectionIds()[0])->close();
+    return waitFor(
+        [&] { return pool_->getActiveConnectionCount() == remaining; });
+  };
+  ASSERT_TRUE(closeOne(1));
+  pool_->removeInactiveConnections();
+  EXPECT_EQ(pool_->getTotalConnectionCount(), 1u);
+  EXPECT_EQ(subscribers(), 1u);
+
+  ASSERT_TRUE(closeOne(0));
+  pool_->cleanupStaleConnections();
+  EXPECT_EQ(pool_->getTotalConnectionCount(), 0u);
+  EXPECT_EQ(subscribers(), 0u);
+}
+
+TEST_F(MessageBroadcasterTest, KeepsSubscriptionsAcrossARestart) {
+  MessageBroadcasterConfig config;
+  config.enableAsyncProcessing = false;
+  startBroadcaster(config);
+  connect(2);
+
+  broadcaster_->stop();
+  broadcaster_->start();
+  ASSERT_EQ(
+      broadcaster_->getConnectionsForMessageType(MessageType::JOB_STATUS_UPDATE)
+          .size(),
+      2u);
+  broadcaster_->broadcastByMessageType("1", MessageType::JOB_STATUS_UPDATE);
+  for (auto &client : clients_) {
+    EXPECT_EQ(readFrame(*client), "1");
+  }
+}
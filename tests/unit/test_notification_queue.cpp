@@ -0,0 +1,141 @@
+#include "http_stub_server.hpp"
+#include "notification_service.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using notification_recovery::RetryTimerWheel;
+
+namespace {
+
+NotificationMessage makeMessage(NotificationPriority priority,
+                                const std::string &subject) {
+  NotificationMessage message;
+  message.id = NotificationMessage::generateId();
+  message.type = NotificationType::SYSTEM_ERROR;
+  message.priority = priority;
+  message.subject = subject;
+  message.message = subject;
+  message.timestamp = std::chrono::system_clock::now();
+  message.scheduledFor = message.timestamp;
+  message.retryCount = 0;
+  message.maxRetries = 3;
+  return message;
+}
+
+template <typename Predicate> bool waitFor(Predicate done) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!done()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+} // namespace
+
+TEST(RetryTimerWheelTest, ReleasesEntriesOnceTheirTickPasses) {
+  using namespace std::chrono_literals;
+  RetryTimerWheel<int> wheel(10ms, 8);
+  const auto now = RetryTimerWheel<int>::Clock::now();
+  wheel.schedule(1, now + 25ms);
+  wheel.schedule(2, now + 5ms);
+  // Further out than one turn of the wheel, in the same slot as 1
+  wheel.schedule(3, now + 105ms);
+  EXPECT_EQ(wheel.size(), 3u);
+  EXPECT_LE(wheel.nextDue(), now + 20ms);
+
+  std::vector<int> due;
+  wheel.advance(now + 40ms, due);
+  EXPECT_EQ(due, std::vector<int>({2, 1}));
+  EXPECT_EQ(wheel.size(), 1u);
+  EXPECT_GE(wheel.nextDue(), now + 100ms);
+
+  due.clear();
+  wheel.advance(now + 100ms, due);
+  EXPECT_TRUE(due.empty());
+  wheel.advance(now + 500ms, due);
+  EXPECT_EQ(due, std::vector<int>({3}));
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(wheel.nextDue(), RetryTimerWheel<int>::Clock::time_point::max());
+}
+
+TEST(NotificationQueueTest, DeliversHighestPriorityFirst) {
+  NotificationConfig config;
+  config.deliveryWorkers = 1;
+  NotificationServiceImpl service;
+  service.configure(config);
+  service.setTestMode(true);
+
+  service.queueNotification(makeMessage(NotificationPriority::LOW, "a"));
+  service.queueNotification(makeMessage(NotificationPriority::MEDIUM, "b"));
+  service.queueNotification(makeMessage(NotificationPriority::CRITICAL, "c"));
+  service.queueNotification(makeMessage(NotificationPriority::HIGH, "d"));
+  service.queueNotification(makeMessage(NotificationPriority::CRITICAL, "e"));
+  EXPECT_EQ(service.getStats().queued, 5u);
+
+  service.start();
+  ASSERT_TRUE(waitFor([&] { return service.getProcessedCount() == 5; }));
+  service.stop();
+
+  std::string order;
+  for (const auto &message : service.getRecentNotifications()) {
+    order += message.subject;
+  }
+  EXPECT_EQ(order, "cedba");
+}
+
+TEST(NotificationQueueTest, DeliversAsSoonAsQueued) {
+  NotificationConfig config;
+  NotificationServiceImpl service;
+  service.configure(config);
+  service.setTestMode(true);
+  service.start();
+
+  for (size_t i = 1; i <= 20; ++i) {
+    service.queueNotification(
+        makeMessage(NotificationPriority::CRITICAL, "disk full"));
+    ASSERT_TRUE(waitFor([&] { return service.getProcessedCount() == i; }));
+  }
+  const NotificationStats stats = service.getStats();
+  service.stop();
+
+  EXPECT_EQ(stats.processed, 20u);
+  EXPECT_EQ(stats.queued, 0u);
+  // Polling every 100ms would hold most of these for tens of milliseconds
+  EXPECT_LT(stats.queueToDeliveryP50, std::chrono::milliseconds(20));
+  EXPECT_LE(stats.queueToDeliveryP50, stats.queueToDeliveryP99);
+}
+
+TEST(NotificationQueueTest, RetriesFailedDeliveryAfterBackoff) {
+  HttpStubServer server;
+  server.respondWith(500);
+  NotificationConfig config;
+  config.webhookUrl = server.url("/notify");
+  config.defaultMethods = {NotificationMethod::WEBHOOK};
+  config.baseRetryDelayMs = 50;
+  NotificationServiceImpl service;
+  service.configure(config);
+  service.start();
+
+  service.queueNotification(makeMessage(NotificationPriority::HIGH, "x"));
+  ASSERT_TRUE(waitFor([&] { return service.getFailedCount() == 1; }));
+  const auto firstAttempt = std::chrono::steady_clock::now();
+  server.respondWith(200);
+  ASSERT_TRUE(waitFor([&] { return service.getProcessedCount() == 1; }));
+  const auto retried = std::chrono::steady_clock::now() - firstAttempt;
+  const NotificationStats stats = service.getStats();
+  service.stop();
+
+  EXPECT_GE(retried, std::chrono::milliseconds(40));
+  EXPECT_EQ(stats.failed, 1u);
+  EXPECT_EQ(stats.retriesPending, 0u);
+  EXPECT_EQ(server.requests().size(), 2u);
+  const auto recent = service.getRecentNotifications();
+  ASSERT_EQ(recent.size(), 1u);
+  EXPECT_EQ(recent[0].retryCount, 1);
+  EXPECT_EQ(recent[0].priority, NotificationPriority::HIGH);
+}
@@ -1,7 +1,10 @@
 #include "rate_limiter.hpp"
+#include "etl_exceptions.hpp"
+#include <atomic>
 #include <chrono>
 #include <gtest/gtest.h>
 #include <thread>
+#include <vector>
 
 class RateLimiterTest : public ::testing::Test {
 protected:
@@ -72,6 +75,126 @@ TEST_F(RateLimiterTest, ResetClient) {
   EXPECT_TRUE(rateLimiter->isAllowed(clientId, endpoint));
 }
 
+TEST_F(RateLimiterTest, MatchesRulesByPathPrefix) {
+  // /api/jobs allows 30 per minute; ids and query strings share its bucket
+  for (int i = 0; i < 30; ++i) {
+    std::string endpoint = i % 2 == 0 ? "/api/jobs/job-" + std::to_string(i)
+                                      : "/api/jobs?limit=" + std::to_string(i);
+    EXPECT_TRUE(rateLimiter->isAllowed("client", endpoint)) << endpoint;
+  }
+  EXPECT_FALSE(rateLimiter->isAllowed("client", "/api/jobs"));
+
+  // Prefixes only match on a path segment boundary
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(rateLimiter->isAllowed("client", "/api/jobsextra"));
+  }
+  EXPECT_TRUE(rateLimiter->isAllowed("client", "/api/unlimited"));
+
+  auto info = rateLimiter->getRateLimitInfo("client", "/api/jobs/42");
+  EXPECT_EQ(info.limit, 30);
+  EXPECT_EQ(info.remainingRequests, 0);
+  EXPECT_GT(info.resetTime, std::chrono::system_clock::now());
+}
+
+TEST_F(RateLimiterTest, HourLimitAppliesAfterMinuteLimit) {
+  rateLimiter->addRule({"/api/reports", 100, 3});
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(rateLimiter->isAllowed("client", "/api/reports"));
+  }
+  EXPECT_FALSE(rateLimiter->isAllowed("client", "/api/reports"));
+
+  // The rejected request did not use up minute quota
+  auto info = rateLimiter->getRateLimitInfo("client", "/api/reports");
+  EXPECT_EQ(info.limit, 100);
+  EXPECT_EQ(info.remainingRequests, 97);
+}
+
+TEST_F(RateLimiterTest, AddRuleReplacesExistingEndpoint) {
+  rateLimiter->addRule({"/api/auth/login", 2, 20});
+
+  EXPECT_TRUE(rateLimiter->isAllowed("client", "/api/auth/login"));
+  EXPECT_TRUE(rateLimiter->isAllowed("client", "/api/auth/login"));
+  EXPECT_FALSE(rateLimiter->isAllowed("client", "/api/auth/login"));
+
+  EXPECT_THROW(rateLimiter->addRule({"/api/bad", 0, 10}),
+               etl::ValidationException);
+  EXPECT_THROW(rateLimiter->addRule({"no-slash", 1, 10}),
+               etl::ValidationException);
+}
+
+TEST_F(RateLimiterTest, ConcurrentRequestsNeverExceedLimit) {
+  std::atomic<int> allowed{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 50; ++i) {
+        if (rateLimiter->isAllowed("shared_client", "/api/auth/login")) {
+          ++allowed;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(allowed.load(), 5);
+}
+
+TEST_F(RateLimiterTest, FixedTableStillLimitsWhenFull) {
+  RateLimiterConfig config;
+  config.slotCount = 16;
+  RateLimiter small(config);
+
+  // Far more clients than slots: overflowing clients share buckets, so
+  // limiting only gets stricter
+  int allowed = 0;
+  for (int i = 0; i < 1000; ++i) {
+    if (small.isAllowed("client" + std::to_string(i), "/api/auth/login")) {
+      ++allowed;
+    }
+  }
+  EXPECT_LE(allowed, 16 * 5);
+  EXPECT_GE(allowed, 16);
+
+  for (int i = 0; i < 5; ++i) {
+    small.isAllowed("late_client", "/api/auth/login");
+  }
+  EXPECT_FALSE(small.isAllowed("late_client", "/api/auth/login"));
+
+  // Reclaiming slots only frees buckets that have fully refilled
+  small.cleanupExpiredEntries();
+  EXPECT_FALSE(small.isAllowed("late_client", "/api/auth/login"));
+}
+
+TEST_F(RateLimiterTest, ResetLeavesSharedBucketsAlone) {
+  RateLimiterConfig config;
+  config.slotCount = 8;
+  RateLimiter small(config);
+
+  // Eight clients fill the table, then a ninth shares one of their buckets
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      small.isAllowed("client" + std::to_string(i), "/api/auth/login");
+    }
+  }
+  EXPECT_FALSE(small.isAllowed("overflow", "/api/auth/login"));
+
+  small.resetClient("overflow");
+  int allowed = 0;
+  for (int i = 0; i < 8; ++i) {
+    const std::string client = "client" + std::to_string(i);
+    small.resetClient(client);
+    if (small.isAllowed(client, "/api/auth/login")) {
+      ++allowed;
+    }
+  }
+  // Every owner but the one whose bucket is shared starts over
+  EXPECT_EQ(allowed, 7);
+  EXPECT_FALSE(small.isAllowed("overflow", "/api/auth/login"));
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,131 @@
+#include "request_executor.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST(RequestExecutorTest, RouteKeyUsesFirstTwoPathSegments) {
+  EXPECT_EQ(RequestExecutor::routeKey("/api/jobs/42/status?x=1"), "/api/jobs");
+  EXPECT_EQ(RequestExecutor::routeKey("/api/jobs?limit=10"), "/api/jobs");
+  EXPECT_EQ(RequestExecutor::routeKey("/api/health"), "/api/health");
+  EXPECT_EQ(RequestExecutor::routeKey("/"), "/");
+}
+
+TEST(RequestExecutorTest, RejectsWhenRouteQueueIsFull) {
+  RequestExecutorConfig config;
+  config.workerCount = 1;
+  config.maxQueueSize = 10;
+  config.maxQueuePerRoute = 2;
+  RequestExecutor executor(config);
+
+  // Park the only worker so later submissions stay queued
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::promise<void> started;
+  ASSERT_TRUE(executor.submit("/api/slow", [&](std::chrono::microseconds) {
+    started.set_value();
+    released.wait();
+  }));
+  started.get_future().wait();
+
+  auto noop = [](std::chrono::microseconds) {};
+  EXPECT_TRUE(executor.submit("/api/jobs", noop));
+  EXPECT_TRUE(executor.submit("/api/jobs", noop));
+  EXPECT_FALSE(executor.submit("/api/jobs", noop));
+  EXPECT_EQ(executor.routeQueueDepth("/api/jobs"), 2u);
+
+  // Other routes are still admitted
+  EXPECT_TRUE(executor.submit("/api/health", noop));
+
+  release.set_value();
+  executor.shutdown();
+
+  auto stats = executor.getStats();
+  EXPECT_EQ(stats.completed, 4u);
+  EXPECT_EQ(stats.rejected, 1u);
+  EXPECT_EQ(executor.routeQueueDepth("/api/jobs"), 0u);
+}
+
+TEST(RequestExecutorTest, RouteOverrideAndGlobalLimit) {
+  RequestExecutorConfig config;
+  config.workerCount = 1;
+  config.maxQueueSize = 3;
+  config.maxQueuePerRoute = 2;
+  config.routeQueueLimits["/api/logs"] = 1;
+  RequestExecutor executor(config);
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::promise<void> started;
+  ASSERT_TRUE(executor.submit("/api/slow", [&](std::chrono::microseconds) {
+    started.set_value();
+    released.wait();
+  }));
+  started.get_future().wait();
+
+  auto noop = [](std::chrono::microseconds) {};
+  EXPECT_TRUE(executor.submit("/api/logs", noop));
+  EXPECT_FALSE(executor.submit("/api/logs", noop));
+  EXPECT_TRUE(executor.submit("/api/jobs", noop));
+  EXPECT_TRUE(executor.submit("/api/auth", noop));
+  EXPECT_FALSE(executor.submit("/api/health", noop)); // Global limit
+
+  release.set_value();
+  executor.shutdown();
+}
+
+TEST(RequestExecutorTest, ReportsQueueWaitSeparately) {
+  RequestExecutorConfig config;
+  config.workerCount = 1;
+  RequestExecutor executor(config);
+
+  std::promise<std::chrono::microseconds> waited;
+  ASSERT_TRUE(executor.submit("/api/slow", [](std::chrono::microseconds) {
+    std::this_thread::sleep_for(20ms);
+  }));
+  ASSERT_TRUE(executor.submit("/api/jobs", [&](std::chrono::microseconds wait) {
+    waited.set_value(wait);
+  }));
+
+  EXPECT_GE(waited.get_future().get(), 10ms);
+  executor.shutdown();
+  EXPECT_GE(executor.getStats().maxQueueWait, 10ms);
+}
+
+TEST(RequestExecutorTest, ShutdownDrainsQueueAndRejectsNewWork) {
+  RequestExecutorConfig config;
+  config.workerCount = 2;
+  config.maxQueuePerRoute = 100;
+  RequestExecutor executor(config);
+
+  std::atomic<int> ran{0};
+  for (int i = 0; i < 50; ++i) {
+    ASSERT_TRUE(executor.submit("/api/jobs", [&ran](std::chrono::microseconds) {
+      std::this_thread::sleep_for(100us);
+      ran.fetch_add(1);
+    }));
+  }
+  executor.shutdown();
+
+  EXPECT_EQ(ran.load(), 50);
+  EXPECT_FALSE(executor.submit("/api/jobs", [](std::chrono::microseconds) {}));
+  EXPECT_EQ(executor.getStats().queued, 0u);
+}
+
+TEST(RequestExecutorTest, TaskExceptionsDoNotKillWorkers) {
+  RequestExecutorConfig config;
+  config.workerCount = 1;
+  RequestExecutor executor(config);
+
+  ASSERT_TRUE(executor.submit("/api/jobs", [](std::chrono::microseconds) {
+    throw std::runtime_error("handler failed");
+  }));
+  std::promise<void> ran;
+  ASSERT_TRUE(executor.submit(
+      "/api/jobs", [&ran](std::chrono::microseconds) { ran.set_value(); }));
+  EXPECT_EQ(ran.get_future().wait_for(2s), std::future_status::ready);
+}
@@ -251,6 +251,21 @@ TEST_F(RequestValidatorTest, ValidateJobsEndpointGet) {
   EXPECT_TRUE(result.isValid);
 }
 
+TEST_F(RequestValidatorTest, RejectOffsetPaginationOnJobList) {
+  // The list pages by cursor; parameters it would ignore are refused
+  for (const std::string query : {"offset=20", "job_id=job-123"}) {
+    auto result = validator_->validateJobsEndpoint(
+        createRequest("GET", "/api/jobs?limit=10&" + query));
+    EXPECT_FALSE(result.isValid) << query;
+    ASSERT_EQ(result.errors.size(), 1u) << query;
+    EXPECT_EQ(result.errors[0].code, "UNKNOWN_PARAMETER");
+  }
+
+  auto cursor = validator_->validateJobsEndpoint(
+      createRequest("GET", "/api/jobs?limit=10&cursor=31363a6a6f622d31"));
+  EXPECT_TRUE(cursor.isValid);
+}
+
 TEST_F(RequestValidatorTest, ValidateJobsEndpointPost) {
   auto req = createRequest(
       "POST", "/api/jobs",
@@ -0,0 +1,131 @@
+#include "simd_string_kernels.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using etl::string_kernels::SimdLevel;
+
+namespace {
+
+const std::vector<SimdLevel> kLevels = {SimdLevel::SCALAR, SimdLevel::SSE2,
+                                        SimdLevel::AVX2};
+
+std::string referenceUpper(std::string s) {
+  for (auto &c : s) {
+    if (c >= 'a' && c <= 'z')
+      c = static_cast<char>(c - 'a' + 'A');
+  }
+  return s;
+}
+
+std::string referenceLower(std::string s) {
+  for (auto &c : s) {
+    if (c >= 'A' && c <= 'Z')
+      c = static_cast<char>(c - 'A' + 'a');
+  }
+  return s;
+}
+
+std::string randomBytes(std::mt19937 &rng, size_t length) {
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::string s(length, '\0');
+  for (auto &c : s) {
+    c = static_cast<char>(dist(rng));
+  }
+  return s;
+}
+
+} // namespace
+
+class SimdStringKernelsTest : public ::testing::TestWithParam<SimdLevel> {};
+
+TEST_P(SimdStringKernelsTest, CaseMappingMatchesReferenceForAllBytes) {
+  std::mt19937 rng(42);
+  // Lengths straddle the 16- and 32-byte block boundaries
+  for (size_t length : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000}) {
+    std::string input = randomBytes(rng, length);
+
+    std::string upper = input;
+    etl::string_kernels::asciiToUpper(upper.data(), upper.size(), GetParam());
+    EXPECT_EQ(upper, referenceUpper(input)) << "length " << length;
+
+    std::string lower = input;
+    etl::string_kernels::asciiToLower(lower.data(), lower.size(), GetParam());
+    EXPECT_EQ(lower, referenceLower(input)) << "length " << length;
+  }
+}
+
+TEST_P(SimdStringKernelsTest, NonAsciiBytesAreUntouched) {
+  std::string utf8 = "stra\xc3\x9f" "e \xc3\xa9t\xc3\xa9";
+  std::string upper = utf8;
+  etl::string_kernels::asciiToUpper(upper.data(), upper.size(), GetParam());
+  EXPECT_EQ(upper, "STRA\xc3\x9f" "E \xc3\xa9T\xc3\xa9");
+}
+
+TEST_P(SimdStringKernelsTest, TrimMatchesReference) {
+  const std::string ws = " \t\n\r";
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> pad(0, 70);
+  std::uniform_int_distribution<int> pick(0, 3);
+
+  for (int i = 0; i < 200; ++i) {
+    std::string left(pad(rng), ' ');
+    std::string right(pad(rng), ' ');
+    for (auto &c : left)
+      c = ws[pick(rng)];
+    for (auto &c : right)
+      c = ws[pick(rng)];
+    std::string body = i % 5 == 0 ? "" : "a b\tc" + std::string(i % 40, 'x');
+
+    std::string input = left + body + right;
+    EXPECT_EQ(etl::string_kernels::trimAsciiWhitespace(input, GetParam()),
+              body)
+        << "iteration " << i;
+  }
+}
+
+TEST_P(SimdStringKernelsTest, FindSubstringMatchesStdFind) {
+  std::mt19937 rng(11);
+  // A small alphabet makes partial matches (first/last byte hits) common
+  std::uniform_int_distribution<int> letter('a', 'd');
+  for (size_t length : {0, 1, 15, 16, 17, 31, 32, 33, 64, 100, 1000}) {
+    std::string haystack(length, ' ');
+    for (auto &c : haystack) {
+      c = static_cast<char>(letter(rng));
+    }
+    for (size_t needleLength : {0, 1, 2, 3, 5, 17, 40}) {
+      for (int trial = 0; trial < 20; ++trial) {
+        std::string needle(needleLength, ' ');
+        for (auto &c : needle) {
+          c = static_cast<char>(letter(rng));
+        }
+        EXPECT_EQ(etl::string_kernels::findSubstring(haystack, needle,
+                                                     GetParam()),
+                  std::string_view(haystack).find(needle))
+            << "length " << length << " needle " << needle;
+      }
+    }
+  }
+}
+
+TEST_P(SimdStringKernelsTest, CountByteMatchesReference) {
+  std::mt19937 rng(5);
+  for (size_t length : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000}) {
+    std::string input = randomBytes(rng, length);
+    const auto expected =
+        static_cast<size_t>(std::count(input.begin(), input.end(), '\n'));
+    EXPECT_EQ(etl::string_kernels::countByte(input, '\n', GetParam()),
+              expected)
+        << "length " << length;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllLevels, SimdStringKernelsTest,
+                         ::testing::ValuesIn(kLevels));
+
+TEST(SimdStringKernelsDetection, DetectedLevelHasName) {
+  auto level = etl::string_kernels::detectedSimdLevel();
+  EXPECT_NE(std::string(etl::string_kernels::simdLevelName(level)), "");
+}
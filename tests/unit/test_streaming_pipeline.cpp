@@ -0,0 +1,65 @@
+#include "streaming_pipeline.hpp"
+#include <atomic>
+#include <future>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(StreamingPipelineTest, PassesEveryBatchThroughInOrder) {
+  StreamingPipeline<int> pipeline(2, [] { return false; });
+  int next = 0;
+  std::vector<int> loaded;
+  pipeline.run(
+      [&]() -> std::optional<int> {
+        return next < 50 ? std::optional<int>(next++) : std::nullopt;
+      },
+      [](int batch) { return batch * 2; },
+      [&](int batch) { loaded.push_back(batch); });
+
+  ASSERT_EQ(loaded.size(), 50u);
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(loaded[i], i * 2);
+  }
+}
+
+TEST(StreamingPipelineTest, CancelMidPipelineUnblocksEveryStage) {
+  std::atomic<bool> cancelled{false};
+  std::atomic<int> extracted{0};
+  StreamingPipeline<int> pipeline(1, [&] { return cancelled.load(); });
+
+  // An endless source keeps both queues full while load is slow, so
+  // extract and transform are blocked in push() when the cancel arrives
+  auto run = std::async(std::launch::async, [&] {
+    int loaded = 0;
+    pipeline.run([&]() -> std::optional<int> { return extracted++; },
+                 [](int batch) { return batch; },
+                 [&](int) {
+                   std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                   if (++loaded == 3) {
+                     cancelled = true;
+                   }
+                 });
+    return loaded;
+  });
+
+  ASSERT_EQ(run.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  EXPECT_EQ(run.get(), 3);
+  EXPECT_GT(pipeline.extractBlocked(), std::chrono::nanoseconds(0));
+}
+
+TEST(StreamingPipelineTest, RethrowsTheFirstStageError) {
+  std::atomic<int> loads{0};
+  StreamingPipeline<int> pipeline(1, [] { return false; });
+  int next = 0;
+  EXPECT_THROW(pipeline.run([&]() -> std::optional<int> { return next++; },
+                            [](int batch) {
+                              if (batch == 5) {
+                                throw std::runtime_error("bad batch");
+                              }
+                              return batch;
+                            },
+                            [&](int) { loads++; }),
+               std::runtime_error);
+  EXPECT_LE(loads.load(), 5);
+}
@@ -0,0 +1,127 @@
+#include "subscription_index.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Index = SubscriptionIndex<int>;
+
+ConnectionFilters jobFilters(std::vector<std::string> jobIds) {
+  ConnectionFilters filters;
+  filters.jobIds = std::move(jobIds);
+  return filters;
+}
+
+std::vector<std::string> sorted(std::vector<std::string> ids) {
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+std::vector<std::string> recipients(const Index &index, MessageType type,
+                                    const std::string &jobId = "",
+                                    const std::string &level = "") {
+  std::vector<std::string> ids;
+  size_t delivered = index.forEachSubscriber(
+      type, jobId, level, [&ids](const std::string &id, int) {
+        ids.push_back(id);
+        return true;
+      });
+  EXPECT_EQ(delivered, ids.size());
+  return sorted(ids);
+}
+
+} // namespace
+
+TEST(SubscriptionIndexTest, RoutesJobUpdatesToSubscribersAndWildcards) {
+  Index index;
+  index.update("a", 1, jobFilters({"job-1"}));
+  index.update("b", 2, jobFilters({"job-2"}));
+  index.update("c", 3, ConnectionFilters{});
+
+  using V = std::vector<std::string>;
+  EXPECT_EQ(recipients(index, MessageType::JOB_STATUS_UPDATE, "job-1"),
+            (V{"a", "c"}));
+  EXPECT_EQ(recipients(index, MessageType::JOB_STATUS_UPDATE, "job-3"),
+            (V{"c"}));
+  // Not job specific: job filters do not apply
+  EXPECT_EQ(recipients(index, MessageType::JOB_STATUS_UPDATE),
+            (V{"a", "b", "c"}));
+  EXPECT_EQ(sorted(index.subscribersForJob("job-2")), (V{"b", "c"}));
+}
+
+TEST(SubscriptionIndexTest, AppliesAllFilterDimensions) {
+  Index index;
+  ConnectionFilters errorsOnly;
+  errorsOnly.logLevels = {"ERROR"};
+  errorsOnly.messageTypes = {MessageType::JOB_LOG_MESSAGE};
+  index.update("errors", 1, errorsOnly);
+
+  ConnectionFilters quiet;
+  quiet.includeSystemNotifications = false;
+  index.update("quiet", 2, quiet);
+
+  using V = std::vector<std::string>;
+  EXPECT_EQ(recipients(index, MessageType::JOB_LOG_MESSAGE, "job-1", "ERROR"),
+            (V{"errors", "quiet"}));
+  EXPECT_EQ(recipients(index, MessageType::JOB_LOG_MESSAGE, "job-1", "INFO"),
+            (V{"quiet"}));
+  EXPECT_EQ(recipients(index, MessageType::JOB_STATUS_UPDATE, "job-1"),
+            (V{"quiet"}));
+  EXPECT_TRUE(recipients(index, MessageType::SYSTEM_NOTIFICATION).empty());
+  EXPECT_EQ(sorted(index.subscribersForMessageType(
+                MessageType::JOB_METRICS_UPDATE)),
+            (V{"quiet"}));
+  EXPECT_EQ(sorted(index.subscribersForLogLevel("ERROR")),
+            (V{"errors", "quiet"}));
+}
+
+TEST(SubscriptionIndexTest, UpdateReplacesPreviousFilters) {
+  Index index;
+  index.update("a", 1, jobFilters({"job-1", "job-2"}));
+  index.update("a", 7, jobFilters({"job-3"}));
+
+  using V = std::vector<std::string>;
+  EXPECT_EQ(index.size(), 1u);
+  EXPECT_TRUE(index.subscribersForJob("job-1").empty());
+  EXPECT_EQ(index.subscribersForJob("job-3"), (V{"a"}));
+
+  int handle = 0;
+  index.forEachSubscriber(MessageType::JOB_STATUS_UPDATE, "job-3", "",
+                          [&handle](const std::string &, int h) {
+                            handle = h;
+                            return true;
+                          });
+  EXPECT_EQ(handle, 7);
+
+  // Clearing the job list makes the connection a wildcard subscriber again
+  index.update("a", 7, ConnectionFilters{});
+  EXPECT_EQ(index.subscribersForJob("job-1"), (V{"a"}));
+}
+
+TEST(SubscriptionIndexTest, RemoveAndClearDropConnections) {
+  Index index;
+  index.update("a", 1, jobFilters({"job-1"}));
+  index.update("b", 2, ConnectionFilters{});
+
+  EXPECT_TRUE(index.remove("a"));
+  EXPECT_FALSE(index.remove("a"));
+  EXPECT_EQ(index.subscribersForJob("job-1"),
+            (std::vector<std::string>{"b"}));
+
+  index.clear();
+  EXPECT_EQ(index.size(), 0u);
+  EXPECT_TRUE(recipients(index, MessageType::JOB_STATUS_UPDATE).empty());
+}
+
+TEST(SubscriptionIndexTest, CountsOnlyAcceptedDeliveries) {
+  Index index;
+  index.update("a", 1, ConnectionFilters{});
+  index.update("b", 2, ConnectionFilters{});
+
+  size_t delivered = index.forEachSubscriber(
+      MessageType::JOB_STATUS_UPDATE, "", "",
+      [](const std::string &, int handle) { return handle == 2; });
+  EXPECT_EQ(delivered, 1u);
+}
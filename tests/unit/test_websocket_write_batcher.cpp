@@ -0,0 +1,175 @@
+#include "websocket_write_batcher.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+
+using Clock = WriteBatcher::Clock;
+
+std::string frameText(const WriteBatch &batch) {
+  std::string text;
+  for (const auto &buffer : batch.buffers()) {
+    text.append(static_cast<const char *>(buffer.data()), buffer.size());
+  }
+  return text;
+}
+
+WriteBatchingConfig batchingConfig() {
+  WriteBatchingConfig config;
+  config.enableBatching = true;
+  config.maxBatchMessages = 3;
+  config.maxBatchBytes = 1024;
+  config.maxBatchDelay = std::chrono::milliseconds(5);
+  return config;
+}
+
+} // namespace
+
+TEST(WriteBatcherTest, WithoutBatchingEachMessageIsAFrame) {
+  WriteBatcher batcher;
+  auto now = Clock::now();
+  batcher.push(makeSharedMessage("{\"a\":1}"), 0, now);
+  batcher.push(makeSharedMessage("{\"b\":2}"), 0, now);
+  EXPECT_TRUE(batcher.readyToFlush(now));
+
+  WriteBatch batch;
+  batcher.takeBatch(batch);
+  EXPECT_EQ(frameText(batch), "{\"a\":1}");
+  EXPECT_EQ(batch.messageCount(), 1u);
+  EXPECT_EQ(batcher.size(), 1u);
+}
+
+TEST(WriteBatcherTest, CoalescesIntoJsonArrayWithinBudget) {
+  WriteBatcher batcher(batchingConfig());
+  auto now = Clock::now();
+  for (int i = 0; i < 4; ++i) {
+    batcher.push(makeSharedMessage("{\"n\":" + std::to_string(i) + "}"), 0,
+                 now);
+  }
+
+  WriteBatch batch;
+  batcher.takeBatch(batch);
+  EXPECT_EQ(frameText(batch), "[{\"n\":0},{\"n\":1},{\"n\":2}]");
+  EXPECT_EQ(batch.messageCount(), 3u);
+  EXPECT_EQ(batch.bytes(), frameText(batch).size());
+
+  // A batch of one goes out unwrapped
+  batcher.takeBatch(batch);
+  EXPECT_EQ(frameText(batch), "{\"n\":3}");
+  EXPECT_TRUE(batcher.empty());
+  EXPECT_EQ(batcher.queuedBytes(), 0u);
+}
+
+TEST(WriteBatcherTest, RespectsByteBudgetAndNewlineFraming) {
+  auto config = batchingConfig();
+  config.framing = BatchFraming::NewlineDelimited;
+  config.maxBatchBytes = 12;
+  config.maxBatchMessages = 10;
+  WriteBatcher batcher(config);
+  auto now = Clock::now();
+  batcher.push(makeSharedMessage("aaaa"), 0, now);
+  batcher.push(makeSharedMessage("bbbb"), 0, now);
+  batcher.push(makeSharedMessage("cccc"), 0, now);
+  batcher.push(makeSharedMessage(std::string(40, 'd')), 0, now);
+
+  WriteBatch batch;
+  batcher.takeBatch(batch);
+  EXPECT_EQ(frameText(batch), "aaaa\nbbbb");
+  batcher.takeBatch(batch);
+  EXPECT_EQ(frameText(batch), "cccc");
+  // Oversized messages still go out, alone
+  batcher.takeBatch(batch);
+  EXPECT_EQ(frameText(batch), std::string(40, 'd'));
+}
+
+TEST(WriteBatcherTest, HoldsMessagesUntilBudgetOrDeadline) {
+  WriteBatcher batcher(batchingConfig());
+  auto now = Clock::now();
+  EXPECT_FALSE(batcher.readyToFlush(now));
+
+  batcher.push(makeSharedMessage("1"), 0, now);
+  EXPECT_FALSE(batcher.readyToFlush(now));
+  EXPECT_EQ(batcher.flushDeadline(), now + std::chrono::milliseconds(5));
+  EXPECT_TRUE(batcher.readyToFlush(now + std::chrono::milliseconds(5)));
+
+  batcher.push(makeSharedMessage("2"), 0, now);
+  batcher.push(makeSharedMessage("3"), 0, now);
+  EXPECT_TRUE(batcher.readyToFlush(now)); // message budget reached
+}
+
+TEST(WriteBatcherTest, DropsOldestWhenFull) {
+  WriteBatchingConfig config;
+  config.maxQueuedMessages = 2;
+  WriteBatcher batcher(config);
+  auto now = Clock::now();
+  EXPECT_EQ(batcher.push(makeSharedMessage("1"), 0, now),
+            WriteBatcher::PushResult::Queued);
+  batcher.push(makeSharedMessage("2"), 0, now);
+  EXPECT_EQ(batcher.push(makeSharedMessage("3"), 0, now),
+            WriteBatcher::PushResult::DroppedOldest);
+
+  WriteBatch batch;
+  batcher.takeBatch(batch);
+  EXPECT_EQ(frameText(batch), "2");
+}
+
+TEST(WriteBatcherTest, SquashesSupersededProgressUpdates) {
+  auto config = batchingConfig();
+  config.slowConsumerPolicy = SlowConsumerPolicy::SquashSuperseded;
+  config.maxBatchMessages = 10;
+  WriteBatcher batcher(config);
+  auto now = Clock::now();
+
+  const uint64_t job1 =
+      supersedeKeyFor(MessageType::JOB_PROGRESS_UPDATE, "job-1");
+  const uint64_t job2 =
+      supersedeKeyFor(MessageType::JOB_PROGRESS_UPDATE, "job-2");
+  EXPECT_NE(job1, 0u);
+  EXPECT_NE(job1, job2);
+  EXPECT_EQ(supersedeKeyFor(MessageType::JOB_LOG_MESSAGE, "job-1"), 0u);
+  EXPECT_EQ(supersedeKeyFor(MessageType::JOB_PROGRESS_UPDATE, ""), 0u);
+
+  batcher.push(makeSharedMessage("10"), job1, now);
+  batcher.push(makeSharedMessage("\"log\""), 0, now);
+  batcher.push(makeSharedMessage("5"), job2, now);
+  EXPECT_EQ(batcher.push(makeSharedMessage("20"), job1, now),
+            WriteBatcher::PushResult::Squashed);
+  EXPECT_EQ(batcher.push(makeSharedMessage("30"), job1, now),
+            WriteBatcher::PushResult::Squashed);
+  EXPECT_EQ(batcher.size(), 3u);
+  EXPECT_EQ(batcher.queuedBytes(), 2u + 5u + 1u);
+
+  // The latest value, in the original update's place
+  WriteBatch batch;
+  batcher.takeBatch(batch);
+  EXPECT_EQ(frameText(batch), "[30,\"log\",5]");
+
+  // Once sent, a new update is queued rather than squashed
+  EXPECT_EQ(batcher.push(makeSharedMessage("40"), job1, now),
+            WriteBatcher::PushResult::Queued);
+}
+
+TEST(WriteBatcherTest, SquashTracksPositionsAcrossDrops) {
+  WriteBatchingConfig config;
+  config.slowConsumerPolicy = SlowConsumerPolicy::SquashSuperseded;
+  config.maxQueuedMessages = 2;
+  WriteBatcher batcher(config);
+  auto now = Clock::now();
+  const uint64_t key =
+      supersedeKeyFor(MessageType::JOB_METRICS_UPDATE, "job-1");
+
+  batcher.push(makeSharedMessage("old"), key, now);
+  batcher.push(makeSharedMessage("a"), 0, now);
+  // Evicts "old", so the next update for the job queues afresh
+  batcher.push(makeSharedMessage("b"), 0, now);
+  EXPECT_EQ(batcher.push(makeSharedMessage("new"), key, now),
+            WriteBatcher::PushResult::DroppedOldest);
+  EXPECT_EQ(batcher.push(makeSharedMessage("newer"), key, now),
+            WriteBatcher::PushResult::Squashed);
+
+  WriteBatch batch;
+  batcher.takeBatch(batch);
+  EXPECT_EQ(frameText(batch), "b");
+  batcher.takeBatch(batch);
+  EXPECT_EQ(frameText(batch), "newer");
+}